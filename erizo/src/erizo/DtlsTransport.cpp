@@ -4,9 +4,12 @@
 
 #include "DtlsTransport.h"
 
+#include <algorithm>
+#include <atomic>
 #include <string>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 #include "./SrtpChannel.h"
 #include "rtp/RtpHeaders.h"
@@ -21,8 +24,6 @@ DEFINE_LOGGER(TimeoutChecker, "TimeoutChecker");
 
 using std::memcpy;
 
-static std::mutex dtls_mutex;
-
 TimeoutChecker::TimeoutChecker(DtlsTransport* transport, dtls::DtlsSocketContext* ctx)
     : transport_(transport), socket_context_(ctx),
       check_seconds_(kInitialSecsPerTimeoutCheck), max_checks_(kMaxTimeoutChecks),
@@ -55,8 +56,7 @@ void TimeoutChecker::scheduleNext() {
         if (max_checks_-- > 0) {
           ELOG_DEBUG("Handling dtls timeout, checks left: %d", max_checks_);
           if (socket_context_) {
-            std::lock_guard<std::mutex> guard(dtls_mutex);
-            socket_context_->handleTimeout();
+            transport_->handleDtlsTimeout(socket_context_);
           }
           scheduleNext();
         } else {
@@ -70,9 +70,12 @@ void TimeoutChecker::scheduleNext() {
 DtlsTransport::DtlsTransport(MediaType med, const std::string &transport_name, const std::string& connection_id,
                             bool bundle, bool rtcp_mux, std::weak_ptr<TransportListener> transport_listener,
                             const IceConfig& iceConfig, std::string username, std::string password,
-                            bool isServer, std::shared_ptr<Worker> worker, std::shared_ptr<IOWorker> io_worker):
+                            bool isServer, std::shared_ptr<Worker> worker, std::shared_ptr<IOWorker> io_worker,
+                            std::shared_ptr<Worker> handshake_worker):
   Transport(med, transport_name, connection_id, bundle, rtcp_mux, transport_listener, iceConfig, worker, io_worker),
-  readyRtp(false), readyRtcp(false), isServer_(isServer) {
+  readyRtp(false), readyRtcp(false), isServer_(isServer), dtls_started_{false},
+  handshake_worker_{handshake_worker ? handshake_worker : worker_}, handshake_started_{false},
+  handshake_duration_{duration::zero()} {
     ELOG_DEBUG("%s message: constructor, transportName: %s, isBundle: %d", toLog(), transport_name.c_str(), bundle);
     dtlsRtp.reset(new DtlsSocketContext());
 
@@ -138,11 +141,14 @@ void DtlsTransport::close() {
     rtcp_timeout_checker_->cancel();
   }
   ice_->close();
-  if (dtlsRtp) {
-    dtlsRtp->close();
-  }
-  if (dtlsRtcp) {
-    dtlsRtcp->close();
+  {
+    std::lock_guard<std::mutex> guard(dtls_mutex_);
+    if (dtlsRtp) {
+      dtlsRtp->close();
+    }
+    if (dtlsRtcp) {
+      dtlsRtcp->close();
+    }
   }
   this->state_ = TRANSPORT_FINISHED;
   ELOG_DEBUG("%s message: closed", toLog());
@@ -161,29 +167,27 @@ void DtlsTransport::onIceData(packetPtr packet) {
   if (DtlsTransport::isDtlsPacket(data, len)) {
     ELOG_DEBUG("%s message: Received DTLS message, transportName: %s, componentId: %u",
                toLog(), transport_name.c_str(), component_id);
-    if (component_id == 1) {
-      std::lock_guard<std::mutex> guard(dtls_mutex);
-      dtlsRtp->read(reinterpret_cast<unsigned char*>(data), len);
-    } else {
-      std::lock_guard<std::mutex> guard(dtls_mutex);
-      dtlsRtcp->read(reinterpret_cast<unsigned char*>(data), len);
-    }
+    startHandshakeTimer();
+    DtlsSocketContext *context = component_id == 1 ? dtlsRtp.get() : dtlsRtcp.get();
+    runInHandshakeWorker([this, context, packet] {
+      context->read(reinterpret_cast<unsigned char*>(packet->data), packet->length);
+    });
     return;
   } else if (this->getTransportState() == TRANSPORT_READY) {
-    std::shared_ptr<DataPacket> unprotect_packet = std::make_shared<DataPacket>(component_id,
-      data, len, VIDEO_PACKET, packet->received_time_ms);
+    // The received packet is owned by this task only, so we unprotect it in place
+    packet->type = VIDEO_PACKET;
 
     if (dtlsRtcp != NULL && component_id == 2) {
       srtp = srtcp_.get();
     }
     if (srtp != NULL) {
-      RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(unprotect_packet->data);
+      RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
       if (chead->isRtcp()) {
-        if (srtp->unprotectRtcp(unprotect_packet->data, &unprotect_packet->length) < 0) {
+        if (srtp->unprotectRtcp(packet->data, &packet->length) < 0) {
           return;
         }
       } else {
-        if (srtp->unprotectRtp(unprotect_packet->data, &unprotect_packet->length) < 0) {
+        if (srtp->unprotectRtp(packet->data, &packet->length) < 0) {
           return;
         }
       }
@@ -195,7 +199,7 @@ void DtlsTransport::onIceData(packetPtr packet) {
       return;
     }
     if (auto listener = getTransportListener().lock()) {
-      listener->onTransportData(unprotect_packet, this);
+      listener->onTransportData(std::move(packet), this);
     }
   }
 }
@@ -247,11 +251,67 @@ void DtlsTransport::write(char* data, int len) {
   }
 }
 
+void DtlsTransport::writeBatch(const std::vector<std::shared_ptr<DataPacket>> &packets) {
+  if (ice_ == nullptr || !running_ || this->getTransportState() != TRANSPORT_READY ||
+      ice_->checkIceState() != IceState::READY) {
+    return;
+  }
+  // Packets that only the caller's batch still holds are protected in place, there is room for the SRTP trailer in
+  // their buffers. Packets someone else keeps, e.g. the retransmission buffer, are copied so they stay unprotected.
+  std::vector<packetPtr> batch;
+  batch.reserve(packets.size());
+  for (const std::shared_ptr<DataPacket> &packet : packets) {
+    if (packet->length + SRTP_MAX_TRAILER_LEN > static_cast<int>(sizeof(packet->data))) {
+      // Sent by write(), after the packets before it to keep them in order
+      protectAndWriteBatch(std::move(batch));
+      batch.clear();
+      write(packet->data, packet->length);
+      continue;
+    }
+    bool is_rtcp = reinterpret_cast<RtcpHeader*>(packet->data)->isRtcp();
+    int comp = (is_rtcp && !rtcp_mux_) ? 2 : 1;
+    if (packet.use_count() == 1) {
+      // Pairs with the release of the holders that dropped it so their reads happen before we protect it
+      std::atomic_thread_fence(std::memory_order_acquire);
+      packet->comp = comp;
+      batch.push_back(packet);
+    } else {
+      batch.push_back(DataPacket::create(comp, packet->data, packet->length, packet->type, 0));
+    }
+  }
+  protectAndWriteBatch(std::move(batch));
+}
+
+void DtlsTransport::protectAndWriteBatch(std::vector<packetPtr> packets) {
+  if (packets.empty()) {
+    return;
+  }
+  // Like write(), RTCP uses its own session when it has its own component and packets without one go unprotected
+  std::vector<packetPtr> rtp_packets;
+  std::vector<packetPtr> rtcp_packets;
+  for (const packetPtr &packet : packets) {
+    if (dtlsRtcp != NULL && reinterpret_cast<RtcpHeader*>(packet->data)->isRtcp()) {
+      rtcp_packets.push_back(packet);
+    } else {
+      rtp_packets.push_back(packet);
+    }
+  }
+  if (srtp_) {
+    srtp_->protectBatch(rtp_packets);
+  }
+  if (srtcp_) {
+    srtcp_->protectBatch(rtcp_packets);
+  }
+  packets.erase(std::remove_if(packets.begin(), packets.end(),
+    [](const packetPtr &packet) { return packet->length <= 10; }), packets.end());
+  writeBatchOnIce(std::move(packets));
+}
+
 void DtlsTransport::onDtlsPacket(DtlsSocketContext *ctx, const unsigned char* data, unsigned int len) {
   bool is_rtcp = ctx == dtlsRtcp.get();
   int component_id = is_rtcp ? 2 : 1;
 
-  packetPtr packet = std::make_shared<DataPacket>(component_id, data, len);
+  packetPtr packet = DataPacket::create(component_id, data, len);
 
   if (is_rtcp) {
     writeDtlsPacket(dtlsRtcp.get(), packet);
@@ -270,8 +330,39 @@ void DtlsTransport::writeDtlsPacket(DtlsSocketContext *ctx, packetPtr packet) {
   writeOnIce(packet->comp, data, len);
 }
 
+void DtlsTransport::runInHandshakeWorker(std::function<void()> f) {
+  // DTLS contexts are owned by this transport, so handshakes of different connections run in parallel. The
+  // mutex is only shared with close(), which runs in our worker.
+  std::weak_ptr<Transport> weak_transport = Transport::shared_from_this();
+  handshake_worker_->task([weak_transport, f, this] {
+    if (auto transport = weak_transport.lock()) {
+      std::lock_guard<std::mutex> guard(dtls_mutex_);
+      if (running_) {
+        f();
+      }
+    }
+  });
+}
+
+void DtlsTransport::handleDtlsTimeout(DtlsSocketContext *ctx) {
+  runInHandshakeWorker([ctx] {
+    ctx->handleTimeout();
+  });
+}
+
 void DtlsTransport::onHandshakeCompleted(DtlsSocketContext *ctx, std::string clientKey, std::string serverKey,
                                          std::string srtp_profile) {
+  // Called from the handshake worker, SRTP sessions and state changes belong to our worker
+  std::weak_ptr<Transport> weak_transport = Transport::shared_from_this();
+  worker_->task([weak_transport, ctx, clientKey, serverKey, srtp_profile, this] {
+    if (auto transport = weak_transport.lock()) {
+      onHandshakeCompletedSync(ctx, clientKey, serverKey, srtp_profile);
+    }
+  });
+}
+
+void DtlsTransport::onHandshakeCompletedSync(DtlsSocketContext *ctx, std::string clientKey, std::string serverKey,
+                                             std::string srtp_profile) {
   boost::mutex::scoped_lock lock(sessionMutex_);
   std::string temp;
 
@@ -286,9 +377,11 @@ void DtlsTransport::onHandshakeCompleted(DtlsSocketContext *ctx, std::string cli
     ELOG_DEBUG("%s message: swapping keys, isServer: %d", toLog(), isServer_);
     clientKey.swap(serverKey);
   }
+  ELOG_DEBUG("%s message: Configuring SRTP, transportName: %s, profile: %s", toLog(), transport_name.c_str(),
+             srtp_profile.c_str());
   if (ctx == dtlsRtp.get()) {
     srtp_.reset(new SrtpChannel());
-    if (srtp_->setRtpParams(clientKey, serverKey)) {
+    if (srtp_->setRtpParams(clientKey, serverKey, srtp_profile)) {
       readyRtp = true;
     } else {
       updateTransportState(TRANSPORT_FAILED);
@@ -299,7 +392,7 @@ void DtlsTransport::onHandshakeCompleted(DtlsSocketContext *ctx, std::string cli
   }
   if (ctx == dtlsRtcp.get()) {
     srtcp_.reset(new SrtpChannel());
-    if (srtcp_->setRtpParams(clientKey, serverKey)) {
+    if (srtcp_->setRtpParams(clientKey, serverKey, srtp_profile)) {
       readyRtcp = true;
     } else {
       updateTransportState(TRANSPORT_FAILED);
@@ -308,11 +401,42 @@ void DtlsTransport::onHandshakeCompleted(DtlsSocketContext *ctx, std::string cli
   ELOG_DEBUG("%s message:HandShakeCompleted, transportName:%s, readyRtp:%d, readyRtcp:%d",
              toLog(), transport_name.c_str(), readyRtp, readyRtcp);
   if (readyRtp && readyRtcp) {
+    if (handshake_started_) {
+      handshake_duration_ = clock::now() - handshake_start_;
+      getHandshakeLatencyHistogram().record(handshake_duration_);
+      ELOG_DEBUG("%s message: Handshake completed, transportName: %s, durationMs: %ld", toLog(),
+                 transport_name.c_str(),
+                 std::chrono::duration_cast<std::chrono::milliseconds>(handshake_duration_).count());
+    }
     updateTransportState(TRANSPORT_READY);
   }
 }
 
+void DtlsTransport::startHandshakeTimer() {
+  if (!handshake_started_) {
+    handshake_started_ = true;
+    handshake_start_ = clock::now();
+  }
+}
+
+erizo::LatencyHistogram& DtlsTransport::getHandshakeLatencyHistogram() {
+  static LatencyHistogram handshake_latencies;
+  return handshake_latencies;
+}
+
 void DtlsTransport::onHandshakeFailed(DtlsSocketContext *ctx, const std::string& error) {
+  std::weak_ptr<Transport> weak_transport = Transport::shared_from_this();
+  worker_->task([weak_transport, ctx, error, this] {
+    if (auto transport = weak_transport.lock()) {
+      onHandshakeFailedSync(ctx, error);
+    }
+  });
+}
+
+void DtlsTransport::onHandshakeFailedSync(DtlsSocketContext *ctx, const std::string& error) {
+  if (!running_) {
+    return;
+  }
   ELOG_WARN("%s message: Handshake failed, transportName:%s, openSSLerror: %s",
             toLog(), transport_name.c_str(), error.c_str());
   running_ = false;
@@ -347,15 +471,23 @@ void DtlsTransport::updateIceStateSync(IceState state, IceConnection *conn) {
     running_ = false;
     updateTransportState(TRANSPORT_FAILED);
   } else if (state == IceState::READY) {
-    if (!isServer_ && dtlsRtp && !dtlsRtp->started) {
+    if (!isServer_ && !dtls_started_) {
+      dtls_started_ = true;
+      startHandshakeTimer();
       ELOG_INFO("%s message: DTLSRTP Start, transportName: %s", toLog(), transport_name.c_str());
-      dtlsRtp->start();
+      DtlsSocketContext *rtp_context = dtlsRtp.get();
+      runInHandshakeWorker([rtp_context] {
+        rtp_context->start();
+      });
       rtp_timeout_checker_->scheduleCheck();
-    }
-    if (!isServer_ && dtlsRtcp != NULL && !dtlsRtcp->started) {
-      ELOG_DEBUG("%s message: DTLSRTCP Start, transportName: %s", toLog(), transport_name.c_str());
-      dtlsRtcp->start();
-      rtcp_timeout_checker_->scheduleCheck();
+      if (dtlsRtcp != NULL) {
+        ELOG_DEBUG("%s message: DTLSRTCP Start, transportName: %s", toLog(), transport_name.c_str());
+        DtlsSocketContext *rtcp_context = dtlsRtcp.get();
+        runInHandshakeWorker([rtcp_context] {
+          rtcp_context->start();
+        });
+        rtcp_timeout_checker_->scheduleCheck();
+      }
     }
   }
 }
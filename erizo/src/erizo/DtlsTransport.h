@@ -7,11 +7,16 @@
 #include <boost/asio.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
+#include <functional>
+#include <mutex>  // NOLINT
 #include <string>
+#include <vector>
 #include "dtls/DtlsSocket.h"
 #include "./IceConnection.h"
 #include "./Transport.h"
 #include "./logger.h"
+#include "lib/Clock.h"
+#include "lib/LatencyHistogram.h"
 
 namespace erizo {
 class SrtpChannel;
@@ -23,7 +28,7 @@ class DtlsTransport : dtls::DtlsReceiver, public Transport {
   DtlsTransport(MediaType med, const std::string& transport_name, const std::string& connection_id, bool bundle,
                 bool rtcp_mux, std::weak_ptr<TransportListener> transport_listener, const IceConfig& iceConfig,
                 std::string username, std::string password, bool isServer, std::shared_ptr<Worker> worker,
-                std::shared_ptr<IOWorker> io_worker);
+                std::shared_ptr<IOWorker> io_worker, std::shared_ptr<Worker> handshake_worker = nullptr);
   virtual ~DtlsTransport();
   void connectionStateChanged(IceState newState);
   std::string getMyFingerprint() const;
@@ -33,6 +38,7 @@ class DtlsTransport : dtls::DtlsReceiver, public Transport {
   void onIceData(packetPtr packet) override;
   void onCandidate(const CandidateInfo &candidate, IceConnection *conn) override;
   void write(char* data, int len) override;
+  void writeBatch(const std::vector<std::shared_ptr<DataPacket>> &packets) override;
   void onDtlsPacket(dtls::DtlsSocketContext *ctx, const unsigned char* data, unsigned int len) override;
   void writeDtlsPacket(dtls::DtlsSocketContext *ctx, packetPtr packet);
   void onHandshakeCompleted(dtls::DtlsSocketContext *ctx, std::string clientKey, std::string serverKey,
@@ -42,16 +48,35 @@ class DtlsTransport : dtls::DtlsReceiver, public Transport {
   void processLocalSdp(SdpInfo *localSdp_) override;
 
   void updateIceStateSync(IceState state, IceConnection *conn);
+  void handleDtlsTimeout(dtls::DtlsSocketContext *ctx);
+
+  duration getHandshakeDuration() override { return handshake_duration_; }
+  // Handshake durations of every DtlsTransport in the process
+  static LatencyHistogram& getHandshakeLatencyHistogram();
 
  private:
+  void startHandshakeTimer();
+  void protectAndWriteBatch(std::vector<packetPtr> packets);
+  // Handshakes run in handshake_worker_, which is the transport worker unless a dedicated one is given
+  void runInHandshakeWorker(std::function<void()> f);
+  void onHandshakeCompletedSync(dtls::DtlsSocketContext *ctx, std::string clientKey, std::string serverKey,
+                                std::string srtp_profile);
+  void onHandshakeFailedSync(dtls::DtlsSocketContext *ctx, const std::string& error);
+
   char protectBuf_[5000];
   boost::scoped_ptr<dtls::DtlsSocketContext> dtlsRtp, dtlsRtcp;
   boost::mutex writeMutex_, sessionMutex_;
   boost::scoped_ptr<SrtpChannel> srtp_, srtcp_;
   bool readyRtp, readyRtcp;
   bool isServer_;
+  bool dtls_started_;
+  std::shared_ptr<Worker> handshake_worker_;
+  std::mutex dtls_mutex_;
   std::unique_ptr<TimeoutChecker> rtcp_timeout_checker_, rtp_timeout_checker_;
   packetPtr p_;
+  bool handshake_started_;
+  time_point handshake_start_;
+  duration handshake_duration_;
 };
 
 class TimeoutChecker {
@@ -40,6 +40,12 @@ const std::string& IceConnection::getLocalPassword() const {
 }
 
 
+void IceConnection::sendDataBatch(std::vector<packetPtr> packets) {
+  for (const packetPtr &packet : packets) {
+    sendData(packet->comp, packet->data, packet->length);
+  }
+}
+
 IceState IceConnection::checkIceState() {
   return ice_state_;
 }
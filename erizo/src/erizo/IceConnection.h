@@ -97,6 +97,8 @@ class IceConnection : public LogContext {
   virtual bool setRemoteCandidates(const std::vector<CandidateInfo> &candidates, bool is_bundle) = 0;
   virtual void setRemoteCredentials(const std::string& username, const std::string& password) = 0;
   virtual int sendData(unsigned int component_id, const void* buf, int len) = 0;
+  // Sends packets already owned by the caller, comp tells the component of each one
+  virtual void sendDataBatch(std::vector<packetPtr> packets);
 
   virtual void onData(unsigned int component_id, char* buf, int len) = 0;
   virtual CandidatePair getSelectedPair() = 0;
@@ -8,9 +8,16 @@
 #include <boost/thread/future.hpp>
 #include <vector>
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string>
 
 #include "lib/Clock.h"
 #include "lib/ClockUtils.h"
+#include "lib/CodecRegistry.h"
+#include "lib/PacketPool.h"
 #include "rtp/RtpHeaders.h"
 
 namespace erizo {
@@ -26,64 +33,152 @@ enum packetPriority {
   LOW_PRIORITY
 };
 
+/**
+ * Set of spatial or temporal layers a packet belongs to, kept as a bitmask so packets are cheap to copy.
+ */
+class LayerSet {
+ public:
+  static constexpr int kMaxLayers = 8;
+
+  LayerSet() : mask_{0} {}
+  LayerSet(std::initializer_list<int> layers) : mask_{0} {  // NOLINT
+    for (int layer : layers) {
+      add(layer);
+    }
+  }
+
+  // Layers out of range (i.e. -1 for unknown ssrcs) are ignored
+  void add(int layer) {
+    if (layer >= 0 && layer < kMaxLayers) {
+      mask_ |= 1 << layer;
+    }
+  }
+  bool contains(int layer) const {
+    return layer >= 0 && layer < kMaxLayers && (mask_ & (1 << layer));
+  }
+  bool empty() const { return mask_ == 0; }
+  void clear() { mask_ = 0; }
+  // -1 if empty
+  int lowest() const {
+    for (int layer = 0; layer < kMaxLayers; layer++) {
+      if (mask_ & (1 << layer)) {
+        return layer;
+      }
+    }
+    return -1;
+  }
+  template <typename F>
+  void forEach(F f) const {
+    for (int layer = 0; layer < kMaxLayers; layer++) {
+      if (mask_ & (1 << layer)) {
+        f(layer);
+      }
+    }
+  }
+
+ private:
+  uint8_t mask_;
+};
+
 struct DataPacket {
   DataPacket() = default;
 
   DataPacket(int comp_, const char *data_, int length_, packetType type_, uint64_t received_time_ms_) :
-    comp{comp_}, length{length_}, type{type_}, priority{HIGH_PRIORITY}, received_time_ms{received_time_ms_},
-    is_keyframe{false}, ending_of_layer_frame{false}, picture_id{-1}, tl0_pic_idx{-1}, is_padding{false} {
+    comp{comp_}, length{length_}, received_time_ms{received_time_ms_}, type{type_}, priority{HIGH_PRIORITY},
+    picture_id{-1}, tl0_pic_idx{-1}, clock_rate{0}, codec{kUnknownCodec}, is_keyframe{false},
+    ending_of_layer_frame{false}, is_padding{false}, is_retransmission{false} {
       memcpy(data, data_, length_);
   }
 
   DataPacket(int comp_, const char *data_, int length_, packetType type_) :
-    comp{comp_}, length{length_}, type{type_}, priority{HIGH_PRIORITY},
-    received_time_ms{ClockUtils::timePointToMs(clock::now())}, is_keyframe{false},
-    ending_of_layer_frame{false}, picture_id{-1}, tl0_pic_idx{-1}, is_padding{false} {
-      memcpy(data, data_, length_);
+    DataPacket(comp_, data_, length_, type_, ClockUtils::timePointToMs(clock::now())) {
   }
 
   DataPacket(int comp_, const unsigned char *data_, int length_) :
-    comp{comp_}, length{length_}, type{VIDEO_PACKET}, priority{HIGH_PRIORITY},
-    received_time_ms{ClockUtils::timePointToMs(clock::now())}, is_keyframe{false},
-    ending_of_layer_frame{false}, picture_id{-1}, tl0_pic_idx{-1}, is_padding{false} {
-      memcpy(data, data_, length_);
+    DataPacket(comp_, reinterpret_cast<const char*>(data_), length_, VIDEO_PACKET) {
   }
 
-  bool belongsToSpatialLayer(int spatial_layer_) {
-    std::vector<int>::iterator item = std::find(compatible_spatial_layers.begin(),
-                                              compatible_spatial_layers.end(),
-                                              spatial_layer_);
+  // Copies only the bytes in use instead of the whole buffer, and never allocates
+  DataPacket(const DataPacket &other) {
+    copyFrom(other);
+  }
 
-    return item != compatible_spatial_layers.end();
+  DataPacket& operator=(const DataPacket &other) {
+    if (this != &other) {
+      copyFrom(other);
+    }
+    return *this;
   }
 
-  bool belongsToTemporalLayer(int temporal_layer_) {
-    std::vector<int>::iterator item = std::find(compatible_temporal_layers.begin(),
-                                              compatible_temporal_layers.end(),
-                                              temporal_layer_);
+  /**
+   * Allocates a packet from the PacketPool. Arguments are forwarded to the DataPacket constructors,
+   * so DataPacket::create(*packet) gives a pooled copy.
+   */
+  template <typename... Args>
+  static std::shared_ptr<DataPacket> create(Args&&... args) {
+    return std::allocate_shared<DataPacket>(PacketPoolAllocator<DataPacket>(), std::forward<Args>(args)...);
+  }
 
-    return item != compatible_temporal_layers.end();
+  bool belongsToSpatialLayer(int spatial_layer_) const {
+    return compatible_spatial_layers.contains(spatial_layer_);
   }
 
+  bool belongsToTemporalLayer(int temporal_layer_) const {
+    return compatible_temporal_layers.contains(temporal_layer_);
+  }
+
+  // Metadata goes first and fits in one cache line, followed by the packet itself
   int comp;
-  char data[1500];
   int length;
+  uint64_t received_time_ms;
   packetType type;
   packetPriority priority;
-  uint64_t received_time_ms;
-  std::vector<int> compatible_spatial_layers;
-  std::vector<int> compatible_temporal_layers;
-  bool is_keyframe;  // Note: It can be just a keyframe first packet in VP8
-  bool ending_of_layer_frame;
   int picture_id;
   int tl0_pic_idx;
-  std::string codec;
-  unsigned int clock_rate = 0;
+  unsigned int clock_rate;
+  LayerSet compatible_spatial_layers;
+  LayerSet compatible_temporal_layers;
+  CodecId codec;
+  bool is_keyframe;  // Note: It can be just a keyframe first packet in VP8
+  bool ending_of_layer_frame;
   bool is_padding;
+  bool is_retransmission;
+  char data[1500];
+
+ private:
+  void copyFrom(const DataPacket &other) {
+    comp = other.comp;
+    length = other.length;
+    received_time_ms = other.received_time_ms;
+    type = other.type;
+    priority = other.priority;
+    picture_id = other.picture_id;
+    tl0_pic_idx = other.tl0_pic_idx;
+    clock_rate = other.clock_rate;
+    compatible_spatial_layers = other.compatible_spatial_layers;
+    compatible_temporal_layers = other.compatible_temporal_layers;
+    codec = other.codec;
+    is_keyframe = other.is_keyframe;
+    ending_of_layer_frame = other.ending_of_layer_frame;
+    is_padding = other.is_padding;
+    is_retransmission = other.is_retransmission;
+    if (other.length > 0) {
+      memcpy(data, other.data, std::min(static_cast<size_t>(other.length), sizeof(data)));
+    }
+  }
 };
 
+static_assert(offsetof(DataPacket, data) <= 64, "DataPacket metadata does not fit in a cache line");
+static_assert(sizeof(DataPacket) + 64 <= PacketPool::kBlockSize, "DataPacket does not fit in a PacketPool block");
+
 class Monitor {
+ public:
+    virtual ~Monitor() {}
+
  protected:
+    // Called whenever a MediaSink or MediaSource SSRC changes, outside monitor_mutex_
+    virtual void onSsrcsChanged() {}
+
     boost::mutex monitor_mutex_;
 };
 
@@ -119,6 +214,27 @@ class FeedbackSource {
   }
 };
 
+/**
+ * Per-sink changes to the header of a packet that is shared, unmodified, among several sinks.
+ * It is applied to the sink's own copy of the packet once it gets materialized. Sinks still copy the packet, since
+ * their pipelines and SRTP rewrite it, sharing only lets them do it on their own thread instead of the publisher's.
+ */
+struct HeaderOverlay {
+  HeaderOverlay() = default;
+  HeaderOverlay(uint32_t ssrc_, bool is_rtcp_) : ssrc{ssrc_}, is_rtcp{is_rtcp_} {}
+
+  void apply(DataPacket *packet) const {
+    if (is_rtcp) {
+      reinterpret_cast<RtcpHeader*>(packet->data)->setSSRC(ssrc);
+    } else {
+      reinterpret_cast<RtpHeader*>(packet->data)->setSSRC(ssrc);
+    }
+  }
+
+  uint32_t ssrc = 0;
+  bool is_rtcp = false;
+};
+
 /*
  * A MediaSink
  */
@@ -137,21 +253,34 @@ class MediaSink: public virtual Monitor {
     int deliverVideoData(std::shared_ptr<DataPacket> data_packet) {
         return deliverVideoData_(data_packet);
     }
+    // The packet is shared with other sinks and must not be modified, overlay gives this sink's header
+    int deliverSharedAudioData(std::shared_ptr<DataPacket> shared_packet, const HeaderOverlay &overlay) {
+        return deliverSharedAudioData_(shared_packet, overlay);
+    }
+    int deliverSharedVideoData(std::shared_ptr<DataPacket> shared_packet, const HeaderOverlay &overlay) {
+        return deliverSharedVideoData_(shared_packet, overlay);
+    }
     uint32_t getVideoSinkSSRC() {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         return video_sink_ssrc_;
     }
     void setVideoSinkSSRC(uint32_t ssrc) {
-        boost::mutex::scoped_lock lock(monitor_mutex_);
-        video_sink_ssrc_ = ssrc;
+        {
+          boost::mutex::scoped_lock lock(monitor_mutex_);
+          video_sink_ssrc_ = ssrc;
+        }
+        onSsrcsChanged();
     }
     uint32_t getAudioSinkSSRC() {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         return audio_sink_ssrc_;
     }
     void setAudioSinkSSRC(uint32_t ssrc) {
-        boost::mutex::scoped_lock lock(monitor_mutex_);
-        audio_sink_ssrc_ = ssrc;
+        {
+          boost::mutex::scoped_lock lock(monitor_mutex_);
+          audio_sink_ssrc_ = ssrc;
+        }
+        onSsrcsChanged();
     }
     bool isVideoSinkSSRC(uint32_t ssrc) {
       return ssrc == video_sink_ssrc_;
@@ -175,6 +304,17 @@ class MediaSink: public virtual Monitor {
     virtual int deliverAudioData_(std::shared_ptr<DataPacket> data_packet) = 0;
     virtual int deliverVideoData_(std::shared_ptr<DataPacket> data_packet) = 0;
     virtual int deliverEvent_(MediaEventPtr event) = 0;
+    // Sinks that can defer the copy (i.e. to their own thread) should override these
+    virtual int deliverSharedAudioData_(std::shared_ptr<DataPacket> shared_packet, const HeaderOverlay &overlay) {
+        std::shared_ptr<DataPacket> packet = DataPacket::create(*shared_packet);
+        overlay.apply(packet.get());
+        return deliverAudioData_(packet);
+    }
+    virtual int deliverSharedVideoData_(std::shared_ptr<DataPacket> shared_packet, const HeaderOverlay &overlay) {
+        std::shared_ptr<DataPacket> packet = DataPacket::create(*shared_packet);
+        overlay.apply(packet.get());
+        return deliverVideoData_(packet);
+    }
 };
 
 /**
@@ -218,28 +358,37 @@ class MediaSource: public virtual Monitor {
         return video_source_ssrc_list_[0];
     }
     void setVideoSourceSSRC(uint32_t ssrc) {
-        boost::mutex::scoped_lock lock(monitor_mutex_);
-        if (video_source_ssrc_list_.empty()) {
-          video_source_ssrc_list_.push_back(ssrc);
-          return;
+        {
+          boost::mutex::scoped_lock lock(monitor_mutex_);
+          if (video_source_ssrc_list_.empty()) {
+            video_source_ssrc_list_.push_back(ssrc);
+          } else {
+            video_source_ssrc_list_[0] = ssrc;
+          }
         }
-        video_source_ssrc_list_[0] = ssrc;
+        onSsrcsChanged();
     }
     std::vector<uint32_t> getVideoSourceSSRCList() {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         return video_source_ssrc_list_;  //  return by copy to avoid concurrent access
     }
     void setVideoSourceSSRCList(const std::vector<uint32_t>& new_ssrc_list) {
-        boost::mutex::scoped_lock lock(monitor_mutex_);
-        video_source_ssrc_list_ = new_ssrc_list;
+        {
+          boost::mutex::scoped_lock lock(monitor_mutex_);
+          video_source_ssrc_list_ = new_ssrc_list;
+        }
+        onSsrcsChanged();
     }
     uint32_t getAudioSourceSSRC() {
         boost::mutex::scoped_lock lock(monitor_mutex_);
         return audio_source_ssrc_;
     }
     void setAudioSourceSSRC(uint32_t ssrc) {
-        boost::mutex::scoped_lock lock(monitor_mutex_);
-        audio_source_ssrc_ = ssrc;
+        {
+          boost::mutex::scoped_lock lock(monitor_mutex_);
+          audio_source_ssrc_ = ssrc;
+        }
+        onSsrcsChanged();
     }
 
     bool isVideoSourceSSRC(uint32_t ssrc) {
@@ -23,6 +23,7 @@
 #include "rtp/RtpTrackMuteHandler.h"
 #include "rtp/BandwidthEstimationHandler.h"
 #include "rtp/FecReceiverHandler.h"
+#include "rtp/FecGeneratorHandler.h"
 #include "rtp/RtcpProcessorHandler.h"
 #include "rtp/RtpRetransmissionHandler.h"
 #include "rtp/RtcpFeedbackGenerationHandler.h"
@@ -40,6 +41,7 @@
 #include "rtp/RtpPaddingGeneratorHandler.h"
 #include "rtp/RtpUtils.h"
 #include "rtp/PacketCodecParser.h"
+#include "pipeline/StaticPipeline.h"
 
 namespace erizo {
 DEFINE_LOGGER(MediaStream, "MediaStream");
@@ -47,6 +49,34 @@ log4cxx::LoggerPtr MediaStream::statsLogger = log4cxx::Logger::getLogger("Stream
 
 static constexpr auto kStreamStatsPeriod = std::chrono::seconds(120);
 static constexpr uint64_t kInitialBitrate = 300000;
+static constexpr size_t kSharedPacketsRingSize = 1024;
+static constexpr size_t kReceivedPacketsRingSize = 1024;
+
+// The handler chain of every MediaStream, from the writer to the reader
+using MediaStreamPipeline = StaticPipeline<
+  PacketWriter,
+  PacketCodecParser,
+  OutgoingStatsHandler,
+  LayerDetectorHandler,
+  SRPacketHandler,
+  FecGeneratorHandler,
+  RtpRetransmissionHandler,
+  RtcpFeedbackGenerationHandler,
+  BandwidthEstimationHandler,
+  RtpPaddingRemovalHandler,
+  PliPacerHandler,
+  PliPriorityHandler,
+  PeriodicPliHandler,
+  RtpPaddingGeneratorHandler,
+  RtpSlideShowHandler,
+  RtpTrackMuteHandler,
+  FakeKeyframeGeneratorHandler,
+  IncomingStatsHandler,
+  QualityFilterHandler,
+  LayerBitrateCalculationHandler,
+  FecReceiverHandler,
+  RtcpProcessorHandler,
+  PacketReader>;
 
 MediaStream::MediaStream(std::shared_ptr<Worker> worker,
   std::shared_ptr<WebRtcConnection> connection,
@@ -60,14 +90,20 @@ MediaStream::MediaStream(std::shared_ptr<Worker> worker,
     stream_id_{media_stream_id},
     mslabel_ {media_stream_label},
     bundle_{false},
-    pipeline_{Pipeline::create()},
+    pipeline_{},
     worker_{std::move(worker)},
+    shared_packets_{kSharedPacketsRingSize},
+    shared_packets_producing_{false},
+    shared_packets_task_pending_{false},
+    received_packets_{kReceivedPacketsRingSize},
+    received_packets_task_pending_{false},
     audio_muted_{false}, video_muted_{false},
     pipeline_initialized_{false},
     is_publisher_{is_publisher},
     simulcast_{false},
     bitrate_from_max_quality_layer_{0},
     video_bitrate_{0},
+    video_sink_rtx_ssrc_{0},
     random_generator_{random_device_()},
     target_padding_bitrate_{0},
     periodic_keyframes_requested_{false},
@@ -79,6 +115,7 @@ MediaStream::MediaStream(std::shared_ptr<Worker> worker,
   } else {
     setAudioSinkSSRC(1000000000 + getRandomValue(0, 999999999));
     setVideoSinkSSRC(1000000000 + getRandomValue(0, 999999999));
+    setVideoSinkRtxSSRC(1000000000 + getRandomValue(0, 999999999));
   }
   ELOG_INFO("%s message: constructor, id: %s",
       toLog(), media_stream_id.c_str());
@@ -136,8 +173,10 @@ void MediaStream::syncClose() {
   audio_sink_.reset();
   fb_sink_.reset();
   pipeline_initialized_ = false;
-  pipeline_->close();
-  pipeline_.reset();
+  if (pipeline_) {
+    pipeline_->close();
+    pipeline_.reset();
+  }
   connection_.reset();
   ELOG_DEBUG("%s message: Close ended", toLog());
 }
@@ -174,6 +213,40 @@ bool MediaStream::isSinkSSRC(uint32_t ssrc) {
   return isVideoSinkSSRC(ssrc) || isAudioSinkSSRC(ssrc);
 }
 
+unsigned int MediaStream::getVideoRtxPayloadType(unsigned int payload_type) {
+  std::shared_ptr<SdpInfo> remote_sdp = remote_sdp_;
+  if (!remote_sdp || video_sink_rtx_ssrc_ == 0) {
+    return 0;
+  }
+  return remote_sdp->getRtxPayloadType(payload_type);
+}
+
+void MediaStream::setVideoSourceRtxSSRCMap(const std::map<uint32_t, uint32_t> &rtx_ssrc_map) {
+  {
+    boost::mutex::scoped_lock lock(monitor_mutex_);
+    video_source_ssrc_by_rtx_ssrc_.clear();
+    for (auto const& rtx_ssrc : rtx_ssrc_map) {
+      video_source_ssrc_by_rtx_ssrc_[rtx_ssrc.second] = rtx_ssrc.first;
+    }
+  }
+  onSsrcsChanged();
+}
+
+std::vector<uint32_t> MediaStream::getVideoSourceRtxSSRCList() {
+  boost::mutex::scoped_lock lock(monitor_mutex_);
+  std::vector<uint32_t> rtx_ssrcs;
+  for (auto const& rtx_ssrc : video_source_ssrc_by_rtx_ssrc_) {
+    rtx_ssrcs.push_back(rtx_ssrc.first);
+  }
+  return rtx_ssrcs;
+}
+
+void MediaStream::onSsrcsChanged() {
+  if (connection_) {
+    connection_->notifySsrcsChanged();
+  }
+}
+
 bool MediaStream::setRemoteSdp(std::shared_ptr<SdpInfo> sdp, int session_version_negotiated = -1) {
   ELOG_DEBUG("%s message: setting remote SDP to Stream, sending: %d, initialized: %d",
     toLog(), sending_, pipeline_initialized_);
@@ -222,6 +295,11 @@ bool MediaStream::setRemoteSdp(std::shared_ptr<SdpInfo> sdp, int session_version
     setVideoSourceSSRCList(video_ssrc_list_it->second);
   }
 
+  auto video_rtx_ssrc_map_it = remote_sdp_->video_rtx_ssrc_map.find(getLabel());
+  if (isPublisher() && video_rtx_ssrc_map_it != remote_sdp_->video_rtx_ssrc_map.end()) {
+    setVideoSourceRtxSSRCMap(video_rtx_ssrc_map_it->second);
+  }
+
   if (audio_ssrc_it != remote_sdp_->audio_ssrc_map.end()) {
     setAudioSourceSSRC(audio_ssrc_it->second);
   }
@@ -307,6 +385,7 @@ void MediaStream::initializeStats() {
   log_stats_->getNode().insertStat("totalBitrate", CumulativeStat{0});
   log_stats_->getNode().insertStat("rtxBitrate", CumulativeStat{0});
   log_stats_->getNode().insertStat("paddingBitrate", CumulativeStat{0});
+  log_stats_->getNode().insertStat("fecBitrate", CumulativeStat{0});
   log_stats_->getNode().insertStat("bwe", CumulativeStat{0});
 
   log_stats_->getNode().insertStat("maxVideoBW", CumulativeStat{0});
@@ -398,6 +477,7 @@ void MediaStream::printStats() {
   transferMediaStats("totalBitrate", "total", "bitrateCalculated");
   transferMediaStats("paddingBitrate", "total", "paddingBitrate");
   transferMediaStats("rtxBitrate", "total", "rtxBitrate");
+  transferMediaStats("fecBitrate", "total", "fecBitrate");
   transferMediaStats("bwe", "total", "senderBitrateEstimation");
 
   ELOG_INFOT(statsLogger, "%s", log_stats_->getStats());
@@ -408,6 +488,30 @@ void MediaStream::initializePipeline() {
     return;
   }
   handler_manager_ = std::make_shared<HandlerManager>(shared_from_this());
+  pipeline_ = MediaStreamPipeline::create(
+    std::make_shared<PacketWriter>(this),
+    std::make_shared<PacketCodecParser>(),
+    std::make_shared<OutgoingStatsHandler>(),
+    std::make_shared<LayerDetectorHandler>(),
+    std::make_shared<SRPacketHandler>(),
+    std::make_shared<FecGeneratorHandler>(),
+    std::make_shared<RtpRetransmissionHandler>(),
+    std::make_shared<RtcpFeedbackGenerationHandler>(),
+    std::make_shared<BandwidthEstimationHandler>(),
+    std::make_shared<RtpPaddingRemovalHandler>(),
+    std::make_shared<PliPacerHandler>(),
+    std::make_shared<PliPriorityHandler>(),
+    std::make_shared<PeriodicPliHandler>(),
+    std::make_shared<RtpPaddingGeneratorHandler>(),
+    std::make_shared<RtpSlideShowHandler>(),
+    std::make_shared<RtpTrackMuteHandler>(),
+    std::make_shared<FakeKeyframeGeneratorHandler>(),
+    std::make_shared<IncomingStatsHandler>(),
+    std::make_shared<QualityFilterHandler>(),
+    std::make_shared<LayerBitrateCalculationHandler>(),
+    std::make_shared<FecReceiverHandler>(),
+    std::make_shared<RtcpProcessorHandler>(),
+    std::make_shared<PacketReader>(this));
   pipeline_->addService(shared_from_this());
   pipeline_->addService(handler_manager_);
   pipeline_->addService(rtcp_processor_);
@@ -415,48 +519,41 @@ void MediaStream::initializePipeline() {
   pipeline_->addService(quality_manager_);
   pipeline_->addService(packet_buffer_);
 
-  pipeline_->addFront(std::make_shared<PacketReader>(this));
-
-  pipeline_->addFront(std::make_shared<RtcpProcessorHandler>());
-  pipeline_->addFront(std::make_shared<FecReceiverHandler>());
-  pipeline_->addFront(std::make_shared<LayerBitrateCalculationHandler>());
-  pipeline_->addFront(std::make_shared<QualityFilterHandler>());
-  pipeline_->addFront(std::make_shared<IncomingStatsHandler>());
-  pipeline_->addFront(std::make_shared<FakeKeyframeGeneratorHandler>());
-  pipeline_->addFront(std::make_shared<RtpTrackMuteHandler>());
-  pipeline_->addFront(std::make_shared<RtpSlideShowHandler>());
-  pipeline_->addFront(std::make_shared<RtpPaddingGeneratorHandler>());
-  pipeline_->addFront(std::make_shared<PeriodicPliHandler>());
-  pipeline_->addFront(std::make_shared<PliPriorityHandler>());
-  pipeline_->addFront(std::make_shared<PliPacerHandler>());
-  pipeline_->addFront(std::make_shared<RtpPaddingRemovalHandler>());
-  pipeline_->addFront(std::make_shared<BandwidthEstimationHandler>());
-  pipeline_->addFront(std::make_shared<RtcpFeedbackGenerationHandler>());
-  pipeline_->addFront(std::make_shared<RtpRetransmissionHandler>());
-  pipeline_->addFront(std::make_shared<SRPacketHandler>());
-  pipeline_->addFront(std::make_shared<LayerDetectorHandler>());
-  pipeline_->addFront(std::make_shared<OutgoingStatsHandler>());
-  pipeline_->addFront(std::make_shared<PacketCodecParser>());
-
-  pipeline_->addFront(std::make_shared<PacketWriter>(this));
   pipeline_->finalize();
 
   if (connection_) {
     quality_manager_->setConnectionQualityLevel(connection_->getConnectionQualityLevel());
+    if (!is_publisher_) {
+      pipeline_->notifyEvent(std::make_shared<VideoFractionLostEvent>(connection_->getVideoFractionLost()));
+    }
   }
   pipeline_initialized_ = true;
 }
 
 int MediaStream::deliverAudioData_(std::shared_ptr<DataPacket> audio_packet) {
   if (audio_enabled_) {
-    sendPacketAsync(std::make_shared<DataPacket>(*audio_packet));
+    sendPacketAsync(DataPacket::create(*audio_packet));
   }
   return audio_packet->length;
 }
 
 int MediaStream::deliverVideoData_(std::shared_ptr<DataPacket> video_packet) {
   if (video_enabled_) {
-    sendPacketAsync(std::make_shared<DataPacket>(*video_packet));
+    sendPacketAsync(DataPacket::create(*video_packet));
+  }
+  return video_packet->length;
+}
+
+int MediaStream::deliverSharedAudioData_(std::shared_ptr<DataPacket> audio_packet, const HeaderOverlay &overlay) {
+  if (audio_enabled_) {
+    sendPacketAsync(audio_packet, overlay);
+  }
+  return audio_packet->length;
+}
+
+int MediaStream::deliverSharedVideoData_(std::shared_ptr<DataPacket> video_packet, const HeaderOverlay &overlay) {
+  if (video_enabled_) {
+    sendPacketAsync(video_packet, overlay);
   }
   return video_packet->length;
 }
@@ -511,13 +608,12 @@ int MediaStream::deliverEvent_(MediaEventPtr event) {
   return 1;
 }
 
-void MediaStream::onTransportData(std::shared_ptr<DataPacket> incoming_packet, Transport *transport) {
+void MediaStream::onTransportData(std::shared_ptr<DataPacket> packet, Transport *transport) {
   if (audio_sink_.expired() && video_sink_.expired() && fb_sink_.expired()) {
     return;
   }
 
-  std::shared_ptr<DataPacket> packet = std::make_shared<DataPacket>(*incoming_packet);
-
+  // WebRtcConnection hands every stream its own packet, so there is no need to copy it here
   if (transport->mediaType == AUDIO_TYPE) {
     packet->type = AUDIO_PACKET;
   } else if (transport->mediaType == VIDEO_TYPE) {
@@ -525,31 +621,77 @@ void MediaStream::onTransportData(std::shared_ptr<DataPacket> incoming_packet, T
   }
   auto stream_ptr = shared_from_this();
 
-  worker_->task([stream_ptr, packet]{
-    if (!stream_ptr->pipeline_initialized_) {
-      ELOG_DEBUG("%s message: Pipeline not initialized yet.", stream_ptr->toLog());
-      return;
-    }
+  // The connection worker is the only producer of the queue. Packets that arrive while a read task is pending
+  // are read with it, so the pipeline handles all of them in one batch and in the order they arrived.
+  if (!received_packets_.push(std::move(packet))) {
+    ELOG_DEBUG("%s message: Received packets ring full, queueing packet in the overflow list", toLog());
+  }
+  if (!received_packets_task_pending_.exchange(true)) {
+    worker_->task([stream_ptr]{
+      stream_ptr->readReceivedPackets();
+    }, kPacketTask);
+  }
+}
+
+void MediaStream::readReceivedPackets() {
+  // Cleared before draining so packets pushed meanwhile schedule a new task
+  received_packets_task_pending_ = false;
+  PacketBatch packets;
+  received_packets_.consumeAll([&packets](std::shared_ptr<DataPacket> &packet) {
+    packets.push_back(std::move(packet));
+  });
+  readPackets(std::move(packets));
+}
+
+void MediaStream::readPackets(PacketBatch packets) {
+  if (packets.empty()) {
+    return;
+  }
+  if (!pipeline_initialized_) {
+    ELOG_DEBUG("%s message: Pipeline not initialized yet.", toLog());
+    return;
+  }
 
+  // Retransmissions that carry no packet (i.e. RTX padding) are dropped here
+  packets.erase(std::remove_if(packets.begin(), packets.end(), [this](const std::shared_ptr<DataPacket> &packet) {
     char* buf = packet->data;
     RtpHeader *head = reinterpret_cast<RtpHeader*> (buf);
     RtcpHeader *chead = reinterpret_cast<RtcpHeader*> (buf);
-    if (!chead->isRtcp()) {
-      uint32_t recvSSRC = head->getSSRC();
-      if (stream_ptr->isVideoSourceSSRC(recvSSRC)) {
-        packet->type = VIDEO_PACKET;
-      } else if (stream_ptr->isAudioSourceSSRC(recvSSRC)) {
-        packet->type = AUDIO_PACKET;
+    if (chead->isRtcp()) {
+      return false;
+    }
+    uint32_t recvSSRC = head->getSSRC();
+    if (isVideoSourceSSRC(recvSSRC)) {
+      packet->type = VIDEO_PACKET;
+    } else if (isAudioSourceSSRC(recvSSRC)) {
+      packet->type = AUDIO_PACKET;
+    } else if (video_source_ssrc_by_rtx_ssrc_.count(recvSSRC) > 0) {
+      if (!unpackVideoSourceRtxPacket(packet)) {
+        return true;
       }
+      packet->type = VIDEO_PACKET;
     }
+    return false;
+  }), packets.end());
 
-    if (stream_ptr->pipeline_) {
-      stream_ptr->pipeline_->read(std::move(packet));
-    }
-  });
+  if (pipeline_ && !packets.empty()) {
+    pipeline_->readBatch(std::move(packets));
+  }
+}
+
+bool MediaStream::unpackVideoSourceRtxPacket(const std::shared_ptr<DataPacket> &packet) {
+  std::shared_ptr<SdpInfo> remote_sdp = remote_sdp_;
+  RtpHeader *head = reinterpret_cast<RtpHeader*>(packet->data);
+  auto video_ssrc_it = video_source_ssrc_by_rtx_ssrc_.find(head->getSSRC());
+  if (!remote_sdp || video_ssrc_it == video_source_ssrc_by_rtx_ssrc_.end()) {
+    return false;
+  }
+  unsigned int payload_type = remote_sdp->getRtxAssociatedPayloadType(head->getPayloadType());
+  return payload_type != 0 && RtpUtils::unpackRtxPacket(packet, video_ssrc_it->second, payload_type);
 }
 
 void MediaStream::read(std::shared_ptr<DataPacket> packet) {
+  worker_->addProcessedPackets();
   char* buf = packet->data;
   int len = packet->length;
   // PROCESS RTCP
@@ -638,7 +780,7 @@ int MediaStream::sendPLI() {
   thePLI.setLength(2);
   char *buf = reinterpret_cast<char*>(&thePLI);
   int len = (thePLI.getLength() + 1) * 4;
-  sendPacketAsync(std::make_shared<DataPacket>(0, buf, len, VIDEO_PACKET));
+  sendPacketAsync(DataPacket::create(0, buf, len, VIDEO_PACKET));
   return len;
 }
 
@@ -662,11 +804,11 @@ void MediaStream::sendPacketAsync(std::shared_ptr<DataPacket> packet) {
   auto stream_ptr = shared_from_this();
   if (packet->comp == -1) {
     sending_ = false;
-    auto p = std::make_shared<DataPacket>();
+    auto p = DataPacket::create();
     p->comp = -1;
     worker_->task([stream_ptr, p]{
       stream_ptr->sendPacket(p);
-    });
+    }, kPacketTask);
     return;
   }
 
@@ -674,6 +816,53 @@ void MediaStream::sendPacketAsync(std::shared_ptr<DataPacket> packet) {
   changeDeliverExtensionId(packet.get(), packet->type);
   worker_->task([stream_ptr, packet]{
     stream_ptr->sendPacket(packet);
+  }, kPacketTask);
+}
+
+void MediaStream::sendPacketAsync(std::shared_ptr<DataPacket> shared_packet, const HeaderOverlay &overlay) {
+  if (!sending_) {
+    return;
+  }
+  if (shared_packet->comp == -1) {
+    sendPacketAsync(shared_packet);
+    return;
+  }
+  // The publisher worker is usually the only producer, but it changes when the publisher is migrated and feedback
+  // can come from other threads, so a thread that finds another one pushing sends its own copy as a task instead.
+  if (shared_packets_producing_.exchange(true, std::memory_order_acquire)) {
+    std::shared_ptr<DataPacket> packet = DataPacket::create(*shared_packet);
+    overlay.apply(packet.get());
+    sendPacketAsync(packet);
+    return;
+  }
+  // The copy is made in our own worker so the publisher does not pay for every subscriber. A full ring spills to
+  // the queue's overflow list, nothing is dropped.
+  shared_packets_.push(SharedPacketHandoff{shared_packet, overlay});
+  shared_packets_producing_.store(false, std::memory_order_release);
+  if (!shared_packets_task_pending_.exchange(true)) {
+    auto stream_ptr = shared_from_this();
+    worker_->task([stream_ptr]{
+      stream_ptr->sendSharedPackets();
+    }, kPacketTask);
+  }
+}
+
+void MediaStream::sendSharedPackets() {
+  // Cleared before draining so packets pushed meanwhile schedule a new task
+  shared_packets_task_pending_ = false;
+  shared_packets_.consumeAll([this](SharedPacketHandoff &handoff) {
+    // Our pipeline and SRTP rewrite the packet, so we need our own copy unless every other holder is done with it
+    std::shared_ptr<DataPacket> packet = std::move(handoff.packet);
+    if (packet.use_count() == 1) {
+      // Pairs with the release of the other holders so their reads happen before our writes
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } else {
+      packet = DataPacket::create(*packet);
+    }
+    handoff.overlay.apply(packet.get());
+    changeDeliverPayloadType(packet.get(), packet->type);
+    changeDeliverExtensionId(packet.get(), packet->type);
+    sendPacket(packet);
   });
 }
 
@@ -794,6 +983,18 @@ void MediaStream::getJSONStats(std::function<void(std::string)> callback) {
   });
 }
 
+void MediaStream::getStatsDelta(const std::string &consumer_id, std::function<void(std::vector<uint8_t>)> callback) {
+  asyncTask([consumer_id, callback] (std::shared_ptr<MediaStream> stream) {
+    callback(stream->stats_->getStatsDelta(consumer_id));
+  });
+}
+
+void MediaStream::removeStatsDeltaConsumer(const std::string &consumer_id) {
+  asyncTask([consumer_id] (std::shared_ptr<MediaStream> stream) {
+    stream->stats_->removeStatsDeltaConsumer(consumer_id);
+  });
+}
+
 void MediaStream::changeDeliverExtensionId(DataPacket *dp, packetType type) {
   RtpHeader* h = reinterpret_cast<RtpHeader*>(dp->data);
   RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(dp->data);
@@ -924,6 +1125,7 @@ void MediaStream::parseIncomingPayloadType(char *buf, int len, packetType type)
 }
 
 void MediaStream::write(std::shared_ptr<DataPacket> packet) {
+  worker_->addProcessedPackets();
   if (connection_) {
     connection_->send(packet);
   }
@@ -19,6 +19,7 @@
 #include "./WebRtcConnection.h"
 #include "pipeline/Pipeline.h"
 #include "thread/Worker.h"
+#include "thread/SpscQueue.h"
 #include "rtp/RtcpProcessor.h"
 #include "rtp/RtpExtensionProcessor.h"
 #include "lib/Clock.h"
@@ -35,6 +36,7 @@ class MediaStreamStatsListener {
     virtual ~MediaStreamStatsListener() {
     }
     virtual void notifyStats(const std::string& message) = 0;
+    virtual void notifyStatsDelta(const std::vector<uint8_t>& delta) {}
 };
 
 
@@ -113,15 +115,19 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
    * Sets the Stats Listener for this MediaStream
    */
   inline void setMediaStreamStatsListener(
-            MediaStreamStatsListener* listener) {
-    stats_->setStatsListener(listener);
+            MediaStreamStatsListener* listener, bool binary = false) {
+    stats_->setStatsListener(listener, binary);
   }
 
   void getJSONStats(std::function<void(std::string)> callback);
+  // Stats changed since the previous call of the same consumer, see StatsDeltaEncoder
+  void getStatsDelta(const std::string &consumer_id, std::function<void(std::vector<uint8_t>)> callback);
+  void removeStatsDeltaConsumer(const std::string &consumer_id);
 
   virtual void onTransportData(std::shared_ptr<DataPacket> packet, Transport *transport);
 
   void sendPacketAsync(std::shared_ptr<DataPacket> packet);
+  void sendPacketAsync(std::shared_ptr<DataPacket> shared_packet, const HeaderOverlay &overlay);
 
   void setTransportInfo(std::string audio_info, std::string video_info);
 
@@ -168,6 +174,14 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
 
   bool isSourceSSRC(uint32_t ssrc);
   bool isSinkSSRC(uint32_t ssrc);
+  uint32_t getVideoSinkRtxSSRC() { return video_sink_rtx_ssrc_; }
+  void setVideoSinkRtxSSRC(uint32_t ssrc) { video_sink_rtx_ssrc_ = ssrc; }
+  bool isVideoSinkRtxSSRC(uint32_t ssrc) { return ssrc != 0 && ssrc == video_sink_rtx_ssrc_; }
+  // RTX SSRCs the publisher retransmits its video SSRCs with, keyed by the video SSRC
+  void setVideoSourceRtxSSRCMap(const std::map<uint32_t, uint32_t> &rtx_ssrc_map);
+  std::vector<uint32_t> getVideoSourceRtxSSRCList();
+  // Returns the rtx payload type to resend packets of the given video payload type, 0 if rtx can't be used
+  unsigned int getVideoRtxPayloadType(unsigned int payload_type);
   void parseIncomingPayloadType(char *buf, int len, packetType type);
   void parseIncomingExtensionId(char *buf, int len, packetType type);
   virtual void setTargetPaddingBitrate(uint64_t bitrate);
@@ -189,9 +203,21 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
   virtual PublisherInfo getPublisherInfo() { return publisher_info_; }
 
  private:
+  struct SharedPacketHandoff {
+    std::shared_ptr<DataPacket> packet;
+    HeaderOverlay overlay;
+  };
+
   void sendPacket(std::shared_ptr<DataPacket> packet);
+  void sendSharedPackets();
+  void readReceivedPackets();
+  void readPackets(PacketBatch packets);
+  bool unpackVideoSourceRtxPacket(const std::shared_ptr<DataPacket> &packet);
+  void onSsrcsChanged() override;
   int deliverAudioData_(std::shared_ptr<DataPacket> audio_packet) override;
   int deliverVideoData_(std::shared_ptr<DataPacket> video_packet) override;
+  int deliverSharedAudioData_(std::shared_ptr<DataPacket> audio_packet, const HeaderOverlay &overlay) override;
+  int deliverSharedVideoData_(std::shared_ptr<DataPacket> video_packet, const HeaderOverlay &overlay) override;
   int deliverFeedback_(std::shared_ptr<DataPacket> fb_packet) override;
   int deliverEvent_(MediaEventPtr event) override;
   void initializePipeline();
@@ -228,9 +254,18 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
   std::shared_ptr<PacketBufferService> packet_buffer_;
   std::shared_ptr<HandlerManager> handler_manager_;
 
+  // Null until initializePipeline() builds the static pipeline
   Pipeline::Ptr pipeline_;
 
   std::shared_ptr<Worker> worker_;
+  // Packets shared by a OneToManyProcessor, pushed from the publisher worker and sent from ours
+  SpscQueue<SharedPacketHandoff> shared_packets_;
+  // Set while a thread pushes to shared_packets_, so there is never more than one producer at a time
+  std::atomic<bool> shared_packets_producing_;
+  std::atomic<bool> shared_packets_task_pending_;
+  // Packets received from the connection, pushed from its worker and read through the pipeline in batches
+  SpscQueue<std::shared_ptr<DataPacket>> received_packets_;
+  std::atomic<bool> received_packets_task_pending_;
 
   bool audio_muted_;
   bool video_muted_;
@@ -242,6 +277,9 @@ class MediaStream: public MediaSink, public MediaSource, public FeedbackSink,
   std::atomic_bool simulcast_;
   std::atomic<uint64_t> bitrate_from_max_quality_layer_;
   std::atomic<uint32_t> video_bitrate_;
+  std::atomic<uint32_t> video_sink_rtx_ssrc_;
+  // Only written from our worker, read without locking there
+  std::map<uint32_t, uint32_t> video_source_ssrc_by_rtx_ssrc_;
   std::random_device random_device_;
   std::mt19937 random_generator_;
   uint64_t target_padding_bitrate_;
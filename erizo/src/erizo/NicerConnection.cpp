@@ -3,6 +3,7 @@
  */
 
 #include "NicerConnection.h"
+#include "lib/NicerBatchSocket.h"
 
 // nICEr includes
 extern "C" {
@@ -188,6 +189,11 @@ void NicerConnection::startSync() {
     return;
   }
 
+  // Sends and receives UDP datagrams in batches where the platform allows it
+  if (nr_socket_factory *socket_factory = NicerBatchSocket::createFactory()) {
+    nicer_->IceContextSetSocketFactory(ctx_, socket_factory);
+  }
+
   r = nicer_->IceContextSetTrickleCallback(ctx_, &NicerConnection::trickle_callback, this);
   if (r) {
     ELOG_WARN("%s message: Couldn't set trickle callback", toLog());
@@ -479,26 +485,41 @@ int NicerConnection::sendData(unsigned int component_id, const void* buf, int le
   if (checkIceState() != IceState::READY) {
     return -1;
   }
-  packetPtr packet (new DataPacket());
-  memcpy(packet->data, buf, len);
-  packet->length = len;
-  nr_ice_peer_ctx *peer = peer_;
-  nr_ice_media_stream *stream = stream_;
-  std::shared_ptr<NicerInterface> nicer = nicer_;
-  async([nicer, packet, peer, stream, component_id, len] (std::shared_ptr<NicerConnection> this_ptr) {
-    UINT4 r = nicer->IceMediaStreamSend(peer,
-                                         stream,
-                                         component_id,
-                                         reinterpret_cast<unsigned char*>(packet->data),
-                                         len);
-    if (r) {
-      ELOG_WARN("%s message: Couldn't send data on ICE", this_ptr->toLog());
-    }
+  packetPtr packet = DataPacket::create(component_id, static_cast<const char*>(buf), len, OTHER_PACKET, 0);
+  async([packet] (std::shared_ptr<NicerConnection> this_ptr) {
+    this_ptr->sendPacketSync(packet);
   });
 
   return len;
 }
 
+void NicerConnection::sendDataBatch(std::vector<packetPtr> packets) {
+  if (checkIceState() != IceState::READY || packets.empty()) {
+    return;
+  }
+  auto shared_packets = std::make_shared<std::vector<packetPtr>>(std::move(packets));
+  async([shared_packets] (std::shared_ptr<NicerConnection> this_ptr) {
+    for (const packetPtr &packet : *shared_packets) {
+      this_ptr->sendPacketSync(packet);
+    }
+  });
+}
+
+void NicerConnection::sendPacketSync(const packetPtr &packet) {
+  // peer_ and stream_ are read here and not when queuing, the connection may have closed in between
+  if (closed_) {
+    return;
+  }
+  UINT4 r = nicer_->IceMediaStreamSend(peer_,
+                                       stream_,
+                                       packet->comp,
+                                       reinterpret_cast<unsigned char*>(packet->data),
+                                       packet->length);
+  if (r) {
+    ELOG_WARN("%s message: Couldn't send data on ICE", toLog());
+  }
+}
+
 std::string getHostTypeFromNicerCandidate(nr_ice_candidate *candidate) {
   switch (candidate->type) {
     case nr_ice_candidate_type::HOST: return "host";
@@ -579,11 +600,8 @@ void NicerConnection::onData(unsigned int component_id, char* buf, int len) {
     state = this->checkIceState();
   }
   if (state == IceState::READY) {
-    packetPtr packet (new DataPacket());
-    memcpy(packet->data, buf, len);
-    packet->comp = component_id;
-    packet->length = len;
-    packet->received_time_ms = ClockUtils::timePointToMs(clock::now());
+    packetPtr packet = DataPacket::create(component_id, buf, len, OTHER_PACKET,
+                                          ClockUtils::timePointToMs(clock::now()));
     if (auto listener = getIceListener().lock()) {
       listener->onPacketReceived(packet);
     }
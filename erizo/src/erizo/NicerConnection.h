@@ -53,6 +53,7 @@ class NicerConnection : public IceConnection, public std::enable_shared_from_thi
   void onCandidate(nr_ice_media_stream *stream, int component_id, nr_ice_candidate *candidate);
   void setRemoteCredentials(const std::string& username, const std::string& password) override;
   int sendData(unsigned int component_id, const void* buf, int len) override;
+  void sendDataBatch(std::vector<packetPtr> packets) override;
 
   void onData(unsigned int component_id, char* buf, int len) override;
   CandidatePair getSelectedPair() override;
@@ -75,6 +76,7 @@ class NicerConnection : public IceConnection, public std::enable_shared_from_thi
   void startChecking();
   void startSync();
   void closeSync();
+  void sendPacketSync(const packetPtr &packet);
   void async(function<void(std::shared_ptr<NicerConnection>)> f);
   void setRemoteCredentialsSync(const std::string& username, const std::string& password);
 
@@ -5,6 +5,7 @@
 #include "OneToManyProcessor.h"
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "./MediaStream.h"
@@ -13,7 +14,8 @@
 
 namespace erizo {
   DEFINE_LOGGER(OneToManyProcessor, "OneToManyProcessor");
-  OneToManyProcessor::OneToManyProcessor() : feedback_sink_{} {
+  OneToManyProcessor::OneToManyProcessor() : feedback_sink_{},
+      snapshot_{std::unique_ptr<const Snapshot>(new Snapshot())} {
     ELOG_DEBUG("OneToManyProcessor constructor");
   }
 
@@ -24,37 +26,28 @@ namespace erizo {
     if (audio_packet->length <= 0)
       return 0;
 
-    boost::unique_lock<boost::mutex> lock(monitor_mutex_);
-    if (subscribers_.empty() || !publisher_) {
+    RcuPointer<Snapshot>::ReadGuard snapshot = snapshot_.read();
+    if (snapshot->subscribers.empty() || !snapshot->publisher) {
       return 0;
     }
 
-    std::map<std::string, std::shared_ptr<MediaSink>>::iterator it;
-    RtpHeader* head = reinterpret_cast<RtpHeader*>(audio_packet->data);
     RtcpHeader* chead = reinterpret_cast<RtcpHeader*>(audio_packet->data);
-    for (it = subscribers_.begin(); it != subscribers_.end(); ++it) {
-      if ((*it).second != nullptr) {
-        // Hack to avoid audio drift
-        if (chead->isRtcp() && chead->isSDES()) {
-          chead->setSSRC((*it).second->getAudioSinkSSRC());
-        } else {
-          head->setSSRC((*it).second->getAudioSinkSSRC());
-        }
-        // Note: deliverAudioData must copy the packet inmediately
-        (*it).second->deliverAudioData(audio_packet);
-      }
+    // Hack to avoid audio drift
+    bool is_rtcp_sdes = chead->isRtcp() && chead->isSDES();
+    for (const std::shared_ptr<MediaSink> &subscriber : snapshot->subscribers) {
+      // The packet is shared by all subscribers, each one applies its own SSRC when copying it
+      HeaderOverlay overlay(subscriber->getAudioSinkSSRC(), is_rtcp_sdes);
+      subscriber->deliverSharedAudioData(audio_packet, overlay);
     }
 
     return 0;
   }
 
   bool OneToManyProcessor::isSSRCFromAudio(uint32_t ssrc) {
-    std::map<std::string, std::shared_ptr<MediaSink>>::iterator it;
-    for (it = subscribers_.begin(); it != subscribers_.end(); ++it) {
-      if ((*it).second != nullptr) {
-        if ((*it).second->getAudioSinkSSRC() == ssrc) {
-          return true;
-        }
+    RcuPointer<Snapshot>::ReadGuard snapshot = snapshot_.read();
+    for (const std::shared_ptr<MediaSink> &subscriber : snapshot->subscribers) {
+      if (subscriber->getAudioSinkSSRC() == ssrc) {
+        return true;
       }
     }
     return false;
@@ -69,60 +62,59 @@ namespace erizo {
       deliverFeedback_(video_packet);
       return 0;
     }
-    boost::unique_lock<boost::mutex> lock(monitor_mutex_);
-    if (subscribers_.empty() || !publisher_) {
+    RcuPointer<Snapshot>::ReadGuard snapshot = snapshot_.read();
+    if (snapshot->subscribers.empty() || !snapshot->publisher) {
       return 0;
     }
-    std::map<std::string, std::shared_ptr<MediaSink>>::iterator it;
     RtpHeader* rhead = reinterpret_cast<RtpHeader*>(video_packet->data);
-    uint32_t ssrc = head->isRtcp() ? head->getSSRC() : rhead->getSSRC();
-    uint32_t ssrc_offset = translateAndMaybeAdaptForSimulcast(ssrc);
-    for (it = subscribers_.begin(); it != subscribers_.end(); ++it) {
-      if ((*it).second != nullptr) {
-        uint32_t base_ssrc = (*it).second->getVideoSinkSSRC();
-        if (head->isRtcp()) {
-          head->setSSRC(base_ssrc + ssrc_offset);
-        } else {
-          rhead->setSSRC(base_ssrc + ssrc_offset);
-        }
-        // Note: deliverVideoData must copy the packet inmediately
-        (*it).second->deliverVideoData(video_packet);
-      }
+    bool is_rtcp = head->isRtcp();
+    uint32_t ssrc = is_rtcp ? head->getSSRC() : rhead->getSSRC();
+    uint32_t ssrc_offset = translateAndMaybeAdaptForSimulcast(snapshot->publisher, ssrc);
+    for (const std::shared_ptr<MediaSink> &subscriber : snapshot->subscribers) {
+      uint32_t base_ssrc = subscriber->getVideoSinkSSRC();
+      // The packet is shared by all subscribers, each one applies its own SSRC when copying it
+      subscriber->deliverSharedVideoData(video_packet, HeaderOverlay(base_ssrc + ssrc_offset, is_rtcp));
     }
     return 0;
   }
 
-  uint32_t OneToManyProcessor::translateAndMaybeAdaptForSimulcast(uint32_t orig_ssrc) {
-    return orig_ssrc - publisher_->getVideoSourceSSRC();
+  uint32_t OneToManyProcessor::translateAndMaybeAdaptForSimulcast(std::shared_ptr<MediaSource> publisher,
+      uint32_t orig_ssrc) {
+    return orig_ssrc - publisher->getVideoSourceSSRC();
   }
 
   void OneToManyProcessor::setPublisher(std::shared_ptr<MediaSource> publisher_stream, std::string publisher_id) {
     boost::mutex::scoped_lock lock(monitor_mutex_);
     publisher_ = publisher_stream;
-    feedback_sink_ = publisher_->getFeedbackSink();
+    feedback_sink_ = publisher_stream->getFeedbackSink();
     publisher_id_ = publisher_id;
+    publishSnapshot();
   }
 
   std::shared_ptr<MediaSource> OneToManyProcessor::getPublisher() {
-    return publisher_;
+    return snapshot_.read()->publisher;
   }
 
   int OneToManyProcessor::deliverFeedback_(std::shared_ptr<DataPacket> fb_packet) {
+    std::shared_ptr<MediaSource> publisher = snapshot_.read()->publisher;
+    if (!publisher) {
+      return 0;
+    }
     if (auto feedback_sink = feedback_sink_.lock()) {
-      RtpUtils::forEachRtcpBlock(fb_packet, [this](RtcpHeader *chead) {
+      RtpUtils::forEachRtcpBlock(fb_packet, [this, &publisher](RtcpHeader *chead) {
         if (chead->isREMB()) {
           for (uint8_t index = 0; index < chead->getREMBNumSSRC(); index++) {
             if (isSSRCFromAudio(chead->getREMBFeedSSRC(index))) {
-              chead->setREMBFeedSSRC(index, publisher_->getAudioSourceSSRC());
+              chead->setREMBFeedSSRC(index, publisher->getAudioSourceSSRC());
             } else {
-              chead->setREMBFeedSSRC(index, publisher_->getVideoSourceSSRC());
+              chead->setREMBFeedSSRC(index, publisher->getVideoSourceSSRC());
             }
           }
         }
         if (isSSRCFromAudio(chead->getSourceSSRC())) {
-          chead->setSourceSSRC(publisher_->getAudioSourceSSRC());
+          chead->setSourceSSRC(publisher->getAudioSourceSSRC());
         } else {
-          chead->setSourceSSRC(publisher_->getVideoSourceSSRC());
+          chead->setSourceSSRC(publisher->getVideoSourceSSRC());
         }
       });
       feedback_sink->deliverFeedback(fb_packet);
@@ -131,15 +123,12 @@ namespace erizo {
   }
 
   int OneToManyProcessor::deliverEvent_(MediaEventPtr event) {
-    boost::unique_lock<boost::mutex> lock(monitor_mutex_);
-    if (subscribers_.empty() || !publisher_) {
+    RcuPointer<Snapshot>::ReadGuard snapshot = snapshot_.read();
+    if (snapshot->subscribers.empty() || !snapshot->publisher) {
       return 0;
     }
-    std::map<std::string, std::shared_ptr<MediaSink>>::iterator it;
-    for (it = subscribers_.begin(); it != subscribers_.end(); ++it) {
-      if ((*it).second != nullptr) {
-        (*it).second->deliverEvent(event);
-      }
+    for (const std::shared_ptr<MediaSink> &subscriber : snapshot->subscribers) {
+      subscriber->deliverEvent(event);
     }
     return 0;
   }
@@ -148,10 +137,11 @@ namespace erizo {
       const std::string& peer_id) {
     ELOG_DEBUG("Adding subscriber");
     boost::mutex::scoped_lock lock(monitor_mutex_);
-    ELOG_DEBUG("From %u, %u ", publisher_->getAudioSourceSSRC(), publisher_->getVideoSourceSSRC());
+    std::shared_ptr<MediaSource> publisher = publisher_;
+    ELOG_DEBUG("From %u, %u ", publisher->getAudioSourceSSRC(), publisher->getVideoSourceSSRC());
     ELOG_DEBUG("Subscribers ssrcs: Audio %u, video, %u from %u, %u ",
                subscriber_stream->getAudioSinkSSRC(), subscriber_stream->getVideoSinkSSRC(),
-               publisher_->getAudioSourceSSRC() , publisher_->getVideoSourceSSRC());
+               publisher->getAudioSourceSSRC() , publisher->getVideoSourceSSRC());
     std::shared_ptr<FeedbackSource> fbsource = subscriber_stream->getFeedbackSource().lock();
 
     if (fbsource) {
@@ -164,9 +154,11 @@ namespace erizo {
         subscribers_.erase(peer_id);
     }
     subscribers_[peer_id] = subscriber_stream;
+    publishSnapshot();
   }
 
   std::shared_ptr<MediaSink> OneToManyProcessor::getSubscriber(const std::string& peer_id) {
+    boost::mutex::scoped_lock lock(monitor_mutex_);
     auto it = subscribers_.find(peer_id);
     if (it != subscribers_.end()) {
       return it->second;
@@ -179,9 +171,23 @@ namespace erizo {
     boost::mutex::scoped_lock lock(monitor_mutex_);
     if (subscribers_.find(peer_id) != subscribers_.end()) {
       subscribers_.erase(peer_id);
+      publishSnapshot();
     }
   }
 
+  void OneToManyProcessor::publishSnapshot() {
+    std::unique_ptr<Snapshot> snapshot(new Snapshot());
+    snapshot->publisher = publisher_;
+    snapshot->subscribers.reserve(subscribers_.size());
+    for (const auto &subscriber : subscribers_) {
+      if (subscriber.second) {
+        snapshot->subscribers.push_back(subscriber.second);
+      }
+    }
+    // Packets that are still being delivered keep the previous snapshot until they are done with it
+    snapshot_.update(std::move(snapshot));
+  }
+
   boost::future<void> OneToManyProcessor::close() {
     return closeAll();
   }
@@ -191,8 +197,8 @@ namespace erizo {
     std::shared_ptr<boost::promise<void>> p = std::make_shared<boost::promise<void>>();
     boost::future<void> f = p->get_future();
     feedback_sink_.reset();
-    publisher_.reset();
     boost::unique_lock<boost::mutex> lock(monitor_mutex_);
+    publisher_.reset();
     std::map<std::string, std::shared_ptr<MediaSink>>::iterator it = subscribers_.begin();
     while (it != subscribers_.end()) {
       if ((*it).second != nullptr) {
@@ -204,6 +210,7 @@ namespace erizo {
       subscribers_.erase(it++);
     }
     subscribers_.clear();
+    publishSnapshot();
     p->set_value();
     ELOG_INFO("OneToManyProcessor closed, publisher_id: %s", publisher_id_);
     return f;
@@ -6,12 +6,15 @@
 #define ERIZO_SRC_ERIZO_ONETOMANYPROCESSOR_H_
 
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 #include <boost/thread/future.hpp>
 
 #include "./MediaDefinitions.h"
 #include "media/ExternalOutput.h"
 #include "./logger.h"
+#include "thread/RcuPointer.h"
 
 namespace erizo {
 
@@ -20,6 +23,7 @@ class MediaStream;
 /**
 * Represents a One to Many connection.
 * Receives media from one publisher and retransmits it to every subscriber.
+* The publisher and subscribers are published as immutable RCU snapshots, so delivering packets takes no locks.
 */
 class OneToManyProcessor
     : public MediaSink, public FeedbackSink, public std::enable_shared_from_this<OneToManyProcessor> {
@@ -59,12 +63,20 @@ class OneToManyProcessor
   int deliverEvent_(MediaEventPtr event) override;
   boost::future<void> closeAll();
   bool isSSRCFromAudio(uint32_t ssrc);
-  uint32_t translateAndMaybeAdaptForSimulcast(uint32_t orig_ssrc);
+  uint32_t translateAndMaybeAdaptForSimulcast(std::shared_ptr<MediaSource> publisher, uint32_t orig_ssrc);
+  void publishSnapshot();
 
  private:
+  struct Snapshot {
+    std::shared_ptr<MediaSource> publisher;
+    std::vector<std::shared_ptr<MediaSink>> subscribers;
+  };
+
   std::weak_ptr<FeedbackSink> feedback_sink_;
+  // subscribers_ and publisher_ are only modified with monitor_mutex_ held, every change publishes a new snapshot_
   std::map<std::string, std::shared_ptr<MediaSink>> subscribers_;
   std::shared_ptr<MediaSource> publisher_;
+  RcuPointer<Snapshot> snapshot_;
   std::string publisher_id_;
 };
 
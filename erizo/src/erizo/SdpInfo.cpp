@@ -109,6 +109,33 @@ namespace erizo {
     return nullptr;
   }
 
+  unsigned int SdpInfo::getRtxPayloadType(const unsigned int payload_type) {
+    const std::string associated_pt = std::to_string(payload_type);
+    for (const RtpMap& rtp : payloadVector) {
+      if (rtp.encoding_name != "rtx") {
+        continue;
+      }
+      auto apt = rtp.format_parameters.find(kAssociatedPt);
+      if (apt != rtp.format_parameters.end() && apt->second == associated_pt) {
+        return rtp.payload_type;
+      }
+    }
+    return 0;
+  }
+
+  unsigned int SdpInfo::getRtxAssociatedPayloadType(const unsigned int rtx_payload_type) {
+    for (const RtpMap& rtp : payloadVector) {
+      if (rtp.payload_type != rtx_payload_type || rtp.encoding_name != "rtx") {
+        continue;
+      }
+      auto apt = rtp.format_parameters.find(kAssociatedPt);
+      if (apt != rtp.format_parameters.end()) {
+        return static_cast<unsigned int>(strtoul(apt->second.c_str(), nullptr, 10));
+      }
+    }
+    return 0;
+  }
+
   RtpMap *SdpInfo::getCodecByName(const std::string codecName, const unsigned int clockRate) {
     for (unsigned int it = 0; it < internalPayloadVector_.size(); it++) {
       RtpMap& rtp = internalPayloadVector_[it];
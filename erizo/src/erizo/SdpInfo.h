@@ -234,6 +234,19 @@ class SdpInfo {
 
   RtpMap* getCodecByExternalPayloadType(const unsigned int payload_type);
 
+  /**
+   * @brief finds the rtx payload type negotiated for a codec
+   * @param payload_type The external payload type of the codec
+   * @return The external rtx payload type associated to it, 0 if rtx was not negotiated
+   */
+  unsigned int getRtxPayloadType(const unsigned int payload_type);
+  /**
+   * @brief finds the codec an rtx payload type retransmits
+   * @param rtx_payload_type The external rtx payload type
+   * @return The external payload type of the codec (apt), 0 if it is not a negotiated rtx payload type
+   */
+  unsigned int getRtxAssociatedPayloadType(const unsigned int rtx_payload_type);
+
   void setCredentials(const std::string& username, const std::string& password, MediaType media);
 
   std::string getUsername(MediaType media) const;
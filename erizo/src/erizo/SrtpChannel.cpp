@@ -18,6 +18,20 @@ boost::mutex SrtpChannel::sessionMutex_;
 
 constexpr int kKeyStringLength = 32;
 
+const char* SrtpChannel::kDefaultProfile = "SRTP_AES128_CM_SHA1_80";
+
+struct SrtpProfileName {
+  const char *name;
+  srtp_profile_t profile;
+};
+
+const SrtpProfileName kSrtpProfileNames[] = {
+  {"SRTP_AES128_CM_SHA1_80", srtp_profile_aes128_cm_sha1_80},
+  {"SRTP_AES128_CM_SHA1_32", srtp_profile_aes128_cm_sha1_32},
+  {"SRTP_AEAD_AES_128_GCM", srtp_profile_aead_aes_128_gcm},
+  {"SRTP_AEAD_AES_256_GCM", srtp_profile_aead_aes_256_gcm}
+};
+
 uint8_t nibble_to_hex_char(uint8_t nibble) {
   char buf[16] = { '0', '1', '2', '3', '4', '5', '6', '7',
                    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
@@ -42,13 +56,52 @@ std::string octet_string_hex_string(const void *s, int length) {
   return std::string(bit_string);
 }
 
-SrtpChannel::SrtpChannel() {
+void SrtpChannel::initialize() {
   boost::mutex::scoped_lock lock(SrtpChannel::sessionMutex_);
   if (SrtpChannel::initialized != true) {
     int res = srtp_init();
     ELOG_DEBUG("Initialized SRTP library %d", res);
     SrtpChannel::initialized = true;
   }
+}
+
+bool SrtpChannel::getProfileByName(const std::string &name, srtp_profile_t *profile) {
+  for (const SrtpProfileName &profile_name : kSrtpProfileNames) {
+    if (name == profile_name.name) {
+      *profile = profile_name.profile;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SrtpChannel::isProfileSupported(const std::string &profile) {
+  srtp_profile_t srtp_profile;
+  if (!getProfileByName(profile, &srtp_profile)) {
+    return false;
+  }
+  initialize();
+  srtp_policy_t policy;
+  memset(&policy, 0, sizeof(policy));
+  if (srtp_crypto_policy_set_from_profile_for_rtp(&policy.rtp, srtp_profile) != srtp_err_status_ok ||
+      srtp_crypto_policy_set_from_profile_for_rtcp(&policy.rtcp, srtp_profile) != srtp_err_status_ok) {
+    return false;
+  }
+  uint8_t key[SRTP_MAX_KEY_LEN] = {};
+  policy.ssrc.type = ssrc_any_outbound;
+  policy.key = key;
+  policy.window_size = 1024;
+  srtp_t session = NULL;
+  if (srtp_create(&session, &policy) != srtp_err_status_ok) {
+    ELOG_DEBUG("message: SRTP profile not supported by libsrtp, profile: %s", profile.c_str());
+    return false;
+  }
+  srtp_dealloc(session);
+  return true;
+}
+
+SrtpChannel::SrtpChannel() {
+  initialize();
 
   active_ = false;
   send_session_ = NULL;
@@ -67,10 +120,17 @@ SrtpChannel::~SrtpChannel() {
   }
 }
 
-bool SrtpChannel::setRtpParams(const std::string &sendingKey, const std::string &receivingKey) {
-  ELOG_DEBUG("Configuring srtp local key %s remote key %s", sendingKey.c_str(), receivingKey.c_str());
-  if (configureSrtpSession(&send_session_,    sendingKey,   SENDING) &&
-      configureSrtpSession(&receive_session_, receivingKey, RECEIVING)) {
+bool SrtpChannel::setRtpParams(const std::string &sendingKey, const std::string &receivingKey,
+                               const std::string &profile) {
+  ELOG_DEBUG("Configuring srtp local key %s remote key %s profile %s", sendingKey.c_str(), receivingKey.c_str(),
+             profile.c_str());
+  srtp_profile_t srtp_profile;
+  if (!getProfileByName(profile, &srtp_profile)) {
+    ELOG_ERROR("message: Unknown SRTP profile, profile: %s", profile.c_str());
+    return false;
+  }
+  if (configureSrtpSession(&send_session_,    sendingKey,   SENDING,   srtp_profile) &&
+      configureSrtpSession(&receive_session_, receivingKey, RECEIVING, srtp_profile)) {
     active_ = true;
     return active_;
   }
@@ -149,11 +209,37 @@ int SrtpChannel::unprotectRtcp(char* buffer, int *len) {
   }
 }
 
-bool SrtpChannel::configureSrtpSession(srtp_t *session, const std::string &key, enum TransmissionType type) {
+int SrtpChannel::protectBatch(const std::vector<std::shared_ptr<DataPacket>> &packets) {
+  int protected_packets = 0;
+  for (const std::shared_ptr<DataPacket> &packet : packets) {
+    if (!active_) {
+      packet->length = 0;
+      continue;
+    }
+    RtcpHeader* head = reinterpret_cast<RtcpHeader*>(packet->data);
+    int val = head->isRtcp() ? srtp_protect_rtcp(send_session_, packet->data, &packet->length) :
+                               srtp_protect(send_session_, packet->data, &packet->length);
+    if (val == 0) {
+      protected_packets++;
+    } else {
+      if (val != 10) {  // Do not warn about reply errors
+        ELOG_DEBUG("Error SrtpChannel::protectBatch %u packettype %d", val, head->packettype);
+      }
+      packet->length = 0;
+    }
+  }
+  return protected_packets;
+}
+
+bool SrtpChannel::configureSrtpSession(srtp_t *session, const std::string &key, enum TransmissionType type,
+                                       srtp_profile_t profile) {
   srtp_policy_t policy;
   memset(&policy, 0, sizeof(policy));
-  srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtp);
-  srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+  if (srtp_crypto_policy_set_from_profile_for_rtp(&policy.rtp, profile) != srtp_err_status_ok ||
+      srtp_crypto_policy_set_from_profile_for_rtcp(&policy.rtcp, profile) != srtp_err_status_ok) {
+    ELOG_ERROR("Failed to set srtp policy for profile %d", profile);
+    return false;
+  }
   if (type == SENDING) {
     policy.ssrc.type = ssrc_any_outbound;
   } else {
@@ -169,6 +255,12 @@ bool SrtpChannel::configureSrtpSession(srtp_t *session, const std::string &key,
   std::string decoded_key;
   Base64::Decode(key, &decoded_key);
   const std::string::size_type size = decoded_key.size();
+  const std::string::size_type expected_size = srtp_profile_get_master_key_length(profile) +
+                                               srtp_profile_get_master_salt_length(profile);
+  if (size != expected_size) {
+    ELOG_ERROR("Failed to create srtp session, key length %zu, expected %zu", size, expected_size);
+    return false;
+  }
   uint8_t *raw_key = new uint8_t[size];
   memcpy(raw_key, decoded_key.c_str(), size);
   ELOG_DEBUG("set master key/salt to %s/", octet_string_hex_string(raw_key, 16).c_str());
@@ -9,8 +9,11 @@
 #include <srtp2/srtp.h>
 #include <boost/thread/mutex.hpp>
 
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "./MediaDefinitions.h"
 #include "rtp/RtpHeaders.h"
 #include "./logger.h"
 
@@ -59,13 +62,22 @@ class SrtpChannel {
    * @return 0 or an error code
    */
   int unprotectRtcp(char* buffer, int *len);
+  /**
+   * Protects a batch of RTP and RTCP packets in place
+   * @param packets Packets owned by the caller, each with SRTP_MAX_TRAILER_LEN spare bytes. The length of
+   * the packets that can not be protected is set to 0
+   * @return the number of packets protected
+   */
+  int protectBatch(const std::vector<std::shared_ptr<DataPacket>> &packets);
   /**
    * Sets a key pair for the RTP channel
    * @param sendingKey The key for protecting data
    * @param receivingKey The key for unprotecting data
+   * @param profile The DTLS-SRTP profile name the keys were negotiated for, as named by OpenSSL
    * @return true if everything is ok
    */
-  bool setRtpParams(const std::string &sendingKey, const std::string &receivingKey);
+  bool setRtpParams(const std::string &sendingKey, const std::string &receivingKey,
+                    const std::string &profile = kDefaultProfile);
   /**
    * Sets a key pair for the RTCP channel
    * @param sendingKey The key for protecting data
@@ -74,12 +86,25 @@ class SrtpChannel {
    */
   bool setRtcpParams(const std::string &sendingKey, const std::string &receivingKey);
 
+  /**
+   * Checks whether libsrtp was built with the ciphers of a profile, AEAD profiles need libsrtp with OpenSSL
+   * @param profile The DTLS-SRTP profile name, as named by OpenSSL
+   * @return true if sessions can be created for the profile
+   */
+  static bool isProfileSupported(const std::string &profile);
+
+  // SRTP_AES128_CM_SHA1_80, the profile every WebRTC endpoint supports
+  static const char* kDefaultProfile;
+
  private:
   enum TransmissionType {
     SENDING, RECEIVING
   };
 
-  bool configureSrtpSession(srtp_t *session, const std::string &key, enum TransmissionType type);
+  static void initialize();
+  static bool getProfileByName(const std::string &name, srtp_profile_t *profile);
+  bool configureSrtpSession(srtp_t *session, const std::string &key, enum TransmissionType type,
+                            srtp_profile_t profile);
 
   bool active_;
   srtp_t send_session_;
@@ -3,6 +3,7 @@
  *
  */
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 
@@ -14,7 +15,9 @@ namespace erizo {
 
   DEFINE_LOGGER(Stats, "Stats");
 
-  Stats::Stats() : listener_{nullptr} {
+  constexpr size_t Stats::kMaxStatsDeltaConsumers;
+
+  Stats::Stats() : listener_{nullptr}, binary_listener_{false}, delta_calls_{0} {
   }
 
   Stats::~Stats() {
@@ -28,13 +31,47 @@ namespace erizo {
     return root_.toString();
   }
 
-  void Stats::setStatsListener(MediaStreamStatsListener* listener) {
+  std::vector<uint8_t> Stats::getStatsDelta(const std::string &consumer_id) {
+    auto consumer = delta_consumers_.find(consumer_id);
+    if (consumer == delta_consumers_.end()) {
+      if (delta_consumers_.size() >= kMaxStatsDeltaConsumers) {
+        auto least_recent = std::min_element(delta_consumers_.begin(), delta_consumers_.end(),
+          [](const std::pair<const std::string, DeltaConsumer> &a,
+             const std::pair<const std::string, DeltaConsumer> &b) {
+            return a.second.last_call < b.second.last_call;
+          });
+        ELOG_DEBUG("message: Too many stats delta consumers, evicting: %s", least_recent->first.c_str());
+        delta_consumers_.erase(least_recent);
+      }
+      consumer = delta_consumers_.emplace(consumer_id, DeltaConsumer()).first;
+    }
+    consumer->second.last_call = ++delta_calls_;
+    return consumer->second.encoder.encode(root_);
+  }
+
+  void Stats::removeStatsDeltaConsumer(const std::string &consumer_id) {
+    delta_consumers_.erase(consumer_id);
+  }
+
+  void Stats::setStatsListener(MediaStreamStatsListener* listener, bool binary) {
     boost::mutex::scoped_lock lock(listener_mutex_);
     listener_ = listener;
+    binary_listener_ = binary;
+    listener_delta_encoder_.reset();
   }
 
   void Stats::sendStats() {
     boost::mutex::scoped_lock lock(listener_mutex_);
-    if (listener_) listener_->notifyStats(getStats());
+    if (!listener_) {
+      return;
+    }
+    if (!binary_listener_) {
+      listener_->notifyStats(getStats());
+      return;
+    }
+    std::vector<uint8_t> delta = listener_delta_encoder_.encode(root_);
+    if (!delta.empty()) {
+      listener_->notifyStatsDelta(delta);
+    }
   }
 }  // namespace erizo
@@ -6,6 +6,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include "./logger.h"
 #include "pipeline/Service.h"
@@ -13,6 +14,7 @@
 #include "lib/Clock.h"
 
 #include "stats/StatNode.h"
+#include "stats/StatsDeltaEncoder.h"
 
 namespace erizo {
 
@@ -29,13 +31,31 @@ class Stats : public Service {
 
   std::string getStats();
 
-  void setStatsListener(MediaStreamStatsListener* listener);
+  // Leaves changed since the previous call of the same consumer, encoded by StatsDeltaEncoder. Empty if nothing
+  // changed. Every consumer has its own encoder, so the first call of a consumer returns a full snapshot.
+  // Only the kMaxStatsDeltaConsumers most recently used encoders are kept, evicted consumers get a full snapshot.
+  std::vector<uint8_t> getStatsDelta(const std::string &consumer_id);
+  void removeStatsDeltaConsumer(const std::string &consumer_id);
+
+  // Binary listeners get deltas in notifyStatsDelta instead of the whole tree in notifyStats
+  void setStatsListener(MediaStreamStatsListener* listener, bool binary = false);
   void sendStats();
 
  private:
+  struct DeltaConsumer {
+    StatsDeltaEncoder encoder;
+    uint64_t last_call = 0;
+  };
+
+  static constexpr size_t kMaxStatsDeltaConsumers = 16;
+
   boost::mutex listener_mutex_;
   MediaStreamStatsListener* listener_;
+  bool binary_listener_;
   StatNode root_;
+  std::map<std::string, DeltaConsumer> delta_consumers_;
+  uint64_t delta_calls_;
+  StatsDeltaEncoder listener_delta_encoder_;
 };
 
 }  // namespace erizo
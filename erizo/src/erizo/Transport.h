@@ -42,10 +42,19 @@ class Transport : public std::enable_shared_from_this<Transport>, public IceConn
   virtual void onIceData(packetPtr packet) = 0;
   virtual void onCandidate(const CandidateInfo &candidate, IceConnection *conn) = 0;
   virtual void write(char* data, int len) = 0;
+  // Sends the packets of a worker tick together, transports that can not batch write them one by one.
+  // Packets only held by the batch may be modified (e.g. protected in place), the caller must not reuse them.
+  virtual void writeBatch(const std::vector<std::shared_ptr<DataPacket>> &packets) {
+    for (const std::shared_ptr<DataPacket> &packet : packets) {
+      write(packet->data, packet->length);
+    }
+  }
   virtual void processLocalSdp(SdpInfo *localSdp_) = 0;
   virtual void start() = 0;
   virtual void close() = 0;
   virtual std::shared_ptr<IceConnection> getIceConnection() { return ice_; }
+  // Time it took to negotiate the keys of this transport, zero if it is not ready yet
+  virtual duration getHandshakeDuration() { return duration::zero(); }
   void setTransportListener(std::weak_ptr<TransportListener> listener) {
     transport_listener_ = listener;
   }
@@ -70,6 +79,12 @@ class Transport : public std::enable_shared_from_this<Transport>, public IceConn
     }
     ice_->sendData(comp, buf, len);
   }
+  void writeBatchOnIce(std::vector<packetPtr> packets) {
+    if (!running_) {
+      return;
+    }
+    ice_->sendDataBatch(std::move(packets));
+  }
   bool setRemoteCandidates(const std::vector<CandidateInfo> &candidates, bool isBundle) {
     return ice_->setRemoteCandidates(candidates, isBundle);
   }
@@ -86,7 +101,7 @@ class Transport : public std::enable_shared_from_this<Transport>, public IceConn
           return;
         }
       }
-    });
+    }, kPacketTask);
   }
 
   bool rtcp_mux_;
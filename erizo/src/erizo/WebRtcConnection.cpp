@@ -36,6 +36,7 @@
 #include "rtp/PliPacerHandler.h"
 #include "rtp/RtpPaddingGeneratorHandler.h"
 #include "rtp/RtpPaddingManagerHandler.h"
+#include "rtp/PacerHandler.h"
 #include "rtp/RtpUtils.h"
 
 namespace erizo {
@@ -44,11 +45,11 @@ DEFINE_LOGGER(WebRtcConnection, "WebRtcConnection");
 WebRtcConnection::WebRtcConnection(std::shared_ptr<Worker> worker, std::shared_ptr<IOWorker> io_worker,
     const std::string& connection_id, const IceConfig& ice_config, const std::vector<RtpMap> rtp_mappings,
     const std::vector<erizo::ExtMap> ext_mappings, bool enable_connection_quality_check,
-    WebRtcConnectionEventListener* listener) :
+    WebRtcConnectionEventListener* listener, std::shared_ptr<Worker> handshake_worker) :
     connection_id_{connection_id},
     audio_enabled_{false}, video_enabled_{false}, bundle_{false}, conn_event_listener_{listener},
     ice_config_{ice_config}, rtp_mappings_{rtp_mappings}, extension_processor_{ext_mappings},
-    worker_{worker}, io_worker_{io_worker},
+    worker_{worker}, io_worker_{io_worker}, handshake_worker_{handshake_worker}, ssrc_routes_dirty_{false},
     remote_sdp_{std::make_shared<SdpInfo>(rtp_mappings)}, local_sdp_{std::make_shared<SdpInfo>(rtp_mappings)},
     audio_muted_{false}, video_muted_{false}, first_remote_sdp_processed_{false},
     enable_connection_quality_check_{enable_connection_quality_check}, pipeline_{Pipeline::create()},
@@ -77,6 +78,7 @@ void WebRtcConnection::syncClose() {
   }
   sending_ = false;
   media_streams_.clear();
+  ssrc_routes_.clear();
   if (video_transport_.get()) {
     video_transport_->close();
   }
@@ -121,8 +123,10 @@ void WebRtcConnection::initializePipeline() {
 
   pipeline_->addFront(std::make_shared<ConnectionPacketReader>(this));
 
-  pipeline_->addFront(std::make_shared<SenderBandwidthEstimationHandler>());
   pipeline_->addFront(std::make_shared<RtpPaddingManagerHandler>());
+  pipeline_->addFront(std::make_shared<PacerHandler>());
+  // After the pacer, it numbers packets for transport-wide feedback in the order they are sent
+  pipeline_->addFront(std::make_shared<SenderBandwidthEstimationHandler>());
 
   pipeline_->addFront(std::make_shared<ConnectionPacketWriter>(this));
   pipeline_->finalize();
@@ -172,6 +176,10 @@ bool WebRtcConnection::createOfferSync(bool video_enabled, bool audio_enabled, b
                  toLog(), media_stream->getId(), media_stream->getAudioSinkSSRC());
       if (!video_ssrc_list.empty()) {
         local_sdp_->video_ssrc_map[media_stream->getLabel()] = video_ssrc_list;
+        if (media_stream->getVideoSinkRtxSSRC() != 0) {
+          local_sdp_->video_rtx_ssrc_map[media_stream->getLabel()] =
+              {{media_stream->getVideoSinkSSRC(), media_stream->getVideoSinkRtxSSRC()}};
+        }
       }
     }
     if (audio_enabled_) {
@@ -186,7 +194,8 @@ bool WebRtcConnection::createOfferSync(bool video_enabled, bool audio_enabled, b
   if (bundle_) {
     if (video_transport_.get() == nullptr && (video_enabled_ || audio_enabled_)) {
       video_transport_.reset(new DtlsTransport(VIDEO_TYPE, "video", connection_id_, bundle_, true,
-                                              listener, ice_config_ , "", "", true, worker_, io_worker_));
+                                              listener, ice_config_ , "", "", true, worker_, io_worker_,
+                                              handshake_worker_));
       video_transport_->copyLogContextFrom(*this);
       video_transport_->start();
     }
@@ -194,13 +203,15 @@ bool WebRtcConnection::createOfferSync(bool video_enabled, bool audio_enabled, b
     if (video_transport_.get() == nullptr && video_enabled_) {
       // For now we don't re/check transports, if they are already created we leave them there
       video_transport_.reset(new DtlsTransport(VIDEO_TYPE, "video", connection_id_, bundle_, true,
-                                              listener, ice_config_ , "", "", true, worker_, io_worker_));
+                                              listener, ice_config_ , "", "", true, worker_, io_worker_,
+                                              handshake_worker_));
       video_transport_->copyLogContextFrom(*this);
       video_transport_->start();
     }
     if (audio_transport_.get() == nullptr && audio_enabled_) {
       audio_transport_.reset(new DtlsTransport(AUDIO_TYPE, "audio", connection_id_, bundle_, true,
-                                              listener, ice_config_, "", "", true, worker_, io_worker_));
+                                              listener, ice_config_, "", "", true, worker_, io_worker_,
+                                              handshake_worker_));
       audio_transport_->copyLogContextFrom(*this);
       audio_transport_->start();
     }
@@ -215,6 +226,10 @@ ConnectionQualityLevel WebRtcConnection::getConnectionQualityLevel() {
   return connection_quality_check_.getLevel();
 }
 
+uint8_t WebRtcConnection::getVideoFractionLost() {
+  return connection_quality_check_.getVideoFractionLost();
+}
+
 bool WebRtcConnection::werePacketLossesRecently() {
   return connection_quality_check_.werePacketLossesRecently();
 }
@@ -224,6 +239,7 @@ boost::future<void> WebRtcConnection::addMediaStream(std::shared_ptr<MediaStream
     boost::mutex::scoped_lock lock(connection->update_state_mutex_);
     ELOG_DEBUG("%s message: Adding mediaStream, id: %s", connection->toLog(), media_stream->getId().c_str());
     connection->media_streams_.push_back(media_stream);
+    connection->updateSsrcRoutes();
   });
 }
 
@@ -240,6 +256,7 @@ boost::future<void> WebRtcConnection::removeMediaStream(const std::string& strea
           if (video_it != connection->local_sdp_->video_ssrc_map.end()) {
             connection->local_sdp_->video_ssrc_map.erase(video_it);
           }
+          connection->local_sdp_->video_rtx_ssrc_map.erase(stream->getLabel());
           auto audio_it = connection->local_sdp_->audio_ssrc_map.find(stream->getLabel());
           if (audio_it != connection->local_sdp_->audio_ssrc_map.end()) {
             connection->local_sdp_->audio_ssrc_map.erase(audio_it);
@@ -247,6 +264,7 @@ boost::future<void> WebRtcConnection::removeMediaStream(const std::string& strea
         }
         return isStream;
       }));
+    connection->updateSsrcRoutes();
     });
 }
 
@@ -344,6 +362,10 @@ std::shared_ptr<SdpInfo> WebRtcConnection::getLocalSdpInfoSync() {
                toLog(), media_stream->getId(), media_stream->getAudioSinkSSRC());
     if (!video_ssrc_list.empty()) {
       local_sdp_->video_ssrc_map[media_stream->getLabel()] = video_ssrc_list;
+      if (media_stream->getVideoSinkRtxSSRC() != 0) {
+        local_sdp_->video_rtx_ssrc_map[media_stream->getLabel()] =
+            {{media_stream->getVideoSinkSSRC(), media_stream->getVideoSinkRtxSSRC()}};
+      }
     }
     if (media_stream->getAudioSinkSSRC() != kDefaultAudioSinkSSRC && media_stream->getAudioSinkSSRC() != 0) {
       local_sdp_->audio_ssrc_map[media_stream->getLabel()] = media_stream->getAudioSinkSSRC();
@@ -448,7 +470,7 @@ boost::future<void> WebRtcConnection::processRemoteSdp(int received_session_vers
                       toLog(), username.c_str(), password.c_str());
           video_transport_.reset(new DtlsTransport(VIDEO_TYPE, "video", connection_id_, bundle_, remote_sdp_->isRtcpMux,
                                                   listener, ice_config_ , username, password, false,
-                                                  worker_, io_worker_));
+                                                  worker_, io_worker_, handshake_worker_));
           video_transport_->copyLogContextFrom(*this);
           video_transport_->start();
         } else {
@@ -465,7 +487,7 @@ boost::future<void> WebRtcConnection::processRemoteSdp(int received_session_vers
                       toLog(), username.c_str(), password.c_str());
           audio_transport_.reset(new DtlsTransport(AUDIO_TYPE, "audio", connection_id_, bundle_, remote_sdp_->isRtcpMux,
                                                   listener, ice_config_, username, password, false,
-                                                  worker_, io_worker_));
+                                                  worker_, io_worker_, handshake_worker_));
           audio_transport_->copyLogContextFrom(*this);
           audio_transport_->start();
         } else {
@@ -588,11 +610,11 @@ void WebRtcConnection::onREMBFromTransport(RtcpHeader *chead, Transport *transpo
 
   for (uint8_t index = 0; index < chead->getREMBNumSSRC(); index++) {
     uint32_t ssrc_feed = chead->getREMBFeedSSRC(index);
-    forEachMediaStream([ssrc_feed, &streams] (const std::shared_ptr<MediaStream> &media_stream) {
+    for (const std::shared_ptr<MediaStream> &media_stream : getMediaStreamsBySsrc(ssrc_feed)) {
       if (media_stream->isSinkSSRC(ssrc_feed)) {
         streams.push_back(media_stream);
       }
-    });
+    }
   }
 
   distributor_->distribute(chead->getREMBBitRate(), chead->getSSRC(), streams, transport);
@@ -608,17 +630,56 @@ void WebRtcConnection::onRtcpFromTransport(std::shared_ptr<DataPacket> packet, T
       onREMBFromTransport(chead, transport);
       return;
     }
-    std::shared_ptr<DataPacket> rtcp = std::make_shared<DataPacket>(*packet);
-    rtcp->length = (ntohs(chead->length) + 1) * 4;
-    std::memcpy(rtcp->data, chead, rtcp->length);
-    forEachMediaStream([rtcp, transport, ssrc] (const std::shared_ptr<MediaStream> &media_stream) {
-      if (media_stream->isSourceSSRC(ssrc) || media_stream->isSinkSSRC(ssrc)) {
-        media_stream->onTransportData(rtcp, transport);
-      }
-    });
+    const std::vector<std::shared_ptr<MediaStream>> &media_streams = getMediaStreamsBySsrc(ssrc);
+    if (media_streams.empty()) {
+      return;
+    }
+    int length = (ntohs(chead->length) + 1) * 4;
+    std::shared_ptr<DataPacket> rtcp = DataPacket::create(packet->comp, reinterpret_cast<char*>(chead), length,
+                                                          packet->type, packet->received_time_ms);
+    deliverToMediaStreams(std::move(rtcp), media_streams, transport);
   });
 }
 
+void WebRtcConnection::deliverToMediaStreams(std::shared_ptr<DataPacket> packet,
+    const std::vector<std::shared_ptr<MediaStream>> &media_streams, Transport *transport) {
+  if (media_streams.empty()) {
+    return;
+  }
+  // Only additional receivers get a copy, the last one takes the packet itself
+  for (auto stream_it = media_streams.begin(); stream_it != media_streams.end() - 1; ++stream_it) {
+    (*stream_it)->onTransportData(DataPacket::create(*packet), transport);
+  }
+  media_streams.back()->onTransportData(std::move(packet), transport);
+}
+
+const std::vector<std::shared_ptr<MediaStream>>& WebRtcConnection::getMediaStreamsBySsrc(uint32_t ssrc) {
+  static const std::vector<std::shared_ptr<MediaStream>> no_media_streams;
+  if (ssrc_routes_dirty_) {
+    updateSsrcRoutes();
+  }
+  auto routes_it = ssrc_routes_.find(ssrc);
+  return routes_it == ssrc_routes_.end() ? no_media_streams : routes_it->second;
+}
+
+void WebRtcConnection::updateSsrcRoutes() {
+  ssrc_routes_dirty_ = false;
+  ssrc_routes_.clear();
+  for (const std::shared_ptr<MediaStream> &media_stream : media_streams_) {
+    std::vector<uint32_t> ssrcs = media_stream->getVideoSourceSSRCList();
+    std::vector<uint32_t> rtx_ssrcs = media_stream->getVideoSourceRtxSSRCList();
+    ssrcs.insert(ssrcs.end(), rtx_ssrcs.begin(), rtx_ssrcs.end());
+    ssrcs.push_back(media_stream->getAudioSourceSSRC());
+    ssrcs.push_back(media_stream->getVideoSinkSSRC());
+    ssrcs.push_back(media_stream->getAudioSinkSSRC());
+    std::sort(ssrcs.begin(), ssrcs.end());
+    ssrcs.erase(std::unique(ssrcs.begin(), ssrcs.end()), ssrcs.end());
+    for (uint32_t ssrc : ssrcs) {
+      ssrc_routes_[ssrc].push_back(media_stream);
+    }
+  }
+}
+
 void WebRtcConnection::onTransportData(std::shared_ptr<DataPacket> packet, Transport *transport) {
   if (getCurrentState() != CONN_READY) {
     return;
@@ -641,6 +702,7 @@ void WebRtcConnection::onTransportData(std::shared_ptr<DataPacket> packet, Trans
 }
 
 void WebRtcConnection::read(std::shared_ptr<DataPacket> packet) {
+  worker_->addProcessedPackets();
   Transport *transport = (bundle_ || packet->type == VIDEO_PACKET) ? video_transport_.get() : audio_transport_.get();
   if (transport == nullptr) {
     return;
@@ -653,11 +715,7 @@ void WebRtcConnection::read(std::shared_ptr<DataPacket> packet) {
   } else {
     RtpHeader *head = reinterpret_cast<RtpHeader*> (buf);
     uint32_t ssrc = head->getSSRC();
-    forEachMediaStream([packet, transport, ssrc] (const std::shared_ptr<MediaStream> &media_stream) {
-      if (media_stream->isSourceSSRC(ssrc) || media_stream->isSinkSSRC(ssrc)) {
-        media_stream->onTransportData(packet, transport);
-      }
-    });
+    deliverToMediaStreams(std::move(packet), getMediaStreamsBySsrc(ssrc), transport);
   }
 }
 
@@ -738,6 +796,9 @@ void WebRtcConnection::updateState(TransportState state, Transport * transport)
       }
       break;
     case TRANSPORT_READY:
+      stats_->getNode()["dtls"][transport->transport_name].insertStat("handshakeTimeMs",
+          CumulativeStat{static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(transport->getHandshakeDuration()).count())});
       if (bundle_) {
         temp = CONN_READY;
         trackTransportInfo();
@@ -843,8 +904,46 @@ void WebRtcConnection::write(std::shared_ptr<DataPacket> packet) {
   if (transport == nullptr) {
     return;
   }
+  worker_->addProcessedPackets();
   this->extension_processor_.processRtpExtensions(packet);
-  transport->write(packet->data, packet->length);
+  if (pending_writes_.empty()) {
+    std::weak_ptr<WebRtcConnection> weak_this = shared_from_this();
+    worker_->task([weak_this] {
+      if (auto this_ptr = weak_this.lock()) {
+        this_ptr->flushPendingWrites();
+      }
+    }, kPacketTask);
+  }
+  pending_writes_.push_back(std::move(packet));
+}
+
+void WebRtcConnection::flushPendingWrites() {
+  std::vector<std::shared_ptr<DataPacket>> packets;
+  packets.swap(pending_writes_);
+  if (!sending_ || packets.empty()) {
+    return;
+  }
+  if (bundle_) {
+    if (video_transport_) {
+      video_transport_->writeBatch(packets);
+    }
+    return;
+  }
+  std::vector<std::shared_ptr<DataPacket>> video_packets;
+  std::vector<std::shared_ptr<DataPacket>> audio_packets;
+  for (std::shared_ptr<DataPacket> &packet : packets) {
+    if (packet->type == VIDEO_PACKET) {
+      video_packets.push_back(std::move(packet));
+    } else {
+      audio_packets.push_back(std::move(packet));
+    }
+  }
+  if (video_transport_ && !video_packets.empty()) {
+    video_transport_->writeBatch(video_packets);
+  }
+  if (audio_transport_ && !audio_packets.empty()) {
+    audio_transport_->writeBatch(audio_packets);
+  }
 }
 
 void WebRtcConnection::setTransport(std::shared_ptr<Transport> transport) {  // Only for Testing purposes
@@ -5,8 +5,10 @@
 #include <boost/thread/future.hpp>
 #include <boost/thread/mutex.hpp>
 
+#include <atomic>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "./logger.h"
@@ -72,7 +74,8 @@ class WebRtcConnection: public TransportListener, public LogContext, public Hand
   WebRtcConnection(std::shared_ptr<Worker> worker, std::shared_ptr<IOWorker> io_worker,
       const std::string& connection_id, const IceConfig& ice_config,
       const std::vector<RtpMap> rtp_mappings, const std::vector<erizo::ExtMap> ext_mappings,
-      bool enable_connection_quality_check, WebRtcConnectionEventListener* listener);
+      bool enable_connection_quality_check, WebRtcConnectionEventListener* listener,
+      std::shared_ptr<Worker> handshake_worker = nullptr);
   /**
    * Destructor.
    */
@@ -140,6 +143,8 @@ class WebRtcConnection: public TransportListener, public LogContext, public Hand
   void forEachMediaStream(std::function<void(const std::shared_ptr<MediaStream>&)> func);
   boost::future<void> forEachMediaStreamAsync(std::function<void(const std::shared_ptr<MediaStream>&)> func);
   void forEachMediaStreamAsyncNoPromise(std::function<void(const std::shared_ptr<MediaStream>&)> func);
+  // Called by MediaStreams when their SSRCs change so packets are routed to them
+  void notifySsrcsChanged() { ssrc_routes_dirty_ = true; }
 
   void setTransport(std::shared_ptr<Transport> transport);  // Only for Testing purposes
 
@@ -158,8 +163,10 @@ class WebRtcConnection: public TransportListener, public LogContext, public Hand
   Pipeline::Ptr getPipeline() { return pipeline_; }
   void read(std::shared_ptr<DataPacket> packet);
   void write(std::shared_ptr<DataPacket> packet);
+  void flushPendingWrites();
   void notifyUpdateToHandlers() override;
   ConnectionQualityLevel getConnectionQualityLevel();
+  uint8_t getVideoFractionLost();
   bool werePacketLossesRecently();
   void getJSONStats(std::function<void(std::string)> callback);
 
@@ -170,6 +177,10 @@ class WebRtcConnection: public TransportListener, public LogContext, public Hand
   std::string getJSONCandidate(const std::string& mid, const std::string& sdp);
   void trackTransportInfo();
   void onRtcpFromTransport(std::shared_ptr<DataPacket> packet, Transport *transport);
+  void deliverToMediaStreams(std::shared_ptr<DataPacket> packet,
+                             const std::vector<std::shared_ptr<MediaStream>> &media_streams, Transport *transport);
+  const std::vector<std::shared_ptr<MediaStream>>& getMediaStreamsBySsrc(uint32_t ssrc);
+  void updateSsrcRoutes();
   void onREMBFromTransport(RtcpHeader *chead, Transport *transport);
   void maybeNotifyWebRtcConnectionEvent(const WebRTCEvent& event, const std::string& message);
   void initializePipeline();
@@ -200,7 +211,13 @@ class WebRtcConnection: public TransportListener, public LogContext, public Hand
 
   std::shared_ptr<Worker> worker_;
   std::shared_ptr<IOWorker> io_worker_;
+  std::shared_ptr<Worker> handshake_worker_;
+  // Packets written in the current worker tick, protected and sent together by flushPendingWrites
+  std::vector<std::shared_ptr<DataPacket>> pending_writes_;
   std::vector<std::shared_ptr<MediaStream>> media_streams_;
+  // Source and sink SSRCs of media_streams_, rebuilt when streams are added, removed or change their SSRCs
+  std::unordered_map<uint32_t, std::vector<std::shared_ptr<MediaStream>>> ssrc_routes_;
+  std::atomic<bool> ssrc_routes_dirty_;
   std::shared_ptr<SdpInfo> remote_sdp_;
   std::shared_ptr<SdpInfo> local_sdp_;
   bool audio_muted_;
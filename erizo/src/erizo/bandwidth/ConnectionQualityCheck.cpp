@@ -19,7 +19,8 @@ constexpr uint8_t ConnectionQualityCheck::kLowVideoFractionLostThreshold;
 constexpr size_t  ConnectionQualityCheck::kNumberOfPacketsPerStream;
 
 ConnectionQualityCheck::ConnectionQualityCheck()
-    : quality_level_{ConnectionQualityLevel::GOOD}, audio_buffer_{1}, video_buffer_{1}, recent_packet_losses_{false} {
+    : quality_level_{ConnectionQualityLevel::GOOD}, audio_buffer_{1}, video_buffer_{1}, recent_packet_losses_{false},
+      video_fraction_lost_{0} {
 }
 
 void ConnectionQualityCheck::onFeedback(std::shared_ptr<DataPacket> packet,
@@ -96,6 +97,8 @@ void ConnectionQualityCheck::maybeNotifyMediaStreamsAboutConnectionQualityLevel(
     recent_packet_losses_ = true;
   }
 
+  maybeNotifyMediaStreamsAboutVideoFractionLost(video_fraction_lost, streams);
+
   ConnectionQualityLevel level = ConnectionQualityLevel::GOOD;
   if (audio_fraction_lost >= kHighAudioFractionLostThreshold) {
     level = ConnectionQualityLevel::HIGH_LOSSES;
@@ -115,4 +118,19 @@ void ConnectionQualityCheck::maybeNotifyMediaStreamsAboutConnectionQualityLevel(
   }
 }
 
+void ConnectionQualityCheck::maybeNotifyMediaStreamsAboutVideoFractionLost(uint8_t video_fraction_lost,
+    const std::vector<std::shared_ptr<MediaStream>> &streams) {
+  if (video_fraction_lost == video_fraction_lost_) {
+    return;
+  }
+  video_fraction_lost_ = video_fraction_lost;
+  // Subscribers use it to adapt the amount of FEC they send
+  std::for_each(streams.begin(), streams.end(),
+      [video_fraction_lost] (const std::shared_ptr<MediaStream> &media_stream) {
+    if (!media_stream->isPublisher()) {
+      media_stream->deliverEvent(std::make_shared<VideoFractionLostEvent>(video_fraction_lost));
+    }
+  });
+}
+
 }  // namespace erizo
@@ -32,6 +32,17 @@ class ConnectionQualityEvent : public MediaEvent {
   ConnectionQualityLevel level;
 };
 
+class VideoFractionLostEvent : public MediaEvent {
+ public:
+  explicit VideoFractionLostEvent(uint8_t fraction_lost_)
+    : fraction_lost{fraction_lost_} {}
+
+  std::string getType() const override {
+    return "VideoFractionLostEvent";
+  }
+  uint8_t fraction_lost;
+};
+
 class ConnectionQualityCheck {
   DECLARE_LOGGER();
 
@@ -47,14 +58,18 @@ class ConnectionQualityCheck {
   virtual ~ConnectionQualityCheck() {}
   void onFeedback(std::shared_ptr<DataPacket> packet, const std::vector<std::shared_ptr<MediaStream>> &streams);
   ConnectionQualityLevel getLevel() { return quality_level_; }
+  uint8_t getVideoFractionLost() { return video_fraction_lost_; }
   bool werePacketLossesRecently();
  private:
   void maybeNotifyMediaStreamsAboutConnectionQualityLevel(const std::vector<std::shared_ptr<MediaStream>> &streams);
+  void maybeNotifyMediaStreamsAboutVideoFractionLost(uint8_t video_fraction_lost,
+      const std::vector<std::shared_ptr<MediaStream>> &streams);
  private:
   ConnectionQualityLevel quality_level_;
   circular_buffer audio_buffer_;
   circular_buffer video_buffer_;
   bool recent_packet_losses_;
+  uint8_t video_fraction_lost_;
 };
 
 }  // namespace erizo
@@ -24,6 +24,7 @@ extern "C" {
 
 #include "lib/Base64.h"
 #include "./DtlsSocket.h"
+#include "SrtpChannel.h"
 
 using dtls::DtlsSocketContext;
 using dtls::DtlsSocket;
@@ -34,6 +35,9 @@ const char* DtlsSocketContext::DefaultSrtpProfile = "SRTP_AES128_CM_SHA1_80";
 
 X509 *DtlsSocketContext::mCert = nullptr;
 EVP_PKEY *DtlsSocketContext::privkey = nullptr;
+SSL_CTX *DtlsSocketContext::mSharedContext = nullptr;
+bool DtlsSocketContext::mSessionResumption = false;
+std::string DtlsSocketContext::mCertFingerprint;
 
 static const int KEY_LENGTH = 1024;
 
@@ -266,35 +270,101 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
   DtlsSocketContext::DtlsSocketContext() {
     started = false;
 
-    ELOG_DEBUG("Creating Dtls factory, Openssl v %s", OPENSSL_VERSION_TEXT);
+    if (mSharedContext) {
+      mContext = mSharedContext;
+#if OPENSSL_VERSION_NUMBER < 0x10100000
+      CRYPTO_add(&mContext->references, 1, CRYPTO_LOCK_SSL_CTX);
+#else
+      SSL_CTX_up_ref(mContext);
+#endif
+    } else {
+      ELOG_WARN("message: There is no shared DTLS context, creating one for this connection");
+      mContext = createContext();
+    }
+
+    ELOG_DEBUG("DtlsSocketContext created");
+  }
 
-    mContext = SSL_CTX_new(DTLS_method());
-    assert(mContext);
+  SSL_CTX* DtlsSocketContext::createContext() {
+    ELOG_DEBUG("Creating Dtls factory, Openssl v %s", OPENSSL_VERSION_TEXT);
 
-    int r = SSL_CTX_use_certificate(mContext, mCert);
-    assert(r == 1);
+    SSL_CTX *context = SSL_CTX_new(DTLS_method());
+    if (!context) {
+      ELOG_ERROR("message: Could not create the DTLS context");
+      return nullptr;
+    }
 
-    r = SSL_CTX_use_PrivateKey(mContext, privkey);
-    assert(r == 1);
+    if (SSL_CTX_use_certificate(context, mCert) != 1 || SSL_CTX_use_PrivateKey(context, privkey) != 1) {
+      ELOG_ERROR("message: Could not set the DTLS certificate");
+      SSL_CTX_free(context);
+      return nullptr;
+    }
 
-    SSL_CTX_set_cipher_list(mContext, "ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
+    SSL_CTX_set_cipher_list(context, "ALL:!ADH:!LOW:!EXP:!MD5:@STRENGTH");
 
-    SSL_CTX_set_info_callback(mContext, SSLInfoCallback);
+    SSL_CTX_set_info_callback(context, SSLInfoCallback);
 
-    SSL_CTX_set_verify(mContext, SSL_VERIFY_PEER |SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
+    SSL_CTX_set_verify(context, SSL_VERIFY_PEER |SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
       SSLVerifyCallback);
 
-    SSL_CTX_set_options(mContext, SSL_OP_NO_QUERY_MTU);
-      // SSL_CTX_set_session_cache_mode(mContext, SSL_SESS_CACHE_OFF);
-      // SSL_CTX_set_options(mContext, SSL_OP_NO_TICKET);
+    SSL_CTX_set_options(context, SSL_OP_NO_QUERY_MTU);
+    // Sessions are only resumed if setSessionResumption enables it
+    static const unsigned char kSessionIdContext[] = "licode";
+    SSL_CTX_set_session_id_context(context, kSessionIdContext, sizeof(kSessionIdContext) - 1);
+    applySessionResumption(context);
       // Set SRTP profiles
-    r = SSL_CTX_set_tlsext_use_srtp(mContext, DefaultSrtpProfile);
-    assert(r == 0);
+    std::string srtp_profiles = getSupportedSrtpProfiles();
+    ELOG_INFO("message: Offering SRTP profiles, profiles: %s", srtp_profiles.c_str());
+    if (SSL_CTX_set_tlsext_use_srtp(context, srtp_profiles.c_str()) != 0) {
+      ELOG_ERROR("message: Could not set the SRTP profiles, profiles: %s", srtp_profiles.c_str());
+      SSL_CTX_free(context);
+      return nullptr;
+    }
 
-    SSL_CTX_set_verify_depth(mContext, 2);
-    SSL_CTX_set_read_ahead(mContext, 1);
+    SSL_CTX_set_verify_depth(context, 2);
+    SSL_CTX_set_read_ahead(context, 1);
+    return context;
+  }
 
-    ELOG_DEBUG("DtlsSocketContext created");
+  void DtlsSocketContext::createSharedContext() {
+    mSharedContext = createContext();
+    if (!mSharedContext) {
+      ELOG_ERROR("message: Could not create the shared DTLS context, connections will create their own");
+    }
+
+    char fingerprint[100] = {};
+    DtlsSocket::computeFingerprint(mCert, fingerprint);
+    mCertFingerprint = fingerprint;
+  }
+
+  std::string DtlsSocketContext::getSupportedSrtpProfiles() {
+    std::string profiles;
+#ifdef SRTP_AEAD_AES_128_GCM
+    for (const char *profile : {"SRTP_AEAD_AES_128_GCM", "SRTP_AEAD_AES_256_GCM"}) {
+      if (erizo::SrtpChannel::isProfileSupported(profile)) {
+        profiles += std::string(profile) + ":";
+      }
+    }
+#endif
+    return profiles + DefaultSrtpProfile;
+  }
+
+  void DtlsSocketContext::setSessionResumption(bool enabled) {
+    ELOG_INFO("message: Setting DTLS session resumption, enabled: %d", enabled);
+    mSessionResumption = enabled;
+    if (mSharedContext) {
+      applySessionResumption(mSharedContext);
+    }
+  }
+
+  void DtlsSocketContext::applySessionResumption(SSL_CTX *context) {
+    if (mSessionResumption) {
+      SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_SERVER);
+      SSL_CTX_clear_options(context, SSL_OP_NO_TICKET);
+    } else {
+      SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_OFF);
+      SSL_CTX_set_options(context, SSL_OP_NO_TICKET);
+    }
   }
 
     DtlsSocketContext::~DtlsSocketContext() {
@@ -317,11 +387,13 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
         SSL_load_error_strings();
         ERR_load_crypto_strings();
         createCert("sip:licode@lynckia.com", 365, 1024, DtlsSocketContext::mCert, DtlsSocketContext::privkey);
+        createSharedContext();
       }
 #else
       if (DtlsSocketContext::mCert == nullptr) {
         OPENSSL_init_ssl(0, NULL);
         createCert("sip:licode@lynckia.com", 365, 1024, DtlsSocketContext::mCert, DtlsSocketContext::privkey);
+        createSharedContext();
       }
 #endif
     }
@@ -340,16 +412,19 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
     }
 
     void DtlsSocketContext::getMyCertFingerprint(char *fingerprint) {
-      DtlsSocket::computeFingerprint(DtlsSocketContext::mCert, fingerprint);
+      memcpy(fingerprint, mCertFingerprint.c_str(), mCertFingerprint.size() + 1);
     }
 
+    // The SSL_CTX is shared by every context, so settings of a single context go to its socket
     void DtlsSocketContext::setSrtpProfiles(const char *str) {
-      int r = SSL_CTX_set_tlsext_use_srtp(mContext, str);
+      assert(mSocket);
+      int r = SSL_set_tlsext_use_srtp(mSocket->getSSL(), str);
       assert(r == 0);
     }
 
     void DtlsSocketContext::setCipherSuites(const char *str) {
-      int r = SSL_CTX_set_cipher_list(mContext, str);
+      assert(mSocket);
+      int r = SSL_set_cipher_list(mSocket->getSSL(), str);
       assert(r == 1);
     }
 
@@ -446,9 +521,11 @@ int createCert(const std::string& pAor, int expireDays, int keyLen, X509*& outCe
 
         srtp_profile = mSocket->getSrtpProfile();
 
-        if (srtp_profile) {
-          ELOG_DEBUG("SRTP Extension negotiated profile=%s", srtp_profile->name);
+        if (!srtp_profile) {
+          handshakeFailed("No SRTP profile negotiated");
+          return;
         }
+        ELOG_DEBUG("SRTP Extension negotiated profile=%s", srtp_profile->name);
 
         if (receiver != NULL) {
           receiver->onHandshakeCompleted(this, client_key_str, server_key_str, srtp_profile->name);
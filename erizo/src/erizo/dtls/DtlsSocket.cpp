@@ -199,29 +199,44 @@ SrtpSessionKeys* DtlsSocket::getSrtpSessionKeys() {
 
   SrtpSessionKeys* keys = new SrtpSessionKeys();
 
-  unsigned char material[SRTP_MASTER_KEY_LEN << 1];
-  if (!SSL_export_keying_material(mSsl, material, sizeof(material), "EXTRACTOR-dtls_srtp", 19, NULL, 0, 0)) {
+  // Key and salt lengths depend on the negotiated profile (RFC 5764 section 4.2)
+  srtp_profile_t profile = getLibSrtpProfile();
+  const int key_len = srtp_profile_get_master_key_length(profile);
+  const int salt_len = srtp_profile_get_master_salt_length(profile);
+  assert(key_len <= SRTP_MAX_MASTER_KEY_KEY_LEN && salt_len <= SRTP_MAX_MASTER_KEY_SALT_LEN);
+
+  unsigned char material[(SRTP_MAX_MASTER_KEY_KEY_LEN + SRTP_MAX_MASTER_KEY_SALT_LEN) << 1];
+  if (!SSL_export_keying_material(mSsl, material, (key_len + salt_len) << 1, "EXTRACTOR-dtls_srtp", 19, NULL, 0, 0)) {
     return keys;
   }
 
   size_t offset = 0;
 
-  memcpy(keys->clientMasterKey, &material[offset], SRTP_MASTER_KEY_KEY_LEN);
-  offset += SRTP_MASTER_KEY_KEY_LEN;
-  memcpy(keys->serverMasterKey, &material[offset], SRTP_MASTER_KEY_KEY_LEN);
-  offset += SRTP_MASTER_KEY_KEY_LEN;
-  memcpy(keys->clientMasterSalt, &material[offset], SRTP_MASTER_KEY_SALT_LEN);
-  offset += SRTP_MASTER_KEY_SALT_LEN;
-  memcpy(keys->serverMasterSalt, &material[offset], SRTP_MASTER_KEY_SALT_LEN);
-  offset += SRTP_MASTER_KEY_SALT_LEN;
-  keys->clientMasterKeyLen = SRTP_MASTER_KEY_KEY_LEN;
-  keys->serverMasterKeyLen = SRTP_MASTER_KEY_KEY_LEN;
-  keys->clientMasterSaltLen = SRTP_MASTER_KEY_SALT_LEN;
-  keys->serverMasterSaltLen = SRTP_MASTER_KEY_SALT_LEN;
+  memcpy(keys->clientMasterKey, &material[offset], key_len);
+  offset += key_len;
+  memcpy(keys->serverMasterKey, &material[offset], key_len);
+  offset += key_len;
+  memcpy(keys->clientMasterSalt, &material[offset], salt_len);
+  offset += salt_len;
+  memcpy(keys->serverMasterSalt, &material[offset], salt_len);
+  offset += salt_len;
+  keys->clientMasterKeyLen = key_len;
+  keys->serverMasterKeyLen = key_len;
+  keys->clientMasterSaltLen = salt_len;
+  keys->serverMasterSaltLen = salt_len;
 
   return keys;
 }
 
+srtp_profile_t DtlsSocket::getLibSrtpProfile() {
+  SRTP_PROTECTION_PROFILE *profile = getSrtpProfile();
+  if (profile == NULL) {
+    return srtp_profile_aes128_cm_sha1_80;
+  }
+  // libsrtp profiles use the DTLS-SRTP protection profile identifiers
+  return static_cast<srtp_profile_t>(profile->id);
+}
+
 SRTP_PROTECTION_PROFILE* DtlsSocket::getSrtpProfile() {
   // TODO(pedro): probably an exception candidate
   assert(mHandshakeCompleted);
@@ -277,8 +292,7 @@ void DtlsSocket::handleTimeout() {
 void DtlsSocket::createSrtpSessionPolicies(srtp_policy_t& outboundPolicy, srtp_policy_t& inboundPolicy) {
   assert(mHandshakeCompleted);
 
-  /* we assume that the default profile is in effect, for now */
-  srtp_profile_t profile = srtp_profile_aes128_cm_sha1_80;
+  srtp_profile_t profile = getLibSrtpProfile();
   int key_len = srtp_profile_get_master_key_length(profile);
   int salt_len = srtp_profile_get_master_salt_length(profile);
 
@@ -20,8 +20,9 @@ extern "C" {
 #include "dtls/bf_dwrap.h"
 #include "../logger.h"
 
-const int SRTP_MASTER_KEY_KEY_LEN = 16;
-const int SRTP_MASTER_KEY_SALT_LEN = 14;
+// Largest master key and salt of the supported profiles, AEAD_AES_256_GCM keys and AES_CM salts
+const int SRTP_MAX_MASTER_KEY_KEY_LEN = 32;
+const int SRTP_MAX_MASTER_KEY_SALT_LEN = 14;
 static const int DTLS_MTU = 1472;
 
 namespace dtls {
@@ -30,13 +31,13 @@ class DtlsSocketContext;
 class SrtpSessionKeys {
  public:
   SrtpSessionKeys() {
-    clientMasterKey = new unsigned char[SRTP_MASTER_KEY_KEY_LEN];
+    clientMasterKey = new unsigned char[SRTP_MAX_MASTER_KEY_KEY_LEN];
     clientMasterKeyLen = 0;
-    clientMasterSalt = new unsigned char[SRTP_MASTER_KEY_SALT_LEN];
+    clientMasterSalt = new unsigned char[SRTP_MAX_MASTER_KEY_SALT_LEN];
     clientMasterSaltLen = 0;
-    serverMasterKey = new unsigned char[SRTP_MASTER_KEY_KEY_LEN];
+    serverMasterKey = new unsigned char[SRTP_MAX_MASTER_KEY_KEY_LEN];
     serverMasterKeyLen = 0;
-    serverMasterSalt = new unsigned char[SRTP_MASTER_KEY_SALT_LEN];
+    serverMasterSalt = new unsigned char[SRTP_MAX_MASTER_KEY_SALT_LEN];
     serverMasterSaltLen = 0;
   }
   ~SrtpSessionKeys() {
@@ -100,6 +101,11 @@ class DtlsSocket {
   // Retrieves the DTLS negotiated SRTP profile - may return 0 if profile selection failed
   SRTP_PROTECTION_PROFILE* getSrtpProfile();
 
+  // Same as getSrtpProfile but as a libsrtp profile, AES_CM_128_HMAC_SHA1_80 if profile selection failed
+  srtp_profile_t getLibSrtpProfile();
+
+  SSL* getSSL() { return mSsl; }
+
   // Creates SRTP session policies appropriately based on socket type (client vs server) and keys
   // extracted from the DTLS handshake process
   void createSrtpSessionPolicies(srtp_policy_t& outboundPolicy, srtp_policy_t& inboundPolicy);  // NOLINT
@@ -171,13 +177,14 @@ class DtlsSocketContext {
   // Returns the fingerprint of the user cert that was passed into the constructor
   void getMyCertFingerprint(char *fingerprint);
 
-  // The default SrtpProfile used at construction time (default is: SRTP_AES128_CM_SHA1_80:SRTP_AES128_CM_SHA1_32)
+  // The SRTP profile every peer supports, always offered last (SRTP_AES128_CM_SHA1_80)
   static const char* DefaultSrtpProfile;
 
-  // Changes the default SRTP profiles supported (default is: SRTP_AES128_CM_SHA1_80:SRTP_AES128_CM_SHA1_32)
+  // Changes the SRTP profiles supported by this context's socket (default is: the AEAD_AES_GCM profiles
+  // libsrtp supports followed by SRTP_AES128_CM_SHA1_80)
   void setSrtpProfiles(const char *policyStr);
 
-  // Changes the default DTLS Cipher Suites supported
+  // Changes the DTLS Cipher Suites supported by this context's socket
   void setCipherSuites(const char *cipherSuites);
 
   SSL_CTX* getSSLContext();
@@ -191,12 +198,29 @@ class DtlsSocketContext {
   static void Init();
   static void Destroy();
 
+  // Lets reconnecting clients resume their previous session (server side only), disabled by default
+  static void setSessionResumption(bool enabled);
+
  protected:
   DtlsSocket *mSocket;
   DtlsReceiver *receiver;
 
  private:
-  // Creates a DTLS SSL Context and enables srtp extension, also sets the private and public key cert
+  // Creates a DTLS SSL Context, enables srtp extension and sets the private and public key cert.
+  // Returns nullptr if it fails
+  static SSL_CTX* createContext();
+  // Creates the context shared by every socket, sockets fall back to their own if it could not be created
+  static void createSharedContext();
+  static void applySessionResumption(SSL_CTX *context);
+
+  // Builds the SRTP profile list offered in the handshake, AES-GCM first as it is cheaper per packet
+  static std::string getSupportedSrtpProfiles();
+
+  // The certificate, the key and the session cache are generated once per process and shared by every context
+  static SSL_CTX *mSharedContext;
+  static bool mSessionResumption;
+  static std::string mCertFingerprint;
+
   SSL_CTX* mContext;
 };
 }  // namespace dtls
@@ -0,0 +1,49 @@
+#include "lib/CodecRegistry.h"
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <mutex>  // NOLINT
+
+namespace erizo {
+
+namespace {
+
+struct Registry {
+  std::mutex mutex;
+  // deque so references returned by getName() stay valid when new names are added
+  std::deque<std::string> names{"", "VP8", "VP9", "H264"};
+};
+
+Registry& getRegistry() {
+  // Never destroyed, so names can be used from static destructors
+  static Registry *registry = new Registry();
+  return *registry;
+}
+
+}  // namespace
+
+CodecId CodecRegistry::intern(const std::string &encoding_name) {
+  Registry &registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto name_it = std::find(registry.names.begin(), registry.names.end(), encoding_name);
+  if (name_it != registry.names.end()) {
+    return static_cast<CodecId>(name_it - registry.names.begin());
+  }
+  if (registry.names.size() > std::numeric_limits<CodecId>::max()) {
+    return kUnknownCodec;
+  }
+  registry.names.push_back(encoding_name);
+  return static_cast<CodecId>(registry.names.size() - 1);
+}
+
+const std::string& CodecRegistry::getName(CodecId id) {
+  Registry &registry = getRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if (id >= registry.names.size()) {
+    return registry.names[kUnknownCodec];
+  }
+  return registry.names[id];
+}
+
+}  // namespace erizo
@@ -0,0 +1,29 @@
+#ifndef ERIZO_SRC_ERIZO_LIB_CODECREGISTRY_H_
+#define ERIZO_SRC_ERIZO_LIB_CODECREGISTRY_H_
+
+#include <cstdint>
+#include <string>
+
+namespace erizo {
+
+// Interned codec name, packets carry and compare it instead of the name itself
+typedef uint8_t CodecId;
+
+constexpr CodecId kUnknownCodec = 0;
+constexpr CodecId kVP8Codec = 1;
+constexpr CodecId kVP9Codec = 2;
+constexpr CodecId kH264Codec = 3;
+
+/**
+ * Process-wide table of codec names. Video codecs we parse have fixed ids, any other encoding name
+ * gets the next free id the first time it is interned.
+ */
+class CodecRegistry {
+ public:
+  static CodecId intern(const std::string &encoding_name);
+  static const std::string& getName(CodecId id);
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_LIB_CODECREGISTRY_H_
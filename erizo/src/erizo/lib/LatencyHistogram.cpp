@@ -0,0 +1,106 @@
+#include "lib/LatencyHistogram.h"
+
+namespace erizo {
+
+constexpr size_t LatencyHistogram::kSubBucketBits;
+constexpr size_t LatencyHistogram::kSubBuckets;
+constexpr size_t LatencyHistogram::kMaxMagnitude;
+constexpr size_t LatencyHistogram::kNumBuckets;
+
+LatencyHistogram::LatencyHistogram() : max_us_{0} {
+  reset();
+}
+
+LatencyHistogram::LatencyHistogram(const LatencyHistogram &other) : max_us_{0} {
+  *this = other;
+}
+
+LatencyHistogram& LatencyHistogram::operator=(const LatencyHistogram &other) {
+  for (size_t bucket = 0; bucket < kNumBuckets; bucket++) {
+    buckets_[bucket].store(other.getBucketCount(bucket), std::memory_order_relaxed);
+  }
+  max_us_.store(other.getMaxMicroseconds(), std::memory_order_relaxed);
+  return *this;
+}
+
+LatencyHistogram& LatencyHistogram::operator+=(const LatencyHistogram &other) {
+  for (size_t bucket = 0; bucket < kNumBuckets; bucket++) {
+    buckets_[bucket].fetch_add(other.getBucketCount(bucket), std::memory_order_relaxed);
+  }
+  uint64_t other_max_us = other.getMaxMicroseconds();
+  uint64_t max_us = max_us_.load(std::memory_order_relaxed);
+  while (other_max_us > max_us &&
+         !max_us_.compare_exchange_weak(max_us, other_max_us, std::memory_order_relaxed)) {
+  }
+  return *this;
+}
+
+void LatencyHistogram::record(duration value) {
+  auto value_us = std::chrono::duration_cast<std::chrono::microseconds>(value).count();
+  recordMicroseconds(value_us > 0 ? value_us : 0);
+}
+
+size_t LatencyHistogram::getBucket(uint64_t value_us) {
+  if (value_us < kSubBuckets) {
+    return value_us;
+  }
+  size_t magnitude = 63 - __builtin_clzll(value_us);
+  if (magnitude > kMaxMagnitude - 1) {
+    return kNumBuckets - 1;
+  }
+  // The kSubBucketBits bits after the highest one set pick the linear bucket inside the power of two
+  size_t shift = magnitude - kSubBucketBits;
+  return (shift << kSubBucketBits) + (value_us >> shift);
+}
+
+uint64_t LatencyHistogram::getBucketUpperBoundMicroseconds(size_t bucket) {
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+  size_t shift = (bucket >> kSubBucketBits) - 1;
+  uint64_t sub_bucket = bucket - (shift << kSubBucketBits);
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::recordMicroseconds(uint64_t value_us) {
+  buckets_[getBucket(value_us)].fetch_add(1, std::memory_order_relaxed);
+  uint64_t max_us = max_us_.load(std::memory_order_relaxed);
+  while (value_us > max_us && !max_us_.compare_exchange_weak(max_us, value_us, std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::reset() {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  max_us_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getCount() const {
+  uint64_t count = 0;
+  for (const auto &bucket : buckets_) {
+    count += bucket.load(std::memory_order_relaxed);
+  }
+  return count;
+}
+
+uint64_t LatencyHistogram::getPercentileMicroseconds(double percentile) const {
+  uint64_t count = getCount();
+  if (count == 0) {
+    return 0;
+  }
+  uint64_t target = static_cast<uint64_t>(percentile / 100. * count + 0.5);
+  if (target == 0) {
+    target = 1;
+  }
+  uint64_t accumulated = 0;
+  for (size_t bucket = 0; bucket < kNumBuckets; bucket++) {
+    accumulated += buckets_[bucket].load(std::memory_order_relaxed);
+    if (accumulated >= target) {
+      return getBucketUpperBoundMicroseconds(bucket);
+    }
+  }
+  return getBucketUpperBoundMicroseconds(kNumBuckets - 1);
+}
+
+}  // namespace erizo
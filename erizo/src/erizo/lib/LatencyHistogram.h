@@ -0,0 +1,52 @@
+#ifndef ERIZO_SRC_ERIZO_LIB_LATENCYHISTOGRAM_H_
+#define ERIZO_SRC_ERIZO_LIB_LATENCYHISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+
+#include "lib/Clock.h"
+
+namespace erizo {
+
+/**
+ * Histogram of durations in microseconds, from 1us to ~8s, with log-linear buckets like HdrHistogram's: values
+ * below kSubBuckets have a bucket each, and every power of two above is split in kSubBuckets linear buckets, so
+ * percentiles are off by less than 1/kSubBuckets of their value. It can be written and read from any thread.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr size_t kSubBucketBits = 4;
+  static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+  // Values of 2^kMaxMagnitude us and above go in the last bucket
+  static constexpr size_t kMaxMagnitude = 23;
+  static constexpr size_t kNumBuckets = (kMaxMagnitude - kSubBucketBits + 1) * kSubBuckets;
+
+  LatencyHistogram();
+  // Copies and sums are not atomic snapshots, values recorded meanwhile may be missing
+  LatencyHistogram(const LatencyHistogram &other);
+  LatencyHistogram& operator=(const LatencyHistogram &other);
+  LatencyHistogram& operator+=(const LatencyHistogram &other);
+
+  void record(duration value);
+  void recordMicroseconds(uint64_t value_us);
+  void reset();
+
+  uint64_t getCount() const;
+  uint64_t getMaxMicroseconds() const { return max_us_.load(std::memory_order_relaxed); }
+  // Upper bound of the bucket that contains the given percentile (0-100)
+  uint64_t getPercentileMicroseconds(double percentile) const;
+  uint64_t getBucketCount(size_t bucket) const { return buckets_[bucket].load(std::memory_order_relaxed); }
+  static size_t getBucket(uint64_t value_us);
+  // Highest value that goes in the bucket
+  static uint64_t getBucketUpperBoundMicroseconds(size_t bucket);
+
+ private:
+  std::array<std::atomic<uint64_t>, kNumBuckets> buckets_;
+  std::atomic<uint64_t> max_us_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_LIB_LATENCYHISTOGRAM_H_
@@ -0,0 +1,532 @@
+/*
+ * NicerBatchSocket.cpp
+ */
+
+#include "lib/NicerBatchSocket.h"
+
+// nICEr includes
+extern "C" {
+#include <nr_api.h>
+#include <r_errors.h>
+#include <nr_socket.h>
+#include <nr_socket_local.h>
+#include <transport_addr.h>
+}
+
+#ifdef __linux__
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+namespace erizo {
+
+DEFINE_LOGGER(NicerBatchSocket, "NicerBatchSocket");
+
+namespace {
+
+struct AtomicSocketBatchStats {
+  std::atomic<uint64_t> send_calls{0};
+  std::atomic<uint64_t> gso_calls{0};
+  std::atomic<uint64_t> sent_datagrams{0};
+  std::atomic<uint64_t> receive_calls{0};
+  std::atomic<uint64_t> received_datagrams{0};
+};
+
+AtomicSocketBatchStats batch_stats;
+
+}  // namespace
+
+SocketBatchStats NicerBatchSocket::getStats() {
+  SocketBatchStats stats;
+  stats.send_calls = batch_stats.send_calls;
+  stats.gso_calls = batch_stats.gso_calls;
+  stats.sent_datagrams = batch_stats.sent_datagrams;
+  stats.receive_calls = batch_stats.receive_calls;
+  stats.received_datagrams = batch_stats.received_datagrams;
+  return stats;
+}
+
+void NicerBatchSocket::resetStats() {
+  batch_stats.send_calls = 0;
+  batch_stats.gso_calls = 0;
+  batch_stats.sent_datagrams = 0;
+  batch_stats.receive_calls = 0;
+  batch_stats.received_datagrams = 0;
+}
+
+#ifdef __linux__
+
+#ifndef SOL_UDP
+#define SOL_UDP IPPROTO_UDP
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+namespace {
+
+// Also the most segments the kernel accepts in a single GSO send
+constexpr size_t kMaxBatchDatagrams = 64;
+constexpr size_t kMaxDatagramLength = 2048;
+constexpr size_t kMaxGsoLength = 65000;
+constexpr size_t kReceiveBatchDatagrams = 16;
+constexpr size_t kTruncatedDatagram = kMaxDatagramLength + 1;
+
+// Cleared the first time the kernel or the NIC refuses a GSO send
+std::atomic<bool> gso_enabled{true};
+
+}  // namespace
+
+class NicerBatchSocket::Socket {
+ public:
+  struct QueuedDatagram {
+    Socket *socket;
+    sockaddr_storage to;
+    socklen_t to_length;
+    size_t offset;
+    size_t length;
+  };
+
+  struct SendQueue {
+    int depth = 0;
+    std::vector<char> buffer;
+    size_t used = 0;
+    std::vector<QueuedDatagram> datagrams;
+  };
+
+  static thread_local SendQueue send_queue_;
+
+  static int create(void *obj, nr_transport_addr *addr, nr_socket **sockp);
+  static int destroyFactory(void **obj);
+  static void flush();
+
+  static int destroy(void **obj);
+  static int sendTo(void *obj, const void *msg, size_t len, int flags, nr_transport_addr *addr);
+  static int receiveFrom(void *obj, void *buf, size_t maxlen, size_t *len, int flags, nr_transport_addr *addr);
+  static int getFd(void *obj, NR_SOCKET *fd);
+  static int getAddress(void *obj, nr_transport_addr *addr);
+  static int connectTo(void *obj, nr_transport_addr *addr);
+  static int writeStream(void *obj, const void *msg, size_t len, size_t *written);
+  static int readStream(void *obj, void *buf, size_t maxlen, size_t *len);
+  static int closeSocket(void *obj);
+
+ private:
+  explicit Socket(nr_socket *inner);
+  ~Socket();
+
+  static nr_socket_vtbl* vtbl();
+  static size_t countSegments(const QueuedDatagram *datagrams, size_t count);
+
+  bool init();
+  int queue(const void *msg, size_t len, nr_transport_addr *addr);
+  void sendQueued(QueuedDatagram *datagrams, size_t count, char *buffer);
+  bool sendSegments(const QueuedDatagram *datagrams, size_t count, char *buffer);
+  void sendMessages(mmsghdr *messages, size_t count);
+  size_t receiveBatch();
+  void clearWakeUp();
+
+  nr_socket *inner_;
+  int fd_;
+  int epoll_fd_;
+  int wake_up_fd_;
+  bool wake_up_signaled_;
+  std::vector<char> received_;
+  std::vector<sockaddr_storage> received_from_;
+  std::vector<size_t> received_lengths_;
+  size_t received_count_;
+  size_t next_received_;
+};
+
+thread_local NicerBatchSocket::Socket::SendQueue NicerBatchSocket::Socket::send_queue_;
+
+NicerBatchSocket::Socket::Socket(nr_socket *inner)
+    : inner_{inner}, fd_{-1}, epoll_fd_{-1}, wake_up_fd_{-1}, wake_up_signaled_{false},
+      received_count_{0}, next_received_{0} {
+}
+
+NicerBatchSocket::Socket::~Socket() {
+  if (inner_) {
+    nr_socket_destroy(&inner_);
+  }
+  if (epoll_fd_ >= 0) {
+    ::close(epoll_fd_);
+  }
+  if (wake_up_fd_ >= 0) {
+    ::close(wake_up_fd_);
+  }
+}
+
+nr_socket_vtbl* NicerBatchSocket::Socket::vtbl() {
+  static nr_socket_vtbl socket_vtbl = [] {
+    nr_socket_vtbl new_vtbl;
+    memset(&new_vtbl, 0, sizeof(new_vtbl));
+    new_vtbl.version = 2;
+    new_vtbl.destroy = &Socket::destroy;
+    new_vtbl.ssendto = &Socket::sendTo;
+    new_vtbl.srecvfrom = &Socket::receiveFrom;
+    new_vtbl.getfd = &Socket::getFd;
+    new_vtbl.getaddr = &Socket::getAddress;
+    new_vtbl.connect = &Socket::connectTo;
+    new_vtbl.swrite = &Socket::writeStream;
+    new_vtbl.sread = &Socket::readStream;
+    new_vtbl.close = &Socket::closeSocket;
+    return new_vtbl;
+  }();
+  return &socket_vtbl;
+}
+
+int NicerBatchSocket::Socket::create(void *obj, nr_transport_addr *addr, nr_socket **sockp) {
+  nr_socket *inner;
+  int r = nr_socket_local_create(nullptr, addr, &inner);
+  if (r) {
+    return r;
+  }
+  if (addr->protocol != IPPROTO_UDP) {
+    *sockp = inner;
+    return 0;
+  }
+  Socket *socket = new Socket(inner);
+  if (!socket->init()) {
+    ELOG_WARN("message: Could not create batch socket, using a plain one, errno: %d", errno);
+    socket->inner_ = nullptr;
+    delete socket;
+    *sockp = inner;
+    return 0;
+  }
+  r = nr_socket_create_int(socket, vtbl(), sockp);
+  if (r) {
+    delete socket;
+  }
+  return r;
+}
+
+int NicerBatchSocket::Socket::destroyFactory(void **obj) {
+  *obj = nullptr;
+  return 0;
+}
+
+bool NicerBatchSocket::Socket::init() {
+  if (inner_->vtbl->getfd(inner_->obj, &fd_)) {
+    return false;
+  }
+  // nICEr waits on the epoll fd, which is readable while the socket is or while datagrams read by the last
+  // recvmmsg are left, as nICEr only reads one per readable callback
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  wake_up_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epoll_fd_ < 0 || wake_up_fd_ < 0) {
+    return false;
+  }
+  for (int fd : {fd_, wake_up_fd_}) {
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+      return false;
+    }
+  }
+  received_.resize(kReceiveBatchDatagrams * kMaxDatagramLength);
+  received_from_.resize(kReceiveBatchDatagrams);
+  received_lengths_.resize(kReceiveBatchDatagrams);
+  return true;
+}
+
+int NicerBatchSocket::Socket::destroy(void **obj) {
+  Socket *socket = static_cast<Socket*>(*obj);
+  *obj = nullptr;
+  // The queue can not keep datagrams of a socket that is gone
+  if (!send_queue_.datagrams.empty()) {
+    flush();
+  }
+  delete socket;
+  return 0;
+}
+
+int NicerBatchSocket::Socket::sendTo(void *obj, const void *msg, size_t len, int flags, nr_transport_addr *addr) {
+  Socket *socket = static_cast<Socket*>(obj);
+  if (send_queue_.depth > 0 && len <= kMaxDatagramLength &&
+      static_cast<size_t>(addr->addr_len) <= sizeof(sockaddr_storage)) {
+    return socket->queue(msg, len, addr);
+  }
+  return socket->inner_->vtbl->ssendto(socket->inner_->obj, msg, len, flags, addr);
+}
+
+int NicerBatchSocket::Socket::queue(const void *msg, size_t len, nr_transport_addr *addr) {
+  if (send_queue_.buffer.empty()) {
+    send_queue_.buffer.resize(kMaxBatchDatagrams * kMaxDatagramLength);
+    send_queue_.datagrams.reserve(kMaxBatchDatagrams);
+  }
+  if (send_queue_.datagrams.size() == kMaxBatchDatagrams || send_queue_.used + len > send_queue_.buffer.size()) {
+    flush();
+  }
+  QueuedDatagram datagram;
+  datagram.socket = this;
+  memcpy(&datagram.to, addr->addr, addr->addr_len);
+  datagram.to_length = addr->addr_len;
+  datagram.offset = send_queue_.used;
+  datagram.length = len;
+  memcpy(send_queue_.buffer.data() + send_queue_.used, msg, len);
+  send_queue_.used += len;
+  send_queue_.datagrams.push_back(datagram);
+  return 0;
+}
+
+void NicerBatchSocket::Socket::flush() {
+  std::vector<QueuedDatagram> &datagrams = send_queue_.datagrams;
+  size_t begin = 0;
+  while (begin < datagrams.size()) {
+    size_t end = begin + 1;
+    while (end < datagrams.size() && datagrams[end].socket == datagrams[begin].socket) {
+      end++;
+    }
+    datagrams[begin].socket->sendQueued(&datagrams[begin], end - begin, send_queue_.buffer.data());
+    begin = end;
+  }
+  datagrams.clear();
+  send_queue_.used = 0;
+}
+
+void NicerBatchSocket::Socket::sendQueued(QueuedDatagram *datagrams, size_t count, char *buffer) {
+  mmsghdr messages[kMaxBatchDatagrams];
+  iovec iovecs[kMaxBatchDatagrams];
+  size_t pending = 0;
+  size_t index = 0;
+  while (index < count) {
+    size_t segments = gso_enabled ? countSegments(datagrams + index, count - index) : 1;
+    if (segments > 1) {
+      sendMessages(messages, pending);
+      pending = 0;
+      if (sendSegments(datagrams + index, segments, buffer)) {
+        index += segments;
+        continue;
+      }
+    }
+    for (size_t end = index + segments; index < end; index++, pending++) {
+      iovecs[pending].iov_base = buffer + datagrams[index].offset;
+      iovecs[pending].iov_len = datagrams[index].length;
+      memset(&messages[pending], 0, sizeof(messages[pending]));
+      messages[pending].msg_hdr.msg_name = &datagrams[index].to;
+      messages[pending].msg_hdr.msg_namelen = datagrams[index].to_length;
+      messages[pending].msg_hdr.msg_iov = &iovecs[pending];
+      messages[pending].msg_hdr.msg_iovlen = 1;
+    }
+  }
+  sendMessages(messages, pending);
+}
+
+size_t NicerBatchSocket::Socket::countSegments(const QueuedDatagram *datagrams, size_t count) {
+  // GSO splits a buffer in segments of the same size, only the last one can be shorter
+  const QueuedDatagram &first = datagrams[0];
+  size_t total_length = first.length;
+  size_t segments = 1;
+  while (segments < count) {
+    const QueuedDatagram &datagram = datagrams[segments];
+    const QueuedDatagram &previous = datagrams[segments - 1];
+    if (previous.length != first.length || datagram.length > first.length ||
+        datagram.offset != previous.offset + previous.length || total_length + datagram.length > kMaxGsoLength ||
+        datagram.to_length != first.to_length || memcmp(&datagram.to, &first.to, first.to_length) != 0) {
+      break;
+    }
+    total_length += datagram.length;
+    segments++;
+  }
+  return segments;
+}
+
+bool NicerBatchSocket::Socket::sendSegments(const QueuedDatagram *datagrams, size_t count, char *buffer) {
+  const QueuedDatagram &last = datagrams[count - 1];
+  iovec segments_iovec;
+  segments_iovec.iov_base = buffer + datagrams[0].offset;
+  segments_iovec.iov_len = last.offset + last.length - datagrams[0].offset;
+
+  char control[CMSG_SPACE(sizeof(uint16_t))];
+  memset(control, 0, sizeof(control));
+  msghdr message;
+  memset(&message, 0, sizeof(message));
+  message.msg_name = const_cast<sockaddr_storage*>(&datagrams[0].to);
+  message.msg_namelen = datagrams[0].to_length;
+  message.msg_iov = &segments_iovec;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  cmsghdr *header = CMSG_FIRSTHDR(&message);
+  header->cmsg_level = SOL_UDP;
+  header->cmsg_type = UDP_SEGMENT;
+  header->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  uint16_t segment_length = datagrams[0].length;
+  memcpy(CMSG_DATA(header), &segment_length, sizeof(segment_length));
+
+  if (sendmsg(fd_, &message, 0) < 0) {
+    if (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT || errno == EOPNOTSUPP) {
+      if (gso_enabled.exchange(false)) {
+        ELOG_INFO("message: UDP GSO is not available, sending with sendmmsg, errno: %d", errno);
+      }
+    }
+    return false;
+  }
+  batch_stats.send_calls++;
+  batch_stats.gso_calls++;
+  batch_stats.sent_datagrams += count;
+  return true;
+}
+
+void NicerBatchSocket::Socket::sendMessages(mmsghdr *messages, size_t count) {
+  size_t sent = 0;
+  while (sent < count) {
+    int result = sendmmsg(fd_, messages + sent, count - sent, 0);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // Only the first datagram failed, it is dropped like a failed sendto would
+      ELOG_DEBUG("message: Could not send datagram, errno: %d", errno);
+      sent++;
+      continue;
+    }
+    batch_stats.send_calls++;
+    batch_stats.sent_datagrams += result;
+    sent += result;
+  }
+}
+
+int NicerBatchSocket::Socket::receiveFrom(void *obj, void *buf, size_t maxlen, size_t *len, int flags,
+                                         nr_transport_addr *addr) {
+  Socket *socket = static_cast<Socket*>(obj);
+  while (true) {
+    if (socket->next_received_ == socket->received_count_ && socket->receiveBatch() == 0) {
+      return R_WOULDBLOCK;
+    }
+    size_t index = socket->next_received_++;
+    if (socket->next_received_ == socket->received_count_) {
+      socket->clearWakeUp();
+    }
+    size_t length = socket->received_lengths_[index];
+    if (length > maxlen || length == kTruncatedDatagram) {
+      ELOG_DEBUG("message: Dropping datagram bigger than the buffer, length: %lu", length);
+      continue;
+    }
+    memcpy(buf, socket->received_.data() + index * kMaxDatagramLength, length);
+    *len = length;
+    return nr_sockaddr_to_transport_addr(reinterpret_cast<sockaddr*>(&socket->received_from_[index]),
+                                         IPPROTO_UDP, 0, addr);
+  }
+}
+
+size_t NicerBatchSocket::Socket::receiveBatch() {
+  mmsghdr messages[kReceiveBatchDatagrams];
+  iovec iovecs[kReceiveBatchDatagrams];
+  for (size_t index = 0; index < kReceiveBatchDatagrams; index++) {
+    iovecs[index].iov_base = received_.data() + index * kMaxDatagramLength;
+    iovecs[index].iov_len = kMaxDatagramLength;
+    memset(&messages[index], 0, sizeof(messages[index]));
+    messages[index].msg_hdr.msg_name = &received_from_[index];
+    messages[index].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+    messages[index].msg_hdr.msg_iov = &iovecs[index];
+    messages[index].msg_hdr.msg_iovlen = 1;
+  }
+  int result = recvmmsg(fd_, messages, kReceiveBatchDatagrams, MSG_DONTWAIT, nullptr);
+  if (result <= 0) {
+    return 0;
+  }
+  for (int index = 0; index < result; index++) {
+    bool truncated = messages[index].msg_hdr.msg_flags & MSG_TRUNC;
+    received_lengths_[index] = truncated ? kTruncatedDatagram : messages[index].msg_len;
+  }
+  received_count_ = result;
+  next_received_ = 0;
+  batch_stats.receive_calls++;
+  batch_stats.received_datagrams += result;
+  // Keeps the epoll fd readable until nICEr reads the rest, even if the socket has nothing new
+  if (result > 1 && !wake_up_signaled_) {
+    uint64_t value = 1;
+    ssize_t written = ::write(wake_up_fd_, &value, sizeof(value));
+    (void) written;
+    wake_up_signaled_ = true;
+  }
+  return result;
+}
+
+void NicerBatchSocket::Socket::clearWakeUp() {
+  if (!wake_up_signaled_) {
+    return;
+  }
+  uint64_t value;
+  ssize_t read_bytes = ::read(wake_up_fd_, &value, sizeof(value));
+  (void) read_bytes;
+  wake_up_signaled_ = false;
+}
+
+int NicerBatchSocket::Socket::getFd(void *obj, NR_SOCKET *fd) {
+  *fd = static_cast<Socket*>(obj)->epoll_fd_;
+  return 0;
+}
+
+int NicerBatchSocket::Socket::getAddress(void *obj, nr_transport_addr *addr) {
+  nr_socket *inner = static_cast<Socket*>(obj)->inner_;
+  return inner->vtbl->getaddr(inner->obj, addr);
+}
+
+int NicerBatchSocket::Socket::connectTo(void *obj, nr_transport_addr *addr) {
+  nr_socket *inner = static_cast<Socket*>(obj)->inner_;
+  return inner->vtbl->connect ? inner->vtbl->connect(inner->obj, addr) : R_INTERNAL;
+}
+
+int NicerBatchSocket::Socket::writeStream(void *obj, const void *msg, size_t len, size_t *written) {
+  nr_socket *inner = static_cast<Socket*>(obj)->inner_;
+  return inner->vtbl->swrite ? inner->vtbl->swrite(inner->obj, msg, len, written) : R_INTERNAL;
+}
+
+int NicerBatchSocket::Socket::readStream(void *obj, void *buf, size_t maxlen, size_t *len) {
+  nr_socket *inner = static_cast<Socket*>(obj)->inner_;
+  return inner->vtbl->sread ? inner->vtbl->sread(inner->obj, buf, maxlen, len) : R_INTERNAL;
+}
+
+int NicerBatchSocket::Socket::closeSocket(void *obj) {
+  nr_socket *inner = static_cast<Socket*>(obj)->inner_;
+  return inner->vtbl->close ? inner->vtbl->close(inner->obj) : 0;
+}
+
+NicerBatchSocket::SendBatch::SendBatch() {
+  Socket::send_queue_.depth++;
+}
+
+NicerBatchSocket::SendBatch::~SendBatch() {
+  if (--Socket::send_queue_.depth == 0 && !Socket::send_queue_.datagrams.empty()) {
+    Socket::flush();
+  }
+}
+
+nr_socket_factory* NicerBatchSocket::createFactory() {
+  static nr_socket_factory_vtbl factory_vtbl = {&Socket::create, &Socket::destroyFactory};
+  nr_socket_factory *factory;
+  if (nr_socket_factory_create_int(nullptr, &factory_vtbl, &factory)) {
+    return nullptr;
+  }
+  return factory;
+}
+
+#else
+
+NicerBatchSocket::SendBatch::SendBatch() {
+}
+
+NicerBatchSocket::SendBatch::~SendBatch() {
+}
+
+nr_socket_factory* NicerBatchSocket::createFactory() {
+  return nullptr;
+}
+
+#endif  // __linux__
+
+}  // namespace erizo
@@ -0,0 +1,58 @@
+/*
+ * NicerBatchSocket.h
+ */
+
+#ifndef ERIZO_SRC_ERIZO_LIB_NICERBATCHSOCKET_H_
+#define ERIZO_SRC_ERIZO_LIB_NICERBATCHSOCKET_H_
+
+#include <cstdint>
+
+#include "./logger.h"
+
+struct nr_socket_factory_;
+
+namespace erizo {
+
+struct SocketBatchStats {
+  uint64_t send_calls = 0;  // sendmmsg and GSO sendmsg calls
+  uint64_t gso_calls = 0;
+  uint64_t sent_datagrams = 0;
+  uint64_t receive_calls = 0;  // recvmmsg calls that returned datagrams
+  uint64_t received_datagrams = 0;
+};
+
+/**
+ * nICEr UDP sockets that send and receive datagrams in batches.
+ *
+ * Datagrams sent in a thread while a SendBatch is alive are queued and flushed together when it is destroyed, with
+ * sendmmsg, or with a single UDP_SEGMENT (GSO) sendmsg when consecutive datagrams go to the same address and have
+ * the same size. Reads use recvmmsg, nICEr still gets one datagram per readable callback from the ones it returned.
+ * Only available in Linux, elsewhere nICEr keeps its own sockets.
+ */
+class NicerBatchSocket {
+  DECLARE_LOGGER();
+
+ public:
+  class SendBatch {
+   public:
+    SendBatch();
+    ~SendBatch();
+
+    SendBatch(const SendBatch&) = delete;
+    SendBatch& operator=(const SendBatch&) = delete;
+  };
+
+  // To be installed with NicerInterface::IceContextSetSocketFactory, the ICE context owns it.
+  // Returns nullptr if batching is not available
+  static nr_socket_factory_* createFactory();
+
+  static SocketBatchStats getStats();
+  static void resetStats();
+
+ private:
+  class Socket;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_LIB_NICERBATCHSOCKET_H_
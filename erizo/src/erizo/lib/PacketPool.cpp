@@ -0,0 +1,84 @@
+#include "lib/PacketPool.h"
+
+#include <algorithm>
+
+namespace erizo {
+
+constexpr std::size_t PacketPool::kBlockSize;
+constexpr std::size_t PacketPool::kMaxThreadCachedBlocks;
+constexpr std::size_t PacketPool::kTransferBatchSize;
+constexpr std::size_t PacketPool::kMaxSharedBlocks;
+
+struct PacketPool::ThreadCache {
+  explicit ThreadCache(PacketPool *owner) : pool{owner} {
+    blocks.reserve(kMaxThreadCachedBlocks + 1);
+  }
+
+  ~ThreadCache() {
+    pool->spill(&blocks, blocks.size());
+  }
+
+  PacketPool *pool;
+  std::vector<void*> blocks;
+};
+
+PacketPool& PacketPool::instance() {
+  // Never destroyed: thread caches may give their blocks back after static destructors have run.
+  static PacketPool *pool = new PacketPool();
+  return *pool;
+}
+
+PacketPool::ThreadCache& PacketPool::getThreadCache() {
+  thread_local ThreadCache cache{&instance()};
+  return cache;
+}
+
+void* PacketPool::allocate() {
+  std::vector<void*> &blocks = getThreadCache().blocks;
+  if (blocks.empty()) {
+    refill(&blocks);
+  }
+  if (blocks.empty()) {
+    return ::operator new(kBlockSize);
+  }
+  void *block = blocks.back();
+  blocks.pop_back();
+  return block;
+}
+
+void PacketPool::deallocate(void* block) {
+  std::vector<void*> &blocks = getThreadCache().blocks;
+  blocks.push_back(block);
+  if (blocks.size() > kMaxThreadCachedBlocks) {
+    spill(&blocks, kTransferBatchSize);
+  }
+}
+
+std::size_t PacketPool::getSharedFreeBlocks() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return free_blocks_.size();
+}
+
+void PacketPool::refill(std::vector<void*>* blocks) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  std::size_t count = std::min(kTransferBatchSize, free_blocks_.size());
+  blocks->insert(blocks->end(), free_blocks_.end() - count, free_blocks_.end());
+  free_blocks_.resize(free_blocks_.size() - count);
+}
+
+void PacketPool::spill(std::vector<void*>* blocks, std::size_t count) {
+  count = std::min(count, blocks->size());
+  auto first = blocks->end() - count;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    while (first != blocks->end() && free_blocks_.size() < kMaxSharedBlocks) {
+      free_blocks_.push_back(*first++);
+    }
+  }
+  for (auto it = first; it != blocks->end(); ++it) {
+    ::operator delete(*it);
+  }
+  blocks->resize(blocks->size() - count);
+}
+
+}  // namespace erizo
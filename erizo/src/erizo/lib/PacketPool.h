@@ -0,0 +1,84 @@
+#ifndef ERIZO_SRC_ERIZO_LIB_PACKETPOOL_H_
+#define ERIZO_SRC_ERIZO_LIB_PACKETPOOL_H_
+
+#include <cstddef>
+#include <mutex>  // NOLINT
+#include <new>
+#include <vector>
+
+namespace erizo {
+
+/**
+ * Fixed-size block pool used to back DataPacket allocations.
+ * Each thread keeps a small cache of free blocks and exchanges them in batches with a shared free list,
+ * so packets allocated in the IO thread and released in a Worker do not go through malloc/free.
+ */
+class PacketPool {
+ public:
+  static constexpr std::size_t kBlockSize = 2048;
+  static constexpr std::size_t kMaxThreadCachedBlocks = 256;
+  static constexpr std::size_t kTransferBatchSize = 64;
+  static constexpr std::size_t kMaxSharedBlocks = 16384;
+
+  static PacketPool& instance();
+
+  void* allocate();
+  void deallocate(void* block);
+
+  std::size_t getSharedFreeBlocks();
+
+ private:
+  struct ThreadCache;
+
+  PacketPool() = default;
+  static ThreadCache& getThreadCache();
+  void refill(std::vector<void*>* blocks);
+  void spill(std::vector<void*>* blocks, std::size_t count);
+
+ private:
+  std::mutex mutex_;
+  std::vector<void*> free_blocks_;
+};
+
+/**
+ * Standard allocator over PacketPool, meant for std::allocate_shared so that the packet and its
+ * reference count live in the same pooled block.
+ */
+template <class T>
+class PacketPoolAllocator {
+ public:
+  typedef T value_type;
+
+  PacketPoolAllocator() = default;
+  template <class U>
+  PacketPoolAllocator(const PacketPoolAllocator<U>&) {}  // NOLINT
+
+  T* allocate(std::size_t n) {
+    if (n == 1 && sizeof(T) <= PacketPool::kBlockSize) {
+      return static_cast<T*>(PacketPool::instance().allocate());
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) {
+    if (n == 1 && sizeof(T) <= PacketPool::kBlockSize) {
+      PacketPool::instance().deallocate(p);
+      return;
+    }
+    ::operator delete(p);
+  }
+};
+
+template <class T, class U>
+bool operator==(const PacketPoolAllocator<T>&, const PacketPoolAllocator<U>&) {
+  return true;
+}
+
+template <class T, class U>
+bool operator!=(const PacketPoolAllocator<T>&, const PacketPoolAllocator<U>&) {
+  return false;
+}
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_LIB_PACKETPOOL_H_
@@ -0,0 +1,26 @@
+#include "lib/WebRtcClock.h"
+
+#include "lib/ClockUtils.h"
+
+namespace erizo {
+
+WebRtcClock::WebRtcClock(std::shared_ptr<erizo::Clock> the_clock) : clock_{the_clock} {
+}
+
+int64_t WebRtcClock::TimeInMilliseconds() const {
+  return ClockUtils::timePointToMs(clock_->now());
+}
+
+int64_t WebRtcClock::TimeInMicroseconds() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(clock_->now().time_since_epoch()).count();
+}
+
+void WebRtcClock::CurrentNtp(uint32_t& seconds, uint32_t& fractions) const {  // NOLINT
+  webrtc::Clock::GetRealTimeClock()->CurrentNtp(seconds, fractions);
+}
+
+int64_t WebRtcClock::CurrentNtpInMilliseconds() const {
+  return webrtc::Clock::GetRealTimeClock()->CurrentNtpInMilliseconds();
+}
+
+}  // namespace erizo
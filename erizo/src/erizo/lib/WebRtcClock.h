@@ -0,0 +1,28 @@
+#ifndef ERIZO_SRC_ERIZO_LIB_WEBRTCCLOCK_H_
+#define ERIZO_SRC_ERIZO_LIB_WEBRTCCLOCK_H_
+
+#include <memory>
+
+#include "lib/Clock.h"
+
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace erizo {
+
+// Lets the webrtc modules run on an erizo::Clock, so tests can drive them with a SimulatedClock
+class WebRtcClock : public webrtc::Clock {
+ public:
+  explicit WebRtcClock(std::shared_ptr<erizo::Clock> the_clock);
+
+  int64_t TimeInMilliseconds() const override;
+  int64_t TimeInMicroseconds() const override;
+  void CurrentNtp(uint32_t& seconds, uint32_t& fractions) const override;  // NOLINT
+  int64_t CurrentNtpInMilliseconds() const override;
+
+ private:
+  std::shared_ptr<erizo::Clock> clock_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_LIB_WEBRTCCLOCK_H_
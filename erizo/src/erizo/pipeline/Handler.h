@@ -12,6 +12,7 @@
 
 #include <cassert>
 #include <string>
+#include <utility>
 
 #include "pipeline/Pipeline.h"
 #include "./MediaDefinitions.h"
@@ -52,6 +53,13 @@ class Handler : public HandlerBase<HandlerContext> {
   virtual std::string getName() = 0;
 
   virtual void read(Context* ctx, std::shared_ptr<DataPacket> packet) = 0;
+  // Handlers that can amortise their work over several packets override this, the rest process them one by one
+  // and the packets they fire still reach the next handler as a batch
+  virtual void readBatch(Context* ctx, PacketBatch packets) {
+    for (std::shared_ptr<DataPacket> &packet : packets) {
+      read(ctx, std::move(packet));
+    }
+  }
   virtual void readEOF(Context* ctx) {
     ctx->fireReadEOF();
   }
@@ -63,6 +71,11 @@ class Handler : public HandlerBase<HandlerContext> {
   }
 
   virtual void write(Context* ctx, std::shared_ptr<DataPacket> packet) = 0;
+  virtual void writeBatch(Context* ctx, PacketBatch packets) {
+    for (std::shared_ptr<DataPacket> &packet : packets) {
+      write(ctx, std::move(packet));
+    }
+  }
   virtual void close(Context* ctx) {
     return ctx->fireClose();
   }
@@ -85,6 +98,13 @@ class InboundHandler : public HandlerBase<InboundHandlerContext> {
   virtual std::string getName() = 0;
 
   virtual void read(Context* ctx, std::shared_ptr<DataPacket> packet) = 0;
+  // Handlers that can amortise their work over several packets override this, the rest process them one by one
+  // and the packets they fire still reach the next handler as a batch
+  virtual void readBatch(Context* ctx, PacketBatch packets) {
+    for (std::shared_ptr<DataPacket> &packet : packets) {
+      read(ctx, std::move(packet));
+    }
+  }
   virtual void readEOF(Context* ctx) {
     ctx->fireReadEOF();
   }
@@ -112,6 +132,11 @@ class OutboundHandler : public HandlerBase<OutboundHandlerContext> {
   virtual std::string getName() = 0;
 
   virtual void write(Context* ctx, std::shared_ptr<DataPacket> packet) = 0;
+  virtual void writeBatch(Context* ctx, PacketBatch packets) {
+    for (std::shared_ptr<DataPacket> &packet : packets) {
+      write(ctx, std::move(packet));
+    }
+  }
   virtual void close(Context* ctx) {
     return ctx->fireClose();
   }
@@ -142,6 +167,14 @@ class HandlerAdapter : public Handler {
     return ctx->fireWrite(std::move(packet));
   }
 
+  void readBatch(Context* ctx, PacketBatch packets) override {
+    ctx->fireReadBatch(std::move(packets));
+  }
+
+  void writeBatch(Context* ctx, PacketBatch packets) override {
+    return ctx->fireWriteBatch(std::move(packets));
+  }
+
   void notifyUpdate() override {
   }
 
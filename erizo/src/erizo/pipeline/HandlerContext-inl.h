@@ -10,7 +10,12 @@
 #ifndef ERIZO_SRC_ERIZO_PIPELINE_HANDLERCONTEXT_INL_H_
 #define ERIZO_SRC_ERIZO_PIPELINE_HANDLERCONTEXT_INL_H_
 
+#include <iterator>
+#include <string>
+#include <utility>
+
 #include "./MediaDefinitions.h"
+#include "thread/HandlerProfiler.h"
 
 namespace erizo {
 
@@ -46,6 +51,7 @@ class InboundLink {
  public:
   virtual ~InboundLink() = default;
   virtual void read(std::shared_ptr<DataPacket> packet) = 0;
+  virtual void readBatch(PacketBatch packets) = 0;
   virtual void readEOF() = 0;
   virtual void transportActive() = 0;
   virtual void transportInactive() = 0;
@@ -55,6 +61,7 @@ class OutboundLink {
  public:
   virtual ~OutboundLink() = default;
   virtual void write(std::shared_ptr<DataPacket> packet) = 0;
+  virtual void writeBatch(PacketBatch packets) = 0;
   virtual void close() = 0;
 };
 
@@ -76,6 +83,7 @@ class ContextImplBase : public PipelineContext {
   }
 
   void notifyUpdate() override {
+    HandlerProfiler::Scope profile{profilerEntry(), HandlerProfiler::kNotifyUpdate};
     handler_->notifyUpdate();
   }
 
@@ -136,12 +144,51 @@ class ContextImplBase : public PipelineContext {
   }
 
  protected:
+  // Entry of the handler in the profiler of the worker running it, looked up again if the stream changes worker
+  HandlerProfiler::Entry* profilerEntry() {
+    HandlerProfiler *profiler = HandlerProfiler::current();
+    if (!profiler) {
+      return nullptr;
+    }
+    if (profiler->getId() != profiler_id_) {
+      profiler_id_ = profiler->getId();
+      profiler_entry_ = profiler->getEntry(handler_->getName());
+    }
+    return profiler_entry_;
+  }
+
+  // While the handler processes a batch, the packets it fires are collected here and reach the next
+  // handler as a single batch once it returns
+  void collect(PacketBatch *batch, std::shared_ptr<DataPacket> packet) {
+    batch->push_back(std::move(packet));
+  }
+
+  void collect(PacketBatch *batch, PacketBatch packets) {
+    if (batch->empty()) {
+      batch->swap(packets);
+      return;
+    }
+    batch->insert(batch->end(), std::make_move_iterator(packets.begin()), std::make_move_iterator(packets.end()));
+  }
+
+  PacketBatch takeBatch(PacketBatch *batch) {
+    PacketBatch packets;
+    packets.swap(*batch);
+    return packets;
+  }
+
   Context* impl_;
   std::weak_ptr<PipelineBase> pipelineWeak_;
   PipelineBase* pipelineRaw_;
   std::shared_ptr<H> handler_;
   InboundLink* nextIn_{nullptr};
   OutboundLink* nextOut_{nullptr};
+  PacketBatch batch_in_;
+  PacketBatch batch_out_;
+  int reading_batch_{0};
+  int writing_batch_{0};
+  uint64_t profiler_id_{0};
+  HandlerProfiler::Entry* profiler_entry_{nullptr};
 
  private:
   bool attached_{false};
@@ -173,11 +220,26 @@ class ContextImpl
   // HandlerContext overrides
   void fireRead(std::shared_ptr<DataPacket> packet) override {
     auto guard = this->pipelineWeak_.lock();
+    if (this->reading_batch_ > 0) {
+      this->collect(&this->batch_in_, std::move(packet));
+      return;
+    }
     if (this->nextIn_) {
       this->nextIn_->read(std::move(packet));
     }
   }
 
+  void fireReadBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    if (this->reading_batch_ > 0) {
+      this->collect(&this->batch_in_, std::move(packets));
+      return;
+    }
+    if (this->nextIn_) {
+      this->nextIn_->readBatch(std::move(packets));
+    }
+  }
+
   void fireReadEOF() override {
     auto guard = this->pipelineWeak_.lock();
     if (this->nextIn_) {
@@ -201,11 +263,26 @@ class ContextImpl
 
   void fireWrite(std::shared_ptr<DataPacket> packet) override {
     auto guard = this->pipelineWeak_.lock();
+    if (this->writing_batch_ > 0) {
+      this->collect(&this->batch_out_, std::move(packet));
+      return;
+    }
     if (this->nextOut_) {
       this->nextOut_->write(std::move(packet));
     }
   }
 
+  void fireWriteBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    if (this->writing_batch_ > 0) {
+      this->collect(&this->batch_out_, std::move(packets));
+      return;
+    }
+    if (this->nextOut_) {
+      this->nextOut_->writeBatch(std::move(packets));
+    }
+  }
+
   void fireClose() override {
     auto guard = this->pipelineWeak_.lock();
     if (this->nextOut_) {
@@ -224,9 +301,27 @@ class ContextImpl
   // InboundLink overrides
   void read(std::shared_ptr<DataPacket> packet) override {
     auto guard = this->pipelineWeak_.lock();
+    HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kRead};
     this->handler_->read(this, std::move(packet));
   }
 
+  void readBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    this->reading_batch_++;
+    {
+      HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kRead};
+      this->handler_->readBatch(this, std::move(packets));
+    }
+    this->reading_batch_--;
+    if (this->reading_batch_ > 0 || this->batch_in_.empty()) {
+      return;
+    }
+    PacketBatch batch = this->takeBatch(&this->batch_in_);
+    if (this->nextIn_) {
+      this->nextIn_->readBatch(std::move(batch));
+    }
+  }
+
   void readEOF() override {
     auto guard = this->pipelineWeak_.lock();
     this->handler_->readEOF(this);
@@ -245,9 +340,27 @@ class ContextImpl
   // OutboundLink overrides
   void write(std::shared_ptr<DataPacket> packet) override {
     auto guard = this->pipelineWeak_.lock();
+    HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kWrite};
     this->handler_->write(this, std::move(packet));
   }
 
+  void writeBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    this->writing_batch_++;
+    {
+      HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kWrite};
+      this->handler_->writeBatch(this, std::move(packets));
+    }
+    this->writing_batch_--;
+    if (this->writing_batch_ > 0 || this->batch_out_.empty()) {
+      return;
+    }
+    PacketBatch batch = this->takeBatch(&this->batch_out_);
+    if (this->nextOut_) {
+      this->nextOut_->writeBatch(std::move(batch));
+    }
+  }
+
   void close() override {
     auto guard = this->pipelineWeak_.lock();
     this->handler_->close(this);
@@ -279,11 +392,26 @@ class InboundContextImpl
   // InboundHandlerContext overrides
   void fireRead(std::shared_ptr<DataPacket> packet) override {
     auto guard = this->pipelineWeak_.lock();
+    if (this->reading_batch_ > 0) {
+      this->collect(&this->batch_in_, std::move(packet));
+      return;
+    }
     if (this->nextIn_) {
       this->nextIn_->read(std::move(packet));
     }
   }
 
+  void fireReadBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    if (this->reading_batch_ > 0) {
+      this->collect(&this->batch_in_, std::move(packets));
+      return;
+    }
+    if (this->nextIn_) {
+      this->nextIn_->readBatch(std::move(packets));
+    }
+  }
+
   void fireReadEOF() override {
     auto guard = this->pipelineWeak_.lock();
     if (this->nextIn_) {
@@ -316,9 +444,27 @@ class InboundContextImpl
   // InboundLink overrides
   void read(std::shared_ptr<DataPacket> packet) override {
     auto guard = this->pipelineWeak_.lock();
+    HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kRead};
     this->handler_->read(this, std::move(packet));
   }
 
+  void readBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    this->reading_batch_++;
+    {
+      HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kRead};
+      this->handler_->readBatch(this, std::move(packets));
+    }
+    this->reading_batch_--;
+    if (this->reading_batch_ > 0 || this->batch_in_.empty()) {
+      return;
+    }
+    PacketBatch batch = this->takeBatch(&this->batch_in_);
+    if (this->nextIn_) {
+      this->nextIn_->readBatch(std::move(batch));
+    }
+  }
+
   void readEOF() override {
     auto guard = this->pipelineWeak_.lock();
     this->handler_->readEOF(this);
@@ -360,11 +506,24 @@ class OutboundContextImpl
   // OutboundHandlerContext overrides
   void fireWrite(std::shared_ptr<DataPacket> packet) override {
     auto guard = this->pipelineWeak_.lock();
+    if (this->writing_batch_ > 0) {
+      return this->collect(&this->batch_out_, std::move(packet));
+    }
     if (this->nextOut_) {
       return this->nextOut_->write(std::move(packet));
     }
   }
 
+  void fireWriteBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    if (this->writing_batch_ > 0) {
+      return this->collect(&this->batch_out_, std::move(packets));
+    }
+    if (this->nextOut_) {
+      return this->nextOut_->writeBatch(std::move(packets));
+    }
+  }
+
   void fireClose() override {
     auto guard = this->pipelineWeak_.lock();
     if (this->nextOut_) {
@@ -383,9 +542,27 @@ class OutboundContextImpl
   // OutboundLink overrides
   void write(std::shared_ptr<DataPacket> packet) override {
     auto guard = this->pipelineWeak_.lock();
+    HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kWrite};
     return this->handler_->write(this, std::move(packet));
   }
 
+  void writeBatch(PacketBatch packets) override {
+    auto guard = this->pipelineWeak_.lock();
+    this->writing_batch_++;
+    {
+      HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kWrite};
+      this->handler_->writeBatch(this, std::move(packets));
+    }
+    this->writing_batch_--;
+    if (this->writing_batch_ > 0 || this->batch_out_.empty()) {
+      return;
+    }
+    PacketBatch batch = this->takeBatch(&this->batch_out_);
+    if (this->nextOut_) {
+      this->nextOut_->writeBatch(std::move(batch));
+    }
+  }
+
   void close() override {
     auto guard = this->pipelineWeak_.lock();
     return this->handler_->close(this);
@@ -11,6 +11,7 @@
 #define ERIZO_SRC_ERIZO_PIPELINE_HANDLERCONTEXT_H_
 
 #include <memory>
+#include <vector>
 
 #include "./MediaDefinitions.h"
 
@@ -18,16 +19,21 @@ namespace erizo {
 
 class PipelineBase;
 
+// Packets drained together, handlers that implement readBatch/writeBatch process them in one call
+using PacketBatch = std::vector<std::shared_ptr<DataPacket>>;
+
 class HandlerContext {
  public:
   virtual ~HandlerContext() = default;
 
   virtual void fireRead(std::shared_ptr<DataPacket> packet) = 0;
+  virtual void fireReadBatch(PacketBatch packets) = 0;
   virtual void fireReadEOF() = 0;
   virtual void fireTransportActive() = 0;
   virtual void fireTransportInactive() = 0;
 
   virtual void fireWrite(std::shared_ptr<DataPacket> packet) = 0;
+  virtual void fireWriteBatch(PacketBatch packets) = 0;
   virtual void fireClose() = 0;
 
   virtual PipelineBase* getPipeline() = 0;
@@ -39,6 +45,7 @@ class InboundHandlerContext {
   virtual ~InboundHandlerContext() = default;
 
   virtual void fireRead(std::shared_ptr<DataPacket> packet) = 0;
+  virtual void fireReadBatch(PacketBatch packets) = 0;
   virtual void fireReadEOF() = 0;
   virtual void fireTransportActive() = 0;
   virtual void fireTransportInactive() = 0;
@@ -52,6 +59,7 @@ class OutboundHandlerContext {
   virtual ~OutboundHandlerContext() = default;
 
   virtual void fireWrite(std::shared_ptr<DataPacket> packet) = 0;
+  virtual void fireWriteBatch(PacketBatch packets) = 0;
   virtual void fireClose() = 0;
 
   virtual PipelineBase* getPipeline() = 0;
@@ -72,6 +72,13 @@ void Pipeline::read(std::shared_ptr<DataPacket> packet) {
   front_->read(std::move(packet));
 }
 
+void Pipeline::readBatch(PacketBatch packets) {
+  if (!front_ || packets.empty()) {
+    return;
+  }
+  front_->readBatch(std::move(packets));
+}
+
 void Pipeline::readEOF() {
   if (!front_) {
     return;
@@ -86,6 +93,13 @@ void Pipeline::write(std::shared_ptr<DataPacket> packet) {
   back_->write(std::move(packet));
 }
 
+void Pipeline::writeBatch(PacketBatch packets) {
+  if (!back_ || packets.empty()) {
+    return;
+  }
+  back_->writeBatch(std::move(packets));
+}
+
 void Pipeline::close() {
   if (!back_) {
     return;
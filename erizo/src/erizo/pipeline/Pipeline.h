@@ -162,6 +162,9 @@ class Pipeline : public PipelineBase {
 
   void read(std::shared_ptr<DataPacket> packet);
 
+  // Pushes several packets through the handlers at once, see Handler::readBatch
+  void readBatch(PacketBatch packets);
+
   void readEOF();
 
   void transportActive();
@@ -170,6 +173,8 @@ class Pipeline : public PipelineBase {
 
   void write(std::shared_ptr<DataPacket> packet);
 
+  void writeBatch(PacketBatch packets);
+
   void close();
 
   void finalize() override;
@@ -0,0 +1,297 @@
+#ifndef ERIZO_SRC_ERIZO_PIPELINE_STATICPIPELINE_H_
+#define ERIZO_SRC_ERIZO_PIPELINE_STATICPIPELINE_H_
+
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "pipeline/Pipeline.h"
+
+namespace erizo {
+
+constexpr size_t kNoNextHandler = std::numeric_limits<size_t>::max();
+
+// Positions of the handlers each one forwards packets to, kNoNextHandler when there is none
+template <class... Handlers>
+struct StaticPipelineLinks {
+  static constexpr size_t kSize = sizeof...(Handlers);
+
+  static constexpr size_t nextIn(size_t from) {
+    constexpr HandlerDir dirs[] = {Handlers::dir...};
+    for (size_t index = from; index < kSize; index++) {
+      if (dirs[index] != HandlerDir::OUT) {
+        return index;
+      }
+    }
+    return kNoNextHandler;
+  }
+
+  static constexpr size_t nextOut(size_t before) {
+    constexpr HandlerDir dirs[] = {Handlers::dir...};
+    for (size_t index = before; index > 0; index--) {
+      if (dirs[index - 1] != HandlerDir::IN) {
+        return index - 1;
+      }
+    }
+    return kNoNextHandler;
+  }
+};
+
+template <class P, class H, class Base, size_t NextIn>
+class StaticInboundContext : public Base {
+ public:
+  // InboundHandlerContext overrides, called by the handler
+  void fireRead(std::shared_ptr<DataPacket> packet) override {
+    typename P::DispatchScope scope{pipeline(), this->pipelineWeak_};
+    if (this->reading_batch_ > 0) {
+      this->collect(&this->batch_in_, std::move(packet));
+      return;
+    }
+    readNext(std::move(packet), HasNextIn());
+  }
+
+  void fireReadBatch(PacketBatch packets) override {
+    typename P::DispatchScope scope{pipeline(), this->pipelineWeak_};
+    if (this->reading_batch_ > 0) {
+      this->collect(&this->batch_in_, std::move(packets));
+      return;
+    }
+    readNextBatch(std::move(packets), HasNextIn());
+  }
+
+  // InboundLink overrides, only Pipeline::read calls them on the first context
+  void read(std::shared_ptr<DataPacket> packet) override {
+    typename P::DispatchScope scope{pipeline(), this->pipelineWeak_};
+    handleRead(std::move(packet));
+  }
+
+  void readBatch(PacketBatch packets) override {
+    typename P::DispatchScope scope{pipeline(), this->pipelineWeak_};
+    handleReadBatch(std::move(packets));
+  }
+
+  // Called by the previous context, H is the exact type of the handler so these calls are not virtual
+  void handleRead(std::shared_ptr<DataPacket> packet) {
+    HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kRead};
+    this->handler_->H::read(this, std::move(packet));
+  }
+
+  void handleReadBatch(PacketBatch packets) {
+    this->reading_batch_++;
+    {
+      HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kRead};
+      this->handler_->H::readBatch(this, std::move(packets));
+    }
+    this->reading_batch_--;
+    if (this->reading_batch_ > 0 || this->batch_in_.empty()) {
+      return;
+    }
+    readNextBatch(this->takeBatch(&this->batch_in_), HasNextIn());
+  }
+
+ private:
+  using HasNextIn = std::integral_constant<bool, (NextIn != kNoNextHandler)>;
+
+  P* pipeline() {
+    return static_cast<P*>(this->pipelineRaw_);
+  }
+
+  void readNext(std::shared_ptr<DataPacket> packet, std::true_type) {
+    pipeline()->template context<NextIn>().handleRead(std::move(packet));
+  }
+
+  void readNext(std::shared_ptr<DataPacket> packet, std::false_type) {
+  }
+
+  void readNextBatch(PacketBatch packets, std::true_type) {
+    pipeline()->template context<NextIn>().handleReadBatch(std::move(packets));
+  }
+
+  void readNextBatch(PacketBatch packets, std::false_type) {
+  }
+};
+
+template <class P, class H, class Base, size_t NextOut>
+class StaticOutboundContext : public Base {
+ public:
+  // OutboundHandlerContext overrides, called by the handler
+  void fireWrite(std::shared_ptr<DataPacket> packet) override {
+    typename P::DispatchScope scope{pipeline(), this->pipelineWeak_};
+    if (this->writing_batch_ > 0) {
+      this->collect(&this->batch_out_, std::move(packet));
+      return;
+    }
+    writeNext(std::move(packet), HasNextOut());
+  }
+
+  void fireWriteBatch(PacketBatch packets) override {
+    typename P::DispatchScope scope{pipeline(), this->pipelineWeak_};
+    if (this->writing_batch_ > 0) {
+      this->collect(&this->batch_out_, std::move(packets));
+      return;
+    }
+    writeNextBatch(std::move(packets), HasNextOut());
+  }
+
+  // OutboundLink overrides, only Pipeline::write calls them on the last context
+  void write(std::shared_ptr<DataPacket> packet) override {
+    typename P::DispatchScope scope{pipeline(), this->pipelineWeak_};
+    handleWrite(std::move(packet));
+  }
+
+  void writeBatch(PacketBatch packets) override {
+    typename P::DispatchScope scope{pipeline(), this->pipelineWeak_};
+    handleWriteBatch(std::move(packets));
+  }
+
+  void handleWrite(std::shared_ptr<DataPacket> packet) {
+    HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kWrite};
+    this->handler_->H::write(this, std::move(packet));
+  }
+
+  void handleWriteBatch(PacketBatch packets) {
+    this->writing_batch_++;
+    {
+      HandlerProfiler::Scope profile{this->profilerEntry(), HandlerProfiler::kWrite};
+      this->handler_->H::writeBatch(this, std::move(packets));
+    }
+    this->writing_batch_--;
+    if (this->writing_batch_ > 0 || this->batch_out_.empty()) {
+      return;
+    }
+    writeNextBatch(this->takeBatch(&this->batch_out_), HasNextOut());
+  }
+
+ private:
+  using HasNextOut = std::integral_constant<bool, (NextOut != kNoNextHandler)>;
+
+  P* pipeline() {
+    return static_cast<P*>(this->pipelineRaw_);
+  }
+
+  void writeNext(std::shared_ptr<DataPacket> packet, std::true_type) {
+    pipeline()->template context<NextOut>().handleWrite(std::move(packet));
+  }
+
+  void writeNext(std::shared_ptr<DataPacket> packet, std::false_type) {
+  }
+
+  void writeNextBatch(PacketBatch packets, std::true_type) {
+    pipeline()->template context<NextOut>().handleWriteBatch(std::move(packets));
+  }
+
+  void writeNextBatch(PacketBatch packets, std::false_type) {
+  }
+};
+
+// Derives from the context Pipeline would use for H, so getHandler<H>(), enable() and the services keep working
+template <class P, class H, size_t NextIn, size_t NextOut>
+class StaticContextImpl final : public std::conditional<
+    H::dir == HandlerDir::BOTH,
+    StaticOutboundContext<P, H, StaticInboundContext<P, H, ContextImpl<H>, NextIn>, NextOut>,
+    typename std::conditional<
+      H::dir == HandlerDir::IN,
+      StaticInboundContext<P, H, InboundContextImpl<H>, NextIn>,
+      StaticOutboundContext<P, H, OutboundContextImpl<H>, NextOut>
+    >::type>::type {
+};
+
+/*
+ * Pipeline whose handlers are fixed at compile time, listed from the front (the one that writes to the
+ * transport) to the back (the one that reads from it), like they end up after the addFront calls of a Pipeline.
+ *
+ * Handlers still call their context virtually, but contexts call the next handler directly and only the
+ * outermost call locks the pipeline, so the compiler can inline the hops between them. Handlers cannot be added
+ * or removed after create().
+ */
+template <class... Handlers>
+class StaticPipeline : public Pipeline {
+  using Links = StaticPipelineLinks<Handlers...>;
+
+  template <size_t I>
+  using HandlerAt = typename std::tuple_element<I, std::tuple<Handlers...>>::type;
+
+  template <class Indices>
+  struct ContextsFor;
+
+  template <size_t... I>
+  struct ContextsFor<std::index_sequence<I...>> {
+    using type = std::tuple<StaticContextImpl<StaticPipeline, HandlerAt<I>, Links::nextIn(I + 1),
+                                              Links::nextOut(I)>...>;
+  };
+
+  using Contexts = typename ContextsFor<std::index_sequence_for<Handlers...>>::type;
+
+ public:
+  using Ptr = std::shared_ptr<StaticPipeline>;
+
+  static constexpr size_t kSize = sizeof...(Handlers);
+
+  // Every handler must be exactly of its listed type, its methods are called without virtual dispatch
+  static Ptr create(std::shared_ptr<Handlers>... handlers) {
+    Ptr pipeline{new StaticPipeline()};
+    pipeline->initialize(std::make_tuple(std::move(handlers)...), std::index_sequence_for<Handlers...>());
+    return pipeline;
+  }
+
+  ~StaticPipeline() {
+    // The contexts are members, so they are detached here instead of in ~Pipeline
+    detachHandlers();
+    ctxs_.clear();
+    inCtxs_.clear();
+    outCtxs_.clear();
+  }
+
+  template <size_t I>
+  typename std::tuple_element<I, Contexts>::type& context() {
+    return std::get<I>(contexts_);
+  }
+
+  // Keeps the pipeline alive while a packet goes through it, locked once per packet instead of once per hop
+  class DispatchScope {
+   public:
+    DispatchScope(StaticPipeline *pipeline, const std::weak_ptr<PipelineBase> &weak_pipeline)
+        : pipeline_{pipeline} {
+      if (pipeline_->dispatch_depth_++ == 0) {
+        guard_ = weak_pipeline.lock();
+      }
+    }
+
+    ~DispatchScope() {
+      pipeline_->dispatch_depth_--;
+    }
+
+   private:
+    StaticPipeline *pipeline_;
+    std::shared_ptr<PipelineBase> guard_;
+  };
+
+ private:
+  StaticPipeline() = default;
+
+  template <size_t... I>
+  void initialize(std::tuple<std::shared_ptr<Handlers>...> handlers, std::index_sequence<I...>) {
+    std::weak_ptr<PipelineBase> weak_this = shared_from_this();
+    int initialized[] = {0, (initializeContext<I>(weak_this, std::move(std::get<I>(handlers))), 0)...};
+    int added[] = {0, (addContextFront(&context<kSize - 1 - I>()), 0)...};
+    (void)initialized;
+    (void)added;
+  }
+
+  template <size_t I>
+  void initializeContext(std::weak_ptr<PipelineBase> weak_this, std::shared_ptr<HandlerAt<I>> handler) {
+    assert(handler && typeid(*handler) == typeid(HandlerAt<I>));
+    context<I>().initialize(weak_this, std::move(handler));
+  }
+
+  Contexts contexts_;
+  int dispatch_depth_{0};
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_PIPELINE_STATICPIPELINE_H_
@@ -0,0 +1,346 @@
+#include "rtp/FecGeneratorHandler.h"
+
+#include <algorithm>
+#include <list>
+#include <vector>
+
+#include "./MediaDefinitions.h"
+#include "./MediaStream.h"
+#include "bandwidth/ConnectionQualityCheck.h"
+#include "rtp/RtpHeaders.h"
+#include "rtp/RtpUtils.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(FecGeneratorHandler, "rtp.FecGeneratorHandler");
+
+constexpr uint8_t FecGeneratorHandler::kMinFractionLost;
+constexpr uint8_t FecGeneratorHandler::kProtectionFactorPerFractionLost;
+constexpr uint8_t FecGeneratorHandler::kMaxProtectionFactor;
+
+static constexpr int kMaxPacketSize = 1500;
+static constexpr int kRedHeaderLength = 1;
+static constexpr int kRtxOsnLength = 2;
+static constexpr int kNackBlpSize = 16;
+
+FecGeneratorHandler::FecGeneratorHandler()
+    : stream_{nullptr}, enabled_{true}, negotiated_{false}, video_sink_ssrc_{0},
+      red_payload_type_{RED_90000_PT}, ulpfec_payload_type_{ULP_90000_PT}, protection_factor_{0},
+      fec_{webrtc::ForwardErrorCorrection::CreateUlpfec()}, media_packets_timestamp_{0},
+      last_protected_sequence_number_{0} {
+}
+
+void FecGeneratorHandler::enable() {
+  enabled_ = true;
+}
+
+void FecGeneratorHandler::disable() {
+  enabled_ = false;
+}
+
+void FecGeneratorHandler::notifyUpdate() {
+  auto pipeline = getContext()->getPipelineShared();
+  if (pipeline && !stream_) {
+    stream_ = pipeline->getService<MediaStream>().get();
+    stats_ = pipeline->getService<Stats>();
+    if (stats_) {
+      stats_->getNode()["total"].insertStat("fecBitrate",
+          MovingIntervalRateStat{std::chrono::milliseconds(100), 30, 8.});
+    }
+  }
+  if (!stream_ || negotiated_) {
+    return;
+  }
+
+  // FEC packets take sequence numbers from the media, so once we start translating them we never stop
+  std::shared_ptr<SdpInfo> remote_sdp = stream_->getRemoteSdpInfo();
+  if (remote_sdp && remote_sdp->supportPayloadType(RED_90000_PT) && remote_sdp->supportPayloadType(ULP_90000_PT)) {
+    video_sink_ssrc_ = stream_->getVideoSinkSSRC();
+    red_payload_type_ = remote_sdp->getVideoExternalPT(RED_90000_PT);
+    ulpfec_payload_type_ = remote_sdp->getVideoExternalPT(ULP_90000_PT);
+    negotiated_ = true;
+  }
+}
+
+void FecGeneratorHandler::notifyEvent(MediaEventPtr event) {
+  if (event->getType() == "VideoFractionLostEvent") {
+    auto fraction_lost_event = std::static_pointer_cast<VideoFractionLostEvent>(event);
+    updateProtectionFactor(fraction_lost_event->fraction_lost);
+  }
+}
+
+void FecGeneratorHandler::updateProtectionFactor(uint8_t fraction_lost) {
+  uint8_t protection_factor = 0;
+  if (fraction_lost >= kMinFractionLost) {
+    protection_factor = std::min(static_cast<int>(kMaxProtectionFactor),
+                                 fraction_lost * kProtectionFactorPerFractionLost);
+  }
+  if (protection_factor != protection_factor_) {
+    ELOG_DEBUG("message: Updating FEC protection, fraction_lost: %u, protection_factor: %u",
+        fraction_lost, protection_factor);
+  }
+  protection_factor_ = protection_factor;
+  if (protection_factor_ == 0) {
+    media_packets_.clear();
+  }
+}
+
+void FecGeneratorHandler::read(Context *ctx, std::shared_ptr<DataPacket> packet) {
+  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
+  if (negotiated_ && chead->isRtcp()) {
+    handleFeedback(packet);
+    if (packet->length == 0) {
+      return;
+    }
+  }
+  ctx->fireRead(std::move(packet));
+}
+
+void FecGeneratorHandler::handleFeedback(std::shared_ptr<DataPacket> packet) {
+  // Handlers before us expect feedback about the sequence numbers they sent, not the ones we generated
+  char translated[sizeof(packet->data)];
+  int translated_length = 0;
+  char *end = packet->data + packet->length;
+  RtpUtils::forEachRtcpBlock(packet, [this, end, &translated, &translated_length](RtcpHeader *chead) {
+    int length = (chead->getLength() + 1) * 4;
+    if (reinterpret_cast<char*>(chead) + length > end) {
+      return;
+    }
+    if (chead->getSourceSSRC() == video_sink_ssrc_) {
+      if (chead->packettype == RTCP_Receiver_PT) {
+        translateReceiverReport(chead);
+      } else if (chead->packettype == RTCP_RTP_Feedback_PT && !chead->isTransportFeedback()) {
+        translated_length += translateNack(chead, translated + translated_length);
+        return;
+      }
+    }
+    memcpy(translated + translated_length, chead, length);
+    translated_length += length;
+  });
+  memcpy(packet->data, translated, translated_length);
+  packet->length = translated_length;
+}
+
+void FecGeneratorHandler::translateReceiverReport(RtcpHeader *chead) {
+  uint16_t incoming_seq_num = chead->getHighestSeqnum();
+  SequenceNumber input_seq_num = translator_.reverse(incoming_seq_num);
+  if (input_seq_num.type != SequenceNumberType::Valid) {
+    return;
+  }
+  if (RtpUtils::sequenceNumberLessThan(input_seq_num.input, incoming_seq_num)) {
+    chead->setSeqnumCycles(chead->getSeqnumCycles() - 1);
+  }
+  chead->setHighestSeqnum(input_seq_num.input);
+}
+
+int FecGeneratorHandler::translateNack(RtcpHeader *chead, char *translated) {
+  // Every lost packet, PID or in the BLP, is translated, losses of FEC packets are left out because only we
+  // could resend them
+  std::vector<uint16_t> lost_seq_nums;
+  RtpUtils::forEachNack(chead, [this, &lost_seq_nums](uint16_t pid, uint16_t blp, RtcpHeader *nack_head) {
+    for (int i = -1; i < kNackBlpSize; i++) {
+      if (i >= 0 && !((blp >> i) & 0x0001)) {
+        continue;
+      }
+      SequenceNumber input_seq_num = translator_.reverse(pid + i + 1);
+      if (input_seq_num.type == SequenceNumberType::Valid) {
+        lost_seq_nums.push_back(input_seq_num.input);
+      }
+    }
+  });
+  if (lost_seq_nums.empty()) {
+    return 0;
+  }
+
+  // Input numbers are never further apart than the output ones, so they fit in the same number of blocks
+  memcpy(translated, chead, kNackCommonHeaderLengthBytes);
+  int length = kNackCommonHeaderLengthBytes;
+  NackBlock *block = nullptr;
+  for (uint16_t seq_num : lost_seq_nums) {
+    if (block) {
+      uint16_t distance = seq_num - block->getNackPid();
+      if (distance == 0) {
+        continue;
+      }
+      if (distance <= kNackBlpSize) {
+        block->setNackBlp(block->getNackBlp() | (1 << (distance - 1)));
+        continue;
+      }
+    }
+    block = reinterpret_cast<NackBlock*>(translated + length);
+    block->setNackPid(seq_num);
+    block->setNackBlp(0);
+    length += sizeof(NackBlock);
+  }
+  reinterpret_cast<RtcpHeader*>(translated)->setLength(length / 4 - 1);
+  return length;
+}
+
+void FecGeneratorHandler::write(Context *ctx, std::shared_ptr<DataPacket> packet) {
+  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
+  if (!negotiated_ || packet->type != VIDEO_PACKET || chead->isRtcp()) {
+    ctx->fireWrite(std::move(packet));
+    return;
+  }
+  if (packet->is_retransmission) {
+    if (translateRetransmission(packet)) {
+      ctx->fireWrite(std::move(packet));
+    }
+    return;
+  }
+
+  RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
+  bool is_protecting = enabled_ && protection_factor_ > 0;
+  // FEC from the publisher does not protect the packets we send, ours replaces it
+  bool should_skip_packet = is_protecting && isUlpfecPacket(packet);
+  SequenceNumber sequence_number = translator_.get(rtp_header->getSeqNumber(), should_skip_packet);
+  if (should_skip_packet || sequence_number.type != SequenceNumberType::Valid) {
+    return;
+  }
+  if (sequence_number.output != sequence_number.input) {
+    // The packet buffer above keeps this same packet, with the number it had
+    packet = DataPacket::create(*packet);
+    reinterpret_cast<RtpHeader*>(packet->data)->setSeqNumber(sequence_number.output);
+  }
+
+  if (!is_protecting || packet->is_padding) {
+    ctx->fireWrite(std::move(packet));
+    return;
+  }
+  protectPacket(ctx, std::move(packet));
+}
+
+bool FecGeneratorHandler::translateRetransmission(std::shared_ptr<DataPacket> packet) {
+  // Retransmissions come from the packet buffer, that keeps the sequence numbers media had before us
+  RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
+  if (rtp_header->getSSRC() == video_sink_ssrc_) {
+    SequenceNumber sequence_number = translator_.get(rtp_header->getSeqNumber());
+    if (sequence_number.type != SequenceNumberType::Valid) {
+      return false;
+    }
+    rtp_header->setSeqNumber(sequence_number.output);
+    return true;
+  }
+  // RTX carries the original sequence number (OSN) in the first bytes of its payload (RFC 4588)
+  int header_length = rtp_header->getHeaderLength();
+  if (rtp_header->getSSRC() != stream_->getVideoSinkRtxSSRC() || header_length + kRtxOsnLength > packet->length) {
+    return true;
+  }
+  uint16_t osn;
+  memcpy(&osn, packet->data + header_length, kRtxOsnLength);
+  SequenceNumber sequence_number = translator_.get(ntohs(osn));
+  if (sequence_number.type != SequenceNumberType::Valid) {
+    return false;
+  }
+  osn = htons(sequence_number.output);
+  memcpy(packet->data + header_length, &osn, kRtxOsnLength);
+  return true;
+}
+
+void FecGeneratorHandler::protectPacket(Context *ctx, std::shared_ptr<DataPacket> packet) {
+  RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
+  uint16_t sequence_number = rtp_header->getSeqNumber();
+  uint32_t timestamp = rtp_header->getTimestamp();
+  bool is_last_packet_of_frame = rtp_header->getMarker();
+
+  // Each FEC block protects packets of a single frame, in ascending order
+  if (!media_packets_.empty() && timestamp != media_packets_timestamp_) {
+    media_packets_.clear();
+  }
+  std::unique_ptr<webrtc::ForwardErrorCorrection::Packet> media_packet = makeMediaPacket(packet);
+  if (!isRedPacket(packet)) {
+    std::shared_ptr<DataPacket> red_packet = RtpUtils::makeRedPacket(packet, red_payload_type_);
+    if (red_packet) {
+      packet = red_packet;
+    } else {
+      // Receivers only keep the media they get in RED to recover packets
+      media_packet.reset();
+    }
+  }
+  if (media_packet && (media_packets_.empty() ||
+      RtpUtils::sequenceNumberLessThan(last_protected_sequence_number_, sequence_number))) {
+    media_packets_timestamp_ = timestamp;
+    last_protected_sequence_number_ = sequence_number;
+    media_packets_.push_back(std::move(media_packet));
+  }
+
+  ctx->fireWrite(packet);
+
+  if (!media_packets_.empty() &&
+      (is_last_packet_of_frame || media_packets_.size() == webrtc::kUlpfecMaxMediaPackets)) {
+    sendFecPackets(ctx, std::move(packet));
+  }
+}
+
+std::unique_ptr<webrtc::ForwardErrorCorrection::Packet> FecGeneratorHandler::makeMediaPacket(
+    std::shared_ptr<DataPacket> packet) {
+  RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
+  int header_length = rtp_header->getHeaderLength();
+  if (header_length >= packet->length) {
+    return nullptr;
+  }
+  std::unique_ptr<webrtc::ForwardErrorCorrection::Packet> media_packet{new webrtc::ForwardErrorCorrection::Packet()};
+  if (!isRedPacket(packet)) {
+    memcpy(media_packet->data, packet->data, packet->length);
+    media_packet->length = packet->length;
+    return media_packet;
+  }
+
+  // Receivers protect what they get after removing the RED header, video only has one block
+  uint8_t block_header = static_cast<uint8_t>(packet->data[header_length]);
+  if (block_header & 0x80) {
+    return nullptr;
+  }
+  memcpy(media_packet->data, packet->data, header_length);
+  memcpy(media_packet->data + header_length, packet->data + header_length + kRedHeaderLength,
+      packet->length - header_length - kRedHeaderLength);
+  media_packet->length = packet->length - kRedHeaderLength;
+  reinterpret_cast<RtpHeader*>(media_packet->data)->setPayloadType(block_header & 0x7F);
+  return media_packet;
+}
+
+void FecGeneratorHandler::sendFecPackets(Context *ctx, std::shared_ptr<DataPacket> last_media_packet) {
+  std::list<webrtc::ForwardErrorCorrection::Packet*> fec_packets;
+  int result = fec_->EncodeFec(media_packets_, protection_factor_, 0, false, webrtc::kFecMaskRandom, &fec_packets);
+  media_packets_.clear();
+  if (result != 0) {
+    ELOG_DEBUG("%s message: Could not generate FEC packets", stream_->toLog());
+    return;
+  }
+
+  // FEC packets go in RED too, with the header of the last media packet they protect
+  RtpHeader *media_header = reinterpret_cast<RtpHeader*>(last_media_packet->data);
+  int header_length = media_header->getHeaderLength();
+  for (webrtc::ForwardErrorCorrection::Packet *fec_packet : fec_packets) {
+    int length = header_length + kRedHeaderLength + fec_packet->length;
+    if (length > kMaxPacketSize) {
+      continue;
+    }
+    auto packet = DataPacket::create(0, last_media_packet->data, header_length, VIDEO_PACKET);
+    packet->data[header_length] = ulpfec_payload_type_;
+    memcpy(packet->data + header_length + kRedHeaderLength, fec_packet->data, fec_packet->length);
+    packet->length = length;
+
+    RtpHeader *fec_header = reinterpret_cast<RtpHeader*>(packet->data);
+    fec_header->setPayloadType(red_payload_type_);
+    fec_header->setMarker(false);
+    fec_header->setPadding(false);
+    fec_header->setSeqNumber(translator_.generate().output);
+    if (stats_) {
+      stats_->getNode()["total"]["fecBitrate"] += packet->length;
+    }
+    ctx->fireWrite(std::move(packet));
+  }
+}
+
+bool FecGeneratorHandler::isRedPacket(std::shared_ptr<DataPacket> packet) {
+  return reinterpret_cast<RtpHeader*>(packet->data)->getPayloadType() == red_payload_type_;
+}
+
+bool FecGeneratorHandler::isUlpfecPacket(std::shared_ptr<DataPacket> packet) {
+  int header_length = reinterpret_cast<RtpHeader*>(packet->data)->getHeaderLength();
+  return isRedPacket(packet) && header_length < packet->length &&
+      (static_cast<uint8_t>(packet->data[header_length]) & 0x7F) == ulpfec_payload_type_;
+}
+
+}  // namespace erizo
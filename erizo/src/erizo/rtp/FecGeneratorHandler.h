@@ -0,0 +1,86 @@
+#ifndef ERIZO_SRC_ERIZO_RTP_FECGENERATORHANDLER_H_
+#define ERIZO_SRC_ERIZO_RTP_FECGENERATORHANDLER_H_
+
+#include <memory>
+#include <string>
+
+#include "./logger.h"
+#include "pipeline/Handler.h"
+#include "rtp/RtpHeaders.h"
+#include "rtp/SequenceNumberTranslator.h"
+#include "./Stats.h"
+
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction.h"
+
+namespace erizo {
+
+class MediaStream;
+
+/*
+ * Protects the video sent to subscribers with ULPFEC (RFC 5109) carried in RED (RFC 2198), so they can recover
+ * losses without waiting for a NACK round trip. The amount of FEC follows the video fraction lost of the connection,
+ * and no FEC is sent while there are no losses. Media packets are wrapped in RED while protecting, and FEC packets
+ * are interleaved in the media sequence number space, so this handler owns a SequenceNumberTranslator.
+ * It goes below RtpRetransmissionHandler, so it is the only place where numbers change: the packet buffer,
+ * retransmissions and every handler above it use the numbers media had before FEC.
+ */
+class FecGeneratorHandler: public Handler {
+  DECLARE_LOGGER();
+
+ public:
+  // Below 1% of losses NACKs are good enough
+  static constexpr uint8_t kMinFractionLost = 1 * 256 / 100;
+  // Roughly the FEC rate webrtc uses for the same losses at medium bitrates
+  static constexpr uint8_t kProtectionFactorPerFractionLost = 3;
+  // Never more than 50% of overhead
+  static constexpr uint8_t kMaxProtectionFactor = 128;
+
+  FecGeneratorHandler();
+
+  void enable() override;
+  void disable() override;
+
+  std::string getName() override {
+    return "fec-generator";
+  }
+
+  void read(Context *ctx, std::shared_ptr<DataPacket> packet) override;
+  void write(Context *ctx, std::shared_ptr<DataPacket> packet) override;
+  void notifyUpdate() override;
+  void notifyEvent(MediaEventPtr event) override;
+
+  uint8_t getProtectionFactor() const {
+    return protection_factor_;
+  }
+
+ private:
+  void updateProtectionFactor(uint8_t fraction_lost);
+  void handleFeedback(std::shared_ptr<DataPacket> packet);
+  void translateReceiverReport(RtcpHeader *chead);
+  int translateNack(RtcpHeader *chead, char *translated);
+  bool translateRetransmission(std::shared_ptr<DataPacket> packet);
+  void protectPacket(Context *ctx, std::shared_ptr<DataPacket> packet);
+  std::unique_ptr<webrtc::ForwardErrorCorrection::Packet> makeMediaPacket(std::shared_ptr<DataPacket> packet);
+  void sendFecPackets(Context *ctx, std::shared_ptr<DataPacket> last_media_packet);
+  bool isRedPacket(std::shared_ptr<DataPacket> packet);
+  bool isUlpfecPacket(std::shared_ptr<DataPacket> packet);
+
+ private:
+  MediaStream *stream_;
+  std::shared_ptr<Stats> stats_;
+  bool enabled_;
+  bool negotiated_;
+  uint32_t video_sink_ssrc_;
+  uint8_t red_payload_type_;
+  uint8_t ulpfec_payload_type_;
+  uint8_t protection_factor_;
+  std::unique_ptr<webrtc::ForwardErrorCorrection> fec_;
+  webrtc::ForwardErrorCorrection::PacketList media_packets_;
+  uint32_t media_packets_timestamp_;
+  uint16_t last_protected_sequence_number_;
+  SequenceNumberTranslator translator_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_RTP_FECGENERATORHANDLER_H_
@@ -36,12 +36,18 @@ void LayerDetectorHandler::disable() {
 void LayerDetectorHandler::read(Context *ctx, std::shared_ptr<DataPacket> packet) {
   RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
   if (!chead->isRtcp() && enabled_ && packet->type == VIDEO_PACKET) {
-    if (packet->codec == "VP8") {
-      parseLayerInfoFromVP8(packet);
-    } else if (packet->codec == "VP9") {
-      parseLayerInfoFromVP9(packet);
-    } else if (packet->codec == "H264") {
-      parseLayerInfoFromH264(packet);
+    switch (packet->codec) {
+      case kVP8Codec:
+        parseLayerInfoFromVP8(packet);
+        break;
+      case kVP9Codec:
+        parseLayerInfoFromVP9(packet);
+        break;
+      case kH264Codec:
+        parseLayerInfoFromH264(packet);
+        break;
+      default:
+        break;
     }
   }
   ctx->fireRead(std::move(packet));
@@ -95,7 +101,7 @@ void LayerDetectorHandler::parseLayerInfoFromVP8(std::shared_ptr<DataPacket> pac
   if (payload->hasTl0PicIdx) {
     packet->tl0_pic_idx = payload->tl0PicIdx;
   }
-  packet->compatible_temporal_layers = {};
+  packet->compatible_temporal_layers.clear();
   switch (payload->tID) {
     case 0: addTemporalLayerAndCalculateRate(packet, 0, payload->beginningOfPartition);
     case 1: addTemporalLayerAndCalculateRate(packet, 1, payload->beginningOfPartition);
@@ -129,7 +135,7 @@ void LayerDetectorHandler::addTemporalLayerAndCalculateRate(const std::shared_pt
   if (new_frame) {
     video_frame_rate_list_[temporal_layer]++;
   }
-  packet->compatible_temporal_layers.push_back(temporal_layer);
+  packet->compatible_temporal_layers.add(temporal_layer);
 }
 
 void LayerDetectorHandler::parseLayerInfoFromVP9(std::shared_ptr<DataPacket> packet) {
@@ -145,12 +151,12 @@ void LayerDetectorHandler::parseLayerInfoFromVP9(std::shared_ptr<DataPacket> pac
 
   int spatial_layer = payload->spatialID;
 
-  packet->compatible_spatial_layers = {};
+  packet->compatible_spatial_layers.clear();
   for (int i = 5; i >= spatial_layer; i--) {
-    packet->compatible_spatial_layers.push_back(i);
+    packet->compatible_spatial_layers.add(i);
   }
 
-  packet->compatible_temporal_layers = {};
+  packet->compatible_temporal_layers.clear();
   switch (payload->temporalID) {
     case 0: addTemporalLayerAndCalculateRate(packet, 0, payload->beginningOfLayerFrame);
     case 2: addTemporalLayerAndCalculateRate(packet, 1, payload->beginningOfLayerFrame);
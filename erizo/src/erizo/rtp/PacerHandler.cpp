@@ -0,0 +1,181 @@
+#include "rtp/PacerHandler.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "./MediaDefinitions.h"
+#include "./WebRtcConnection.h"
+#include "./Stats.h"
+#include "lib/ClockUtils.h"
+#include "lib/WebRtcClock.h"
+#include "rtp/RtpHeaders.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(PacerHandler, "rtp.PacerHandler");
+
+constexpr uint32_t PacerHandler::kStartBitrate;
+constexpr uint32_t PacerHandler::kMinSendBitrate;
+constexpr duration PacerHandler::kEstimateUpdatePeriod;
+constexpr uint32_t PacerHandler::kQueueDelayWindow;
+
+PacerHandler::PacerHandler(std::shared_ptr<erizo::Clock> the_clock)
+    : enabled_{true}, initialized_{false}, clock_{the_clock},
+      webrtc_clock_{new WebRtcClock(the_clock)},
+      pacer_{new webrtc::PacedSender(webrtc_clock_.get(), this)},
+      connection_{nullptr}, next_order_{0}, process_scheduled_{false}, last_estimate_update_{clock_->now()},
+      estimated_bitrate_{kStartBitrate} {
+  // Probing needs padding, which MediaStreams generate on their own
+  pacer_->SetProbingEnabled(false);
+  pacer_->SetEstimatedBitrate(kStartBitrate);
+  pacer_->SetSendBitrateLimits(kMinSendBitrate, 0);
+}
+
+PacerHandler::~PacerHandler() {
+}
+
+void PacerHandler::enable() {
+  enabled_ = true;
+}
+
+void PacerHandler::disable() {
+  enabled_ = false;
+  flushQueue();
+}
+
+void PacerHandler::notifyUpdate() {
+  if (initialized_) {
+    return;
+  }
+  auto pipeline = getContext()->getPipelineShared();
+  if (!pipeline) {
+    return;
+  }
+  connection_ = pipeline->getService<WebRtcConnection>().get();
+  stats_ = pipeline->getService<Stats>();
+  if (!connection_ || !stats_) {
+    return;
+  }
+  queue_delay_stat_ = stats_->getNode()["total"].getOrInsertStat("pacerQueueDelay",
+      MovingAverageStat{kQueueDelayWindow});
+  queued_packets_stat_ = stats_->getNode()["total"].getOrInsertStat("pacerQueuedPackets", CumulativeStat{0});
+  initialized_ = true;
+}
+
+void PacerHandler::write(Context *ctx, std::shared_ptr<DataPacket> packet) {
+  RtcpHeader *chead = reinterpret_cast<RtcpHeader*>(packet->data);
+  if (!enabled_ || !initialized_ || packet->length <= 0 || chead->isRtcp()) {
+    ctx->fireWrite(std::move(packet));
+    return;
+  }
+  RtpHeader *head = reinterpret_cast<RtpHeader*>(packet->data);
+  uint32_t ssrc = head->getSSRC();
+  uint16_t sequence_number = head->getSeqNumber();
+  uint64_t key = getKey(ssrc, sequence_number);
+  if (queued_packets_.find(key) != queued_packets_.end()) {
+    // PacedSender drops it too, the queued copy is sent anyway
+    return;
+  }
+
+  webrtc::RtpPacketSender::Priority priority = webrtc::RtpPacketSender::kNormalPriority;
+  if (packet->type == AUDIO_PACKET) {
+    priority = webrtc::RtpPacketSender::kHighPriority;
+  } else if (packet->is_padding) {
+    priority = webrtc::RtpPacketSender::kLowPriority;
+  }
+  size_t length = packet->length;
+  bool retransmission = packet->is_retransmission;
+  queued_packets_.emplace(key, QueuedPacket{std::move(packet), clock_->now(), next_order_++});
+
+  updateEstimatedBitrate();
+  pacer_->InsertPacket(priority, ssrc, sequence_number, -1, length, retransmission);
+  process();
+}
+
+bool PacerHandler::TimeToSendPacket(uint32_t ssrc, uint16_t sequence_number, int64_t capture_time_ms,
+                                    bool retransmission, int probe_cluster_id) {
+  auto queued_packet = queued_packets_.find(getKey(ssrc, sequence_number));
+  if (queued_packet == queued_packets_.end()) {
+    // Already sent when the pacer was disabled
+    return true;
+  }
+  *queue_delay_stat_ += ClockUtils::durationToMs(clock_->now() - queued_packet->second.queued_at);
+  released_packets_.push_back(std::move(queued_packet->second.packet));
+  queued_packets_.erase(queued_packet);
+  return true;
+}
+
+size_t PacerHandler::TimeToSendPadding(size_t bytes, int probe_cluster_id) {
+  return 0;
+}
+
+void PacerHandler::process() {
+  pacer_->Process();
+  *queued_packets_stat_ = queued_packets_.size();
+  if (released_packets_.size() == 1) {
+    getContext()->fireWrite(std::move(released_packets_.front()));
+  } else if (!released_packets_.empty()) {
+    getContext()->fireWriteBatch(std::move(released_packets_));
+  }
+  released_packets_.clear();
+  scheduleProcess();
+}
+
+void PacerHandler::scheduleProcess() {
+  if (process_scheduled_ || queued_packets_.empty()) {
+    return;
+  }
+  process_scheduled_ = true;
+  duration delay = std::chrono::milliseconds(std::max<int64_t>(pacer_->TimeUntilNextProcess(), 1));
+  std::weak_ptr<PacerHandler> weak_this = shared_from_this();
+  connection_->getWorker()->scheduleFromNow([weak_this] {
+    if (auto this_ptr = weak_this.lock()) {
+      this_ptr->process_scheduled_ = false;
+      this_ptr->updateEstimatedBitrate();
+      this_ptr->process();
+    }
+  }, delay);
+}
+
+void PacerHandler::updateEstimatedBitrate() {
+  time_point now = clock_->now();
+  if (now - last_estimate_update_ < kEstimateUpdatePeriod) {
+    return;
+  }
+  last_estimate_update_ = now;
+  StatNode &total = stats_->getNode()["total"];
+  if (!total.hasChild("senderBitrateEstimation")) {
+    return;
+  }
+  uint32_t estimated_bitrate = total["senderBitrateEstimation"].value();
+  if (estimated_bitrate == 0 || estimated_bitrate == estimated_bitrate_) {
+    return;
+  }
+  estimated_bitrate_ = estimated_bitrate;
+  pacer_->SetEstimatedBitrate(estimated_bitrate_);
+}
+
+void PacerHandler::flushQueue() {
+  if (queued_packets_.empty()) {
+    return;
+  }
+  ELOG_DEBUG("%s message: Sending queued packets without pacing, count: %lu", connection_->toLog(),
+             queued_packets_.size());
+  std::vector<QueuedPacket*> in_order;
+  for (auto &queued_packet : queued_packets_) {
+    in_order.push_back(&queued_packet.second);
+  }
+  std::sort(in_order.begin(), in_order.end(), [](const QueuedPacket *first, const QueuedPacket *second) {
+    return first->order < second->order;
+  });
+  PacketBatch packets;
+  for (QueuedPacket *queued_packet : in_order) {
+    packets.push_back(std::move(queued_packet->packet));
+  }
+  queued_packets_.clear();
+  *queued_packets_stat_ = 0;
+  getContext()->fireWriteBatch(std::move(packets));
+}
+
+}  // namespace erizo
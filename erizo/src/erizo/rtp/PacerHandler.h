@@ -0,0 +1,93 @@
+#ifndef ERIZO_SRC_ERIZO_RTP_PACERHANDLER_H_
+#define ERIZO_SRC_ERIZO_RTP_PACERHANDLER_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "./logger.h"
+#include "pipeline/Handler.h"
+#include "thread/Worker.h"
+#include "lib/Clock.h"
+#include "stats/StatNode.h"
+
+#include "webrtc/modules/pacing/paced_sender.h"
+
+namespace erizo {
+
+class WebRtcConnection;
+class Stats;
+
+/*
+ * Smooths the RTP packets a connection sends to the estimated bandwidth, so a burst like a keyframe going to
+ * many subscribers does not overflow the queues of constrained links. It uses webrtc's PacedSender to decide
+ * when each packet is sent: audio goes out right away, retransmissions before the rest of the video and
+ * padding last. RTCP is never delayed.
+ */
+class PacerHandler : public OutboundHandler, public webrtc::PacedSender::PacketSender,
+                     public std::enable_shared_from_this<PacerHandler> {
+  DECLARE_LOGGER();
+
+ public:
+  static constexpr uint32_t kStartBitrate = 300000;
+  static constexpr uint32_t kMinSendBitrate = 30000;
+  static constexpr duration kEstimateUpdatePeriod = std::chrono::milliseconds(100);
+  static constexpr uint32_t kQueueDelayWindow = 100;
+
+ public:
+  explicit PacerHandler(std::shared_ptr<erizo::Clock> the_clock = std::make_shared<SteadyClock>());
+  ~PacerHandler();
+
+  void enable() override;
+  void disable() override;
+
+  std::string getName() override {
+    return "pacer";
+  }
+
+  void write(Context *ctx, std::shared_ptr<DataPacket> packet) override;
+  void notifyUpdate() override;
+
+  // webrtc::PacedSender::PacketSender, called from PacedSender::Process()
+  bool TimeToSendPacket(uint32_t ssrc, uint16_t sequence_number, int64_t capture_time_ms, bool retransmission,
+                        int probe_cluster_id) override;
+  size_t TimeToSendPadding(size_t bytes, int probe_cluster_id) override;
+
+ private:
+  struct QueuedPacket {
+    std::shared_ptr<DataPacket> packet;
+    time_point queued_at;
+    uint64_t order;
+  };
+
+  static uint64_t getKey(uint32_t ssrc, uint16_t sequence_number) {
+    return (static_cast<uint64_t>(ssrc) << 16) | sequence_number;
+  }
+
+  void process();
+  void scheduleProcess();
+  void updateEstimatedBitrate();
+  void flushQueue();
+
+ private:
+  bool enabled_;
+  bool initialized_;
+  std::shared_ptr<erizo::Clock> clock_;
+  std::unique_ptr<webrtc::Clock> webrtc_clock_;
+  std::unique_ptr<webrtc::PacedSender> pacer_;
+  WebRtcConnection *connection_;
+  std::shared_ptr<Stats> stats_;
+  std::shared_ptr<MovingAverageStat> queue_delay_stat_;
+  std::shared_ptr<CumulativeStat> queued_packets_stat_;
+  std::unordered_map<uint64_t, QueuedPacket> queued_packets_;
+  // Packets the pacer releases during a process() call, fired together once it returns
+  PacketBatch released_packets_;
+  uint64_t next_order_;
+  bool process_scheduled_;
+  time_point last_estimate_update_;
+  uint32_t estimated_bitrate_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_RTP_PACERHANDLER_H_
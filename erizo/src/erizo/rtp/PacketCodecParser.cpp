@@ -8,6 +8,7 @@ DEFINE_LOGGER(PacketCodecParser, "rtp.PacketCodecParser");
 
 PacketCodecParser::PacketCodecParser() :
     stream_ { nullptr }, enabled_ { true }, initialized_ { false } {
+  interned_codecs_.fill(InternedCodec{nullptr, kUnknownCodec});
 }
 
 void PacketCodecParser::enable() {
@@ -26,15 +27,26 @@ void PacketCodecParser::read(Context *ctx, std::shared_ptr<DataPacket> packet) {
         stream_->getRemoteSdpInfo()->getCodecByExternalPayloadType(
             rtp_header->getPayloadType());
     if (codec) {
-      packet->codec = codec->encoding_name;
+      packet->codec = getCodecId(codec);
       packet->clock_rate = codec->clock_rate;
-      ELOG_DEBUG("Reading codec: %s, clock: %u", packet->codec.c_str(), packet->clock_rate);
+      ELOG_DEBUG("Reading codec: %s, clock: %u", codec->encoding_name.c_str(), packet->clock_rate);
     }
   }
   ctx->fireRead(std::move(packet));
 }
 
+CodecId PacketCodecParser::getCodecId(const RtpMap *codec) {
+  InternedCodec &interned = interned_codecs_[codec->payload_type & 0x7F];
+  if (interned.codec != codec) {
+    interned.codec = codec;
+    interned.id = CodecRegistry::intern(codec->encoding_name);
+  }
+  return interned.id;
+}
+
 void PacketCodecParser::notifyUpdate() {
+  // Remote SDP might have changed
+  interned_codecs_.fill(InternedCodec{nullptr, kUnknownCodec});
   if (initialized_) {
     return;
   }
@@ -1,12 +1,16 @@
 #ifndef ERIZO_SRC_ERIZO_RTP_PACKETCODECPARSER_H_
 #define ERIZO_SRC_ERIZO_RTP_PACKETCODECPARSER_H_
 
+#include <array>
+
 #include "./logger.h"
+#include "lib/CodecRegistry.h"
 #include "pipeline/Handler.h"
 
 namespace erizo {
 
 class MediaStream;
+struct RtpMap;
 
 class PacketCodecParser: public InboundHandler {
   DECLARE_LOGGER();
@@ -26,9 +30,19 @@ class PacketCodecParser: public InboundHandler {
   void notifyUpdate() override;
 
  private:
+  CodecId getCodecId(const RtpMap *codec);
+
+ private:
+  struct InternedCodec {
+    const RtpMap *codec;
+    CodecId id;
+  };
+
   MediaStream *stream_;
   bool enabled_;
   bool initialized_;
+  // Interned codec of each payload type, valid while it was resolved from the same RtpMap
+  std::array<InternedCodec, 128> interned_codecs_;
 };
 }  // namespace erizo
 
@@ -115,7 +115,7 @@ void QualityFilterHandler::detectVideoScalability(const std::shared_ptr<DataPack
 }
 
 void QualityFilterHandler::updatePictureID(const std::shared_ptr<DataPacket> &packet, int new_picture_id) {
-  if (packet->codec == "VP8") {
+  if (packet->codec == kVP8Codec) {
     RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
     unsigned char* start_buffer = reinterpret_cast<unsigned char*> (packet->data);
     start_buffer = start_buffer + rtp_header->getHeaderLength();
@@ -124,7 +124,7 @@ void QualityFilterHandler::updatePictureID(const std::shared_ptr<DataPacket> &pa
 }
 
 void QualityFilterHandler::updateTL0PicIdx(const std::shared_ptr<DataPacket> &packet, uint8_t new_tl0_pic_idx) {
-  if (packet->codec == "VP8") {
+  if (packet->codec == kVP8Codec) {
     RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
     unsigned char* start_buffer = reinterpret_cast<unsigned char*> (packet->data);
     start_buffer = start_buffer + rtp_header->getHeaderLength();
@@ -133,7 +133,7 @@ void QualityFilterHandler::updateTL0PicIdx(const std::shared_ptr<DataPacket> &pa
 }
 
 void QualityFilterHandler::removeVP8OptionalPayload(const std::shared_ptr<DataPacket> &packet) {
-  if (packet->codec == "VP8") {
+  if (packet->codec == kVP8Codec) {
     RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
     unsigned char* start_buffer = reinterpret_cast<unsigned char*> (packet->data);
     start_buffer = start_buffer + rtp_header->getHeaderLength();
@@ -203,7 +203,7 @@ void QualityFilterHandler::write(Context *ctx, std::shared_ptr<DataPacket> packe
       return;
     }
 
-    if (packet->compatible_spatial_layers.back() == target_spatial_layer_ && packet->ending_of_layer_frame) {
+    if (packet->compatible_spatial_layers.lowest() == target_spatial_layer_ && packet->ending_of_layer_frame) {
       rtp_header->setMarker(1);
     }
 
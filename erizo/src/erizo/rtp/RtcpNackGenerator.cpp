@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <cstdlib>
+#include <limits>
 #include "rtp/RtcpNackGenerator.h"
 #include "rtp/RtpUtils.h"
 
@@ -9,10 +11,15 @@ DEFINE_LOGGER(RtcpNackGenerator, "rtp.RtcpNackGenerator");
 static const int kMaxRetransmits = 2;
 static const int kMaxNacks = 150;
 static const int kMinNackDelayMs = 20;
+static const int kMaxNackDelayMs = 500;
 static const int kNackCommonHeaderLengthRtcp = kNackCommonHeaderLengthBytes/4 - 1;
+static const uint16_t kNackBlpSize = 16;
+
+constexpr uint16_t RtcpNackGenerator::kNackRingSize;
 
 RtcpNackGenerator::RtcpNackGenerator(uint32_t ssrc, std::shared_ptr<Clock> the_clock) :
-  initialized_{false}, highest_seq_num_{0}, ssrc_{ssrc}, clock_{the_clock} {}
+  initialized_{false}, highest_seq_num_{0}, ssrc_{ssrc}, pending_nacks_{}, nack_count_{0}, rtt_ms_{0},
+  next_nack_time_ms_{0}, clock_{the_clock} {}
 
 bool RtcpNackGenerator::handleRtpPacket(std::shared_ptr<DataPacket> packet) {
   if (packet->type != VIDEO_PACKET) {
@@ -36,80 +43,146 @@ bool RtcpNackGenerator::handleRtpPacket(std::shared_ptr<DataPacket> packet) {
   if (RtpUtils::sequenceNumberLessThan(seq_num, highest_seq_num_)) {
     ELOG_DEBUG("message: packet out of order, ssrc: %u, seq_num: %u, highest_seq_num: %u",
         seq_num, highest_seq_num_, ssrc_);
-    //  Look for it in nack list, remove it if its there
-    auto nack_info = std::find_if(nack_info_list_.begin(), nack_info_list_.end(),
-        [seq_num](NackInfo& current_nack) {
-        return (current_nack.seq_num == seq_num);
-        });
-    if (nack_info != nack_info_list_.end()) {
+    // Slots keep the NackInfo after we give up on it, so late retransmissions still tell us the RTT
+    NackInfo& nack_info = nack_infos_[seq_num % kNackRingSize];
+    uint64_t now_ms = ClockUtils::timePointToMs(clock_->now());
+    if (nack_info.seq_num == seq_num && nack_info.retransmits > 0 && now_ms - nack_info.sent_time <= kMaxNackDelayMs) {
+      updateRtt(nack_info, now_ms);
+      nack_info.retransmits = 0;
+    }
+    if (isNackPending(seq_num)) {
       ELOG_DEBUG("message: Recovered Packet %u", seq_num);
-      nack_info_list_.erase(nack_info);
+      removeNack(seq_num);
     }
     return false;
   }
-  bool available_nacks = addNacks(seq_num);
-  highest_seq_num_ = seq_num;
-  return available_nacks;
+  return addNacks(seq_num);
 }
 
 bool RtcpNackGenerator::addNacks(uint16_t seq_num) {
-  for (uint16_t current_seq_num = highest_seq_num_ + 1; current_seq_num != seq_num; current_seq_num++) {
+  // Slots up to the new highest sequence number held older ones, they are now too old to be nacked
+  uint16_t gap = seq_num - highest_seq_num_;
+  uint16_t slots_to_clear = std::min(gap, kNackRingSize);
+  uint16_t last_seq_num_to_clear = seq_num + 1;
+  for (uint16_t current_seq_num = seq_num - slots_to_clear + 1; current_seq_num != last_seq_num_to_clear;
+       current_seq_num++) {
+    uint16_t index = current_seq_num % kNackRingSize;
+    if (pending_nacks_[index / 64] & (uint64_t{1} << (index % 64))) {
+      removeNack(nack_infos_[index].seq_num);
+    }
+  }
+  uint16_t first_lost_seq_num = gap > kMaxNacks ? seq_num - kMaxNacks : highest_seq_num_ + 1;
+  for (uint16_t current_seq_num = first_lost_seq_num; current_seq_num != seq_num; current_seq_num++) {
     ELOG_DEBUG("message: Inserting a new Nack in list, ssrc: %u, seq_num: %u", ssrc_, current_seq_num);
-    nack_info_list_.push_back(NackInfo{current_seq_num});
+    uint16_t index = current_seq_num % kNackRingSize;
+    nack_infos_[index] = NackInfo{current_seq_num};
+    pending_nacks_[index / 64] |= uint64_t{1} << (index % 64);
+    nack_count_++;
+    next_nack_time_ms_ = 0;
+  }
+  highest_seq_num_ = seq_num;
+  // The oldest ones are the least likely to arrive in time
+  while (nack_count_ > kMaxNacks) {
+    removeNack(nextNack(highest_seq_num_ - kNackRingSize + 1));
+  }
+  return nack_count_ > 0;
+}
+
+bool RtcpNackGenerator::isNackPending(uint16_t seq_num) const {
+  uint16_t index = seq_num % kNackRingSize;
+  return (pending_nacks_[index / 64] & (uint64_t{1} << (index % 64))) && nack_infos_[index].seq_num == seq_num;
+}
+
+void RtcpNackGenerator::removeNack(uint16_t seq_num) {
+  uint16_t index = seq_num % kNackRingSize;
+  pending_nacks_[index / 64] &= ~(uint64_t{1} << (index % 64));
+  nack_count_--;
+}
+
+uint16_t RtcpNackGenerator::nextNack(uint16_t seq_num) const {
+  // Returns the first pending sequence number from seq_num on, or highest_seq_num_ if there are none
+  while (RtpUtils::sequenceNumberLessThan(seq_num, highest_seq_num_)) {
+    uint16_t index = seq_num % kNackRingSize;
+    uint64_t pending = pending_nacks_[index / 64] >> (index % 64);
+    if (pending != 0) {
+      uint16_t next_seq_num = seq_num + __builtin_ctzll(pending);
+      return RtpUtils::sequenceNumberLessThan(next_seq_num, highest_seq_num_) ? next_seq_num : highest_seq_num_;
+    }
+    seq_num += 64 - index % 64;
   }
-  while (nack_info_list_.size() > kMaxNacks) {
-     nack_info_list_.erase(nack_info_list_.end() - 1);
+  return highest_seq_num_;
+}
+
+void RtcpNackGenerator::updateRtt(const NackInfo& nack_info, uint64_t current_time_ms) {
+  // Packets nacked more than once may answer any of the NACKs, we pick the one closer to the estimate. Without an
+  // estimate we assume the first one, otherwise RTTs longer than kMinNackDelayMs could never be measured
+  uint64_t sample_ms = current_time_ms - nack_info.first_sent_time;
+  uint64_t last_sample_ms = current_time_ms - nack_info.sent_time;
+  if (rtt_ms_ != 0 && std::abs(static_cast<int64_t>(last_sample_ms - rtt_ms_)) <
+      std::abs(static_cast<int64_t>(sample_ms - rtt_ms_))) {
+    sample_ms = last_sample_ms;
   }
-  return !nack_info_list_.empty();
+  rtt_ms_ = rtt_ms_ == 0 ? sample_ms : (7 * rtt_ms_ + sample_ms) / 8;
+  next_nack_time_ms_ = 0;
 }
 
 bool RtcpNackGenerator::addNackPacketToRr(std::shared_ptr<DataPacket> rr_packet) {
-  // Goes through the list adds blocks of 16 in compound packets (adds more PID/BLP blocks) max is 10 blocks
-  // Only does it if it's time (> 100 ms since last NACK)
-  std::vector <NackBlock> nack_vector;
-  ELOG_DEBUG("message: Adding nacks to RR, nack_info_list_.size(): %lu", nack_info_list_.size());
+  // Goes through the pending nacks and adds blocks of 16 in compound packets (adds more PID/BLP blocks)
+  // Only does it if it's time (> 1 RTT since the last NACK)
   uint64_t now_ms = ClockUtils::timePointToMs(clock_->now());
-  for (uint16_t index = 0; index < nack_info_list_.size(); index++) {
-    NackInfo& base_nack_info = nack_info_list_[index];
+  if (now_ms < next_nack_time_ms_) {
+    return false;
+  }
+  std::vector <NackBlock> nack_vector;
+  ELOG_DEBUG("message: Adding nacks to RR, nack_count_: %u", nack_count_);
+  uint64_t nack_delay_ms = getNackDelayMs();
+  next_nack_time_ms_ = std::numeric_limits<uint64_t>::max();
+  uint16_t window_start = highest_seq_num_ - kNackRingSize + 1;
+  for (uint16_t seq_num = nextNack(window_start); seq_num != highest_seq_num_; seq_num = nextNack(seq_num + 1)) {
+    NackInfo& base_nack_info = nack_infos_[seq_num % kNackRingSize];
     if (!isTimeToRetransmit(base_nack_info, now_ms)) {
       ELOG_DEBUG("It's not time to retransmit %lu, now %lu, diff %lu", base_nack_info.sent_time, now_ms,
           now_ms - base_nack_info.sent_time);
+      next_nack_time_ms_ = std::min(next_nack_time_ms_, base_nack_info.sent_time + nack_delay_ms + 1);
       continue;
     }
     if (base_nack_info.retransmits >= kMaxRetransmits) {
       ELOG_DEBUG("message: Removing Nack in list too many retransmits, ssrc: %u, seq_num: %u",
           ssrc_, base_nack_info.seq_num);
-        nack_info_list_.erase(nack_info_list_.begin() + index);
-        index--;  // Items are moved in the list so the next element has the current index
-        continue;
+      removeNack(seq_num);
+      continue;
     }
     ELOG_DEBUG("message: PID, seq_num %u", base_nack_info.seq_num);
     uint16_t pid = base_nack_info.seq_num;
     uint16_t blp = 0;
+    if (base_nack_info.retransmits == 0) {
+      base_nack_info.first_sent_time = now_ms;
+    }
     base_nack_info.sent_time = now_ms;
     base_nack_info.retransmits++;
-    while (index + 1u < nack_info_list_.size()) {
-      NackInfo& blp_nack_info = nack_info_list_[index + 1];
-      uint16_t distance = blp_nack_info.seq_num - pid -1;
-      if (distance <= 15) {
-        if (!isTimeToRetransmit(blp_nack_info, now_ms)) {
-          index++;
-          continue;
-        }
-        if (blp_nack_info.retransmits >= kMaxRetransmits) {
-          ELOG_DEBUG("message: Removing Nack in list too many retransmits, ssrc: %u, seq_num: %u",
-              ssrc_, blp_nack_info.seq_num);
-          nack_info_list_.erase(nack_info_list_.begin() + index + 1);
-          continue;
-        }
-        ELOG_DEBUG("message: Adding Nack to BLP, seq_num: %u", blp_nack_info.seq_num);
-        blp |= (1 << distance);
-        blp_nack_info.sent_time = now_ms;
-        blp_nack_info.retransmits++;
-        index++;
-      } else {
-        break;
+    next_nack_time_ms_ = std::min(next_nack_time_ms_, now_ms + nack_delay_ms + 1);
+    for (uint16_t blp_seq_num = nextNack(pid + 1);
+         blp_seq_num != highest_seq_num_ && static_cast<uint16_t>(blp_seq_num - pid - 1) < kNackBlpSize;
+         blp_seq_num = nextNack(blp_seq_num + 1)) {
+      seq_num = blp_seq_num;
+      NackInfo& blp_nack_info = nack_infos_[blp_seq_num % kNackRingSize];
+      if (!isTimeToRetransmit(blp_nack_info, now_ms)) {
+        next_nack_time_ms_ = std::min(next_nack_time_ms_, blp_nack_info.sent_time + nack_delay_ms + 1);
+        continue;
+      }
+      if (blp_nack_info.retransmits >= kMaxRetransmits) {
+        ELOG_DEBUG("message: Removing Nack in list too many retransmits, ssrc: %u, seq_num: %u",
+            ssrc_, blp_nack_info.seq_num);
+        removeNack(blp_seq_num);
+        continue;
       }
+      ELOG_DEBUG("message: Adding Nack to BLP, seq_num: %u", blp_nack_info.seq_num);
+      blp |= (1 << static_cast<uint16_t>(blp_seq_num - pid - 1));
+      if (blp_nack_info.retransmits == 0) {
+        blp_nack_info.first_sent_time = now_ms;
+      }
+      blp_nack_info.sent_time = now_ms;
+      blp_nack_info.retransmits++;
     }
     NackBlock block;
     block.setNackPid(pid);
@@ -140,7 +213,12 @@ bool RtcpNackGenerator::addNackPacketToRr(std::shared_ptr<DataPacket> rr_packet)
 }
 
 bool RtcpNackGenerator::isTimeToRetransmit(const NackInfo& nack_info, uint64_t current_time_ms) {
-  return (nack_info.sent_time == 0 || (current_time_ms - nack_info.sent_time) > kMinNackDelayMs);
+  return (nack_info.sent_time == 0 || (current_time_ms - nack_info.sent_time) > getNackDelayMs());
+}
+
+uint64_t RtcpNackGenerator::getNackDelayMs() const {
+  // Resending before the retransmission had time to arrive only wastes bandwidth
+  return std::min(std::max(rtt_ms_, static_cast<uint64_t>(kMinNackDelayMs)), static_cast<uint64_t>(kMaxNackDelayMs));
 }
 
 }  // namespace erizo
@@ -1,6 +1,7 @@
 #ifndef ERIZO_SRC_ERIZO_RTP_RTCPNACKGENERATOR_H_
 #define ERIZO_SRC_ERIZO_RTP_RTCPNACKGENERATOR_H_
 
+#include <array>
 #include <memory>
 #include <string>
 #include <map>
@@ -15,32 +16,57 @@ namespace erizo {
 
 class NackInfo {
  public:
-  NackInfo(): seq_num{0}, retransmits{0}, sent_time{0} {}
-  explicit NackInfo(uint16_t seq_num): seq_num{seq_num}, retransmits{0}, sent_time{0} {}
+  NackInfo(): seq_num{0}, retransmits{0}, sent_time{0}, first_sent_time{0} {}
+  explicit NackInfo(uint16_t seq_num): seq_num{seq_num}, retransmits{0}, sent_time{0}, first_sent_time{0} {}
   uint16_t seq_num;
   uint16_t retransmits;
   uint64_t sent_time;
+  uint64_t first_sent_time;
 };
 
+/*
+ * Tracks the missing packets of a stream and adds NACKs for them to the RRs. Missing packets live in a ring indexed
+ * by sequence number with a bitmap of the pending ones, so marking a packet as lost or recovered is O(1) and
+ * building the NACK only walks the pending ones. NACKs are resent once per RTT, measured from the time it takes
+ * retransmissions to arrive.
+ */
 class RtcpNackGenerator{
   DECLARE_LOGGER();
 
  public:
+  // Only the latest kNackRingSize sequence numbers are tracked, it must divide 65536
+  static constexpr uint16_t kNackRingSize = 512;
+
   explicit RtcpNackGenerator(uint32_t ssrc_,
       std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
   bool handleRtpPacket(std::shared_ptr<DataPacket> packet);
   bool addNackPacketToRr(std::shared_ptr<DataPacket> rr_packet);
 
+  uint16_t getPendingNacks() const {
+    return nack_count_;
+  }
+  uint64_t getRttMs() const {
+    return rtt_ms_;
+  }
+
  private:
   bool addNacks(uint16_t seq_num);
   bool isTimeToRetransmit(const NackInfo& nack_info, uint64_t current_time_ms);
+  uint64_t getNackDelayMs() const;
+  bool isNackPending(uint16_t seq_num) const;
+  void removeNack(uint16_t seq_num);
+  uint16_t nextNack(uint16_t seq_num) const;
+  void updateRtt(const NackInfo& nack_info, uint64_t current_time_ms);
 
  private:
   bool initialized_;
   uint16_t highest_seq_num_;
   uint32_t ssrc_;
-  NackInfo nack_info_;
-  std::vector<NackInfo> nack_info_list_;
+  std::array<NackInfo, kNackRingSize> nack_infos_;
+  std::array<uint64_t, kNackRingSize / 64> pending_nacks_;
+  uint16_t nack_count_;
+  uint64_t rtt_ms_;
+  uint64_t next_nack_time_ms_;
   std::shared_ptr<Clock> clock_;
 };
 }  // namespace erizo
@@ -111,6 +111,49 @@ uint32_t RtpExtensionProcessor::processRtpExtensions(std::shared_ptr<DataPacket>
   return len;
 }
 
+char* RtpExtensionProcessor::findExtension(std::shared_ptr<DataPacket> p, RTPExtensions extension) {
+  const RtpHeader* head = reinterpret_cast<const RtpHeader*>(p->data);
+  if (!head->getExtension() || head->getExtId() != 0xBEDE) {
+    return nullptr;
+  }
+  std::array<RTPExtensions, 15> extMap;
+  switch (p->type) {
+    case VIDEO_PACKET:
+      extMap = ext_map_video_;
+      break;
+    case AUDIO_PACKET:
+      extMap = ext_map_audio_;
+      break;
+    default:
+      return nullptr;
+  }
+  uint16_t totalExtLength = head->getExtLength();
+  char* extBuffer = (char*)&head->extensions;  // NOLINT
+  char* extEnd = extBuffer + totalExtLength * 4;
+  if (extEnd > p->data + p->length) {
+    return nullptr;
+  }
+  while (extBuffer < extEnd) {
+    uint8_t extByte = (uint8_t)(*extBuffer);
+    uint8_t extId = extByte >> 4;
+    uint8_t extLength = extByte & 0x0F;
+    if (extId == 0) {
+      // Padding byte between elements
+      extBuffer++;
+      continue;
+    }
+    if (extId == 15) {
+      // Reserved, the rest of the header must be ignored
+      break;
+    }
+    if (extMap[extId] == extension && extBuffer + extLength + 2 <= extEnd) {
+      return extBuffer;
+    }
+    extBuffer = extBuffer + extLength + 2;
+  }
+  return nullptr;
+}
+
 VideoRotation RtpExtensionProcessor::getVideoRotation() {
   return video_orientation_;
 }
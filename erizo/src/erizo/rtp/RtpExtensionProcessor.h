@@ -32,6 +32,8 @@ class RtpExtensionProcessor{
 
   void setSdpInfo(std::shared_ptr<SdpInfo> theInfo);
   uint32_t processRtpExtensions(std::shared_ptr<DataPacket> p);
+  // Returns the element of the given extension in the packet, nullptr if the packet does not carry it
+  char* findExtension(std::shared_ptr<DataPacket> p, RTPExtensions extension);
   VideoRotation getVideoRotation();
 
   // extensions id range see https://tools.ietf.org/html/rfc5285#section-4.2
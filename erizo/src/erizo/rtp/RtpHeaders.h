@@ -22,6 +22,7 @@ namespace erizo {
 #define RTCP_SLI_FMT           2
 #define RTCP_FIR_FMT           4
 #define RTCP_AFB              15
+#define RTCP_TRANSPORT_CC_FMT 15
 
 #define VP8_90000_PT        100  // VP8 Video Codec
 #define RED_90000_PT        116  // REDundancy (RFC 2198)
@@ -233,6 +234,25 @@ class AbsSendTimeExtension {
   }
 };
 
+class TransportCcExtension {
+ public:
+  uint8_t ext_info;
+  uint8_t sequence_number[2];
+  inline uint8_t getId() {
+    return ext_info >> 4;
+  }
+  inline uint8_t getLength() {
+    return (ext_info & 0x0F);
+  }
+  inline uint16_t getSequenceNumber() {
+    return (sequence_number[0] << 8) | sequence_number[1];
+  }
+  inline void setSequenceNumber(uint16_t number) {
+    sequence_number[0] = number >> 8;
+    sequence_number[1] = number & 0xFF;
+  }
+};
+
 class RtpRtxHeader {
  public:
   RtpHeader rtpHeader;
@@ -429,6 +449,9 @@ class RtcpHeader {
   inline bool isREMB() {
     return packettype == RTCP_PS_Feedback_PT && blockcount == RTCP_AFB;
   }
+  inline bool isTransportFeedback() {
+    return packettype == RTCP_RTP_Feedback_PT && blockcount == RTCP_TRANSPORT_CC_FMT;
+  }
   inline bool isRtcp(void) {
     return (packettype >= RTCP_MIN_PT && packettype <= RTCP_MAX_PT);
   }
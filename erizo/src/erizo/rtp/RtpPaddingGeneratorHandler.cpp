@@ -17,11 +17,13 @@ constexpr uint64_t kMinMarkerRate = 3;
 constexpr uint64_t kInitialBitrate = 300000;
 constexpr uint8_t kMaxBurstPackets = 200;
 constexpr uint8_t kSlideShowBurstPackets = 20;
+// Media packets resent as padding are bigger than padding-only ones, the bucket must fit at least one
+constexpr uint64_t kMinBurstSize = 1500;
 
 RtpPaddingGeneratorHandler::RtpPaddingGeneratorHandler(std::shared_ptr<erizo::Clock> the_clock) :
   clock_{the_clock}, stream_{nullptr}, higher_sequence_number_{0},
   video_sink_ssrc_{0}, audio_source_ssrc_{0},
-  number_of_full_padding_packets_{0}, last_padding_packet_size_{0},
+  number_of_full_padding_packets_{0}, last_padding_packet_size_{0}, bytes_per_marker_{0},
   started_at_{clock_->now()},
   enabled_{false}, first_packet_received_{false},
   slideshow_mode_active_ {false},
@@ -44,6 +46,7 @@ void RtpPaddingGeneratorHandler::notifyUpdate() {
     video_sink_ssrc_ = stream_->getVideoSinkSSRC();
     audio_source_ssrc_ = stream_->getAudioSinkSSRC();
     stats_ = pipeline->getService<Stats>();
+    packet_buffer_ = pipeline->getService<PacketBufferService>();
     stats_->getNode()["total"].insertStat("paddingBitrate",
         MovingIntervalRateStat{std::chrono::milliseconds(100), 30, 8., clock_});
   }
@@ -102,14 +105,47 @@ void RtpPaddingGeneratorHandler::sendPaddingPacket(std::shared_ptr<DataPacket> p
   getContext()->fireWrite(std::move(padding_packet));
 }
 
+bool RtpPaddingGeneratorHandler::sendRtxPaddingPackets(std::shared_ptr<DataPacket> packet) {
+  RtpHeader *rtp_header = reinterpret_cast<RtpHeader*>(packet->data);
+  if (!packet_buffer_ || stream_->getVideoRtxPayloadType(rtp_header->getPayloadType()) == 0) {
+    return false;
+  }
+  // Resends the latest media packets, so the receiver can use the probing bytes to recover losses
+  uint16_t sequence_number = rtp_header->getSeqNumber();
+  bool found_packets = false;
+  uint64_t bytes_sent = 0;
+  for (uint8_t i = 0; i < kMaxBurstPackets && bytes_sent < bytes_per_marker_; i++, sequence_number--) {
+    std::shared_ptr<DataPacket> sent_packet = packet_buffer_->getVideoPacket(sequence_number);
+    if (!sent_packet || reinterpret_cast<RtpHeader*>(sent_packet->data)->getSeqNumber() != sequence_number) {
+      break;
+    }
+    if (sent_packet->is_padding) {
+      continue;
+    }
+    found_packets = true;
+    if (!bucket_.consume(sent_packet->length)) {
+      break;
+    }
+    auto padding_packet = DataPacket::create(*sent_packet);
+    padding_packet->is_padding = true;
+    padding_packet->is_retransmission = true;
+    bytes_sent += padding_packet->length;
+    stats_->getNode()["total"]["paddingBitrate"] += padding_packet->length;
+    getContext()->fireWrite(std::move(padding_packet));
+  }
+  return found_packets;
+}
+
 void RtpPaddingGeneratorHandler::onPacketWithMarkerSet(std::shared_ptr<DataPacket> packet) {
   marker_rate_++;
 
-  for (uint i = 0; i < number_of_full_padding_packets_; i++) {
-    sendPaddingPacket(packet, kMaxPaddingSize);
-  }
+  if (!sendRtxPaddingPackets(packet)) {
+    for (uint i = 0; i < number_of_full_padding_packets_; i++) {
+      sendPaddingPacket(packet, kMaxPaddingSize);
+    }
 
-  sendPaddingPacket(packet, last_padding_packet_size_);
+    sendPaddingPacket(packet, last_padding_packet_size_);
+  }
 
   std::weak_ptr<RtpPaddingGeneratorHandler> weak_this = shared_from_this();
   scheduled_task_ = stream_->getWorker()->scheduleFromNow([packet, weak_this] {
@@ -151,6 +187,7 @@ void RtpPaddingGeneratorHandler::recalculatePaddingRate(uint64_t target_padding_
     enabled_ = false;
     number_of_full_padding_packets_ = 0;
     last_padding_packet_size_ = 0;
+    bytes_per_marker_ = 0;
     return;
   }
 
@@ -163,9 +200,9 @@ void RtpPaddingGeneratorHandler::recalculatePaddingRate(uint64_t target_padding_
   if (marker_rate > std::numeric_limits<uint64_t>::max() / 8) {
     ELOG_WARN("message: Marker Rate too high %" PRIu64, marker_rate);
   }
-  uint64_t bytes_per_marker = target_padding_bitrate / (marker_rate * 8);
-  number_of_full_padding_packets_ = bytes_per_marker / (kMaxPaddingSize + rtp_header_length_);
-  last_padding_packet_size_ = bytes_per_marker % (kMaxPaddingSize + rtp_header_length_) - rtp_header_length_;
+  bytes_per_marker_ = target_padding_bitrate / (marker_rate * 8);
+  number_of_full_padding_packets_ = bytes_per_marker_ / (kMaxPaddingSize + rtp_header_length_);
+  last_padding_packet_size_ = bytes_per_marker_ % (kMaxPaddingSize + rtp_header_length_) - rtp_header_length_;
 }
 
 uint64_t RtpPaddingGeneratorHandler::getBurstSize() {
@@ -173,7 +210,7 @@ uint64_t RtpPaddingGeneratorHandler::getBurstSize() {
   if (!slideshow_mode_active_) {
     burstPackets = std::min((number_of_full_padding_packets_ + 1), (uint64_t)kMaxBurstPackets);
   }
-  return burstPackets * kMaxPaddingSize;
+  return std::max(burstPackets * kMaxPaddingSize, kMinBurstSize);
 }
 
 }  // namespace erizo
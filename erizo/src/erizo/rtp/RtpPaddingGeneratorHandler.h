@@ -9,6 +9,7 @@
 #include "lib/TokenBucket.h"
 #include "thread/Worker.h"
 #include "rtp/SequenceNumberTranslator.h"
+#include "rtp/PacketBufferService.h"
 #include "./Stats.h"
 
 namespace erizo {
@@ -34,6 +35,7 @@ class RtpPaddingGeneratorHandler: public Handler, public std::enable_shared_from
 
  private:
   void sendPaddingPacket(std::shared_ptr<DataPacket> packet, uint8_t padding_size);
+  bool sendRtxPaddingPackets(std::shared_ptr<DataPacket> packet);
   void onPacketWithMarkerSet(std::shared_ptr<DataPacket> packet);
   bool isHigherSequenceNumber(std::shared_ptr<DataPacket> packet);
   void onVideoPacket(std::shared_ptr<DataPacket> packet);
@@ -50,11 +52,13 @@ class RtpPaddingGeneratorHandler: public Handler, public std::enable_shared_from
   SequenceNumberTranslator translator_;
   MediaStream* stream_;
   std::shared_ptr<Stats> stats_;
+  std::shared_ptr<PacketBufferService> packet_buffer_;
   uint16_t higher_sequence_number_;
   uint32_t video_sink_ssrc_;
   uint32_t audio_source_ssrc_;
   uint64_t number_of_full_padding_packets_;
   uint8_t last_padding_packet_size_;
+  uint64_t bytes_per_marker_;
   time_point started_at_;
   bool enabled_;
   bool first_packet_received_;
@@ -2,6 +2,7 @@
 #include "rtp/RtpRetransmissionHandler.h"
 
 #include <algorithm>
+#include <random>
 
 #include "rtp/RtpUtils.h"
 
@@ -16,7 +17,9 @@ RtpRetransmissionHandler::RtpRetransmissionHandler(std::shared_ptr<erizo::Clock>
     stream_{nullptr},
     initialized_{false}, enabled_{true},
     bucket_{static_cast<uint64_t>(kDefaultBitrate * kMarginRtxBitrate), kBurstSize, clock_},
-    last_bitrate_time_{clock_->now()} {}
+    last_bitrate_time_{clock_->now()},
+    // Like any RTP stream, RTX starts at a random sequence number (RFC 3550)
+    rtx_sequence_number_{static_cast<uint16_t>(std::random_device{}())} {}
 
 
 void RtpRetransmissionHandler::enable() {
@@ -40,18 +43,22 @@ void RtpRetransmissionHandler::notifyUpdate() {
 }
 
 MovingIntervalRateStat& RtpRetransmissionHandler::getRtxBitrateStat() {
-  if (!stats_->getNode()["total"].hasChild("rtxBitrate")) {
-    stats_->getNode()["total"].insertStat("rtxBitrate",
+  if (!rtx_bitrate_) {
+    rtx_bitrate_ = stats_->getNode()["total"].getOrInsertStat("rtxBitrate",
         MovingIntervalRateStat{std::chrono::milliseconds(100), 30, 8.});
   }
-  return static_cast<erizo::MovingIntervalRateStat&>(stats_->getNode()["total"]["rtxBitrate"]);
+  return *rtx_bitrate_;
 }
 
 uint64_t RtpRetransmissionHandler::getBitrateCalculated() {
-  if (!stats_->getNode()["total"].hasChild("bitrateCalculated")) {
-    return 0;
+  // The stats handler creates it, so we keep looking for it until it exists
+  if (!total_bitrate_) {
+    total_bitrate_ = stats_->getNode()["total"].getStat<StatNode>("bitrateCalculated");
+    if (!total_bitrate_) {
+      return 0;
+    }
   }
-  return stats_->getNode()["total"]["bitrateCalculated"].value() / 8.;
+  return total_bitrate_->value() / 8.;
 }
 
 void RtpRetransmissionHandler::calculateRtxBitrate() {
@@ -62,6 +69,26 @@ void RtpRetransmissionHandler::calculateRtxBitrate() {
   }
 }
 
+std::shared_ptr<DataPacket> RtpRetransmissionHandler::makeRetransmission(std::shared_ptr<DataPacket> packet) {
+  unsigned int rtx_payload_type = 0;
+  if (packet->type == VIDEO_PACKET) {
+    RtpHeader *head = reinterpret_cast<RtpHeader*>(packet->data);
+    rtx_payload_type = stream_->getVideoRtxPayloadType(head->getPayloadType());
+  }
+  if (rtx_payload_type == 0) {
+    // The buffered packet may still be in use by the connection, so the copy is the one marked
+    std::shared_ptr<DataPacket> retransmission = DataPacket::create(*packet);
+    retransmission->is_retransmission = true;
+    return retransmission;
+  }
+  std::shared_ptr<DataPacket> retransmission = RtpUtils::makeRtxPacket(packet, stream_->getVideoSinkRtxSSRC(),
+      rtx_payload_type, rtx_sequence_number_);
+  if (retransmission) {
+    rtx_sequence_number_++;
+  }
+  return retransmission;
+}
+
 void RtpRetransmissionHandler::read(Context *ctx, std::shared_ptr<DataPacket> packet) {
   if (!enabled_ || !initialized_) {
     return;
@@ -98,9 +125,13 @@ void RtpRetransmissionHandler::read(Context *ctx, std::shared_ptr<DataPacket> pa
               continue;
             }
             RtpHeader *recovered_head = reinterpret_cast<RtpHeader*> (recovered->data);
+            std::shared_ptr<DataPacket> retransmission;
             if (recovered_head->getSeqNumber() == seq_num) {
-              getRtxBitrateStat() += recovered->length;
-              getContext()->fireWrite(recovered);
+              retransmission = makeRetransmission(recovered);
+            }
+            if (retransmission) {
+              getRtxBitrateStat() += retransmission->length;
+              getContext()->fireWrite(std::move(retransmission));
               continue;
             }
           }
@@ -120,6 +151,14 @@ void RtpRetransmissionHandler::write(Context *ctx, std::shared_ptr<DataPacket> p
   if (!initialized_) {
     return;
   }
+  if (packet->is_retransmission) {
+    // Buffered packets resent by upstream handlers (i.e. padding) go out with the same rtx stream as ours
+    std::shared_ptr<DataPacket> retransmission = makeRetransmission(packet);
+    if (retransmission) {
+      ctx->fireWrite(std::move(retransmission));
+    }
+    return;
+  }
   RtcpHeader *chead = reinterpret_cast<RtcpHeader*> (packet->data);
   if (!chead->isRtcp()) {
     packet_buffer_->insertPacket(packet);
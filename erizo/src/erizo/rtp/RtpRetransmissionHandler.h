@@ -38,19 +38,25 @@ class RtpRetransmissionHandler : public Handler {
   void write(Context *ctx, std::shared_ptr<DataPacket> packet) override;
   void notifyUpdate() override;
 
+  uint16_t getRtxSequenceNumber() { return rtx_sequence_number_; }
+
  private:
   MovingIntervalRateStat& getRtxBitrateStat();
   uint64_t getBitrateCalculated();
   void calculateRtxBitrate();
+  std::shared_ptr<DataPacket> makeRetransmission(std::shared_ptr<DataPacket> packet);
 
  private:
   std::shared_ptr<erizo::Clock> clock_;
   MediaStream *stream_;
   bool initialized_, enabled_;
   std::shared_ptr<Stats> stats_;
+  std::shared_ptr<MovingIntervalRateStat> rtx_bitrate_;
+  std::shared_ptr<StatNode> total_bitrate_;
   std::shared_ptr<PacketBufferService> packet_buffer_;
   TokenBucket bucket_;
   erizo::time_point last_bitrate_time_;
+  uint16_t rtx_sequence_number_;
 };
 }  // namespace erizo
 
@@ -96,12 +96,12 @@ void RtpTrackMuteHandler::handlePacket(Context *ctx, TrackMuteInfo *info, std::s
           (now - last_keyframe_sent_time_) > kMuteVideoKeyframeTimeout) {
         ELOG_DEBUG("message: Will create Keyframe last_keyframe, time: %u, is_keyframe: %u",
             now - last_keyframe_sent_time_, packet->is_keyframe);
-        if (packet->codec == "VP8") {
+        if (packet->codec == kVP8Codec) {
           packet = transformIntoBlackKeyframePacket(packet);
           last_keyframe_sent_time_ = now;
         } else {
           ELOG_INFO("%s message: cannot generate keyframe packet is not available for codec %s",
-              stream_->toLog(), packet->codec);
+              stream_->toLog(), CodecRegistry::getName(packet->codec).c_str());
           should_skip_packet = true;
         }
       } else {
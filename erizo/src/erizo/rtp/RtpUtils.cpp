@@ -7,6 +7,8 @@ namespace erizo {
 
 
 constexpr int kMaxPacketSize = 1500;
+constexpr int kRtxOsnLength = 2;
+constexpr int kRedHeaderLength = 1;
 bool RtpUtils::sequenceNumberLessThan(uint16_t first, uint16_t last) {
   return RtpUtils::numberLessThan(first, last, 16);
 }
@@ -177,6 +179,71 @@ std::shared_ptr<DataPacket> RtpUtils::makePaddingPacket(std::shared_ptr<DataPack
   return padding_packet;
 }
 
+std::shared_ptr<DataPacket> RtpUtils::makeRtxPacket(std::shared_ptr<DataPacket> packet, uint32_t rtx_ssrc,
+                                                    uint8_t rtx_payload_type, uint16_t rtx_sequence_number) {
+  erizo::RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+  int header_length = header->getHeaderLength();
+  int rtx_length = packet->length + kRtxOsnLength;
+  if (header_length > packet->length || rtx_length > kMaxPacketSize) {
+    return std::shared_ptr<DataPacket>();
+  }
+
+  // The original sequence number goes between the header and the original payload
+  auto rtx_packet = DataPacket::create(*packet);
+  char *payload = rtx_packet->data + header_length;
+  memmove(payload + kRtxOsnLength, payload, packet->length - header_length);
+  uint16_t osn = htons(header->getSeqNumber());
+  memcpy(payload, &osn, kRtxOsnLength);
+  rtx_packet->length = rtx_length;
+
+  erizo::RtpHeader *rtx_header = reinterpret_cast<RtpHeader*>(rtx_packet->data);
+  rtx_header->setSSRC(rtx_ssrc);
+  rtx_header->setPayloadType(rtx_payload_type);
+  rtx_header->setSeqNumber(rtx_sequence_number);
+  rtx_packet->is_retransmission = true;
+  return rtx_packet;
+}
+
+std::shared_ptr<DataPacket> RtpUtils::makeRedPacket(std::shared_ptr<DataPacket> packet, uint8_t red_payload_type) {
+  erizo::RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+  int header_length = header->getHeaderLength();
+  int red_length = packet->length + kRedHeaderLength;
+  if (header_length > packet->length || red_length > kMaxPacketSize) {
+    return std::shared_ptr<DataPacket>();
+  }
+
+  // The last (and only) block header is just the original payload type with the F bit unset
+  auto red_packet = DataPacket::create(*packet);
+  char *payload = red_packet->data + header_length;
+  memmove(payload + kRedHeaderLength, payload, packet->length - header_length);
+  payload[0] = header->getPayloadType() & 0x7F;
+  red_packet->length = red_length;
+
+  erizo::RtpHeader *red_header = reinterpret_cast<RtpHeader*>(red_packet->data);
+  red_header->setPayloadType(red_payload_type);
+  return red_packet;
+}
+
+bool RtpUtils::unpackRtxPacket(std::shared_ptr<DataPacket> packet, uint32_t ssrc, uint8_t payload_type) {
+  erizo::RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+  int header_length = header->getHeaderLength();
+  if (header_length + kRtxOsnLength + getPaddingLength(packet) > packet->length) {
+    return false;
+  }
+
+  char *payload = packet->data + header_length;
+  uint16_t osn;
+  memcpy(&osn, payload, kRtxOsnLength);
+  memmove(payload, payload + kRtxOsnLength, packet->length - header_length - kRtxOsnLength);
+  packet->length -= kRtxOsnLength;
+
+  header->setSSRC(ssrc);
+  header->setPayloadType(payload_type);
+  header->setSeqNumber(ntohs(osn));
+  packet->is_retransmission = true;
+  return true;
+}
+
 std::shared_ptr<DataPacket> RtpUtils::makeVP8BlackKeyframePacket(std::shared_ptr<DataPacket> packet) {
   uint8_t vp8_keyframe[] = {
     (uint8_t) 0x90, (uint8_t) 0xe0, (uint8_t) 0x80, (uint8_t) 0x01,  // payload header 1
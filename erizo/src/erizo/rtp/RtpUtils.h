@@ -37,6 +37,13 @@ class RtpUtils {
   static int getPaddingLength(std::shared_ptr<DataPacket> packet);
 
   static std::shared_ptr<DataPacket> makePaddingPacket(std::shared_ptr<DataPacket> packet, uint8_t padding_size);
+  // RFC 4588 retransmission of the packet, returns nullptr if it does not fit in a DataPacket
+  static std::shared_ptr<DataPacket> makeRtxPacket(std::shared_ptr<DataPacket> packet, uint32_t rtx_ssrc,
+                                                   uint8_t rtx_payload_type, uint16_t rtx_sequence_number);
+  // Restores in place the original packet of an RFC 4588 retransmission, false if it carries none (i.e. padding)
+  static bool unpackRtxPacket(std::shared_ptr<DataPacket> packet, uint32_t ssrc, uint8_t payload_type);
+  // RFC 2198 single block encapsulation of the packet, returns nullptr if it does not fit in a DataPacket
+  static std::shared_ptr<DataPacket> makeRedPacket(std::shared_ptr<DataPacket> packet, uint8_t red_payload_type);
   static std::shared_ptr<DataPacket> makeVP8BlackKeyframePacket(std::shared_ptr<DataPacket> packet);
 };
 
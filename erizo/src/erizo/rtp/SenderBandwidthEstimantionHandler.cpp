@@ -11,11 +11,20 @@ namespace erizo {
 DEFINE_LOGGER(SenderBandwidthEstimationHandler, "rtp.SenderBandwidthEstimationHandler");
 
 constexpr duration SenderBandwidthEstimationHandler::kMinUpdateEstimateInterval;
+constexpr duration SenderBandwidthEstimationHandler::kMinTransportFeedbackRembInterval;
+
+// Feed SSRCs that fit in a REMB packet, see RtcpHeader
+static constexpr size_t kMaxRembFeedSsrcs = 50;
+// One-byte header extensions store their length minus one, transport-cc numbers take two bytes
+static constexpr uint8_t kTransportCcExtensionLength = 1;
 
 SenderBandwidthEstimationHandler::SenderBandwidthEstimationHandler(std::shared_ptr<Clock> the_clock) :
   connection_{nullptr}, bwe_listener_{nullptr}, clock_{the_clock}, initialized_{false}, enabled_{true},
-  received_remb_{false}, estimated_bitrate_{0}, estimated_loss_{0},
+  received_remb_{false}, received_transport_feedback_{false}, pending_transport_feedback_remb_{false},
+  transport_feedback_sender_ssrc_{0}, last_transport_feedback_remb_{the_clock->now()},
+  estimated_bitrate_{0}, estimated_loss_{0},
   estimated_rtt_{0}, last_estimate_update_{clock::now()}, sender_bwe_{new SendSideBandwidthEstimation()},
+  transport_feedback_{std::make_shared<TransportFeedbackAdapter>(the_clock)},
   max_rr_delay_data_size_{0}, max_sr_delay_data_size_{0} {
     sender_bwe_->SetBitrates(kStartSendBitrate, kMinSendBitrate, kMaxSendBitrate);
   }
@@ -27,11 +36,16 @@ SenderBandwidthEstimationHandler::SenderBandwidthEstimationHandler(const SenderB
     initialized_{handler.initialized_},
     enabled_{handler.enabled_},
     received_remb_{false},
+    received_transport_feedback_{handler.received_transport_feedback_},
+    pending_transport_feedback_remb_{handler.pending_transport_feedback_remb_},
+    transport_feedback_sender_ssrc_{handler.transport_feedback_sender_ssrc_},
+    last_transport_feedback_remb_{handler.last_transport_feedback_remb_},
     period_packets_sent_{handler.period_packets_sent_},
     estimated_bitrate_{handler.estimated_bitrate_},
     estimated_loss_{handler.estimated_loss_},
     estimated_rtt_{handler.estimated_rtt_},
     sender_bwe_{handler.sender_bwe_},
+    transport_feedback_{handler.transport_feedback_},
     sr_delay_data_{std::move(handler.sr_delay_data_)},
     rr_delay_data_{std::move(handler.rr_delay_data_)},
     max_rr_delay_data_size_{handler.max_sr_delay_data_size_},
@@ -106,8 +120,9 @@ void SenderBandwidthEstimationHandler::read(Context *ctx, std::shared_ptr<DataPa
               value != sr_delay_data_.end(),
               max_rr_delay_data_size_,
               rr_delay_data_.size());
-          if (received_remb_ && value != sr_delay_data_.end()) {
+          if (hasReceiverEstimate() && value != sr_delay_data_.end()) {
               uint32_t delay = now_ms - (*value)->sr_send_time - delay_since_last_ms;
+              transport_feedback_->onRttUpdate(delay);
               rr_delay_data_.push_back(
                 std::make_shared<RrDelayData>(chead->getSourceSSRC(), delay, chead->getFractionLost()));
               updateReceiverBlockFromList();
@@ -136,19 +151,62 @@ void SenderBandwidthEstimationHandler::read(Context *ctx, std::shared_ptr<DataPa
           }
         }
         break;
+      case RTCP_RTP_Feedback_PT:
+        if (chead->isTransportFeedback()) {
+          onTransportFeedback(chead);
+        }
+        break;
       default:
         break;
     }
   });
   ctx->fireRead(std::move(packet));
+  maybeNotifyTransportFeedbackEstimate(ctx);
+}
+
+void SenderBandwidthEstimationHandler::onTransportFeedback(RtcpHeader *chead) {
+  if (!transport_feedback_->onTransportFeedback(chead)) {
+    return;
+  }
+  received_transport_feedback_ = true;
+  transport_feedback_sender_ssrc_ = chead->getSSRC();
+  int64_t now_ms = ClockUtils::timePointToMs(clock_->now());
+  uint32_t delay_based_bitrate = transport_feedback_->getEstimate();
+  ELOG_DEBUG("%s message: Updating estimate with transport feedback, delay_based_bitrate: %u",
+      connection_->toLog(), delay_based_bitrate);
+  sender_bwe_->UpdateDelayBasedEstimate(now_ms, delay_based_bitrate);
+  updateEstimate();
+  pending_transport_feedback_remb_ = true;
+}
+
+void SenderBandwidthEstimationHandler::maybeNotifyTransportFeedbackEstimate(Context *ctx) {
+  time_point now = clock_->now();
+  if (!initialized_ || !pending_transport_feedback_remb_ ||
+      now - last_transport_feedback_remb_ < kMinTransportFeedbackRembInterval) {
+    return;
+  }
+  std::vector<uint32_t> ssrcs;
+  connection_->forEachMediaStream([&ssrcs] (const std::shared_ptr<MediaStream> &media_stream) {
+    if (!media_stream->isPublisher() && media_stream->getVideoSinkSSRC() != 0 && ssrcs.size() < kMaxRembFeedSsrcs) {
+      ssrcs.push_back(media_stream->getVideoSinkSSRC());
+    }
+  });
+  pending_transport_feedback_remb_ = false;
+  last_transport_feedback_remb_ = now;
+  if (ssrcs.empty()) {
+    return;
+  }
+  // Receivers that only send transport feedback never send REMBs, so we make one up with our estimate and let the
+  // connection distribute it between its streams like any other REMB
+  ctx->fireRead(RtpUtils::createREMB(transport_feedback_sender_ssrc_, ssrcs, estimated_bitrate_));
 }
 
 void SenderBandwidthEstimationHandler::updateReceiverBlockFromList() {
   if (rr_delay_data_.size() < max_rr_delay_data_size_) {
     return;
   }
-  // TODO(pedro) Implement alternative when there are no REMBs
-  if (received_remb_) {
+  // TODO(pedro) Implement alternative when there are no REMBs nor transport feedback
+  if (hasReceiverEstimate()) {
     uint32_t total_packets_lost = 0;
     uint32_t total_packets_sent = 0;
     uint64_t avg_delay = 0;
@@ -188,9 +246,12 @@ void SenderBandwidthEstimationHandler::write(Context *ctx, std::shared_ptr<DataP
     } else {
       period_packets_sent_.emplace(ssrc, 1);
     }
+    if (initialized_) {
+      stampTransportSequenceNumber(packet);
+    }
     if (packet->type == VIDEO_PACKET) {
       time_point now = clock_->now();
-      if (received_remb_ && now - last_estimate_update_ > kMinUpdateEstimateInterval) {
+      if (hasReceiverEstimate() && now - last_estimate_update_ > kMinUpdateEstimateInterval) {
         sender_bwe_->UpdateEstimate(ClockUtils::timePointToMs(now));
         updateEstimate();
         last_estimate_update_ = now;
@@ -202,6 +263,20 @@ void SenderBandwidthEstimationHandler::write(Context *ctx, std::shared_ptr<DataP
   ctx->fireWrite(std::move(packet));
 }
 
+void SenderBandwidthEstimationHandler::stampTransportSequenceNumber(std::shared_ptr<DataPacket> packet) {
+  char *extension = connection_->getRtpExtensionProcessor().findExtension(packet, TRANSPORT_CC);
+  if (!extension) {
+    return;
+  }
+  // Forwarded packets carry the numbers of the publisher's connection, receivers expect ours
+  TransportCcExtension *transport_cc = reinterpret_cast<TransportCcExtension*>(extension);
+  if (transport_cc->getLength() != kTransportCcExtensionLength) {
+    // Not the two bytes we would write, so receivers could not give feedback about it either
+    return;
+  }
+  transport_cc->setSequenceNumber(transport_feedback_->onPacketSent(packet->length));
+}
+
 void SenderBandwidthEstimationHandler::analyzeSr(RtcpHeader* chead) {
   uint64_t now = ClockUtils::timePointToMs(clock_->now());
   uint32_t ntp;
@@ -218,8 +293,12 @@ void SenderBandwidthEstimationHandler::updateEstimate() {
   sender_bwe_->CurrentEstimate(&estimated_bitrate_, &estimated_loss_,
       &estimated_rtt_);
   if (stats_) {
-    stats_->getNode()["total"].insertStat("senderBitrateEstimation",
-      CumulativeStat{static_cast<uint64_t>(estimated_bitrate_)});
+    // Resolved once and updated in place, instead of replacing the stat on every estimate
+    if (!sender_bitrate_estimation_) {
+      sender_bitrate_estimation_ = stats_->getNode()["total"].getOrInsertStat("senderBitrateEstimation",
+          CumulativeStat{0});
+    }
+    *sender_bitrate_estimation_ = static_cast<uint64_t>(estimated_bitrate_);
   }
   ELOG_DEBUG("%s message: estimated bitrate %d, loss %u, rtt %ld",
       connection_->toLog(), estimated_bitrate_, estimated_loss_, estimated_rtt_);
@@ -6,6 +6,7 @@
 #include "./logger.h"
 #include "./WebRtcConnection.h"
 #include "lib/Clock.h"
+#include "rtp/TransportFeedbackAdapter.h"
 
 #include "webrtc/modules/bitrate_controller/send_side_bandwidth_estimation.h"
 
@@ -30,6 +31,7 @@ class SenderBandwidthEstimationHandler : public Handler,
   static const uint32_t kMinSendBitrate = 30000;
   static const uint32_t kMaxSendBitrate = 1000000000;
   static constexpr duration kMinUpdateEstimateInterval = std::chrono::milliseconds(25);
+  static constexpr duration kMinTransportFeedbackRembInterval = std::chrono::milliseconds(100);
 
  public:
   explicit SenderBandwidthEstimationHandler(std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
@@ -55,6 +57,12 @@ class SenderBandwidthEstimationHandler : public Handler,
  private:
   void updateMaxListSizes();
   void updateReceiverBlockFromList();
+  void stampTransportSequenceNumber(std::shared_ptr<DataPacket> packet);
+  void onTransportFeedback(RtcpHeader *chead);
+  void maybeNotifyTransportFeedbackEstimate(Context *ctx);
+  bool hasReceiverEstimate() {
+    return received_remb_ || received_transport_feedback_;
+  }
 
  private:
   WebRtcConnection* connection_;
@@ -63,15 +71,21 @@ class SenderBandwidthEstimationHandler : public Handler,
   bool initialized_;
   bool enabled_;
   bool received_remb_;
+  bool received_transport_feedback_;
+  bool pending_transport_feedback_remb_;
+  uint32_t transport_feedback_sender_ssrc_;
+  time_point last_transport_feedback_remb_;
   std::map<uint32_t, uint32_t> period_packets_sent_;
   int estimated_bitrate_;
   uint8_t estimated_loss_;
   int64_t estimated_rtt_;
   time_point last_estimate_update_;
   std::shared_ptr<SendSideBandwidthEstimation> sender_bwe_;
+  std::shared_ptr<TransportFeedbackAdapter> transport_feedback_;
   std::list<std::shared_ptr<SrDelayData>> sr_delay_data_;
   std::list<std::shared_ptr<RrDelayData>> rr_delay_data_;
   std::shared_ptr<Stats> stats_;
+  std::shared_ptr<CumulativeStat> sender_bitrate_estimation_;
   uint32_t max_rr_delay_data_size_;
   uint32_t max_sr_delay_data_size_;
 
@@ -17,10 +17,8 @@ void StatsCalculator::update(MediaStream *stream, std::shared_ptr<Stats> stats)
   if (!stream_) {
     stream_ = stream;
     stats_ = stats;
-    if (!getStatsInfo().hasChild("total")) {
-      getStatsInfo()["total"].insertStat("bitrateCalculated", MovingIntervalRateStat{kRateStatIntervalSize,
-        kRateStatIntervals, 8.});
-    }
+    total_bitrate_ = getStatsInfo()["total"].getOrInsertStat("bitrateCalculated",
+      MovingIntervalRateStat{kRateStatIntervalSize, kRateStatIntervals, 8.});
   }
 }
 
@@ -38,40 +36,62 @@ void StatsCalculator::processRtpPacket(std::shared_ptr<DataPacket> packet) {
   int len = packet->length;
   RtpHeader* head = reinterpret_cast<RtpHeader*>(buf);
   uint32_t ssrc = head->getSSRC();
-  if (!stream_->isSinkSSRC(ssrc) && !stream_->isSourceSSRC(ssrc)) {
+  bool is_rtx = stream_->isVideoSinkRtxSSRC(ssrc);
+  if (!stream_->isSinkSSRC(ssrc) && !stream_->isSourceSSRC(ssrc) && !is_rtx) {
     ELOG_DEBUG("message: Unknown SSRC in processRtpPacket, ssrc: %u, PT: %u", ssrc, head->getPayloadType());
     return;
   }
-  if (!getStatsInfo()[ssrc].hasChild("bitrateCalculated")) {
-    if (stream_->isVideoSourceSSRC(ssrc) || stream_->isVideoSinkSSRC(ssrc)) {
-      getStatsInfo()[ssrc].insertStat("type", StringStat{"video"});
-    } else if (stream_->isAudioSourceSSRC(ssrc) || stream_->isAudioSinkSSRC(ssrc)) {
-      getStatsInfo()[ssrc].insertStat("type", StringStat{"audio"});
-    }
-    getStatsInfo()[ssrc].insertStat("bitrateCalculated", MovingIntervalRateStat{kRateStatIntervalSize,
-        kRateStatIntervals, 8.});
-    getStatsInfo()[ssrc].insertStat("mediaBitrateCalculated", MovingIntervalRateStat{kRateStatIntervalSize,
-        kRateStatIntervals, 8.});
+  SsrcStats &ssrc_stats = getSsrcStats(ssrc);
+  *ssrc_stats.bitrate += len;
+  *total_bitrate_ += len;
+  if (is_rtx) {
+    return;
   }
-  getStatsInfo()[ssrc]["bitrateCalculated"] += len;
-  getStatsInfo()["total"]["bitrateCalculated"] += len;
   if (!packet->is_padding) {
-    getStatsInfo()[ssrc]["mediaBitrateCalculated"] += len;
+    *ssrc_stats.media_bitrate += len;
   }
   if (packet->type == VIDEO_PACKET) {
-    stream_->setVideoBitrate(getStatsInfo()[ssrc]["mediaBitrateCalculated"].value());
+    stream_->setVideoBitrate(ssrc_stats.media_bitrate->value());
     if (packet->is_keyframe) {
-      incrStat(ssrc, "keyFrames");
+      if (!ssrc_stats.key_frames) {
+        ssrc_stats.key_frames = getStatsInfo()[ssrc].getOrInsertStat("keyFrames", CumulativeStat{0});
+      }
+      (*ssrc_stats.key_frames)++;
     }
   }
 }
 
-void StatsCalculator::incrStat(uint32_t ssrc, std::string stat) {
-  if (!getStatsInfo()[ssrc].hasChild(stat)) {
-    getStatsInfo()[ssrc].insertStat(stat, CumulativeStat{1});
-    return;
+StatsCalculator::SsrcStats& StatsCalculator::getSsrcStats(uint32_t ssrc) {
+  auto ssrc_stats = ssrc_stats_.find(ssrc);
+  if (ssrc_stats != ssrc_stats_.end()) {
+    return ssrc_stats->second;
+  }
+  StatNode &ssrc_node = getStatsInfo()[ssrc];
+  if (!ssrc_node.hasChild("bitrateCalculated")) {
+    if (stream_->isVideoSourceSSRC(ssrc) || stream_->isVideoSinkSSRC(ssrc)) {
+      ssrc_node.insertStat("type", StringStat{"video"});
+    } else if (stream_->isAudioSourceSSRC(ssrc) || stream_->isAudioSinkSSRC(ssrc)) {
+      ssrc_node.insertStat("type", StringStat{"audio"});
+    } else if (stream_->isVideoSinkRtxSSRC(ssrc)) {
+      ssrc_node.insertStat("type", StringStat{"rtx"});
+    }
   }
-  getStatsInfo()[ssrc][stat]++;
+  SsrcStats &new_ssrc_stats = ssrc_stats_[ssrc];
+  new_ssrc_stats.bitrate = ssrc_node.getOrInsertStat("bitrateCalculated",
+    MovingIntervalRateStat{kRateStatIntervalSize, kRateStatIntervals, 8.});
+  new_ssrc_stats.media_bitrate = ssrc_node.getOrInsertStat("mediaBitrateCalculated",
+    MovingIntervalRateStat{kRateStatIntervalSize, kRateStatIntervals, 8.});
+  new_ssrc_stats.key_frames = ssrc_node.getStat<CumulativeStat>("keyFrames");
+  return new_ssrc_stats;
+}
+
+void StatsCalculator::incrStat(uint32_t ssrc, std::string stat) {
+  (*getStatsInfo()[ssrc].getOrInsertStat(stat, CumulativeStat{0}))++;
+}
+
+void StatsCalculator::setStat(uint32_t ssrc, std::string stat, uint64_t value) {
+  // Updates the stat in place instead of allocating a new one for every report
+  *getStatsInfo()[ssrc].getOrInsertStat(stat, CumulativeStat{0}) = value;
 }
 
 void StatsCalculator::processRtcpPacket(std::shared_ptr<DataPacket> packet) {
@@ -119,17 +139,17 @@ void StatsCalculator::processRtcpPacket(std::shared_ptr<DataPacket> packet) {
           break;
         }
         ELOG_DEBUG("RTP RR: Fraction Lost %u, packetsLost %u", chead->getFractionLost(), chead->getLostPackets());
-        getStatsInfo()[ssrc].insertStat("fractionLost", CumulativeStat{chead->getFractionLost()});
-        getStatsInfo()[ssrc].insertStat("packetsLost", CumulativeStat{chead->getLostPackets()});
-        getStatsInfo()[ssrc].insertStat("jitter", CumulativeStat{chead->getJitter()});
-        getStatsInfo()[ssrc].insertStat("sourceSsrc", CumulativeStat{ssrc});
+        setStat(ssrc, "fractionLost", chead->getFractionLost());
+        setStat(ssrc, "packetsLost", chead->getLostPackets());
+        setStat(ssrc, "jitter", chead->getJitter());
+        setStat(ssrc, "sourceSsrc", ssrc);
         break;
       case RTCP_Sender_PT:
         ELOG_DEBUG("RTP SR: Packets Sent %u, Octets Sent %u", chead->getPacketsSent(), chead->getOctetsSent());
-        getStatsInfo()[ssrc].insertStat("packetsSent", CumulativeStat{chead->getPacketsSent()});
-        getStatsInfo()[ssrc].insertStat("bytesSent", CumulativeStat{chead->getOctetsSent()});
-        getStatsInfo()[ssrc].insertStat("srTimestamp", CumulativeStat{chead->getTimestamp()});
-        getStatsInfo()[ssrc].insertStat("srNtp", CumulativeStat{chead->getNtpTimestamp()});
+        setStat(ssrc, "packetsSent", chead->getPacketsSent());
+        setStat(ssrc, "bytesSent", chead->getOctetsSent());
+        setStat(ssrc, "srTimestamp", chead->getTimestamp());
+        setStat(ssrc, "srNtp", chead->getNtpTimestamp());
         break;
       case RTCP_RTP_Feedback_PT:
         ELOG_DEBUG("RTP FB: Usually NACKs: %u", chead->getBlockCount());
@@ -163,8 +183,8 @@ void StatsCalculator::processRtcpPacket(std::shared_ptr<DataPacket> packet) {
                 uint64_t bitrate = chead->getREMBBitRate();
                 // ELOG_DEBUG("REMB Packet numSSRC %u mantissa %u exp %u, tot %lu bps",
                 //             chead->getREMBNumSSRC(), chead->getBrMantis(), chead->getBrExp(), bitrate);
-                getStatsInfo()[ssrc].insertStat("bandwidth", CumulativeStat{bitrate});
-                getStatsInfo()["total"].insertStat("senderBitrateEstimation", CumulativeStat{bitrate});
+                setStat(ssrc, "bandwidth", bitrate);
+                *getStatsInfo()["total"].getOrInsertStat("senderBitrateEstimation", CumulativeStat{0}) = bitrate;
               } else {
                 ELOG_DEBUG("Unsupported AFB Packet not REMB")
               }
@@ -1,7 +1,9 @@
 #ifndef ERIZO_SRC_ERIZO_RTP_STATSHANDLER_H_
 #define ERIZO_SRC_ERIZO_RTP_STATSHANDLER_H_
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "./logger.h"
 #include "pipeline/Handler.h"
@@ -33,13 +35,24 @@ class StatsCalculator {
   }
 
  private:
+  // Handles to the stats updated for every RTP packet of an SSRC, resolved when the SSRC is first seen
+  struct SsrcStats {
+    std::shared_ptr<MovingIntervalRateStat> bitrate;
+    std::shared_ptr<MovingIntervalRateStat> media_bitrate;
+    std::shared_ptr<CumulativeStat> key_frames;
+  };
+
   void processRtpPacket(std::shared_ptr<DataPacket> packet);
   void processRtcpPacket(std::shared_ptr<DataPacket> packet);
+  SsrcStats& getSsrcStats(uint32_t ssrc);
   void incrStat(uint32_t ssrc, std::string stat);
+  void setStat(uint32_t ssrc, std::string stat, uint64_t value);
 
  private:
   MediaStream* stream_;
   std::shared_ptr<Stats> stats_;
+  std::shared_ptr<MovingIntervalRateStat> total_bitrate_;
+  std::unordered_map<uint32_t, SsrcStats> ssrc_stats_;
 };
 
 class IncomingStatsHandler: public InboundHandler, public StatsCalculator {
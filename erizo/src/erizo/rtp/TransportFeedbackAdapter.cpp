@@ -0,0 +1,108 @@
+#include "rtp/TransportFeedbackAdapter.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "lib/WebRtcClock.h"
+
+#include "webrtc/modules/remote_bitrate_estimator/remote_bitrate_estimator_abs_send_time.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+
+namespace erizo {
+
+DEFINE_LOGGER(TransportFeedbackAdapter, "rtp.TransportFeedbackAdapter");
+
+constexpr int64_t TransportFeedbackAdapter::kSendTimeHistoryWindowMs;
+constexpr int TransportFeedbackAdapter::kMinBitrate;
+
+// The feedback base time has 24 bits in units of 64ms, so it wraps every ~12 days
+static constexpr int64_t kBaseTimeScaleFactorUs = webrtc::rtcp::TransportFeedback::kDeltaScaleFactor * (1 << 8);
+static constexpr int64_t kBaseTimeRangeUs = kBaseTimeScaleFactorUs * (1 << 24);
+static constexpr int64_t kNoFeedback = -1;
+
+TransportFeedbackAdapter::TransportFeedbackAdapter(std::shared_ptr<Clock> the_clock)
+    : clock_{the_clock}, webrtc_clock_{new WebRtcClock(the_clock)},
+      send_time_history_{webrtc_clock_.get(), kSendTimeHistoryWindowMs},
+      estimator_{new webrtc::RemoteBitrateEstimatorAbsSendTime(this, webrtc_clock_.get())},
+      next_sequence_number_{1}, last_feedback_base_time_us_{kNoFeedback}, feedback_time_offset_ms_{0},
+      has_estimate_{false}, estimate_updated_{false}, estimated_bitrate_{0} {
+  estimator_->SetMinBitrate(kMinBitrate);
+}
+
+TransportFeedbackAdapter::~TransportFeedbackAdapter() {
+}
+
+uint16_t TransportFeedbackAdapter::onPacketSent(size_t payload_size) {
+  uint16_t sequence_number = next_sequence_number_++;
+  send_time_history_.AddAndRemoveOld(sequence_number, payload_size, webrtc::PacketInfo::kNotAProbe);
+  send_time_history_.OnSentPacket(sequence_number, webrtc_clock_->TimeInMilliseconds());
+  return sequence_number;
+}
+
+bool TransportFeedbackAdapter::onTransportFeedback(RtcpHeader *chead) {
+  size_t length = (chead->getLength() + 1) * 4;
+  std::unique_ptr<webrtc::rtcp::TransportFeedback> feedback =
+      webrtc::rtcp::TransportFeedback::ParseFrom(reinterpret_cast<uint8_t*>(chead), length);
+  if (!feedback) {
+    ELOG_DEBUG("message: Could not parse transport feedback, length: %lu", length);
+    return false;
+  }
+
+  // Arrival times are in the receiver clock, only their differences matter so we anchor them to ours
+  int64_t base_time_us = feedback->GetBaseTimeUs();
+  if (last_feedback_base_time_us_ == kNoFeedback) {
+    feedback_time_offset_ms_ = webrtc_clock_->TimeInMilliseconds();
+  } else {
+    int64_t delta_us = base_time_us - last_feedback_base_time_us_;
+    if (std::abs(delta_us - kBaseTimeRangeUs) < std::abs(delta_us)) {
+      delta_us -= kBaseTimeRangeUs;
+    } else if (std::abs(delta_us + kBaseTimeRangeUs) < std::abs(delta_us)) {
+      delta_us += kBaseTimeRangeUs;
+    }
+    feedback_time_offset_ms_ += delta_us / 1000;
+  }
+  last_feedback_base_time_us_ = base_time_us;
+
+  std::vector<webrtc::rtcp::TransportFeedback::StatusSymbol> statuses = feedback->GetStatusVector();
+  std::vector<int64_t> deltas_us = feedback->GetReceiveDeltasUs();
+  std::vector<webrtc::PacketInfo> packets;
+  packets.reserve(deltas_us.size());
+  uint16_t sequence_number = feedback->GetBaseSequence();
+  int64_t offset_us = 0;
+  size_t delta_index = 0;
+  for (webrtc::rtcp::TransportFeedback::StatusSymbol status : statuses) {
+    if (status != webrtc::rtcp::TransportFeedback::StatusSymbol::kNotReceived && delta_index < deltas_us.size()) {
+      offset_us += deltas_us[delta_index++];
+      webrtc::PacketInfo info(feedback_time_offset_ms_ + offset_us / 1000, sequence_number);
+      if (send_time_history_.GetInfo(&info, true) && info.send_time_ms >= 0) {
+        packets.push_back(info);
+      }
+    }
+    sequence_number++;
+  }
+  if (packets.empty()) {
+    return false;
+  }
+  std::sort(packets.begin(), packets.end(), [](const webrtc::PacketInfo &first, const webrtc::PacketInfo &second) {
+    if (first.arrival_time_ms != second.arrival_time_ms) {
+      return first.arrival_time_ms < second.arrival_time_ms;
+    }
+    return first.sequence_number < second.sequence_number;
+  });
+
+  estimate_updated_ = false;
+  estimator_->IncomingPacketFeedbackVector(packets);
+  return estimate_updated_;
+}
+
+void TransportFeedbackAdapter::onRttUpdate(int64_t rtt_ms) {
+  estimator_->OnRttUpdate(rtt_ms, rtt_ms);
+}
+
+void TransportFeedbackAdapter::OnReceiveBitrateChanged(const std::vector<uint32_t>& ssrcs, uint32_t bitrate) {
+  has_estimate_ = true;
+  estimate_updated_ = true;
+  estimated_bitrate_ = bitrate;
+}
+
+}  // namespace erizo
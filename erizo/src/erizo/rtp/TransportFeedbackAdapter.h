@@ -0,0 +1,67 @@
+#ifndef ERIZO_SRC_ERIZO_RTP_TRANSPORTFEEDBACKADAPTER_H_
+#define ERIZO_SRC_ERIZO_RTP_TRANSPORTFEEDBACKADAPTER_H_
+
+#include <memory>
+#include <vector>
+
+#include "./logger.h"
+#include "lib/Clock.h"
+#include "rtp/RtpHeaders.h"
+
+#include "webrtc/modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
+#include "webrtc/modules/remote_bitrate_estimator/include/send_time_history.h"
+
+namespace webrtc {
+class Clock;
+}  // namespace webrtc
+
+namespace erizo {
+
+/*
+ * Send side of transport-wide congestion control: hands out the transport-wide sequence numbers of the packets
+ * a connection sends, remembers when they were sent, and matches the transport-cc feedback of the receiver against
+ * them. The resulting send/arrival times feed webrtc's delay-based estimator, like the abs-send-time extension does
+ * on the receive side.
+ */
+class TransportFeedbackAdapter : public webrtc::RemoteBitrateObserver {
+  DECLARE_LOGGER();
+
+ public:
+  static constexpr int64_t kSendTimeHistoryWindowMs = 60000;
+  static constexpr int kMinBitrate = 30000;
+
+  explicit TransportFeedbackAdapter(std::shared_ptr<Clock> the_clock);
+  virtual ~TransportFeedbackAdapter();
+
+  // Returns the transport-wide sequence number of a packet that is being sent
+  uint16_t onPacketSent(size_t payload_size);
+  // Returns true when the feedback updated the estimate
+  bool onTransportFeedback(RtcpHeader *chead);
+  void onRttUpdate(int64_t rtt_ms);
+
+  bool hasEstimate() const {
+    return has_estimate_;
+  }
+  uint32_t getEstimate() const {
+    return estimated_bitrate_;
+  }
+
+  // webrtc::RemoteBitrateObserver
+  void OnReceiveBitrateChanged(const std::vector<uint32_t>& ssrcs, uint32_t bitrate) override;
+
+ private:
+  std::shared_ptr<Clock> clock_;
+  std::unique_ptr<webrtc::Clock> webrtc_clock_;
+  webrtc::SendTimeHistory send_time_history_;
+  std::unique_ptr<webrtc::RemoteBitrateEstimator> estimator_;
+  uint16_t next_sequence_number_;
+  int64_t last_feedback_base_time_us_;
+  int64_t feedback_time_offset_ms_;
+  bool has_estimate_;
+  bool estimate_updated_;
+  uint32_t estimated_bitrate_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_RTP_TRANSPORTFEEDBACKADAPTER_H_
@@ -5,6 +5,8 @@
 #include <map>
 #include <vector>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 #include "lib/Clock.h"
 
@@ -28,6 +30,29 @@ class StatNode {
     node_map_.insert(std::make_pair(key, std::make_shared<Node>(std::forward<Node>(stat))));
   }
 
+  // Returns a typed handle to a child, inserting stat if there is none or it has another type. Hot paths
+  // resolve their handles once and update them without walking the tree.
+  template <typename Node>
+  std::shared_ptr<typename std::decay<Node>::type> getOrInsertStat(std::string key, Node&& stat) {  // NOLINT
+    typedef typename std::decay<Node>::type NodeType;
+    if (std::shared_ptr<NodeType> child = getStat<NodeType>(key)) {
+      return child;
+    }
+    std::shared_ptr<NodeType> child = std::make_shared<NodeType>(std::forward<Node>(stat));
+    node_map_[key] = child;
+    return child;
+  }
+
+  // Returns a typed handle to a child, nullptr if there is none or it has another type
+  template <typename NodeType>
+  std::shared_ptr<NodeType> getStat(std::string key) {
+    auto child = node_map_.find(key);
+    if (child == node_map_.end()) {
+      return std::shared_ptr<NodeType>();
+    }
+    return std::dynamic_pointer_cast<NodeType>(child->second);
+  }
+
   virtual bool hasChild(std::string name) { return node_map_.find(name) != node_map_.end(); }
 
   virtual bool hasChild(uint64_t value) { return hasChild(std::to_string(value)); }
@@ -38,6 +63,11 @@ class StatNode {
 
   virtual uint64_t value() { return 0; }
 
+  // Leaves hold a value instead of children, text leaves are read with text() and the rest with value()
+  virtual bool isLeaf() { return false; }
+  virtual bool isText() { return false; }
+  virtual std::string text() { return ""; }
+
   virtual const std::map<std::string, std::shared_ptr<StatNode>>& getMap() {return node_map_;}
 
   virtual std::string toString();
@@ -63,6 +93,10 @@ class StringStat : public StatNode {
 
   uint64_t value() override { return 0; }
 
+  bool isLeaf() override { return true; }
+  bool isText() override { return true; }
+  std::string text() override { return text_; }
+
  private:
   std::string text_;
 };
@@ -83,6 +117,8 @@ class CumulativeStat : public StatNode {
 
   uint64_t value() override { return total_; }
 
+  bool isLeaf() override { return true; }
+
  private:
   uint64_t total_;
 };
@@ -101,6 +137,8 @@ class RateStat : public StatNode {
 
   std::string toString() override;
 
+  bool isLeaf() override { return true; }
+
  private:
   void add(uint64_t value);
   void checkPeriod();
@@ -131,6 +169,8 @@ class MovingIntervalRateStat : public StatNode {
 
   std::string toString() override;
 
+  bool isLeaf() override { return true; }
+
 
  private:
   void add(uint64_t value);
@@ -168,6 +208,8 @@ class MovingAverageStat : public StatNode {
 
   std::string toString() override;
 
+  bool isLeaf() override { return true; }
+
  private:
   void add(uint64_t value);
   double getAverage(uint32_t sample_number);
@@ -0,0 +1,117 @@
+#include "stats/StatsDeltaEncoder.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace erizo {
+
+constexpr uint8_t StatsDeltaEncoder::kVersion;
+constexpr uint8_t StatsDeltaEncoder::kFullSnapshot;
+
+StatsDeltaEncoder::StatsDeltaEncoder() : next_id_{0}, generation_{0}, full_snapshot_{true} {
+}
+
+void StatsDeltaEncoder::reset() {
+  leaves_.clear();
+  next_id_ = 0;
+  full_snapshot_ = true;
+}
+
+std::vector<uint8_t> StatsDeltaEncoder::encode(StatNode &root) {
+  generation_++;
+  std::string path;
+  std::vector<uint8_t> keys;
+  std::vector<uint8_t> changes;
+  uint32_t key_count = 0;
+  uint32_t change_count = 0;
+  encodeNode(root, &path, &keys, &changes, &key_count, &change_count);
+
+  for (auto leaf = leaves_.begin(); leaf != leaves_.end();) {
+    if (leaf->second.generation != generation_) {
+      writeVarint(leaf->second.id, &changes);
+      changes.push_back(kRemoved);
+      change_count++;
+      leaf = leaves_.erase(leaf);
+    } else {
+      ++leaf;
+    }
+  }
+
+  std::vector<uint8_t> delta;
+  if (change_count == 0 && !full_snapshot_) {
+    return delta;
+  }
+  delta.reserve(keys.size() + changes.size() + 12);
+  delta.push_back(kVersion);
+  delta.push_back(full_snapshot_ ? kFullSnapshot : 0);
+  writeVarint(key_count, &delta);
+  delta.insert(delta.end(), keys.begin(), keys.end());
+  writeVarint(change_count, &delta);
+  delta.insert(delta.end(), changes.begin(), changes.end());
+  full_snapshot_ = false;
+  return delta;
+}
+
+void StatsDeltaEncoder::encodeNode(StatNode &node, std::string *path, std::vector<uint8_t> *keys,
+                                   std::vector<uint8_t> *changes, uint32_t *key_count, uint32_t *change_count) {
+  for (const auto &child : node.getMap()) {
+    const std::string::size_type parent_length = path->size();
+    if (parent_length > 0) {
+      path->push_back('.');
+    }
+    path->append(child.first);
+    StatNode &child_node = *child.second;
+    if (!child_node.isLeaf()) {
+      encodeNode(child_node, path, keys, changes, key_count, change_count);
+      path->resize(parent_length);
+      continue;
+    }
+
+    auto leaf = leaves_.find(*path);
+    bool is_new = leaf == leaves_.end();
+    if (is_new) {
+      leaf = leaves_.emplace(*path, Leaf{next_id_++, 0, "", generation_}).first;
+      writeVarint(leaf->second.id, keys);
+      writeString(*path, keys);
+      (*key_count)++;
+    }
+    Leaf &state = leaf->second;
+    state.generation = generation_;
+    if (child_node.isText()) {
+      std::string text = child_node.text();
+      if (is_new || text != state.text) {
+        state.text = text;
+        writeVarint(state.id, changes);
+        changes->push_back(kText);
+        writeString(text, changes);
+        (*change_count)++;
+      }
+    } else {
+      uint64_t value = child_node.value();
+      if (is_new || value != state.value) {
+        state.value = value;
+        writeVarint(state.id, changes);
+        changes->push_back(kNumber);
+        writeVarint(value, changes);
+        (*change_count)++;
+      }
+    }
+    path->resize(parent_length);
+  }
+}
+
+void StatsDeltaEncoder::writeVarint(uint64_t value, std::vector<uint8_t> *buffer) {
+  while (value >= 0x80) {
+    buffer->push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  buffer->push_back(static_cast<uint8_t>(value));
+}
+
+void StatsDeltaEncoder::writeString(const std::string &text, std::vector<uint8_t> *buffer) {
+  writeVarint(text.size(), buffer);
+  buffer->insert(buffer->end(), text.begin(), text.end());
+}
+
+}  // namespace erizo
@@ -0,0 +1,59 @@
+#ifndef ERIZO_SRC_ERIZO_STATS_STATSDELTAENCODER_H_
+#define ERIZO_SRC_ERIZO_STATS_STATSDELTAENCODER_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "stats/StatNode.h"
+
+namespace erizo {
+
+/**
+ * Encodes the leaves of a StatNode tree that changed since the previous call, so consumers keep their own copy
+ * of the tree and apply small binary deltas instead of parsing the whole tree as JSON.
+ *
+ * Integers are unsigned LEB128 varints. A delta is:
+ *   uint8 version, uint8 flags (kFullSnapshot if the consumer must drop its copy first),
+ *   varint key count, then for each key: varint id, varint path length, path (node names joined with '.'),
+ *   varint change count, then for each change: varint id, uint8 type and, for kNumber a varint, for kText
+ *   a varint length and the text, nothing for kRemoved.
+ * Keys are sent once, the first time their path is seen.
+ */
+class StatsDeltaEncoder {
+ public:
+  static constexpr uint8_t kVersion = 1;
+  static constexpr uint8_t kFullSnapshot = 1;
+
+  enum ChangeType : uint8_t { kNumber = 0, kText = 1, kRemoved = 2 };
+
+  StatsDeltaEncoder();
+
+  // Returns an empty vector if no leaf changed since the previous call
+  std::vector<uint8_t> encode(StatNode &root);
+
+  // The next delta will be a full snapshot
+  void reset();
+
+ private:
+  struct Leaf {
+    uint32_t id;
+    uint64_t value;
+    std::string text;
+    uint64_t generation;
+  };
+
+  void encodeNode(StatNode &node, std::string *path, std::vector<uint8_t> *keys, std::vector<uint8_t> *changes,
+                  uint32_t *key_count, uint32_t *change_count);
+  static void writeVarint(uint64_t value, std::vector<uint8_t> *buffer);
+  static void writeString(const std::string &text, std::vector<uint8_t> *buffer);
+
+  std::unordered_map<std::string, Leaf> leaves_;
+  uint32_t next_id_;
+  uint64_t generation_;
+  bool full_snapshot_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_STATS_STATSDELTAENCODER_H_
@@ -0,0 +1,144 @@
+#include "thread/HandlerProfiler.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>  // NOLINT
+#endif
+
+#include <string>
+
+namespace erizo {
+
+constexpr uint32_t HandlerProfiler::kDefaultSamplingInterval;
+
+static std::atomic<uint32_t> sampling_interval{HandlerProfiler::kDefaultSamplingInterval};
+static std::atomic<uint64_t> next_profiler_id{1};
+static thread_local HandlerProfiler *current_profiler = nullptr;
+
+HandlerProfiler::Entry::Entry(HandlerProfiler *profiler) : profiler_{profiler} {
+  for (size_t call = 0; call < kNumCalls; call++) {
+    calls_[call] = 0;
+    sampled_calls_[call] = 0;
+    sampled_cycles_[call] = 0;
+    reset_calls_[call] = 0;
+    reset_sampled_calls_[call] = 0;
+    reset_sampled_cycles_[call] = 0;
+  }
+}
+
+HandlerProfiler::Scope::Scope(Entry *entry, Call call)
+    : entry_{entry}, call_{call}, sampled_{false}, start_{0}, nested_cycles_{0} {
+  if (!entry_) {
+    return;
+  }
+  HandlerProfiler *profiler = entry_->profiler_;
+  increment(&entry_->calls_[call_], 1);
+  // Whole dispatches are sampled, so the handlers a sampled handler calls are timed too and can be subtracted
+  if (profiler->depth_++ == 0) {
+    uint32_t interval = sampling_interval.load(std::memory_order_relaxed);
+    profiler->sampling_ = interval > 0 && ++profiler->dispatches_ % interval == 0;
+  }
+  if (profiler->sampling_) {
+    sampled_ = true;
+    nested_cycles_ = profiler->nested_cycles_;
+    start_ = readCycles();
+  }
+}
+
+HandlerProfiler::Scope::~Scope() {
+  if (!entry_) {
+    return;
+  }
+  HandlerProfiler *profiler = entry_->profiler_;
+  if (sampled_) {
+    uint64_t elapsed = readCycles() - start_;
+    uint64_t nested = profiler->nested_cycles_ - nested_cycles_;
+    increment(&entry_->sampled_calls_[call_], 1);
+    increment(&entry_->sampled_cycles_[call_], elapsed > nested ? elapsed - nested : 0);
+    profiler->nested_cycles_ = nested_cycles_ + elapsed;
+  }
+  profiler->depth_--;
+}
+
+HandlerProfiler::HandlerProfiler()
+    : id_{next_profiler_id++}, depth_{0}, sampling_{false}, dispatches_{0}, nested_cycles_{0} {
+}
+
+HandlerProfiler* HandlerProfiler::current() {
+  if (sampling_interval.load(std::memory_order_relaxed) == 0) {
+    return nullptr;
+  }
+  return current_profiler;
+}
+
+void HandlerProfiler::setCurrent(HandlerProfiler *profiler) {
+  current_profiler = profiler;
+}
+
+void HandlerProfiler::setSamplingInterval(uint32_t interval) {
+  sampling_interval = interval;
+}
+
+uint32_t HandlerProfiler::getSamplingInterval() {
+  return sampling_interval;
+}
+
+HandlerProfiler::Entry* HandlerProfiler::getEntry(const std::string &handler_name) {
+  std::lock_guard<std::mutex> lock(entries_mutex_);
+  std::unique_ptr<Entry> &entry = entries_[handler_name];
+  if (!entry) {
+    entry.reset(new Entry(this));
+  }
+  return entry.get();
+}
+
+HandlerProfiler::Snapshot HandlerProfiler::getSnapshot() {
+  Snapshot snapshot;
+  std::lock_guard<std::mutex> lock(entries_mutex_);
+  for (const auto &name_and_entry : entries_) {
+    const Entry &entry = *name_and_entry.second;
+    Costs &costs = snapshot[name_and_entry.first];
+    for (size_t call = 0; call < kNumCalls; call++) {
+      uint64_t calls = entry.calls_[call].load(std::memory_order_relaxed) - entry.reset_calls_[call];
+      uint64_t sampled_calls = entry.sampled_calls_[call].load(std::memory_order_relaxed) -
+        entry.reset_sampled_calls_[call];
+      uint64_t sampled_cycles = entry.sampled_cycles_[call].load(std::memory_order_relaxed) -
+        entry.reset_sampled_cycles_[call];
+      costs[call].calls = calls;
+      costs[call].cycles = sampled_calls == 0 ? 0 :
+        static_cast<uint64_t>(static_cast<double>(sampled_cycles) * calls / sampled_calls);
+    }
+  }
+  return snapshot;
+}
+
+// Clearing the counters from here would race with the profiler thread, which adds with a plain load and store, so
+// the current values are kept as the base that later snapshots subtract
+void HandlerProfiler::reset() {
+  std::lock_guard<std::mutex> lock(entries_mutex_);
+  for (const auto &name_and_entry : entries_) {
+    Entry &entry = *name_and_entry.second;
+    for (size_t call = 0; call < kNumCalls; call++) {
+      entry.reset_calls_[call] = entry.calls_[call].load(std::memory_order_relaxed);
+      entry.reset_sampled_calls_[call] = entry.sampled_calls_[call].load(std::memory_order_relaxed);
+      entry.reset_sampled_cycles_[call] = entry.sampled_cycles_[call].load(std::memory_order_relaxed);
+    }
+  }
+}
+
+uint64_t HandlerProfiler::readCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Only the profiler thread writes, so a relaxed load and store is enough and avoids a locked instruction
+void HandlerProfiler::increment(std::atomic<uint64_t> *counter, uint64_t value) {
+  counter->store(counter->load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+}  // namespace erizo
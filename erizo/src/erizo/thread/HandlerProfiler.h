@@ -0,0 +1,105 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_HANDLERPROFILER_H_
+#define ERIZO_SRC_ERIZO_THREAD_HANDLERPROFILER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+
+namespace erizo {
+
+/**
+ * Counts the calls each pipeline handler gets in a worker and how many CPU cycles it spends in them, not counting
+ * the handlers it calls. Every call is counted but only the packets in one of every getSamplingInterval()
+ * dispatches are timed, and the timed cycles are scaled up to all the calls, so it can stay enabled in production.
+ *
+ * Workers install their profiler in their thread; it is only written from there and can be read from any thread.
+ */
+class HandlerProfiler {
+ public:
+  enum Call { kRead = 0, kWrite, kNotifyUpdate, kNumCalls };
+
+  struct Cost {
+    uint64_t calls;
+    // Estimated for all the calls from the sampled ones
+    uint64_t cycles;
+  };
+
+  using Costs = std::array<Cost, kNumCalls>;
+  // Costs by handler name
+  using Snapshot = std::map<std::string, Costs>;
+
+  class Entry {
+   public:
+    explicit Entry(HandlerProfiler *profiler);
+
+   private:
+    friend class HandlerProfiler;
+    HandlerProfiler *profiler_;
+    std::array<std::atomic<uint64_t>, kNumCalls> calls_;
+    std::array<std::atomic<uint64_t>, kNumCalls> sampled_calls_;
+    std::array<std::atomic<uint64_t>, kNumCalls> sampled_cycles_;
+    // Values at the last reset(), guarded by entries_mutex_. The counters are never cleared since only the
+    // profiler thread may write them
+    std::array<uint64_t, kNumCalls> reset_calls_;
+    std::array<uint64_t, kNumCalls> reset_sampled_calls_;
+    std::array<uint64_t, kNumCalls> reset_sampled_cycles_;
+  };
+
+  // Measures a handler call while it is in scope, does nothing if entry is nullptr
+  class Scope {
+   public:
+    Scope(Entry *entry, Call call);
+    ~Scope();
+
+   private:
+    Entry *entry_;
+    Call call_;
+    bool sampled_;
+    uint64_t start_;
+    uint64_t nested_cycles_;
+  };
+
+  HandlerProfiler();
+
+  // The profiler of the worker running in this thread, nullptr if there is none or profiling is disabled
+  static HandlerProfiler* current();
+  static void setCurrent(HandlerProfiler *profiler);
+
+  // One of every interval dispatches is timed, 0 disables profiling. Defaults to kDefaultSamplingInterval
+  static void setSamplingInterval(uint32_t interval);
+  static uint32_t getSamplingInterval();
+
+  // Unique among all the profilers ever created, so callers can cache entries
+  uint64_t getId() const { return id_; }
+
+  // Must be called from the thread the profiler is installed in
+  Entry* getEntry(const std::string &handler_name);
+
+  // Costs since the last reset(), both can be called from any thread
+  Snapshot getSnapshot();
+  void reset();
+
+  static uint64_t readCycles();
+
+  static constexpr uint32_t kDefaultSamplingInterval = 64;
+
+ private:
+  static void increment(std::atomic<uint64_t> *counter, uint64_t value);
+
+  const uint64_t id_;
+  std::mutex entries_mutex_;
+  std::map<std::string, std::unique_ptr<Entry>> entries_;
+  // Only used from the profiler thread
+  uint32_t depth_;
+  bool sampling_;
+  uint64_t dispatches_;
+  uint64_t nested_cycles_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_HANDLERPROFILER_H_
@@ -5,6 +5,9 @@
 
 using erizo::IOThreadPool;
 using erizo::IOWorker;
+using erizo::TaskLatency;
+using erizo::NicerBatchSocket;
+using erizo::SocketBatchStats;
 
 IOThreadPool::IOThreadPool(unsigned int num_io_workers)
     : io_workers_{} {
@@ -44,3 +47,22 @@ void IOThreadPool::close() {
     io_worker->close();
   }
 }
+
+void IOThreadPool::resetStats() {
+  for (auto io_worker : io_workers_) {
+    io_worker->resetStats();
+  }
+  NicerBatchSocket::resetStats();
+}
+
+std::vector<TaskLatency> IOThreadPool::getTaskLatencies() {
+  std::vector<TaskLatency> latencies;
+  for (auto io_worker : io_workers_) {
+    latencies.push_back(io_worker->getTaskLatency());
+  }
+  return latencies;
+}
+
+SocketBatchStats IOThreadPool::getSocketBatchStats() {
+  return NicerBatchSocket::getStats();
+}
@@ -4,8 +4,8 @@
 #include <memory>
 #include <vector>
 
+#include "lib/NicerBatchSocket.h"
 #include "thread/IOWorker.h"
-#include "thread/Scheduler.h"
 
 namespace erizo {
 
@@ -18,6 +18,12 @@ class IOThreadPool {
   void start();
   void close();
 
+  void resetStats();
+  // One per worker, in creation order
+  std::vector<TaskLatency> getTaskLatencies();
+  // Batched UDP sends and reads of every worker
+  SocketBatchStats getSocketBatchStats();
+
  private:
   std::vector<std::shared_ptr<IOWorker>> io_workers_;
 };
@@ -6,15 +6,41 @@ extern "C" {
 #include <async_timer.h>
 }
 
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
 #include <chrono>  // NOLINT
 
+#include "lib/NicerBatchSocket.h"
+
 using erizo::IOWorker;
+using erizo::NicerBatchSocket;
+using erizo::TaskLatency;
+using erizo::TaskOriginScope;
 
-IOWorker::IOWorker() : started_{false}, closed_{false} {
+IOWorker::IOWorker() : started_{false}, closed_{false}, wake_up_pending_{false}, wake_up_fds_{-1, -1},
+    queued_tasks_{0} {
+#ifdef __linux__
+  wake_up_fds_[0] = wake_up_fds_[1] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#else
+  if (pipe(wake_up_fds_) == 0) {
+    fcntl(wake_up_fds_[0], F_SETFL, O_NONBLOCK);
+    fcntl(wake_up_fds_[1], F_SETFL, O_NONBLOCK);
+  }
+#endif
 }
 
 IOWorker::~IOWorker() {
   close();
+  if (wake_up_fds_[0] >= 0) {
+    ::close(wake_up_fds_[0]);
+  }
+  if (wake_up_fds_[1] >= 0 && wake_up_fds_[1] != wake_up_fds_[0]) {
+    ::close(wake_up_fds_[1]);
+  }
 }
 
 void IOWorker::start() {
@@ -28,9 +54,12 @@ void IOWorker::start(std::shared_ptr<std::promise<void>> start_promise) {
   }
 
   thread_ = std::unique_ptr<std::thread>(new std::thread([this, start_promise] {
+    TaskOriginScope::setThreadDefault(erizo::kInternalTask);
+    watchWakeUpEvents();
     start_promise->set_value();
     while (!closed_) {
       int events;
+      // Timers still need the timeout, new tasks wake the loop up through the wake up fd
       struct timeval towait = {0, 100000};
       struct timeval tv;
       int r = NR_async_event_wait2(&events, &towait);
@@ -39,28 +68,75 @@ void IOWorker::start(std::shared_ptr<std::promise<void>> start_promise) {
       }
       gettimeofday(&tv, 0);
       NR_async_timer_update_time(&tv);
-      std::vector<Task> tasks;
-      {
-        std::unique_lock<std::mutex> lock(task_mutex_);
-        tasks.swap(tasks_);
-      }
-      for (Task &task : tasks) {
-        task();
-      }
+      runTasks();
+    }
+    if (wake_up_fds_[0] >= 0) {
+      NR_async_cancel(wake_up_fds_[0], NR_ASYNC_WAIT_READ);
     }
   }));
 }
 
+void IOWorker::runTasks() {
+  wake_up_pending_.store(false);
+  // Datagrams sent by the tasks of this iteration go out together when it ends
+  NicerBatchSocket::SendBatch send_batch;
+  tasks_.consumeAll([this](QueuedTask &queued_task) {
+    queued_tasks_--;
+    time_point start = clock::now();
+    task_latency_.recordDelay(queued_task.origin, start - queued_task.queued_at);
+    queued_task.task();
+    task_latency_.recordDuration(queued_task.origin, clock::now() - start);
+  });
+}
+
 void IOWorker::task(Task f) {
-  std::unique_lock<std::mutex> lock(task_mutex_);
-  tasks_.push_back(f);
+  queued_tasks_++;
+  tasks_.push(QueuedTask{std::move(f), clock::now(), TaskOriginScope::current()});
+  if (!wake_up_pending_.exchange(true)) {
+    wakeUp();
+  }
+}
+
+TaskLatency IOWorker::getTaskLatency() {
+  TaskLatency task_latency = task_latency_;
+  task_latency.queued_tasks = queued_tasks_;
+  return task_latency;
+}
+
+void IOWorker::resetStats() {
+  task_latency_.reset();
+}
+
+void IOWorker::wakeUp() {
+  if (wake_up_fds_[1] < 0) {
+    return;
+  }
+  uint64_t value = 1;
+  ssize_t written = write(wake_up_fds_[1], &value, sizeof(value));
+  (void) written;
+}
+
+void IOWorker::watchWakeUpEvents() {
+  if (wake_up_fds_[0] >= 0) {
+    NR_ASYNC_WAIT(wake_up_fds_[0], NR_ASYNC_WAIT_READ, &IOWorker::onWakeUpEvent, this);
+  }
+}
+
+void IOWorker::onWakeUpEvent(int fd, int how, void *arg) {
+  IOWorker *io_worker = reinterpret_cast<IOWorker*>(arg);
+  uint64_t value;
+  while (read(fd, &value, sizeof(value)) > 0) {
+  }
+  // nICEr waits are one shot, so it has to be registered again
+  io_worker->watchWakeUpEvents();
 }
 
 void IOWorker::close() {
   if (!closed_.exchange(true)) {
     if (thread_ != nullptr) {
+      wakeUp();
       thread_->join();
     }
-    tasks_.clear();
+    tasks_.consumeAll([](QueuedTask&) {});
   }
 }
@@ -8,6 +8,10 @@
 #include <thread>  // NOLINT
 #include <vector>
 
+#include "lib/Clock.h"
+#include "thread/MpscQueue.h"
+#include "thread/TaskLatency.h"
+
 namespace erizo {
 
 class IOWorker : public std::enable_shared_from_this<IOWorker> {
@@ -22,12 +26,31 @@ class IOWorker : public std::enable_shared_from_this<IOWorker> {
 
   virtual void task(Task f);
 
+  // How long tasks waited in the queue and ran, by origin, plus the current queue depth
+  TaskLatency getTaskLatency();
+  void resetStats();
+
+ private:
+  struct QueuedTask {
+    Task task;
+    time_point queued_at;
+    TaskOrigin origin;
+  };
+
+  void runTasks();
+  void wakeUp();
+  void watchWakeUpEvents();
+  static void onWakeUpEvent(int fd, int how, void *arg);
+
  private:
   std::atomic<bool> started_;
   std::atomic<bool> closed_;
   std::unique_ptr<std::thread> thread_;
-  std::vector<Task> tasks_;
-  mutable std::mutex task_mutex_;
+  MpscQueue<QueuedTask> tasks_;
+  std::atomic<bool> wake_up_pending_;
+  int wake_up_fds_[2];
+  std::atomic<uint64_t> queued_tasks_;
+  TaskLatency task_latency_;
 };
 }  // namespace erizo
 
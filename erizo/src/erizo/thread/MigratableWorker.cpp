@@ -0,0 +1,176 @@
+#include "thread/MigratableWorker.h"
+
+#include <memory>
+#include <utility>
+
+using erizo::MigratableWorker;
+using erizo::Worker;
+using erizo::ScheduledTaskReference;
+using erizo::TaskOriginScope;
+using erizo::duration;
+
+/**
+ * Owned by the drain marker posted to the old target, so the migration always ends when the marker is gone:
+ * in the new target if the old one got to run it, or back in the old one if it was dropped without running.
+ */
+class MigratableWorker::Migration {
+ public:
+  Migration(std::shared_ptr<MigratableWorker> worker, std::shared_ptr<Worker> old_target,
+            std::shared_ptr<Worker> new_target)
+      : worker_{worker}, old_target_{old_target}, new_target_{new_target}, drained_{false} {
+  }
+
+  ~Migration() {
+    worker_->finishMigration(drained_ ? new_target_ : old_target_);
+    promise_.set_value(drained_);
+  }
+
+  void setDrained() { drained_ = true; }
+  boost::future<bool> getFuture() { return promise_.get_future(); }
+
+ private:
+  std::shared_ptr<MigratableWorker> worker_;
+  std::shared_ptr<Worker> old_target_;
+  std::shared_ptr<Worker> new_target_;
+  bool drained_;
+  boost::promise<bool> promise_;
+};
+
+MigratableWorker::MigratableWorker(std::shared_ptr<Worker> target, std::shared_ptr<Clock> the_clock)
+    : Worker(the_clock), target_{target}, migrating_{false}, busy_time_us_{0} {
+}
+
+void MigratableWorker::task(Task f) {
+  forward(measuredTask(std::move(f)), false);
+}
+
+void MigratableWorker::post(Task f) {
+  forward(measuredTask(std::move(f)), true);
+}
+
+void MigratableWorker::forward(Task f, bool always_queue) {
+  std::shared_ptr<Worker> target;
+  {
+    std::lock_guard<std::mutex> lock(target_mutex_);
+    if (migrating_) {
+      pending_tasks_.push_back(PendingTask{std::move(f), TaskOriginScope::current()});
+      return;
+    }
+    // Queued with the lock held, so a migration can not start in between and miss it when draining the target
+    if (always_queue || target_->getId() != boost::this_thread::get_id()) {
+      target_->post(std::move(f));
+      return;
+    }
+    target = target_;
+  }
+  // We are in the target thread, no migration can finish before we return
+  target->task(std::move(f));
+}
+
+MigratableWorker::Task MigratableWorker::measuredTask(Task f) {
+  std::weak_ptr<Worker> weak_this = shared_from_this();
+  return [f, weak_this] {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    if (auto this_ptr = weak_this.lock()) {
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      std::static_pointer_cast<MigratableWorker>(this_ptr)->busy_time_us_ +=
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    }
+  };
+}
+
+void MigratableWorker::start() {
+}
+
+void MigratableWorker::start(std::shared_ptr<std::promise<void>> start_promise) {
+  start_promise->set_value();
+}
+
+void MigratableWorker::close() {
+}
+
+boost::thread::id MigratableWorker::getId() {
+  return getTarget()->getId();
+}
+
+std::shared_ptr<ScheduledTaskReference> MigratableWorker::scheduleFromNow(Task f, duration delta) {
+  std::weak_ptr<MigratableWorker> weak_this = std::static_pointer_cast<MigratableWorker>(shared_from_this());
+  std::shared_ptr<Worker> target = getTarget();
+  Worker *timer_target = target.get();
+  // The timer lives in the current target, but the task runs wherever the target is when it expires
+  return target->scheduleFromNow([weak_this, f, timer_target] {
+    if (auto this_ptr = weak_this.lock()) {
+      this_ptr->runScheduledTask(f, timer_target);
+    }
+  }, delta);
+}
+
+void MigratableWorker::runScheduledTask(const Task &f, Worker *timer_target) {
+  bool is_in_target;
+  {
+    std::lock_guard<std::mutex> lock(target_mutex_);
+    is_in_target = !migrating_ && target_.get() == timer_target;
+  }
+  if (is_in_target) {
+    // The worker that ran the timer already accounts it as a timer task
+    measuredTask(f)();
+    return;
+  }
+  TaskOriginScope scope{erizo::kTimerTask};
+  forward(measuredTask(f), true);
+}
+
+void MigratableWorker::unschedule(std::shared_ptr<ScheduledTaskReference> id) {
+  // The timer is in the wheel of the target we had when it was scheduled, that might not be the current one
+  if (std::shared_ptr<Worker> owner = id->getOwner()) {
+    owner->unschedule(id);
+  } else {
+    id->cancel();
+  }
+}
+
+void MigratableWorker::addProcessedPackets(uint64_t packets) {
+  getTarget()->addProcessedPackets(packets);
+}
+
+std::shared_ptr<Worker> MigratableWorker::getTarget() {
+  std::lock_guard<std::mutex> lock(target_mutex_);
+  return target_;
+}
+
+boost::future<bool> MigratableWorker::migrateTo(std::shared_ptr<Worker> new_target) {
+  std::shared_ptr<Worker> old_target;
+  {
+    std::lock_guard<std::mutex> lock(target_mutex_);
+    if (!migrating_ && target_ != new_target) {
+      migrating_ = true;
+      old_target = target_;
+    }
+  }
+  if (!old_target) {
+    boost::promise<bool> not_migrated;
+    not_migrated.set_value(false);
+    return not_migrated.get_future();
+  }
+
+  auto migration = std::make_shared<Migration>(std::static_pointer_cast<MigratableWorker>(shared_from_this()),
+                                               old_target, new_target);
+  boost::future<bool> migrated = migration->getFuture();
+  // Every task forwarded to the old target was queued before this marker, the ones that come later wait here
+  old_target->post([migration] {
+    migration->setDrained();
+  });
+  return migrated;
+}
+
+void MigratableWorker::finishMigration(std::shared_ptr<Worker> target) {
+  std::lock_guard<std::mutex> lock(target_mutex_);
+  for (PendingTask &pending_task : pending_tasks_) {
+    TaskOriginScope scope{pending_task.origin};
+    target->post(std::move(pending_task.task));
+  }
+  pending_tasks_.clear();
+  target_ = target;
+  migrating_ = false;
+}
@@ -0,0 +1,70 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_MIGRATABLEWORKER_H_
+#define ERIZO_SRC_ERIZO_THREAD_MIGRATABLEWORKER_H_
+
+#include <boost/thread/future.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "thread/Worker.h"
+
+namespace erizo {
+
+/**
+ * A Worker that forwards its tasks to another Worker (the target) that can be changed at runtime, it has no thread
+ * nor event loop of its own. Objects keep a reference to this worker, so their tasks and scheduled tasks
+ * (scheduleEvery, scheduleFromNow) follow the target when it is migrated.
+ */
+class MigratableWorker : public Worker {
+ public:
+  explicit MigratableWorker(std::shared_ptr<Worker> target,
+                            std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
+
+  using Worker::task;
+  void task(Task f) override;
+  void post(Task f) override;
+  void start() override;
+  void start(std::shared_ptr<std::promise<void>> start_promise) override;
+  void close() override;
+  boost::thread::id getId() override;
+  std::shared_ptr<ScheduledTaskReference> scheduleFromNow(Task f, duration delta) override;
+  void unschedule(std::shared_ptr<ScheduledTaskReference> id) override;
+  void addProcessedPackets(uint64_t packets = 1) override;
+
+  std::shared_ptr<Worker> getTarget();
+  uint64_t getBusyTimeMicroseconds() { return busy_time_us_; }
+
+  /**
+   * Moves the execution of the tasks to a new target without running them concurrently nor dropping them.
+   * Tasks queued meanwhile are kept here and handed to the new target, in order, once the old one has run
+   * every task it had queued, so no worker ever waits for the other.
+   * @return A future that will be true once migrated, or false if it could not be done.
+   */
+  boost::future<bool> migrateTo(std::shared_ptr<Worker> new_target);
+
+ private:
+  class Migration;
+
+  struct PendingTask {
+    Task task;
+    TaskOrigin origin;
+  };
+
+  Task measuredTask(Task f);
+  void forward(Task f, bool always_queue);
+  void runScheduledTask(const Task &f, Worker *timer_target);
+  void finishMigration(std::shared_ptr<Worker> target);
+
+ private:
+  std::mutex target_mutex_;
+  std::shared_ptr<Worker> target_;
+  bool migrating_;
+  std::vector<PendingTask> pending_tasks_;
+  std::atomic<uint64_t> busy_time_us_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_MIGRATABLEWORKER_H_
@@ -0,0 +1,72 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_MPSCQUEUE_H_
+#define ERIZO_SRC_ERIZO_THREAD_MPSCQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace erizo {
+
+/**
+ * Lock-free multiple producer, single consumer queue.
+ * Producers push onto an atomic stack, the consumer takes the whole stack at once and reverses it,
+ * so elements are consumed in the order they were pushed.
+ */
+template <class T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_{nullptr} {}
+
+  ~MpscQueue() {
+    consumeAll([](T&) {});
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  void push(T value) {
+    Node *node = new Node(std::move(value));
+    node->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+  }
+
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) == nullptr;
+  }
+
+  // Must only be called from the consumer thread. Returns the number of consumed elements.
+  template <class F>
+  size_t consumeAll(F consumer) {
+    Node *node = head_.exchange(nullptr, std::memory_order_acquire);
+    Node *reversed = nullptr;
+    while (node) {
+      Node *next = node->next;
+      node->next = reversed;
+      reversed = node;
+      node = next;
+    }
+    size_t count = 0;
+    while (reversed) {
+      Node *next = reversed->next;
+      consumer(reversed->value);
+      delete reversed;
+      reversed = next;
+      count++;
+    }
+    return count;
+  }
+
+ private:
+  struct Node {
+    explicit Node(T value_) : value{std::move(value_)}, next{nullptr} {}
+    T value;
+    Node *next;
+  };
+
+  std::atomic<Node*> head_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_MPSCQUEUE_H_
@@ -0,0 +1,136 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_RCUPOINTER_H_
+#define ERIZO_SRC_ERIZO_THREAD_RCUPOINTER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+namespace erizo {
+
+/**
+ * Pointer to an immutable value that is read without locks and replaced as a whole (read-copy-update).
+ *
+ * Readers hold a ReadGuard while they use the value, which only increments the reader counter of the current
+ * epoch. update() never waits for readers, it retires the previous value and it gets deleted, by the writer or
+ * by the last reader that leaves, once the epoch could be advanced twice: each advance needs the counter of the
+ * previous epoch to be empty, so by then every reader that could see the retired value is gone.
+ * Readers may call update(), e.g. to remove themselves from the list they are being called from.
+ */
+template <class T>
+class RcuPointer {
+ public:
+  class ReadGuard {
+   public:
+    ReadGuard(RcuPointer *pointer, unsigned slot, const T *value) : pointer_{pointer}, slot_{slot}, value_{value} {}
+    ReadGuard(ReadGuard &&other) : pointer_{other.pointer_}, slot_{other.slot_}, value_{other.value_} {
+      other.pointer_ = nullptr;
+    }
+    ~ReadGuard() {
+      if (pointer_) {
+        pointer_->release(slot_);
+      }
+    }
+
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+    ReadGuard& operator=(ReadGuard&&) = delete;
+
+    const T& operator*() const { return *value_; }
+    const T* operator->() const { return value_; }
+
+   private:
+    RcuPointer *pointer_;
+    unsigned slot_;
+    const T *value_;
+  };
+
+  explicit RcuPointer(std::unique_ptr<const T> value) : value_{value.release()}, epoch_{0}, readers_{{0}, {0}},
+      has_retired_{false} {}
+  ~RcuPointer() {
+    delete value_.load();
+    for (const Retired &retired : retired_) {
+      delete retired.value;
+    }
+  }
+
+  RcuPointer(const RcuPointer&) = delete;
+  RcuPointer& operator=(const RcuPointer&) = delete;
+
+  ReadGuard read() {
+    unsigned slot = epoch_.load() & 1;
+    readers_[slot].fetch_add(1);
+    // Sequentially consistent with update(): either a reclaim sees this reader or this reader sees the new value
+    return ReadGuard(this, slot, value_.load());
+  }
+
+  void update(std::unique_ptr<const T> value) {
+    const T *previous = value_.exchange(value.release());
+    std::vector<const T*> reclaimed;
+    {
+      std::lock_guard<std::mutex> lock(reclaim_mutex_);
+      retired_.push_back(Retired{epoch_.load(), previous});
+      has_retired_.store(true);
+      reclaim(&reclaimed);
+    }
+    deleteAll(reclaimed);
+  }
+
+ private:
+  struct Retired {
+    uint64_t epoch;
+    const T *value;
+  };
+
+  void release(unsigned slot) {
+    readers_[slot].fetch_sub(1);
+    if (!has_retired_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    std::vector<const T*> reclaimed;
+    {
+      // Readers never wait, whoever holds the mutex is already reclaiming
+      std::unique_lock<std::mutex> lock(reclaim_mutex_, std::try_to_lock);
+      if (lock.owns_lock()) {
+        reclaim(&reclaimed);
+      }
+    }
+    deleteAll(reclaimed);
+  }
+
+  // Must be called with reclaim_mutex_ held, values are deleted outside it in case their destructors read this
+  void reclaim(std::vector<const T*> *reclaimed) {
+    uint64_t epoch = epoch_.load();
+    for (int advance = 0; advance < 2 && !retired_.empty() && retired_.front().epoch + 2 > epoch; advance++) {
+      if (readers_[(epoch + 1) & 1].load() != 0) {
+        break;
+      }
+      epoch_.store(++epoch);
+    }
+    while (!retired_.empty() && retired_.front().epoch + 2 <= epoch) {
+      reclaimed->push_back(retired_.front().value);
+      retired_.pop_front();
+    }
+    has_retired_.store(!retired_.empty());
+  }
+
+  static void deleteAll(const std::vector<const T*> &values) {
+    for (const T *value : values) {
+      delete value;
+    }
+  }
+
+  std::atomic<const T*> value_;
+  std::atomic<uint64_t> epoch_;
+  std::atomic<unsigned> readers_[2];
+  std::mutex reclaim_mutex_;
+  std::deque<Retired> retired_;
+  std::atomic<bool> has_retired_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_RCUPOINTER_H_
@@ -0,0 +1,75 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_SPSCQUEUE_H_
+#define ERIZO_SRC_ERIZO_THREAD_SPSCQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "thread/SpscRing.h"
+
+namespace erizo {
+
+/**
+ * Unbounded single producer, single consumer FIFO queue. Elements go through a lock-free SpscRing, and only when
+ * it is full they go to an overflow list protected by a mutex. Once something overflows every later element goes
+ * to the list too, until the consumer takes it, so elements are always consumed in the order they were pushed.
+ */
+template <class T>
+class SpscQueue {
+ public:
+  explicit SpscQueue(size_t ring_capacity) : ring_{ring_capacity}, overflowing_{false} {}
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  // Must only be called from the producer thread. Returns false if the element went to the overflow list
+  bool push(T value) {
+    if (!overflowing_.load(std::memory_order_acquire) && ring_.push(std::move(value))) {
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    // The consumer might have taken the overflow list meanwhile, then the ring has room again
+    if (!overflowing_.load(std::memory_order_relaxed) && ring_.push(std::move(value))) {
+      return true;
+    }
+    overflow_.push_back(std::move(value));
+    overflowing_.store(true, std::memory_order_release);
+    return false;
+  }
+
+  // Must only be called from the consumer thread. Consumes every element pushed before it was called and returns
+  // how many of them there were.
+  template <class F>
+  size_t consumeAll(F consumer) {
+    size_t consumed = ring_.consumeAll(consumer);
+    if (!overflowing_.load(std::memory_order_acquire)) {
+      return consumed;
+    }
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    // The producer stops using the ring once it overflows, so what is left there is older than the overflow list
+    consumed += ring_.consumeAll(consumer);
+    std::vector<T> overflow;
+    overflow.swap(overflow_);
+    overflowing_.store(false, std::memory_order_release);
+    for (T &value : overflow) {
+      consumer(value);
+    }
+    return consumed + overflow.size();
+  }
+
+  bool empty() const {
+    return ring_.empty() && !overflowing_.load(std::memory_order_acquire);
+  }
+
+ private:
+  SpscRing<T> ring_;
+  std::mutex overflow_mutex_;
+  std::vector<T> overflow_;
+  std::atomic<bool> overflowing_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_SPSCQUEUE_H_
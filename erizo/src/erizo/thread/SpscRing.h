@@ -0,0 +1,99 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_SPSCRING_H_
+#define ERIZO_SRC_ERIZO_THREAD_SPSCRING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace erizo {
+
+/**
+ * Bounded lock-free single producer, single consumer ring.
+ * The capacity is rounded up to a power of two. push() fails instead of blocking when the ring is full,
+ * so the producer decides what to do with the element.
+ */
+template <class T>
+class SpscRing {
+ public:
+  explicit SpscRing(size_t capacity) : slots_(roundUpToPowerOfTwo(capacity)), mask_{slots_.size() - 1},
+      head_{0}, padding_{}, tail_{0} {}
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  // Must only be called from the producer thread. The value is left untouched if the ring is full
+  bool push(T &&value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == slots_.size()) {
+      return false;
+    }
+    slots_[tail & mask_] = std::move(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool push(const T &value) {
+    T copy = value;
+    return push(std::move(copy));
+  }
+
+  // Must only be called from the consumer thread
+  bool pop(T *value) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    *value = std::move(slots_[head & mask_]);
+    slots_[head & mask_] = T();
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Must only be called from the consumer thread. Consumes the elements that were in the ring when it was called
+  // and returns how many of them there were.
+  template <class F>
+  size_t consumeAll(F consumer) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    for (size_t index = head; index != tail; index++) {
+      T value = std::move(slots_[index & mask_]);
+      slots_[index & mask_] = T();
+      head_.store(index + 1, std::memory_order_release);
+      consumer(value);
+    }
+    return tail - head;
+  }
+
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+  size_t size() const {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+
+  size_t capacity() const {
+    return slots_.size();
+  }
+
+ private:
+  static size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  std::vector<T> slots_;
+  const size_t mask_;
+  // Keeps producer and consumer indexes apart so they do not share a cache line
+  std::atomic<size_t> head_;
+  char padding_[64 - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> tail_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_SPSCRING_H_
@@ -0,0 +1,59 @@
+#include "thread/TaskLatency.h"
+
+namespace erizo {
+
+static thread_local TaskOrigin thread_default_origin = kApiTask;
+static thread_local TaskOrigin thread_origin = kNumTaskOrigins;
+
+TaskOriginScope::TaskOriginScope(TaskOrigin origin) : previous_{thread_origin} {
+  thread_origin = origin;
+}
+
+TaskOriginScope::~TaskOriginScope() {
+  thread_origin = previous_;
+}
+
+TaskOrigin TaskOriginScope::current() {
+  return thread_origin == kNumTaskOrigins ? thread_default_origin : thread_origin;
+}
+
+void TaskOriginScope::setThreadDefault(TaskOrigin origin) {
+  thread_default_origin = origin;
+}
+
+TaskLatency::TaskLatency() : queued_tasks{0} {
+}
+
+void TaskLatency::reset() {
+  for (size_t origin = 0; origin < kNumTaskOrigins; origin++) {
+    durations_[origin].reset();
+    delays_[origin].reset();
+  }
+}
+
+LatencyHistogram TaskLatency::getDurations() const {
+  LatencyHistogram durations;
+  for (const LatencyHistogram &histogram : durations_) {
+    durations += histogram;
+  }
+  return durations;
+}
+
+LatencyHistogram TaskLatency::getDelays() const {
+  LatencyHistogram delays;
+  for (const LatencyHistogram &histogram : delays_) {
+    delays += histogram;
+  }
+  return delays;
+}
+
+TaskLatency& TaskLatency::operator+=(const TaskLatency &other) {
+  queued_tasks += other.queued_tasks;
+  for (size_t origin = 0; origin < kNumTaskOrigins; origin++) {
+    durations_[origin] += other.durations_[origin];
+    delays_[origin] += other.delays_[origin];
+  }
+  return *this;
+}
+
+}  // namespace erizo
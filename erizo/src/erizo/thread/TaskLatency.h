@@ -0,0 +1,67 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_TASKLATENCY_H_
+#define ERIZO_SRC_ERIZO_THREAD_TASKLATENCY_H_
+
+#include <array>
+#include <cstdint>
+
+#include "lib/LatencyHistogram.h"
+
+namespace erizo {
+
+// What made a task be queued in a worker
+enum TaskOrigin {
+  kInternalTask = 0,  // Queued by another task of a worker
+  kPacketTask,        // Carries media or network packets
+  kTimerTask,         // A scheduled task that is due
+  kApiTask,           // Queued from a thread that is not a worker, like Node's one
+  kNumTaskOrigins
+};
+
+/**
+ * Sets the origin of the tasks queued from this thread while it is in scope. Tasks queued outside of any scope
+ * get the default origin of the thread, which is kApiTask unless the thread is a worker.
+ */
+class TaskOriginScope {
+ public:
+  explicit TaskOriginScope(TaskOrigin origin);
+  ~TaskOriginScope();
+
+  static TaskOrigin current();
+  // Workers call it from their threads with kInternalTask
+  static void setThreadDefault(TaskOrigin origin);
+
+ private:
+  TaskOrigin previous_;
+};
+
+/**
+ * Microsecond histograms of how long the tasks of a worker ran and waited in the queue before running, by origin.
+ */
+class TaskLatency {
+ public:
+  TaskLatency();
+
+  void recordDuration(TaskOrigin origin, duration task_duration) { durations_[origin].record(task_duration); }
+  void recordDelay(TaskOrigin origin, duration task_delay) { delays_[origin].record(task_delay); }
+  void reset();
+
+  const LatencyHistogram& getDurations(TaskOrigin origin) const { return durations_[origin]; }
+  const LatencyHistogram& getDelays(TaskOrigin origin) const { return delays_[origin]; }
+  // All origins together
+  LatencyHistogram getDurations() const;
+  LatencyHistogram getDelays() const;
+
+  TaskLatency& operator+=(const TaskLatency &other);
+
+ public:
+  // Tasks waiting in the queue when the latency was read
+  uint64_t queued_tasks;
+
+ private:
+  std::array<LatencyHistogram, kNumTaskOrigins> durations_;
+  std::array<LatencyHistogram, kNumTaskOrigins> delays_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_TASKLATENCY_H_
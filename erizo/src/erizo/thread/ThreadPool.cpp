@@ -1,17 +1,31 @@
 #include "thread/ThreadPool.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <vector>
 
-constexpr int kNumThreadsPerScheduler = 2;
+// Workers whose load scores differ less than this are considered equally loaded
+constexpr double kLoadScoreTolerance = 0.05;
+// Minimum load score difference between two workers to move tasks from one to the other
+constexpr double kMinLoadScoreDifferenceToRebalance = 0.1;
 
 using erizo::ThreadPool;
 using erizo::Worker;
+using erizo::ThreadWorker;
+using erizo::MigratableWorker;
 using erizo::DurationDistribution;
+using erizo::HandlerProfiler;
+using erizo::TaskLatency;
+using erizo::WorkerLoad;
 
-ThreadPool::ThreadPool(unsigned int num_workers)
-    : workers_{}, scheduler_{std::make_shared<Scheduler>(kNumThreadsPerScheduler)} {
+ThreadPool::ThreadPool(unsigned int num_workers, unsigned int num_handshake_workers)
+    : workers_{}, handshake_workers_{}, last_slow_delays_(num_workers, 0) {
   for (unsigned int index = 0; index < num_workers; index++) {
-    workers_.push_back(std::make_shared<Worker>(scheduler_));
+    workers_.push_back(std::make_shared<ThreadWorker>());
+  }
+  for (unsigned int index = 0; index < num_handshake_workers; index++) {
+    handshake_workers_.push_back(std::make_shared<ThreadWorker>());
   }
 }
 
@@ -20,22 +34,112 @@ ThreadPool::~ThreadPool() {
 }
 
 std::shared_ptr<Worker> ThreadPool::getLessUsedWorker() {
-  std::shared_ptr<Worker> chosen_worker = workers_.front();
-  for (auto worker : workers_) {
-    if (chosen_worker.use_count() > worker.use_count()) {
+  return getLessUsed(workers_);
+}
+
+std::shared_ptr<Worker> ThreadPool::getLessUsedHandshakeWorker() {
+  if (handshake_workers_.empty()) {
+    return std::shared_ptr<Worker>();
+  }
+  return getLessUsed(handshake_workers_);
+}
+
+std::shared_ptr<ThreadWorker> ThreadPool::getLessUsed(const std::vector<std::shared_ptr<ThreadWorker>> &workers) {
+  std::shared_ptr<ThreadWorker> chosen_worker = workers.front();
+  double chosen_score = chosen_worker->getLoad().getScore();
+  for (auto worker : workers) {
+    double score = worker->getLoad().getScore();
+    // Load is sampled every second, so references break ties between similar workers
+    // and connections created in bursts are still spread among them
+    bool similar_load = std::abs(score - chosen_score) < kLoadScoreTolerance;
+    if ((!similar_load && score < chosen_score) ||
+        (similar_load && chosen_worker.use_count() > worker.use_count())) {
       chosen_worker = worker;
+      chosen_score = score;
     }
   }
   return chosen_worker;
 }
 
+std::shared_ptr<MigratableWorker> ThreadPool::getLessUsedMigratableWorker() {
+  auto worker = std::make_shared<MigratableWorker>(getLessUsedWorker());
+  std::lock_guard<std::mutex> lock(migratable_workers_mutex_);
+  migratable_workers_.erase(std::remove_if(migratable_workers_.begin(), migratable_workers_.end(),
+    [](const std::weak_ptr<MigratableWorker> &worker) {
+      return worker.expired();
+    }), migratable_workers_.end());
+  migratable_workers_.push_back(worker);
+  return worker;
+}
+
+bool ThreadPool::rebalance() {
+  std::lock_guard<std::mutex> lock(migratable_workers_mutex_);
+  if (migration_.valid() && !migration_.is_ready()) {
+    return false;
+  }
+  std::shared_ptr<ThreadWorker> hot_worker;
+  uint64_t hottest_slow_delays = 0;
+  for (unsigned int index = 0; index < workers_.size(); index++) {
+    DurationDistribution delays = workers_[index]->getDelayDistribution();
+    uint64_t slow_delays = delays.duration_50_100_ms + delays.duration_100_1000_ms + delays.duration_1000_ms;
+    // Stats may have been reset since the last call
+    uint64_t new_slow_delays = slow_delays >= last_slow_delays_[index] ?
+      slow_delays - last_slow_delays_[index] : slow_delays;
+    last_slow_delays_[index] = slow_delays;
+    if (new_slow_delays > hottest_slow_delays) {
+      hottest_slow_delays = new_slow_delays;
+      hot_worker = workers_[index];
+    }
+  }
+  if (!hot_worker) {
+    return false;
+  }
+
+  double hot_score = hot_worker->getLoad().getScore();
+  std::shared_ptr<ThreadWorker> cold_worker;
+  double cold_score = hot_score - kMinLoadScoreDifferenceToRebalance;
+  for (auto worker : workers_) {
+    double score = worker->getLoad().getScore();
+    if (worker != hot_worker && score < cold_score) {
+      cold_worker = worker;
+      cold_score = score;
+    }
+  }
+  if (!cold_worker) {
+    return false;
+  }
+
+  std::shared_ptr<MigratableWorker> busiest_worker;
+  unsigned int workers_in_hot_worker = 0;
+  for (auto weak_worker : migratable_workers_) {
+    auto worker = weak_worker.lock();
+    if (!worker || worker->getTarget() != hot_worker) {
+      continue;
+    }
+    workers_in_hot_worker++;
+    if (!busiest_worker || worker->getBusyTimeMicroseconds() > busiest_worker->getBusyTimeMicroseconds()) {
+      busiest_worker = worker;
+    }
+  }
+  // Moving the only user of a worker would just move the problem to another worker
+  if (workers_in_hot_worker < 2) {
+    return false;
+  }
+  migration_ = busiest_worker->migrateTo(cold_worker);
+  return true;
+}
+
 void ThreadPool::start() {
-  std::vector<std::shared_ptr<std::promise<void>>> promises(workers_.size());
+  std::vector<std::shared_ptr<std::promise<void>>> promises(workers_.size() + handshake_workers_.size());
   int index = 0;
   for (auto worker : workers_) {
     promises[index] = std::make_shared<std::promise<void>>();
     worker->start(promises[index++]);
   }
+  for (auto worker : handshake_workers_) {
+    promises[index] = std::make_shared<std::promise<void>>();
+    worker->start(promises[index++]);
+  }
   for (auto promise : promises) {
     promise->get_future().wait();
   }
@@ -45,7 +149,9 @@ void ThreadPool::close() {
   for (auto worker : workers_) {
     worker->close();
   }
-  scheduler_->stop(true);
+  for (auto worker : handshake_workers_) {
+    worker->close();
+  }
 }
 
 DurationDistribution ThreadPool::getDurationDistribution() {
@@ -64,8 +170,41 @@ DurationDistribution ThreadPool::getDelayDistribution() {
   return total_delays;
 }
 
+std::vector<WorkerLoad> ThreadPool::getWorkersLoad() {
+  std::vector<WorkerLoad> loads;
+  for (auto worker : workers_) {
+    loads.push_back(worker->getLoad());
+  }
+  return loads;
+}
+
+std::vector<HandlerProfiler::Snapshot> ThreadPool::getHandlerProfiles() {
+  std::vector<HandlerProfiler::Snapshot> profiles;
+  for (auto worker : workers_) {
+    profiles.push_back(worker->getHandlerProfile());
+  }
+  for (auto worker : handshake_workers_) {
+    profiles.push_back(worker->getHandlerProfile());
+  }
+  return profiles;
+}
+
+std::vector<TaskLatency> ThreadPool::getTaskLatencies() {
+  std::vector<TaskLatency> latencies;
+  for (auto worker : workers_) {
+    latencies.push_back(worker->getTaskLatency());
+  }
+  for (auto worker : handshake_workers_) {
+    latencies.push_back(worker->getTaskLatency());
+  }
+  return latencies;
+}
+
 void ThreadPool::resetStats() {
   for (auto worker : workers_) {
     worker->resetStats();
   }
+  for (auto worker : handshake_workers_) {
+    worker->resetStats();
+  }
 }
@@ -1,30 +1,56 @@
 #ifndef ERIZO_SRC_ERIZO_THREAD_THREADPOOL_H_
 #define ERIZO_SRC_ERIZO_THREAD_THREADPOOL_H_
 
+#include <boost/thread/future.hpp>
+
 #include <memory>
+#include <mutex>  // NOLINT
 #include <vector>
 
+#include "thread/MigratableWorker.h"
 #include "thread/Worker.h"
-#include "thread/Scheduler.h"
 
 namespace erizo {
 
 class ThreadPool {
  public:
-  explicit ThreadPool(unsigned int num_workers);
+  explicit ThreadPool(unsigned int num_workers, unsigned int num_handshake_workers = 0);
   ~ThreadPool();
 
   std::shared_ptr<Worker> getLessUsedWorker();
+  // Workers reserved for DTLS handshakes so they do not delay media, nullptr if the pool has none
+  std::shared_ptr<Worker> getLessUsedHandshakeWorker();
+  // Same worker selection, but the returned worker can be moved to another one by rebalance()
+  std::shared_ptr<MigratableWorker> getLessUsedMigratableWorker();
   void start();
   void close();
 
   void resetStats();
   DurationDistribution getDurationDistribution();
   DurationDistribution getDelayDistribution();
+  // One profile per worker, in the same order as getWorkersLoad(), followed by the DTLS handshake workers
+  std::vector<HandlerProfiler::Snapshot> getHandlerProfiles();
+  std::vector<TaskLatency> getTaskLatencies();
+  std::vector<WorkerLoad> getWorkersLoad();
+
+  /**
+   * Moves the busiest migratable worker away from a worker that had tasks delayed 50ms or more since the
+   * last call, if there is a less loaded worker to move it to.
+   * Only one migration is in progress at a time.
+   * @return true if a migration has been started.
+   */
+  bool rebalance();
+
+ private:
+  static std::shared_ptr<ThreadWorker> getLessUsed(const std::vector<std::shared_ptr<ThreadWorker>> &workers);
 
  private:
-  std::vector<std::shared_ptr<Worker>> workers_;
-  std::shared_ptr<Scheduler> scheduler_;
+  std::vector<std::shared_ptr<ThreadWorker>> workers_;
+  std::vector<std::shared_ptr<ThreadWorker>> handshake_workers_;
+  std::mutex migratable_workers_mutex_;
+  std::vector<std::weak_ptr<MigratableWorker>> migratable_workers_;
+  std::vector<uint64_t> last_slow_delays_;
+  boost::future<bool> migration_;
 };
 }  // namespace erizo
 
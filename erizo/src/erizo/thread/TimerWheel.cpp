@@ -0,0 +1,199 @@
+#include "thread/TimerWheel.h"
+
+#include <algorithm>
+#include <utility>
+
+using erizo::TimerWheel;
+using erizo::ScheduledTaskReference;
+using erizo::time_point;
+
+constexpr int TimerWheel::kLevels;
+constexpr uint64_t TimerWheel::kFirstLevelSlots;
+constexpr uint64_t TimerWheel::kLevelSlots;
+constexpr uint64_t TimerWheel::kMaxTicks;
+
+ScheduledTaskReference::ScheduledTaskReference()
+    : cancelled{false}, wheel_{nullptr}, slot_{nullptr}, expiry_tick_{0}, level_{0} {
+}
+
+ScheduledTaskReference::ScheduledTaskReference(std::weak_ptr<Worker> owner)
+    : cancelled{false}, owner_{owner}, wheel_{nullptr}, slot_{nullptr}, expiry_tick_{0}, level_{0} {
+}
+
+bool ScheduledTaskReference::isCancelled() {
+  return cancelled;
+}
+
+void ScheduledTaskReference::cancel() {
+  cancelled = true;
+}
+
+TimerWheel::TimerWheel(time_point start, duration resolution)
+    : start_{start}, resolution_{resolution}, current_tick_{0}, size_{0}, level_sizes_{} {
+}
+
+TimerWheel::~TimerWheel() {
+  clear();
+}
+
+uint64_t TimerWheel::toTick(time_point time, bool round_up) const {
+  if (time <= start_) {
+    return 0;
+  }
+  duration elapsed = time - start_;
+  uint64_t tick = elapsed / resolution_;
+  if (round_up && elapsed % resolution_ != duration::zero()) {
+    tick++;
+  }
+  return tick;
+}
+
+int TimerWheel::getLevelShift(int level) const {
+  return kFirstLevelBits + (level - 1) * kLevelBits;
+}
+
+TimerWheel::Slot& TimerWheel::getSlot(uint64_t expiry_tick, int *level) {
+  uint64_t delta = expiry_tick - current_tick_;
+  if (delta < kFirstLevelSlots) {
+    *level = 0;
+    return first_level_[expiry_tick & (kFirstLevelSlots - 1)];
+  }
+  if (delta >= kMaxTicks) {
+    // Too far away, it will be cascaded again from the last level until it gets close enough
+    expiry_tick = current_tick_ + kMaxTicks - 1;
+  }
+  for (*level = 1; *level < kLevels - 1; (*level)++) {
+    if (delta < (uint64_t(1) << (getLevelShift(*level) + kLevelBits))) {
+      break;
+    }
+  }
+  return levels_[*level - 1][(expiry_tick >> getLevelShift(*level)) & (kLevelSlots - 1)];
+}
+
+void TimerWheel::place(Slot *from, Slot::iterator position) {
+  std::shared_ptr<ScheduledTaskReference> reference = *position;
+  int level;
+  Slot &to = getSlot(std::max(reference->expiry_tick_, current_tick_), &level);
+  to.splice(to.end(), *from, position);
+  reference->slot_ = &to;
+  reference->level_ = level;
+  level_sizes_[level]++;
+}
+
+void TimerWheel::add(std::shared_ptr<ScheduledTaskReference> reference, time_point deadline, Task f) {
+  remove(reference);
+  reference->wheel_ = this;
+  reference->expiry_tick_ = toTick(deadline, true);
+  reference->task_ = std::move(f);
+  Slot incoming;
+  incoming.push_back(reference);
+  reference->position_ = incoming.begin();
+  place(&incoming, incoming.begin());
+  size_++;
+}
+
+void TimerWheel::remove(std::shared_ptr<ScheduledTaskReference> reference) {
+  if (reference->wheel_ != this) {
+    return;
+  }
+  level_sizes_[reference->level_]--;
+  size_--;
+  reference->slot_->erase(reference->position_);
+  reference->wheel_ = nullptr;
+  reference->slot_ = nullptr;
+  reference->task_ = nullptr;
+}
+
+void TimerWheel::clear() {
+  auto clear_slot = [](Slot &slot) {
+    for (const std::shared_ptr<ScheduledTaskReference> &reference : slot) {
+      reference->wheel_ = nullptr;
+      reference->slot_ = nullptr;
+      reference->task_ = nullptr;
+    }
+    slot.clear();
+  };
+  std::for_each(first_level_.begin(), first_level_.end(), clear_slot);
+  for (auto &level : levels_) {
+    std::for_each(level.begin(), level.end(), clear_slot);
+  }
+  level_sizes_.fill(0);
+  size_ = 0;
+}
+
+void TimerWheel::cascade(int level) {
+  Slot pending;
+  pending.splice(pending.end(), levels_[level - 1][(current_tick_ >> getLevelShift(level)) & (kLevelSlots - 1)]);
+  level_sizes_[level] -= pending.size();
+  while (!pending.empty()) {
+    place(&pending, pending.begin());
+  }
+}
+
+std::size_t TimerWheel::advance(time_point now) {
+  uint64_t target_tick = toTick(now, false);
+  std::size_t tasks_run = 0;
+  while (current_tick_ <= target_tick) {
+    if (size_ == 0) {
+      current_tick_ = target_tick + 1;
+      break;
+    }
+    uint64_t index = current_tick_ & (kFirstLevelSlots - 1);
+    if (index == 0) {
+      for (int level = 1; level < kLevels; level++) {
+        cascade(level);
+        if (((current_tick_ >> getLevelShift(level)) & (kLevelSlots - 1)) != 0) {
+          break;
+        }
+      }
+    } else if (level_sizes_[0] == 0) {
+      // Nothing to run until the next cascade
+      current_tick_ = std::min((current_tick_ | (kFirstLevelSlots - 1)) + 1, target_tick + 1);
+      continue;
+    }
+    Slot expired;
+    expired.splice(expired.end(), first_level_[index]);
+    current_tick_++;
+    tasks_run += runExpired(&expired);
+  }
+  return tasks_run;
+}
+
+std::size_t TimerWheel::runExpired(Slot *expired) {
+  // Tasks can remove other expired tasks while we run them
+  for (const std::shared_ptr<ScheduledTaskReference> &reference : *expired) {
+    reference->slot_ = expired;
+  }
+  std::size_t tasks_run = 0;
+  while (!expired->empty()) {
+    std::shared_ptr<ScheduledTaskReference> reference = expired->front();
+    expired->pop_front();
+    level_sizes_[0]--;
+    size_--;
+    reference->wheel_ = nullptr;
+    reference->slot_ = nullptr;
+    Task f = std::move(reference->task_);
+    reference->task_ = nullptr;
+    if (!reference->isCancelled()) {
+      f();
+      tasks_run++;
+    }
+  }
+  return tasks_run;
+}
+
+bool TimerWheel::getNextDeadline(time_point *deadline) {
+  if (size_ == 0) {
+    return false;
+  }
+  bool pending_cascades = size_ > level_sizes_[0];
+  uint64_t tick = current_tick_;
+  for (uint64_t slots = 0; slots < kFirstLevelSlots; slots++, tick++) {
+    uint64_t index = tick & (kFirstLevelSlots - 1);
+    if ((index == 0 && pending_cascades) || !first_level_[index].empty()) {
+      break;
+    }
+  }
+  *deadline = start_ + resolution_ * static_cast<duration::rep>(tick);
+  return true;
+}
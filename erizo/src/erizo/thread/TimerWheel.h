@@ -0,0 +1,97 @@
+#ifndef ERIZO_SRC_ERIZO_THREAD_TIMERWHEEL_H_
+#define ERIZO_SRC_ERIZO_THREAD_TIMERWHEEL_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+
+#include "lib/Clock.h"
+
+namespace erizo {
+
+class TimerWheel;
+class Worker;
+
+class ScheduledTaskReference {
+ public:
+  ScheduledTaskReference();
+  // owner is the Worker whose wheel holds the task, so it can be unscheduled from a Worker that forwards to it
+  explicit ScheduledTaskReference(std::weak_ptr<Worker> owner);
+  bool isCancelled();
+  void cancel();
+  std::shared_ptr<Worker> getOwner() { return owner_.lock(); }
+
+ private:
+  friend class TimerWheel;
+  typedef std::list<std::shared_ptr<ScheduledTaskReference>> Slot;
+
+  std::atomic<bool> cancelled;
+  std::weak_ptr<Worker> owner_;
+  // Only accessed by the wheel that holds the task, from its own thread
+  TimerWheel *wheel_;
+  Slot *slot_;
+  Slot::iterator position_;
+  uint64_t expiry_tick_;
+  int level_;
+  std::function<void()> task_;
+};
+
+/**
+ * Hierarchical timer wheel (as in Varghese & Lauck) with 1ms ticks by default.
+ * Adding and removing tasks is O(1); tasks due in more than 256 ticks are kept in coarser levels and cascaded
+ * to finer ones as time goes by. It is not thread safe, each Worker owns one and uses it from its own thread.
+ */
+class TimerWheel {
+ public:
+  typedef std::function<void()> Task;
+
+  explicit TimerWheel(time_point start, duration resolution = std::chrono::milliseconds(1));
+  ~TimerWheel();
+
+  void add(std::shared_ptr<ScheduledTaskReference> reference, time_point deadline, Task f);
+  void remove(std::shared_ptr<ScheduledTaskReference> reference);
+  void clear();
+
+  // Runs every task whose deadline is not after now, and returns how many of them ran
+  std::size_t advance(time_point now);
+
+  // Earliest time at which advance() has something to do, false if the wheel is empty
+  bool getNextDeadline(time_point *deadline);
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  typedef ScheduledTaskReference::Slot Slot;
+
+  static constexpr int kLevels = 4;
+  static constexpr int kFirstLevelBits = 8;
+  static constexpr int kLevelBits = 6;
+  static constexpr uint64_t kFirstLevelSlots = 1 << kFirstLevelBits;
+  static constexpr uint64_t kLevelSlots = 1 << kLevelBits;
+  static constexpr uint64_t kMaxTicks = uint64_t(1) << (kFirstLevelBits + (kLevels - 1) * kLevelBits);
+
+  uint64_t toTick(time_point time, bool round_up) const;
+  int getLevelShift(int level) const;
+  Slot& getSlot(uint64_t expiry_tick, int *level);
+  void place(Slot *from, Slot::iterator position);
+  void cascade(int level);
+  std::size_t runExpired(Slot *expired);
+
+ private:
+  time_point start_;
+  duration resolution_;
+  uint64_t current_tick_;
+  std::size_t size_;
+  std::array<std::size_t, kLevels> level_sizes_;
+  std::array<Slot, kFirstLevelSlots> first_level_;
+  std::array<std::array<Slot, kLevelSlots>, kLevels - 1> levels_;
+};
+
+}  // namespace erizo
+
+#endif  // ERIZO_SRC_ERIZO_THREAD_TIMERWHEEL_H_
@@ -9,20 +9,18 @@
 #include "lib/ClockUtils.h"
 
 using erizo::Worker;
+using erizo::ThreadWorker;
 using erizo::DurationDistribution;
+using erizo::HandlerProfiler;
+using erizo::TaskLatency;
+using erizo::TaskOrigin;
+using erizo::TaskOriginScope;
+using erizo::WorkerLoad;
+using erizo::duration;
+using erizo::time_point;
 using erizo::SimulatedWorker;
 using erizo::ScheduledTaskReference;
 
-ScheduledTaskReference::ScheduledTaskReference() : cancelled{false} {
-}
-
-bool ScheduledTaskReference::isCancelled() {
-  return cancelled;
-}
-void ScheduledTaskReference::cancel() {
-  cancelled = true;
-}
-
 DurationDistribution::DurationDistribution()
     : duration_0_10_ms{0},
       duration_10_50_ms{0},
@@ -47,42 +45,103 @@ DurationDistribution& DurationDistribution::operator+=(const DurationDistributio
   return *this;
 }
 
-Worker::Worker(std::weak_ptr<Scheduler> scheduler, std::shared_ptr<Clock> the_clock)
-    : scheduler_{scheduler},
-      clock_{the_clock},
-      service_{},
-      service_worker_{new asio_worker::element_type(service_)},
-      closed_{false} {
+constexpr duration kLoadSampleInterval = std::chrono::seconds(1);
+constexpr double kLoadPerQueuedTask = 0.01;
+constexpr double kPacketsPerSecondAtFullLoad = 50000.;
+
+WorkerLoad::WorkerLoad() : busy_ratio{0.}, queued_tasks{0}, packets_per_second{0.} {}
+
+double WorkerLoad::getScore() const {
+  return busy_ratio + queued_tasks * kLoadPerQueuedTask + packets_per_second / kPacketsPerSecondAtFullLoad;
+}
+
+Worker::Worker(std::shared_ptr<Clock> the_clock) : clock_{the_clock} {
 }
 
 Worker::~Worker() {
 }
 
-void Worker::task(Task f) {
+void Worker::task(Task f, TaskOrigin origin) {
+  TaskOriginScope scope{origin};
+  task(std::move(f));
+}
+
+void Worker::scheduleEvery(ScheduledTask f, duration period) {
+  scheduleEvery(f, period, period);
+}
+
+void Worker::scheduleEvery(ScheduledTask f, duration period, duration next_delay) {
+  time_point start = clock_->now();
+  std::shared_ptr<Clock> clock = clock_;
   std::weak_ptr<Worker> weak_this = shared_from_this();
+
+  scheduleFromNow([weak_this, start, period, next_delay, f, clock] {
+    auto this_ptr = weak_this.lock();
+    if (this_ptr && f()) {
+      duration clock_skew = clock->now() - start - next_delay;
+      duration delay = period - clock_skew;
+      this_ptr->scheduleEvery(f, period, delay);
+    }
+  }, std::max(next_delay, duration{0}));
+}
+
+ThreadWorker::ThreadWorker(std::shared_ptr<Clock> the_clock)
+    : Worker(the_clock),
+      service_{},
+      service_worker_{new asio_worker::element_type(service_)},
+      timer_wheel_{clock_->now()},
+      timer_wheel_timer_{service_},
+      timer_wheel_timer_armed_{false},
+      closed_{false},
+      busy_time_us_{0},
+      queued_tasks_{0},
+      processed_packets_{0},
+      last_load_sample_{clock_->now()},
+      last_busy_time_us_{0},
+      last_processed_packets_{0} {
+}
+
+ThreadWorker::~ThreadWorker() {
+}
+
+void ThreadWorker::task(Task f) {
+  queued_tasks_++;
+  service_.dispatch(measuredTask(f));
+}
+
+void ThreadWorker::post(Task f) {
+  queued_tasks_++;
+  service_.post(measuredTask(f));
+}
+
+ThreadWorker::Task ThreadWorker::measuredTask(Task f) {
+  std::weak_ptr<ThreadWorker> weak_this = std::static_pointer_cast<ThreadWorker>(shared_from_this());
   time_point scheduled_at = clock_->now();
-  service_.dispatch([f, scheduled_at, weak_this] {
+  TaskOrigin origin = TaskOriginScope::current();
+  return [f, scheduled_at, origin, weak_this] {
     time_point start;
     if (auto this_ptr = weak_this.lock()) {
+      this_ptr->queued_tasks_--;
       start = this_ptr->clock_->now();
     }
     f();
     if (auto this_ptr = weak_this.lock()) {
       time_point end = this_ptr->clock_->now();
-      this_ptr->addToDurationStats(end - start);
-      this_ptr->addToDelayStats(start - scheduled_at);
+      this_ptr->addToTaskStats(origin, scheduled_at, start, end);
     }
-  });
+  };
 }
 
-void Worker::start() {
+void ThreadWorker::start() {
   auto promise = std::make_shared<std::promise<void>>();
   start(promise);
 }
 
-void Worker::start(std::shared_ptr<std::promise<void>> start_promise) {
-  auto this_ptr = shared_from_this();
+void ThreadWorker::start(std::shared_ptr<std::promise<void>> start_promise) {
+  auto this_ptr = std::static_pointer_cast<ThreadWorker>(shared_from_this());
   auto worker = [this_ptr, start_promise] {
+    HandlerProfiler::setCurrent(&this_ptr->handler_profiler_);
+    TaskOriginScope::setThreadDefault(erizo::kInternalTask);
     start_promise->set_value();
     if (!this_ptr->closed_) {
       return this_ptr->service_.run();
@@ -94,54 +153,93 @@ void Worker::start(std::shared_ptr<std::promise<void>> start_promise) {
   group_.add_thread(thread);
 }
 
-void Worker::close() {
+void ThreadWorker::close() {
   closed_ = true;
+  service_.post([this] {
+    timer_wheel_timer_.cancel();
+    timer_wheel_.clear();
+  });
   service_worker_.reset();
   group_.join_all();
   service_.stop();
 }
 
-std::shared_ptr<ScheduledTaskReference> Worker::scheduleFromNow(Task f, duration delta) {
-  auto delta_ms = std::chrono::duration_cast<std::chrono::milliseconds>(delta);
-  auto id = std::make_shared<ScheduledTaskReference>();
-  if (auto scheduler = scheduler_.lock()) {
-    scheduler->scheduleFromNow(safeTask([f, id](std::shared_ptr<Worker> this_ptr) {
-      this_ptr->task(this_ptr->safeTask([f, id](std::shared_ptr<Worker> this_ptr) {
-        {
-          if (id->isCancelled()) {
-            return;
-          }
-        }
-        f();
-      }));
-    }), delta_ms);
-  }
+std::shared_ptr<ScheduledTaskReference> ThreadWorker::scheduleFromNow(Task f, duration delta) {
+  std::weak_ptr<ThreadWorker> weak_this = std::static_pointer_cast<ThreadWorker>(shared_from_this());
+  auto id = std::make_shared<ScheduledTaskReference>(weak_this);
+  time_point deadline = clock_->now() + delta;
+  service_.dispatch([weak_this, id, f, deadline] {
+    if (auto this_ptr = weak_this.lock()) {
+      this_ptr->addToTimerWheel(id, f, deadline);
+    }
+  });
   return id;
 }
 
-void Worker::scheduleEvery(ScheduledTask f, duration period) {
-  scheduleEvery(f, period, period);
+void ThreadWorker::addToTimerWheel(std::shared_ptr<ScheduledTaskReference> id, Task f, time_point deadline) {
+  if (closed_ || id->isCancelled()) {
+    return;
+  }
+  timer_wheel_.add(id, deadline, [this, f, deadline] {
+    runScheduledTask(f, deadline);
+  });
+  armTimerWheel();
 }
 
-void Worker::scheduleEvery(ScheduledTask f, duration period, duration next_delay) {
+void ThreadWorker::runScheduledTask(const Task &f, time_point deadline) {
   time_point start = clock_->now();
-  std::shared_ptr<Clock> clock = clock_;
+  f();
+  addToTaskStats(erizo::kTimerTask, deadline, start, clock_->now());
+}
 
-  scheduleFromNow(safeTask([start, period, next_delay, f, clock](std::shared_ptr<Worker> this_ptr) {
-    if (f()) {
-      duration clock_skew = clock->now() - start - next_delay;
-      duration delay = period - clock_skew;
-      this_ptr->scheduleEvery(f, period, delay);
+void ThreadWorker::addToTaskStats(TaskOrigin origin, time_point scheduled_at, time_point start, time_point end) {
+  addToDurationStats(end - start);
+  addToDelayStats(start - scheduled_at);
+  task_latency_.recordDuration(origin, end - start);
+  task_latency_.recordDelay(origin, start - scheduled_at);
+  busy_time_us_ += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+void ThreadWorker::armTimerWheel() {
+  time_point next_deadline;
+  if (closed_ || !timer_wheel_.getNextDeadline(&next_deadline)) {
+    return;
+  }
+  if (timer_wheel_timer_armed_ && next_deadline >= timer_wheel_timer_deadline_) {
+    return;
+  }
+  timer_wheel_timer_armed_ = true;
+  timer_wheel_timer_deadline_ = next_deadline;
+  timer_wheel_timer_.expires_from_now(next_deadline - clock_->now());
+  std::weak_ptr<ThreadWorker> weak_this = std::static_pointer_cast<ThreadWorker>(shared_from_this());
+  timer_wheel_timer_.async_wait([weak_this](const boost::system::error_code &error) {
+    if (error == boost::asio::error::operation_aborted) {
+      return;
     }
-  }), std::max(next_delay, duration{0}));
+    if (auto this_ptr = weak_this.lock()) {
+      this_ptr->onTimerWheelTimeout();
+    }
+  });
+}
+
+void ThreadWorker::onTimerWheelTimeout() {
+  timer_wheel_timer_armed_ = false;
+  timer_wheel_.advance(clock_->now());
+  armTimerWheel();
 }
 
-void Worker::unschedule(std::shared_ptr<ScheduledTaskReference> id) {
+void ThreadWorker::unschedule(std::shared_ptr<ScheduledTaskReference> id) {
   id->cancel();
+  std::weak_ptr<ThreadWorker> weak_this = std::static_pointer_cast<ThreadWorker>(shared_from_this());
+  service_.dispatch([weak_this, id] {
+    if (auto this_ptr = weak_this.lock()) {
+      this_ptr->timer_wheel_.remove(id);
+    }
+  });
 }
 
-std::function<void()> Worker::safeTask(std::function<void(std::shared_ptr<Worker>)> f) {
-  std::weak_ptr<Worker> weak_this = shared_from_this();
+std::function<void()> ThreadWorker::safeTask(std::function<void(std::shared_ptr<ThreadWorker>)> f) {
+  std::weak_ptr<ThreadWorker> weak_this = std::static_pointer_cast<ThreadWorker>(shared_from_this());
   return [f, weak_this] {
     if (auto this_ptr = weak_this.lock()) {
       time_point start = this_ptr->clock_->now();
@@ -152,7 +250,7 @@ std::function<void()> Worker::safeTask(std::function<void(std::shared_ptr<Worker
   };
 }
 
-void Worker::addToDurationStats(duration task_duration) {
+void ThreadWorker::addToDurationStats(duration task_duration) {
   if (task_duration <= std::chrono::milliseconds(10)) {
     durations_.duration_0_10_ms++;
   } else if (task_duration <= std::chrono::milliseconds(50)) {
@@ -166,7 +264,7 @@ void Worker::addToDurationStats(duration task_duration) {
   }
 }
 
-void Worker::addToDelayStats(duration task_delay) {
+void ThreadWorker::addToDelayStats(duration task_delay) {
   if (task_delay <= std::chrono::milliseconds(10)) {
     delays_.duration_0_10_ms++;
   } else if (task_delay <= std::chrono::milliseconds(50)) {
@@ -180,21 +278,51 @@ void Worker::addToDelayStats(duration task_delay) {
   }
 }
 
-void Worker::resetStats() {
-  task(safeTask([](std::shared_ptr<Worker> worker) {
+WorkerLoad ThreadWorker::getLoad() {
+  std::lock_guard<std::mutex> lock(load_mutex_);
+  time_point now = clock_->now();
+  duration elapsed = now - last_load_sample_;
+  if (elapsed >= kLoadSampleInterval) {
+    uint64_t busy_time_us = busy_time_us_;
+    uint64_t processed_packets = processed_packets_;
+    double elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    load_.busy_ratio = std::min(1., (busy_time_us - last_busy_time_us_) / elapsed_us);
+    load_.packets_per_second = (processed_packets - last_processed_packets_) * 1000000. / elapsed_us;
+    last_busy_time_us_ = busy_time_us;
+    last_processed_packets_ = processed_packets;
+    last_load_sample_ = now;
+  }
+  load_.queued_tasks = queued_tasks_;
+  return load_;
+}
+
+TaskLatency ThreadWorker::getTaskLatency() {
+  TaskLatency task_latency = task_latency_;
+  task_latency.queued_tasks = queued_tasks_;
+  return task_latency;
+}
+
+void ThreadWorker::resetStats() {
+  task(safeTask([](std::shared_ptr<ThreadWorker> worker) {
     worker->durations_.reset();
     worker->delays_.reset();
+    worker->handler_profiler_.reset();
+    worker->task_latency_.reset();
   }));
 }
 
 SimulatedWorker::SimulatedWorker(std::shared_ptr<SimulatedClock> the_clock)
-    : Worker(std::make_shared<Scheduler>(1), the_clock), clock_{the_clock} {
+    : ThreadWorker(the_clock), simulated_clock_{the_clock} {
 }
 
 void SimulatedWorker::task(Task f) {
   tasks_.push_back(f);
 }
 
+void SimulatedWorker::post(Task f) {
+  tasks_.push_back(f);
+}
+
 void SimulatedWorker::start() {
 }
 
@@ -207,8 +335,8 @@ void SimulatedWorker::close() {
 }
 
 std::shared_ptr<ScheduledTaskReference> SimulatedWorker::scheduleFromNow(Task f, duration delta) {
-  auto id = std::make_shared<ScheduledTaskReference>();
-  scheduled_tasks_[clock_->now() + delta] =  [f, id] {
+  auto id = std::make_shared<ScheduledTaskReference>(shared_from_this());
+  scheduled_tasks_[simulated_clock_->now() + delta] =  [f, id] {
       if (id->isCancelled()) {
         return;
       }
@@ -225,7 +353,7 @@ void SimulatedWorker::executeTasks() {
 }
 
 void SimulatedWorker::executePastScheduledTasks() {
-  time_point now = clock_->now();
+  time_point now = simulated_clock_->now();
   for (auto iter = scheduled_tasks_.begin(), last_iter = scheduled_tasks_.end(); iter != last_iter; ) {
     if (iter->first <= now) {
       iter->second();
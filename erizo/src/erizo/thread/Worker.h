@@ -2,6 +2,7 @@
 #define ERIZO_SRC_ERIZO_THREAD_WORKER_H_
 
 #include <boost/asio.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/thread.hpp>
 
 #include <algorithm>
@@ -9,23 +10,17 @@
 #include <map>
 #include <memory>
 #include <future>  // NOLINT
+#include <mutex>  // NOLINT
 #include <vector>
 
 #include "lib/Clock.h"
 
-#include "thread/Scheduler.h"
+#include "thread/HandlerProfiler.h"
+#include "thread/TaskLatency.h"
+#include "thread/TimerWheel.h"
 
 namespace erizo {
 
-class ScheduledTaskReference {
- public:
-  ScheduledTaskReference();
-  bool isCancelled();
-  void cancel();
- private:
-  std::atomic<bool> cancelled;
-};
-
 class DurationDistribution {
  public:
   DurationDistribution();
@@ -41,35 +36,93 @@ class DurationDistribution {
   uint duration_1000_ms;
 };
 
+class WorkerLoad {
+ public:
+  WorkerLoad();
+  // Estimation of how loaded the worker is, 1.0 is roughly a saturated worker
+  double getScore() const;
+
+ public:
+  double busy_ratio;
+  uint64_t queued_tasks;
+  double packets_per_second;
+};
+
+/**
+ * Runs tasks, in order and never concurrently, and schedules tasks to run later. This is all the objects that live in
+ * a worker need from it: ThreadWorker runs them in its own thread and MigratableWorker forwards them to another one.
+ */
 class Worker : public std::enable_shared_from_this<Worker> {
  public:
-  typedef std::unique_ptr<boost::asio::io_service::work> asio_worker;
   typedef std::function<void()> Task;
   typedef std::function<bool()> ScheduledTask;
 
-  explicit Worker(std::weak_ptr<Scheduler> scheduler,
-                  std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
+  explicit Worker(std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
   virtual ~Worker();
 
-  virtual void task(Task f);
+  virtual void task(Task f) = 0;
+  // Like task(f) but the task is accounted to the given origin instead of the one of the calling thread
+  void task(Task f, TaskOrigin origin);
+  // Like task() but always queued, even when called from the worker thread
+  virtual void post(Task f) = 0;
 
-  virtual void start();
-  virtual void start(std::shared_ptr<std::promise<void>> start_promise);
-  virtual void close();
-  virtual boost::thread::id getId() { return thread_id_; }
+  virtual void start() = 0;
+  virtual void start(std::shared_ptr<std::promise<void>> start_promise) = 0;
+  virtual void close() = 0;
+  virtual boost::thread::id getId() = 0;
 
-  virtual std::shared_ptr<ScheduledTaskReference> scheduleFromNow(Task f, duration delta);
-  virtual void unschedule(std::shared_ptr<ScheduledTaskReference> id);
+  virtual std::shared_ptr<ScheduledTaskReference> scheduleFromNow(Task f, duration delta) = 0;
+  virtual void unschedule(std::shared_ptr<ScheduledTaskReference> id) = 0;
 
   virtual void scheduleEvery(ScheduledTask f, duration period);
 
+  virtual void addProcessedPackets(uint64_t packets = 1) {}
+
+ private:
+  void scheduleEvery(ScheduledTask f, duration period, duration next_delay);
+
+ protected:
+  std::shared_ptr<Clock> clock_;
+};
+
+class ThreadWorker : public Worker {
+ public:
+  typedef std::unique_ptr<boost::asio::io_service::work> asio_worker;
+
+  explicit ThreadWorker(std::shared_ptr<Clock> the_clock = std::make_shared<SteadyClock>());
+  virtual ~ThreadWorker();
+
+  using Worker::task;
+  void task(Task f) override;
+  void post(Task f) override;
+
+  void start() override;
+  void start(std::shared_ptr<std::promise<void>> start_promise) override;
+  void close() override;
+  boost::thread::id getId() override { return thread_id_; }
+
+  std::shared_ptr<ScheduledTaskReference> scheduleFromNow(Task f, duration delta) override;
+  void unschedule(std::shared_ptr<ScheduledTaskReference> id) override;
+
   void resetStats();
   DurationDistribution getDurationDistribution() { return durations_; }
   DurationDistribution getDelayDistribution() { return delays_; }
+  // Cost of the pipeline handlers run by this worker since the last resetStats()
+  HandlerProfiler::Snapshot getHandlerProfile() { return handler_profiler_.getSnapshot(); }
+  // Same durations and delays with microsecond resolution and by origin, plus the current queue depth
+  TaskLatency getTaskLatency();
+
+  void addProcessedPackets(uint64_t packets = 1) override { processed_packets_ += packets; }
+  WorkerLoad getLoad();
 
  private:
-  void scheduleEvery(ScheduledTask f, duration period, duration next_delay);
-  std::function<void()> safeTask(std::function<void(std::shared_ptr<Worker>)> f);
+  Task measuredTask(Task f);
+  void addToTimerWheel(std::shared_ptr<ScheduledTaskReference> id, Task f, time_point deadline);
+  void runScheduledTask(const Task &f, time_point deadline);
+  void addToTaskStats(TaskOrigin origin, time_point scheduled_at, time_point start, time_point end);
+  void armTimerWheel();
+  void onTimerWheelTimeout();
+  std::function<void()> safeTask(std::function<void(std::shared_ptr<ThreadWorker>)> f);
   void addToDurationStats(duration task_duration);
   void addToDelayStats(duration task_delay);
 
@@ -77,21 +130,37 @@ class Worker : public std::enable_shared_from_this<Worker> {
   int next_scheduled_ = 0;
 
  private:
-  std::weak_ptr<Scheduler> scheduler_;
-  std::shared_ptr<Clock> clock_;
   boost::asio::io_service service_;
   asio_worker service_worker_;
+  // Scheduled tasks live in the timer wheel and the steady_timer wakes us up when the next one is due,
+  // both are only accessed from the worker thread
+  TimerWheel timer_wheel_;
+  boost::asio::steady_timer timer_wheel_timer_;
+  bool timer_wheel_timer_armed_;
+  time_point timer_wheel_timer_deadline_;
   boost::thread_group group_;
   std::atomic<bool> closed_;
   boost::thread::id thread_id_;
   DurationDistribution durations_;
   DurationDistribution delays_;
+  HandlerProfiler handler_profiler_;
+  TaskLatency task_latency_;
+  std::atomic<uint64_t> busy_time_us_;
+  std::atomic<uint64_t> queued_tasks_;
+  std::atomic<uint64_t> processed_packets_;
+  std::mutex load_mutex_;
+  time_point last_load_sample_;
+  uint64_t last_busy_time_us_;
+  uint64_t last_processed_packets_;
+  WorkerLoad load_;
 };
 
-class SimulatedWorker : public Worker {
+class SimulatedWorker : public ThreadWorker {
  public:
   explicit SimulatedWorker(std::shared_ptr<SimulatedClock> the_clock);
+  using Worker::task;
   void task(Task f) override;
+  void post(Task f) override;
   void start() override;
   void start(std::shared_ptr<std::promise<void>> start_promise) override;
   void close() override;
@@ -101,7 +170,7 @@ class SimulatedWorker : public Worker {
   void executePastScheduledTasks();
 
  private:
-  std::shared_ptr<SimulatedClock> clock_;
+  std::shared_ptr<SimulatedClock> simulated_clock_;
   std::vector<Task> tasks_;
   std::map<time_point, Task> scheduled_tasks_;
 };
@@ -0,0 +1,114 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <DtlsTransport.h>
+#include <dtls/DtlsSocket.h>
+#include <rtp/RtpHeaders.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/Mocks.h"
+#include "utils/Tools.h"
+
+using testing::ElementsAre;
+using testing::Eq;
+using erizo::DtlsTransport;
+using erizo::IceConfig;
+using erizo::IceConnection;
+using erizo::RtpHeader;
+using erizo::packetPtr;
+
+class FakeIceConnection : public IceConnection {
+ public:
+  explicit FakeIceConnection(const IceConfig& ice_config) : IceConnection(ice_config) {
+    updateIceState(erizo::IceState::READY);
+  }
+
+  void start() override {}
+  bool setRemoteCandidates(const std::vector<erizo::CandidateInfo> &candidates, bool is_bundle) override {
+    return true;
+  }
+  void setRemoteCredentials(const std::string& username, const std::string& password) override {}
+  int sendData(unsigned int component_id, const void* buf, int len) override {
+    sent_seq_numbers.push_back(reinterpret_cast<const RtpHeader*>(buf)->getSeqNumber());
+    return len;
+  }
+  void sendDataBatch(std::vector<packetPtr> packets) override {
+    for (const packetPtr &packet : packets) {
+      sent_seq_numbers.push_back(reinterpret_cast<const RtpHeader*>(packet->data)->getSeqNumber());
+      sent_packets.push_back(packet.get());
+    }
+  }
+  void onData(unsigned int component_id, char* buf, int len) override {}
+  erizo::CandidatePair getSelectedPair() override { return erizo::CandidatePair(); }
+  void setReceivedLastCandidate(bool hasReceived) override {}
+  void close() override {}
+
+  std::vector<uint16_t> sent_seq_numbers;
+  std::vector<const erizo::DataPacket*> sent_packets;
+};
+
+class DtlsTransportTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    dtls::DtlsSocketContext::Init();
+    simulated_clock = std::make_shared<erizo::SimulatedClock>();
+    simulated_worker = std::make_shared<erizo::SimulatedWorker>(simulated_clock);
+    io_worker = std::make_shared<erizo::IOWorker>();
+    transport = std::make_shared<DtlsTransport>(erizo::VIDEO_TYPE, "video", "a_connection_id", true, true,
+                                                std::weak_ptr<erizo::TransportListener>(), ice_config,
+                                                "", "", true, simulated_worker, io_worker);
+    ice_connection = std::make_shared<FakeIceConnection>(ice_config);
+    transport->ice_ = ice_connection;
+    transport->updateTransportState(TRANSPORT_READY);
+  }
+
+  virtual void TearDown() {
+    transport->close();
+    dtls::DtlsSocketContext::Destroy();
+  }
+
+  IceConfig ice_config;
+  std::shared_ptr<erizo::SimulatedClock> simulated_clock;
+  std::shared_ptr<erizo::SimulatedWorker> simulated_worker;
+  std::shared_ptr<erizo::IOWorker> io_worker;
+  std::shared_ptr<FakeIceConnection> ice_connection;
+  std::shared_ptr<DtlsTransport> transport;
+};
+
+TEST_F(DtlsTransportTest, writeBatch_SendsThePacketsInOrder_WhenSrtpIsNotConfiguredLikeWrite) {
+  std::vector<packetPtr> packets{erizo::PacketTools::createDataPacket(1, erizo::VIDEO_PACKET),
+                                 erizo::PacketTools::createDataPacket(2, erizo::VIDEO_PACKET),
+                                 erizo::PacketTools::createDataPacket(3, erizo::VIDEO_PACKET)};
+
+  transport->writeBatch(packets);
+
+  EXPECT_THAT(ice_connection->sent_seq_numbers, ElementsAre(1, 2, 3));
+}
+
+TEST_F(DtlsTransportTest, writeBatch_KeepsTheOrder_WhenAPacketHasNoRoomForTheSrtpTrailer) {
+  packetPtr oversize_packet = erizo::PacketTools::createDataPacket(3, erizo::VIDEO_PACKET);
+  oversize_packet->length = sizeof(oversize_packet->data) - 1;
+  std::vector<packetPtr> packets{erizo::PacketTools::createDataPacket(1, erizo::VIDEO_PACKET),
+                                 erizo::PacketTools::createDataPacket(2, erizo::VIDEO_PACKET),
+                                 oversize_packet,
+                                 erizo::PacketTools::createDataPacket(4, erizo::VIDEO_PACKET)};
+
+  transport->writeBatch(packets);
+
+  EXPECT_THAT(ice_connection->sent_seq_numbers, ElementsAre(1, 2, 3, 4));
+}
+
+TEST_F(DtlsTransportTest, writeBatch_CopiesOnlyThePacketsThatAreHeldElsewhere) {
+  packetPtr kept_packet = erizo::PacketTools::createDataPacket(1, erizo::VIDEO_PACKET);
+  std::vector<packetPtr> packets{kept_packet, erizo::PacketTools::createDataPacket(2, erizo::VIDEO_PACKET)};
+  const erizo::DataPacket *batch_only_packet = packets[1].get();
+
+  transport->writeBatch(packets);
+
+  ASSERT_THAT(ice_connection->sent_packets.size(), Eq(2u));
+  EXPECT_NE(ice_connection->sent_packets[0], kept_packet.get());
+  EXPECT_EQ(ice_connection->sent_packets[1], batch_only_packet);
+}
@@ -31,6 +31,8 @@ class MockNicer: public erizo::NicerInterface {
                             &erizo::NicerInterfaceImpl::IceContextDestroy));
     ON_CALL(*this, IcePeerContextDestroy(_)).WillByDefault(Invoke(&real_impl_,
                             &erizo::NicerInterfaceImpl::IcePeerContextDestroy));
+    ON_CALL(*this, IceContextSetSocketFactory(_, _)).WillByDefault(Invoke(
+        [](nr_ice_ctx *, nr_socket_factory *factory) { nr_socket_factory_destroy(&factory); }));
   }
   virtual ~MockNicer() {
   }
@@ -398,6 +400,18 @@ TEST_F(NicerConnectionTest, sendData_Succeed_When_Ice_Ready) {
   EXPECT_EQ(kLength, nicer_connection->sendData(kCompId, test_packet, kLength));
 }
 
+TEST_F(NicerConnectionTest, sendDataBatch_Sends_Every_Packet_In_Its_Component_When_Ice_Ready) {
+  const int kLength = strlen(test_packet);
+
+  EXPECT_CALL(*nicer_listener, updateIceState(erizo::IceState::READY , _)).Times(1);
+  nicer_connection->updateIceState(erizo::IceState::READY);
+  EXPECT_CALL(*nicer, IceMediaStreamSend(_, _, 1, _, kLength)).Times(2).WillRepeatedly(Return(0));
+  EXPECT_CALL(*nicer, IceMediaStreamSend(_, _, 2, _, kLength)).Times(1).WillOnce(Return(0));
+  nicer_connection->sendDataBatch({erizo::DataPacket::create(1, test_packet, kLength, erizo::OTHER_PACKET, 0),
+                                   erizo::DataPacket::create(2, test_packet, kLength, erizo::OTHER_PACKET, 0),
+                                   erizo::DataPacket::create(1, test_packet, kLength, erizo::OTHER_PACKET, 0)});
+}
+
 TEST_F(NicerConnectionTest, sendData_Fail_When_Ice_Not_Ready) {
   const unsigned int kCompId = 1;
   const unsigned int kLength = strlen(test_packet);
@@ -7,12 +7,18 @@
 #include <string>
 
 using testing::_;
+using testing::Invoke;
 using testing::Return;
 using testing::Eq;
 using erizo::DataPacket;
 using erizo::MediaEventPtr;
 
 static const char kArbitraryPeerId[] = "111";
+static const char kAnotherArbitraryPeerId[] = "222";
+
+MATCHER_P(PacketHasSsrc, ssrc, "") {
+  return reinterpret_cast<erizo::RtpHeader*>(arg->data)->getSSRC() == ssrc;
+}
 
 class MockPublisher
   : public erizo::MediaSource, public erizo::FeedbackSink, public std::enable_shared_from_this<MockPublisher> {
@@ -136,3 +142,42 @@ TEST_F(OneToManyProcessorTest, deliverAudioData_CallsSubscriber_whenCalled) {
   otm.deliverAudioData(std::make_shared<DataPacket>(0, reinterpret_cast<char*>(&header),
                        sizeof(erizo::RtpHeader), erizo::AUDIO_PACKET));
 }
+
+TEST_F(OneToManyProcessorTest, deliverVideoData_DoesNotModifyPublisherPacket_whenDeliveringToManySubscribers) {
+  auto another_subscriber = std::make_shared<MockSubscriber>();
+  subscriber->setVideoSinkSSRC(10);
+  another_subscriber->setVideoSinkSSRC(20);
+  otm.addSubscriber(another_subscriber, kAnotherArbitraryPeerId);
+  erizo::RtpHeader header;
+  header.setSSRC(publisher->getVideoSourceSSRC());
+  header.setSeqNumber(12);
+  auto packet = std::make_shared<DataPacket>(0, reinterpret_cast<char*>(&header),
+                                             sizeof(erizo::RtpHeader), erizo::VIDEO_PACKET);
+
+  EXPECT_CALL(*subscriber, internalDeliverVideoData_(PacketHasSsrc(10u))).Times(1).WillOnce(Return(0));
+  EXPECT_CALL(*another_subscriber, internalDeliverVideoData_(PacketHasSsrc(20u))).Times(1).WillOnce(Return(0));
+  otm.deliverVideoData(packet);
+
+  EXPECT_THAT(reinterpret_cast<erizo::RtpHeader*>(packet->data)->getSSRC(), Eq(publisher->getVideoSourceSSRC()));
+}
+
+TEST_F(OneToManyProcessorTest, deliverVideoData_AllowsSubscribersToBeRemoved_whenDelivering) {
+  auto another_subscriber = std::make_shared<MockSubscriber>();
+  otm.addSubscriber(another_subscriber, kAnotherArbitraryPeerId);
+  erizo::RtpHeader header;
+  header.setSeqNumber(12);
+  auto packet = std::make_shared<DataPacket>(0, reinterpret_cast<char*>(&header),
+                                             sizeof(erizo::RtpHeader), erizo::VIDEO_PACKET);
+
+  EXPECT_CALL(*subscriber, internalDeliverVideoData_(_)).Times(1).WillOnce(Invoke([this](std::shared_ptr<DataPacket> packet) {
+    otm.removeSubscriber(kAnotherArbitraryPeerId);
+    return 0;
+  }));
+  EXPECT_CALL(*another_subscriber, internalDeliverVideoData_(_)).Times(1).WillOnce(Return(0));
+  otm.deliverVideoData(packet);
+
+  EXPECT_EQ(nullptr, getSubscriber(kAnotherArbitraryPeerId).get());
+  EXPECT_CALL(*subscriber, internalDeliverVideoData_(_)).Times(1).WillOnce(Return(0));
+  EXPECT_CALL(*another_subscriber, internalDeliverVideoData_(_)).Times(0);
+  otm.deliverVideoData(packet);
+}
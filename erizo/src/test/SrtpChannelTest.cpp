@@ -0,0 +1,165 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <SrtpChannel.h>
+#include <lib/Base64.h>
+#include <rtp/RtpHeaders.h>
+
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using testing::Eq;
+using erizo::Base64;
+using erizo::DataPacket;
+using erizo::RtpHeader;
+using erizo::SrtpChannel;
+
+constexpr int kBenchmarkPackets = 20000;
+constexpr int kRtpHeaderLength = 12;
+constexpr int kMaxSrtpPacketLength = 1500;
+
+static const char *kProfiles[] = {"SRTP_AES128_CM_SHA1_80", "SRTP_AEAD_AES_128_GCM", "SRTP_AEAD_AES_256_GCM"};
+static const int kPacketSizes[] = {100, 500, 1200};
+
+// gtest 1.8 can not skip a test at runtime, so only the profiles this libsrtp supports are instantiated
+std::vector<const char*> supportedProfiles() {
+  std::vector<const char*> profiles;
+  for (const char *profile : kProfiles) {
+    if (SrtpChannel::isProfileSupported(profile)) {
+      profiles.push_back(profile);
+    }
+  }
+  return profiles;
+}
+
+std::string createKey(const char *profile, char seed) {
+  // Master key plus salt: 30 bytes for AES_CM, 28 for AEAD_AES_128_GCM and 44 for AEAD_AES_256_GCM
+  size_t length = std::string(profile) == "SRTP_AES128_CM_SHA1_80" ? 30 :
+                  std::string(profile) == "SRTP_AEAD_AES_128_GCM" ? 28 : 44;
+  std::string key(length, seed);
+  std::string encoded_key;
+  Base64::Encode(key, &encoded_key);
+  return encoded_key;
+}
+
+int createRtpPacket(char *buffer, int length, uint16_t seq_number) {
+  memset(buffer, 0, length);
+  RtpHeader *header = reinterpret_cast<RtpHeader*>(buffer);
+  header->setVersion(2);
+  header->setPayloadType(96);
+  header->setSeqNumber(seq_number);
+  header->setTimestamp(seq_number * 3000);
+  header->setSSRC(1234);
+  memset(buffer + kRtpHeaderLength, seq_number & 0xff, length - kRtpHeaderLength);
+  return length;
+}
+
+class SrtpChannelTest : public ::testing::TestWithParam<const char*> {
+ protected:
+  virtual void SetUp() {
+    profile = GetParam();
+    std::string local_key = createKey(profile, 'a');
+    std::string remote_key = createKey(profile, 'b');
+    ASSERT_TRUE(sender.setRtpParams(local_key, remote_key, profile));
+    ASSERT_TRUE(receiver.setRtpParams(remote_key, local_key, profile));
+  }
+
+  const char *profile;
+  SrtpChannel sender;
+  SrtpChannel receiver;
+};
+
+TEST_P(SrtpChannelTest, unprotectRtp_ReturnsTheOriginalPacket_WhenProtectedWithTheSameProfile) {
+  char original[kMaxSrtpPacketLength];
+  char buffer[kMaxSrtpPacketLength];
+  int length = createRtpPacket(original, 500, 1);
+  memcpy(buffer, original, length);
+
+  ASSERT_THAT(sender.protectRtp(buffer, &length), Eq(0));
+  EXPECT_THAT(length > 500, Eq(true));
+  ASSERT_THAT(receiver.unprotectRtp(buffer, &length), Eq(0));
+
+  EXPECT_THAT(length, Eq(500));
+  EXPECT_THAT(memcmp(buffer, original, length), Eq(0));
+}
+
+TEST_P(SrtpChannelTest, protectBatch_ProtectsEveryPacketInOrder) {
+  char original[kMaxSrtpPacketLength];
+  std::vector<std::shared_ptr<DataPacket>> packets;
+  for (uint16_t seq_number = 1; seq_number <= 3; seq_number++) {
+    int length = createRtpPacket(original, 500, seq_number);
+    packets.push_back(DataPacket::create(1, original, length, erizo::VIDEO_PACKET));
+  }
+
+  EXPECT_THAT(sender.protectBatch(packets), Eq(3));
+
+  for (uint16_t seq_number = 1; seq_number <= 3; seq_number++) {
+    std::shared_ptr<DataPacket> packet = packets[seq_number - 1];
+    int length = createRtpPacket(original, 500, seq_number);
+    ASSERT_THAT(receiver.unprotectRtp(packet->data, &packet->length), Eq(0));
+    EXPECT_THAT(packet->length, Eq(length));
+    EXPECT_THAT(memcmp(packet->data, original, length), Eq(0));
+  }
+}
+
+TEST_P(SrtpChannelTest, protectBatch_SetsLengthToZero_WhenAPacketInTheMiddleFails) {
+  char original[kMaxSrtpPacketLength];
+  std::vector<std::shared_ptr<DataPacket>> packets;
+  // libsrtp refuses to protect a sequence number twice
+  for (uint16_t seq_number : {1, 2, 2, 3}) {
+    int length = createRtpPacket(original, 500, seq_number);
+    packets.push_back(DataPacket::create(1, original, length, erizo::VIDEO_PACKET));
+  }
+
+  EXPECT_THAT(sender.protectBatch(packets), Eq(3));
+
+  EXPECT_THAT(packets[2]->length, Eq(0));
+  for (int index : {0, 1, 3}) {
+    ASSERT_THAT(receiver.unprotectRtp(packets[index]->data, &packets[index]->length), Eq(0));
+    EXPECT_THAT(packets[index]->length, Eq(500));
+  }
+}
+
+TEST(SrtpChannelProfileTest, setRtpParams_Fails_WhenTheKeyDoesNotMatchTheProfile) {
+  SrtpChannel channel;
+  std::string cm_key = createKey("SRTP_AES128_CM_SHA1_80", 'a');
+
+  EXPECT_FALSE(channel.setRtpParams(cm_key, cm_key, "SRTP_AEAD_AES_256_GCM"));
+  EXPECT_FALSE(channel.setRtpParams(cm_key, cm_key, "SRTP_UNKNOWN"));
+}
+
+// Protects and unprotects kBenchmarkPackets RTP packets of several sizes with each profile libsrtp supports.
+// Run it with --gtest_also_run_disabled_tests --gtest_output=xml to get the ns/packet of every size
+TEST_P(SrtpChannelTest, DISABLED_Benchmark_ProtectAndUnprotectThroughput) {
+  std::vector<char> packets(kBenchmarkPackets * kMaxSrtpPacketLength);
+  std::vector<int> lengths(kBenchmarkPackets);
+  uint16_t seq_number = 0;
+  for (int size : kPacketSizes) {
+    for (int index = 0; index < kBenchmarkPackets; index++) {
+      lengths[index] = createRtpPacket(&packets[index * kMaxSrtpPacketLength], size, ++seq_number);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int index = 0; index < kBenchmarkPackets; index++) {
+      ASSERT_THAT(sender.protectRtp(&packets[index * kMaxSrtpPacketLength], &lengths[index]), Eq(0));
+    }
+    auto protected_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int index = 0; index < kBenchmarkPackets; index++) {
+      ASSERT_THAT(receiver.unprotectRtp(&packets[index * kMaxSrtpPacketLength], &lengths[index]), Eq(0));
+    }
+    auto unprotected_time = std::chrono::steady_clock::now() - start;
+
+    auto to_ns_per_packet = [](std::chrono::steady_clock::duration time) {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() / kBenchmarkPackets;
+    };
+    RecordProperty("protect_ns_per_packet_" + std::to_string(size), to_ns_per_packet(protected_time));
+    RecordProperty("unprotect_ns_per_packet_" + std::to_string(size), to_ns_per_packet(unprotected_time));
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(Profiles, SrtpChannelTest, testing::ValuesIn(supportedProfiles()));
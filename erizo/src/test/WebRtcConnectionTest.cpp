@@ -161,6 +161,18 @@ TEST_P(WebRtcConnectionTest, forwardRembToStreams_When_StreamTheyExist) {
   onRembReceived();
 }
 
+TEST_P(WebRtcConnectionTest, read_DeliversPacketsToTheStreamWithTheSsrc_When_SsrcChangesAfterBeingAdded) {
+  const uint32_t kArbitraryNewSsrc = 123456;
+  streams.back()->setVideoSourceSSRC(kArbitraryNewSsrc);
+  for (auto stream : streams) {
+    EXPECT_CALL(*stream, onTransportData(_, _)).Times(stream == streams.back() ? 1 : 0);
+  }
+
+  auto packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+  reinterpret_cast<erizo::RtpHeader*>(packet->data)->setSSRC(kArbitraryNewSsrc);
+  connection->read(packet);
+}
+
 INSTANTIATE_TEST_CASE_P(
   REMB_values, WebRtcConnectionTest, testing::Values(
     //                bitrate_list     remb    streams enabled,    expected remb
@@ -0,0 +1,30 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lib/CodecRegistry.h>
+
+#include <string>
+
+using testing::Eq;
+using testing::Ne;
+using erizo::CodecRegistry;
+
+TEST(CodecRegistryTest, intern_ReturnsFixedIds_ForParsedVideoCodecs) {
+  EXPECT_THAT(CodecRegistry::intern("VP8"), Eq(erizo::kVP8Codec));
+  EXPECT_THAT(CodecRegistry::intern("VP9"), Eq(erizo::kVP9Codec));
+  EXPECT_THAT(CodecRegistry::intern("H264"), Eq(erizo::kH264Codec));
+}
+
+TEST(CodecRegistryTest, intern_ReturnsTheSameId_ForTheSameName) {
+  erizo::CodecId id = CodecRegistry::intern("arbitrary-codec");
+
+  EXPECT_THAT(id, Ne(erizo::kUnknownCodec));
+  EXPECT_THAT(CodecRegistry::intern("arbitrary-codec"), Eq(id));
+  EXPECT_THAT(CodecRegistry::intern("another-codec"), Ne(id));
+  EXPECT_THAT(CodecRegistry::getName(id), Eq("arbitrary-codec"));
+}
+
+TEST(CodecRegistryTest, getName_ReturnsEmptyName_ForUnknownIds) {
+  EXPECT_THAT(CodecRegistry::getName(erizo::kUnknownCodec), Eq(""));
+  EXPECT_THAT(CodecRegistry::getName(250), Eq(""));
+}
@@ -0,0 +1,97 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lib/LatencyHistogram.h>
+
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+using testing::Eq;
+using testing::Ge;
+using testing::Lt;
+using erizo::LatencyHistogram;
+
+class LatencyHistogramTest : public ::testing::Test {
+ protected:
+  LatencyHistogram histogram;
+};
+
+TEST_F(LatencyHistogramTest, getPercentile_ReturnsZero_WhenEmpty) {
+  EXPECT_THAT(histogram.getCount(), Eq(0u));
+  EXPECT_THAT(histogram.getPercentileMicroseconds(50), Eq(0u));
+}
+
+TEST_F(LatencyHistogramTest, getPercentile_ReturnsBucketUpperBound_WhenValuesAreRecorded) {
+  for (int i = 0; i < 98; i++) {
+    histogram.recordMicroseconds(3);
+  }
+  histogram.record(std::chrono::milliseconds(1));
+  histogram.record(std::chrono::milliseconds(100));
+
+  EXPECT_THAT(histogram.getCount(), Eq(100u));
+  EXPECT_THAT(histogram.getPercentileMicroseconds(50), Eq(3u));
+  EXPECT_THAT(histogram.getPercentileMicroseconds(99), Eq(1023u));
+  EXPECT_THAT(histogram.getPercentileMicroseconds(100), Eq(102399u));
+  EXPECT_THAT(histogram.getMaxMicroseconds(), Eq(100000u));
+}
+
+TEST_F(LatencyHistogramTest, record_UsesLastBucket_WhenValueIsTooLarge) {
+  histogram.record(std::chrono::seconds(10));
+
+  EXPECT_THAT(histogram.getBucketCount(LatencyHistogram::kNumBuckets - 1), Eq(1u));
+}
+
+TEST_F(LatencyHistogramTest, getPercentile_IsOffByLessThanOneSubBucket) {
+  const uint64_t kMaxValue = uint64_t{1} << LatencyHistogram::kMaxMagnitude;
+  for (uint64_t value_us = 1; value_us < kMaxValue; value_us = value_us * 9 / 8 + 1) {
+    LatencyHistogram one_value;
+    one_value.recordMicroseconds(value_us);
+
+    uint64_t percentile_us = one_value.getPercentileMicroseconds(50);
+    EXPECT_THAT(percentile_us, Ge(value_us));
+    EXPECT_THAT((percentile_us - value_us) * LatencyHistogram::kSubBuckets, Lt(value_us));
+  }
+}
+
+TEST_F(LatencyHistogramTest, reset_ClearsEveryBucket) {
+  histogram.recordMicroseconds(10);
+
+  histogram.reset();
+
+  EXPECT_THAT(histogram.getCount(), Eq(0u));
+  EXPECT_THAT(histogram.getMaxMicroseconds(), Eq(0u));
+}
+
+TEST_F(LatencyHistogramTest, record_KeepsEveryValueAndTheMaximum_WhenRecordedFromManyThreads) {
+  std::vector<std::thread> threads;
+  for (int thread = 1; thread <= 4; thread++) {
+    threads.emplace_back([this, thread] {
+      for (int i = 0; i < 1000; i++) {
+        histogram.record(std::chrono::milliseconds(thread * 1000));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_THAT(histogram.getCount(), Eq(4000u));
+  EXPECT_THAT(histogram.getMaxMicroseconds(), Eq(4000000u));
+  EXPECT_THAT(histogram.getPercentileMicroseconds(100), Eq(4063231u));
+}
+
+TEST_F(LatencyHistogramTest, sum_KeepsTheBucketsAndTheMaximumOfBoth) {
+  histogram.recordMicroseconds(3);
+  LatencyHistogram other;
+  other.recordMicroseconds(3);
+  other.recordMicroseconds(1000);
+
+  LatencyHistogram sum = histogram;
+  sum += other;
+
+  EXPECT_THAT(sum.getCount(), Eq(3u));
+  EXPECT_THAT(sum.getPercentileMicroseconds(50), Eq(3u));
+  EXPECT_THAT(sum.getMaxMicroseconds(), Eq(1000u));
+  EXPECT_THAT(histogram.getCount(), Eq(1u));
+}
@@ -0,0 +1,122 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+extern "C" {
+#include <nr_api.h>
+#include <r_errors.h>
+#include <nr_socket.h>
+#include <transport_addr.h>
+}
+
+#include <lib/NicerBatchSocket.h>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+using testing::Eq;
+using testing::ElementsAre;
+using erizo::NicerBatchSocket;
+using erizo::SocketBatchStats;
+
+#ifdef __linux__
+
+class NicerBatchSocketTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    NicerBatchSocket::resetStats();
+    factory = NicerBatchSocket::createFactory();
+    ASSERT_THAT(factory != nullptr, Eq(true));
+    nr_transport_addr local_address;
+    ASSERT_THAT(nr_str_port_to_transport_addr("127.0.0.1", 0, IPPROTO_UDP, &local_address), Eq(0));
+    ASSERT_THAT(nr_socket_factory_create_socket(factory, &local_address, &sender), Eq(0));
+    ASSERT_THAT(nr_socket_factory_create_socket(factory, &local_address, &receiver), Eq(0));
+    ASSERT_THAT(nr_socket_getaddr(receiver, &receiver_address), Eq(0));
+  }
+
+  virtual void TearDown() {
+    nr_socket_destroy(&sender);
+    nr_socket_destroy(&receiver);
+    nr_socket_factory_destroy(&factory);
+  }
+
+  void send(const std::string &datagram) {
+    ASSERT_THAT(nr_socket_sendto(sender, datagram.data(), datagram.size(), 0, &receiver_address), Eq(0));
+  }
+
+  bool isReceiverReadable() {
+    NR_SOCKET fd;
+    nr_socket_getfd(receiver, &fd);
+    pollfd poll_fd = {fd, POLLIN, 0};
+    return poll(&poll_fd, 1, 1000) == 1;
+  }
+
+  std::string receive() {
+    char buffer[1500];
+    size_t length = 0;
+    nr_transport_addr from;
+    if (nr_socket_recvfrom(receiver, buffer, sizeof(buffer), &length, 0, &from) != 0) {
+      return "";
+    }
+    return std::string(buffer, length);
+  }
+
+  nr_socket_factory *factory;
+  nr_socket *sender;
+  nr_socket *receiver;
+  nr_transport_addr receiver_address;
+};
+
+TEST_F(NicerBatchSocketTest, sendTo_SendsRightAway_WhenThereIsNoBatch) {
+  send("a");
+
+  ASSERT_TRUE(isReceiverReadable());
+  EXPECT_THAT(receive(), Eq("a"));
+  EXPECT_THAT(NicerBatchSocket::getStats().send_calls, Eq(0u));
+}
+
+TEST_F(NicerBatchSocketTest, sendTo_SendsTheBatchInOrderAndInOneCall_WhenTheBatchEnds) {
+  {
+    NicerBatchSocket::SendBatch batch;
+    send("aa");
+    send("bb");
+    send("c");
+    EXPECT_THAT(NicerBatchSocket::getStats().sent_datagrams, Eq(0u));
+  }
+
+  std::vector<std::string> received;
+  while (received.size() < 3 && isReceiverReadable()) {
+    received.push_back(receive());
+  }
+
+  EXPECT_THAT(received, ElementsAre("aa", "bb", "c"));
+  SocketBatchStats stats = NicerBatchSocket::getStats();
+  EXPECT_THAT(stats.send_calls, Eq(1u));
+  EXPECT_THAT(stats.sent_datagrams, Eq(3u));
+}
+
+TEST_F(NicerBatchSocketTest, receiveFrom_ReadsSeveralDatagramsInOneCall_AndStaysReadableUntilTheyAreRead) {
+  {
+    NicerBatchSocket::SendBatch batch;
+    send("a");
+    send("bb");
+    send("ccc");
+  }
+  ASSERT_TRUE(isReceiverReadable());
+  // Gives loopback time to deliver the three of them before the first read
+  usleep(10000);
+
+  EXPECT_THAT(receive(), Eq("a"));
+  EXPECT_TRUE(isReceiverReadable());
+  EXPECT_THAT(receive(), Eq("bb"));
+  EXPECT_THAT(receive(), Eq("ccc"));
+  EXPECT_THAT(receive(), Eq(""));
+
+  SocketBatchStats stats = NicerBatchSocket::getStats();
+  EXPECT_THAT(stats.receive_calls, Eq(1u));
+  EXPECT_THAT(stats.received_datagrams, Eq(3u));
+}
+
+#endif  // __linux__
@@ -0,0 +1,61 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <lib/PacketPool.h>
+#include <MediaDefinitions.h>
+
+#include <cstring>
+#include <thread>  // NOLINT
+#include <vector>
+
+using ::testing::Eq;
+using ::testing::Ge;
+using erizo::DataPacket;
+using erizo::PacketPool;
+
+constexpr int kArbitraryNumberOfPackets = 1000;
+
+TEST(PacketPoolTest, shouldReuseBlocksReleasedInTheSameThread) {
+  PacketPool &pool = PacketPool::instance();
+  void *block = pool.allocate();
+  pool.deallocate(block);
+
+  EXPECT_THAT(pool.allocate(), Eq(block));
+  pool.deallocate(block);
+}
+
+TEST(PacketPoolTest, shouldReturnBlocksToTheSharedListWhenThreadExits) {
+  PacketPool &pool = PacketPool::instance();
+
+  std::thread producer([&pool] {
+    std::vector<void*> blocks;
+    for (int i = 0; i < kArbitraryNumberOfPackets; i++) {
+      blocks.push_back(pool.allocate());
+    }
+    for (void *block : blocks) {
+      pool.deallocate(block);
+    }
+  });
+  producer.join();
+
+  EXPECT_THAT(pool.getSharedFreeBlocks(), Ge(static_cast<size_t>(kArbitraryNumberOfPackets)));
+}
+
+TEST(PacketPoolTest, createShouldCopyPacketFields) {
+  const char kPayload[] = "arbitrary payload";
+  std::shared_ptr<DataPacket> packet = DataPacket::create(1, kPayload, sizeof(kPayload), erizo::AUDIO_PACKET, 100);
+  packet->codec = erizo::CodecRegistry::intern("opus");
+  packet->compatible_spatial_layers = {0, 2};
+
+  std::shared_ptr<DataPacket> copy = DataPacket::create(*packet);
+
+  EXPECT_THAT(copy->comp, Eq(1));
+  EXPECT_THAT(copy->length, Eq(static_cast<int>(sizeof(kPayload))));
+  EXPECT_THAT(copy->type, Eq(erizo::AUDIO_PACKET));
+  EXPECT_THAT(copy->received_time_ms, Eq(100u));
+  EXPECT_THAT(erizo::CodecRegistry::getName(copy->codec), Eq("opus"));
+  EXPECT_TRUE(copy->belongsToSpatialLayer(0));
+  EXPECT_FALSE(copy->belongsToSpatialLayer(1));
+  EXPECT_TRUE(copy->belongsToSpatialLayer(2));
+  EXPECT_THAT(std::memcmp(copy->data, kPayload, sizeof(kPayload)), Eq(0));
+}
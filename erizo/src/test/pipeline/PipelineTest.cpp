@@ -0,0 +1,154 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <pipeline/Pipeline.h>
+#include <pipeline/Handler.h>
+#include <MediaDefinitions.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using ::testing::Eq;
+using erizo::DataPacket;
+using erizo::InboundHandler;
+using erizo::OutboundHandler;
+using erizo::PacketBatch;
+using erizo::Pipeline;
+
+// Processes packets one by one and drops the ones with odd lengths
+class DropOddInboundHandler : public InboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "drop-odd-inbound"; }
+  void notifyUpdate() override {}
+
+  void read(Context *ctx, std::shared_ptr<DataPacket> packet) override {
+    reads++;
+    if (packet->length % 2 == 0) {
+      ctx->fireRead(std::move(packet));
+    }
+  }
+
+  int reads = 0;
+};
+
+class DropOddOutboundHandler : public OutboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "drop-odd-outbound"; }
+  void notifyUpdate() override {}
+
+  void write(Context *ctx, std::shared_ptr<DataPacket> packet) override {
+    writes++;
+    if (packet->length % 2 == 0) {
+      ctx->fireWrite(std::move(packet));
+    }
+  }
+
+  int writes = 0;
+};
+
+// Records how packets reach the end of the pipeline
+class BatchReader : public InboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "batch-reader"; }
+  void notifyUpdate() override {}
+
+  void read(Context *ctx, std::shared_ptr<DataPacket> packet) override {
+    batch_sizes.push_back(1);
+  }
+
+  void readBatch(Context *ctx, PacketBatch packets) override {
+    batch_sizes.push_back(packets.size());
+  }
+
+  std::vector<size_t> batch_sizes;
+};
+
+class BatchWriter : public OutboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "batch-writer"; }
+  void notifyUpdate() override {}
+
+  void write(Context *ctx, std::shared_ptr<DataPacket> packet) override {
+    batch_sizes.push_back(1);
+  }
+
+  void writeBatch(Context *ctx, PacketBatch packets) override {
+    batch_sizes.push_back(packets.size());
+  }
+
+  std::vector<size_t> batch_sizes;
+};
+
+class PipelineBatchTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    pipeline = Pipeline::create();
+    writer = std::make_shared<BatchWriter>();
+    first_inbound = std::make_shared<DropOddInboundHandler>();
+    second_inbound = std::make_shared<DropOddInboundHandler>();
+    outbound = std::make_shared<DropOddOutboundHandler>();
+    reader = std::make_shared<BatchReader>();
+    pipeline->addBack(writer);
+    pipeline->addBack(first_inbound);
+    pipeline->addBack(outbound);
+    pipeline->addBack(second_inbound);
+    pipeline->addBack(reader);
+    pipeline->finalize();
+  }
+
+  PacketBatch createBatch(std::vector<int> lengths) {
+    PacketBatch packets;
+    char buffer[100] = {0};
+    for (int length : lengths) {
+      packets.push_back(std::make_shared<DataPacket>(0, buffer, length, erizo::VIDEO_PACKET));
+    }
+    return packets;
+  }
+
+  std::shared_ptr<Pipeline> pipeline;
+  std::shared_ptr<BatchWriter> writer;
+  std::shared_ptr<DropOddInboundHandler> first_inbound;
+  std::shared_ptr<DropOddInboundHandler> second_inbound;
+  std::shared_ptr<DropOddOutboundHandler> outbound;
+  std::shared_ptr<BatchReader> reader;
+};
+
+TEST_F(PipelineBatchTest, readBatch_ReachesTheLastHandlerAsOneBatch_ThroughHandlersWithoutBatchSupport) {
+  pipeline->readBatch(createBatch({10, 11, 12, 14}));
+
+  EXPECT_THAT(first_inbound->reads, Eq(4));
+  EXPECT_THAT(second_inbound->reads, Eq(3));
+  ASSERT_THAT(reader->batch_sizes.size(), Eq(1u));
+  EXPECT_THAT(reader->batch_sizes[0], Eq(3u));
+}
+
+TEST_F(PipelineBatchTest, readBatch_DoesNotReachTheLastHandler_WhenEveryPacketIsDropped) {
+  pipeline->readBatch(createBatch({11, 13}));
+
+  EXPECT_THAT(second_inbound->reads, Eq(0));
+  EXPECT_THAT(reader->batch_sizes.size(), Eq(0u));
+}
+
+TEST_F(PipelineBatchTest, read_StillDeliversSinglePackets) {
+  pipeline->read(createBatch({10})[0]);
+
+  ASSERT_THAT(reader->batch_sizes.size(), Eq(1u));
+  EXPECT_THAT(reader->batch_sizes[0], Eq(1u));
+}
+
+TEST_F(PipelineBatchTest, writeBatch_ReachesTheFirstHandlerAsOneBatch_ThroughHandlersWithoutBatchSupport) {
+  pipeline->writeBatch(createBatch({10, 11, 12}));
+
+  EXPECT_THAT(outbound->writes, Eq(3));
+  ASSERT_THAT(writer->batch_sizes.size(), Eq(1u));
+  EXPECT_THAT(writer->batch_sizes[0], Eq(2u));
+}
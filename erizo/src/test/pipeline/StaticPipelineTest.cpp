@@ -0,0 +1,242 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <pipeline/Pipeline.h>
+#include <pipeline/Handler.h>
+#include <pipeline/StaticPipeline.h>
+#include <MediaDefinitions.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <memory>
+#include <string>
+#include <vector>
+
+using ::testing::Eq;
+using erizo::DataPacket;
+using erizo::Handler;
+using erizo::InboundHandler;
+using erizo::OutboundHandler;
+using erizo::PacketBatch;
+using erizo::Pipeline;
+using erizo::StaticPipeline;
+
+constexpr int kBenchmarkPackets = 1000000;
+
+// Appends its id to every packet it forwards, so tests can check the order packets go through handlers
+template <int Id>
+class TracingHandler : public Handler {
+ public:
+  void enable() override { enabled = true; }
+  void disable() override { enabled = false; }
+  std::string getName() override { return "tracing-" + std::to_string(Id); }
+  void notifyUpdate() override {}
+
+  void read(Context *ctx, std::shared_ptr<DataPacket> packet) override {
+    if (enabled) {
+      packet->data[packet->length++] = 'a' + Id;
+    }
+    ctx->fireRead(std::move(packet));
+  }
+
+  void write(Context *ctx, std::shared_ptr<DataPacket> packet) override {
+    if (enabled) {
+      packet->data[packet->length++] = 'a' + Id;
+    }
+    ctx->fireWrite(std::move(packet));
+  }
+
+  bool enabled = true;
+};
+
+// Counts packets and does nothing else, used for the benchmark
+template <int Id>
+class CountingHandler : public Handler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "counting"; }
+  void notifyUpdate() override {}
+
+  void read(Context *ctx, std::shared_ptr<DataPacket> packet) override {
+    count++;
+    ctx->fireRead(std::move(packet));
+  }
+
+  void write(Context *ctx, std::shared_ptr<DataPacket> packet) override {
+    count++;
+    ctx->fireWrite(std::move(packet));
+  }
+
+  uint64_t count = 0;
+};
+
+class TraceReader : public InboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "reader"; }
+  void notifyUpdate() override {}
+
+  void read(Context *ctx, std::shared_ptr<DataPacket> packet) override {
+    traces.push_back(std::string(packet->data, packet->length));
+  }
+
+  void readBatch(Context *ctx, PacketBatch packets) override {
+    batches++;
+    for (const std::shared_ptr<DataPacket> &packet : packets) {
+      traces.push_back(std::string(packet->data, packet->length));
+    }
+  }
+
+  std::vector<std::string> traces;
+  int batches = 0;
+};
+
+class TraceWriter : public OutboundHandler {
+ public:
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return "writer"; }
+  void notifyUpdate() override {}
+
+  void write(Context *ctx, std::shared_ptr<DataPacket> packet) override {
+    traces.push_back(std::string(packet->data, packet->length));
+  }
+
+  std::vector<std::string> traces;
+};
+
+using TestPipeline = StaticPipeline<TraceWriter, TracingHandler<0>, TracingHandler<1>, TraceReader>;
+
+std::shared_ptr<DataPacket> createEmptyPacket() {
+  char buffer[16] = {0};
+  auto packet = std::make_shared<DataPacket>(0, buffer, 0, erizo::VIDEO_PACKET);
+  return packet;
+}
+
+class StaticPipelineTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    writer = std::make_shared<TraceWriter>();
+    first = std::make_shared<TracingHandler<0>>();
+    second = std::make_shared<TracingHandler<1>>();
+    reader = std::make_shared<TraceReader>();
+    pipeline = TestPipeline::create(writer, first, second, reader);
+    pipeline->finalize();
+  }
+
+  std::shared_ptr<TraceWriter> writer;
+  std::shared_ptr<TracingHandler<0>> first;
+  std::shared_ptr<TracingHandler<1>> second;
+  std::shared_ptr<TraceReader> reader;
+  TestPipeline::Ptr pipeline;
+};
+
+TEST_F(StaticPipelineTest, read_GoesThroughTheHandlersFromFrontToBack) {
+  pipeline->read(createEmptyPacket());
+
+  ASSERT_THAT(reader->traces.size(), Eq(1u));
+  EXPECT_THAT(reader->traces[0], Eq("ab"));
+}
+
+TEST_F(StaticPipelineTest, write_GoesThroughTheHandlersFromBackToFront) {
+  pipeline->write(createEmptyPacket());
+
+  ASSERT_THAT(writer->traces.size(), Eq(1u));
+  EXPECT_THAT(writer->traces[0], Eq("ba"));
+}
+
+TEST_F(StaticPipelineTest, readBatch_ReachesTheLastHandlerAsOneBatch) {
+  pipeline->readBatch(PacketBatch{createEmptyPacket(), createEmptyPacket()});
+
+  EXPECT_THAT(reader->batches, Eq(1));
+  ASSERT_THAT(reader->traces.size(), Eq(2u));
+  EXPECT_THAT(reader->traces[1], Eq("ab"));
+}
+
+TEST_F(StaticPipelineTest, handlers_CanBeFoundAndDisabledLikeInPipeline) {
+  EXPECT_THAT(pipeline->getHandler<TracingHandler<1>>(), Eq(second.get()));
+
+  pipeline->disable("tracing-0");
+  pipeline->read(createEmptyPacket());
+
+  ASSERT_THAT(reader->traces.size(), Eq(1u));
+  EXPECT_THAT(reader->traces[0], Eq("b"));
+}
+
+TEST_F(StaticPipelineTest, handlers_CanFirePacketsOnTheirOwn) {
+  first->getContext()->fireRead(createEmptyPacket());
+  second->getContext()->fireWrite(createEmptyPacket());
+
+  ASSERT_THAT(reader->traces.size(), Eq(1u));
+  EXPECT_THAT(reader->traces[0], Eq("b"));
+  ASSERT_THAT(writer->traces.size(), Eq(1u));
+  EXPECT_THAT(writer->traces[0], Eq("a"));
+}
+
+// Reads kBenchmarkPackets through the same 20 handler chain built with Pipeline and with StaticPipeline.
+// Run it with --gtest_also_run_disabled_tests --gtest_output=xml to get the packets/s of both
+TEST(StaticPipelineBenchmarkTest, DISABLED_Benchmark_PacketsPerSecond) {
+  using BenchmarkPipeline = StaticPipeline<
+    CountingHandler<0>, CountingHandler<1>, CountingHandler<2>, CountingHandler<3>, CountingHandler<4>,
+    CountingHandler<5>, CountingHandler<6>, CountingHandler<7>, CountingHandler<8>, CountingHandler<9>,
+    CountingHandler<10>, CountingHandler<11>, CountingHandler<12>, CountingHandler<13>, CountingHandler<14>,
+    CountingHandler<15>, CountingHandler<16>, CountingHandler<17>, CountingHandler<18>, CountingHandler<19>>;
+
+  auto last_static = std::make_shared<CountingHandler<19>>();
+  auto static_pipeline = BenchmarkPipeline::create(
+    std::make_shared<CountingHandler<0>>(), std::make_shared<CountingHandler<1>>(),
+    std::make_shared<CountingHandler<2>>(), std::make_shared<CountingHandler<3>>(),
+    std::make_shared<CountingHandler<4>>(), std::make_shared<CountingHandler<5>>(),
+    std::make_shared<CountingHandler<6>>(), std::make_shared<CountingHandler<7>>(),
+    std::make_shared<CountingHandler<8>>(), std::make_shared<CountingHandler<9>>(),
+    std::make_shared<CountingHandler<10>>(), std::make_shared<CountingHandler<11>>(),
+    std::make_shared<CountingHandler<12>>(), std::make_shared<CountingHandler<13>>(),
+    std::make_shared<CountingHandler<14>>(), std::make_shared<CountingHandler<15>>(),
+    std::make_shared<CountingHandler<16>>(), std::make_shared<CountingHandler<17>>(),
+    std::make_shared<CountingHandler<18>>(), last_static);
+  static_pipeline->finalize();
+
+  auto last_dynamic = std::make_shared<CountingHandler<19>>();
+  auto dynamic_pipeline = Pipeline::create();
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<0>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<1>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<2>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<3>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<4>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<5>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<6>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<7>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<8>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<9>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<10>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<11>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<12>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<13>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<14>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<15>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<16>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<17>>());
+  dynamic_pipeline->addBack(std::make_shared<CountingHandler<18>>());
+  dynamic_pipeline->addBack(last_dynamic);
+  dynamic_pipeline->finalize();
+
+  auto packet = createEmptyPacket();
+  auto measure = [&packet](Pipeline *pipeline) {
+    auto start = std::chrono::steady_clock::now();
+    for (int index = 0; index < kBenchmarkPackets; index++) {
+      pipeline->read(packet);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    return kBenchmarkPackets * 1000000.0 / std::max<int64_t>(elapsed.count(), 1);
+  };
+  double dynamic_rate = measure(dynamic_pipeline.get());
+  double static_rate = measure(static_pipeline.get());
+
+  EXPECT_THAT(last_dynamic->count, Eq(static_cast<uint64_t>(kBenchmarkPackets)));
+  EXPECT_THAT(last_static->count, Eq(static_cast<uint64_t>(kBenchmarkPackets)));
+  ::testing::Test::RecordProperty("pipeline_packets_per_second", std::to_string(static_cast<uint64_t>(dynamic_rate)));
+  ::testing::Test::RecordProperty("static_pipeline_packets_per_second",
+                                  std::to_string(static_cast<uint64_t>(static_rate)));
+}
@@ -0,0 +1,258 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/FecGeneratorHandler.h>
+#include <rtp/RtpHeaders.h>
+#include <rtp/RtpUtils.h>
+#include <bandwidth/ConnectionQualityCheck.h>
+#include <MediaDefinitions.h>
+#include <WebRtcConnection.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/modules/rtp_rtcp/include/ulpfec_receiver.h"
+
+#include "../utils/Mocks.h"
+#include "../utils/Tools.h"
+#include "../utils/Matchers.h"
+
+using ::testing::_;
+using ::testing::Eq;
+using ::testing::Gt;
+using ::testing::Invoke;
+using erizo::DataPacket;
+using erizo::VIDEO_PACKET;
+using erizo::RtpHeader;
+using erizo::RtpMap;
+using erizo::FecGeneratorHandler;
+using erizo::VideoFractionLostEvent;
+
+constexpr uint8_t kTenPercentFractionLost = 10 * 256 / 100;
+constexpr uint32_t kTimestamp = 1000;
+constexpr uint8_t kVP8PayloadType = 96;
+
+// Collects the packets a webrtc receiver recovers from the FEC we generate
+class RecoveredPacketsCollector : public webrtc::RtpData {
+ public:
+  int32_t OnReceivedPayloadData(const uint8_t* payload_data, size_t payload_size,
+                                const webrtc::WebRtcRTPHeader* rtp_header) override {
+    return 0;
+  }
+  bool OnRecoveredPacket(const uint8_t* packet, size_t packet_length) override {
+    recovered_packets.push_back(std::make_shared<DataPacket>(0, reinterpret_cast<const char*>(packet),
+        packet_length, VIDEO_PACKET));
+    return true;
+  }
+
+  std::vector<std::shared_ptr<DataPacket>> recovered_packets;
+};
+
+class FecGeneratorHandlerTest : public erizo::HandlerTest {
+ public:
+  FecGeneratorHandlerTest() {}
+
+ protected:
+  void setHandler() {
+    fec_generator_handler = std::make_shared<FecGeneratorHandler>();
+    pipeline->addBack(fec_generator_handler);
+  }
+
+  void afterPipelineSetup() {
+    EXPECT_CALL(*writer.get(), write(_, _)).WillRepeatedly(Invoke(
+      [this](erizo::Writer::Context *ctx, std::shared_ptr<DataPacket> packet) {
+        written_packets.push_back(packet);
+      }));
+  }
+
+  void negotiateFec() {
+    std::shared_ptr<erizo::SdpInfo> remote_sdp = media_stream->getRemoteSdpInfo();
+    remote_sdp->getPayloadInfos().push_back(RtpMap{RED_90000_PT, "red", 90000, erizo::VIDEO_TYPE});
+    remote_sdp->getPayloadInfos().push_back(RtpMap{ULP_90000_PT, "ulpfec", 90000, erizo::VIDEO_TYPE});
+    remote_sdp->inOutPTMap[RED_90000_PT] = RED_90000_PT;
+    remote_sdp->inOutPTMap[ULP_90000_PT] = ULP_90000_PT;
+    pipeline->notifyUpdate();
+  }
+
+  void writeFrame(uint16_t first_seq_number, int packets) {
+    for (int i = 0; i < packets; i++) {
+      auto packet = erizo::PacketTools::createVP8Packet(first_seq_number + i, kTimestamp, false, i == packets - 1);
+      // So every packet has a different payload to recover
+      packet->data[packet->length - 1] = static_cast<char>(i + 1);
+      pipeline->write(packet);
+    }
+  }
+
+  uint8_t getRedBlockPayloadType(std::shared_ptr<DataPacket> packet) {
+    return packet->data[reinterpret_cast<RtpHeader*>(packet->data)->getHeaderLength()] & 0x7F;
+  }
+
+  std::shared_ptr<FecGeneratorHandler> fec_generator_handler;
+  std::vector<std::shared_ptr<DataPacket>> written_packets;
+};
+
+TEST_F(FecGeneratorHandlerTest, shouldForwardPacketsUntouched_whenFecIsNotNegotiated) {
+  pipeline->notifyEvent(std::make_shared<VideoFractionLostEvent>(kTenPercentFractionLost));
+
+  writeFrame(erizo::kArbitrarySeqNumber, 3);
+
+  ASSERT_THAT(written_packets.size(), Eq(3u));
+  for (const auto &packet : written_packets) {
+    EXPECT_THAT(reinterpret_cast<RtpHeader*>(packet->data)->getPayloadType(), Eq(kVP8PayloadType));
+  }
+}
+
+TEST_F(FecGeneratorHandlerTest, shouldNotSendFec_whenThereAreNoLosses) {
+  negotiateFec();
+  pipeline->notifyEvent(std::make_shared<VideoFractionLostEvent>(0));
+
+  writeFrame(erizo::kArbitrarySeqNumber, 3);
+
+  EXPECT_THAT(fec_generator_handler->getProtectionFactor(), Eq(0));
+  ASSERT_THAT(written_packets.size(), Eq(3u));
+  for (const auto &packet : written_packets) {
+    EXPECT_THAT(reinterpret_cast<RtpHeader*>(packet->data)->getPayloadType(), Eq(kVP8PayloadType));
+  }
+}
+
+TEST_F(FecGeneratorHandlerTest, shouldIncreaseProtection_withLosses) {
+  negotiateFec();
+
+  pipeline->notifyEvent(std::make_shared<VideoFractionLostEvent>(kTenPercentFractionLost));
+  uint8_t protection_with_low_losses = fec_generator_handler->getProtectionFactor();
+  pipeline->notifyEvent(std::make_shared<VideoFractionLostEvent>(3 * kTenPercentFractionLost));
+  uint8_t protection_with_high_losses = fec_generator_handler->getProtectionFactor();
+  pipeline->notifyEvent(std::make_shared<VideoFractionLostEvent>(255));
+
+  EXPECT_THAT(protection_with_low_losses, Gt(0));
+  EXPECT_THAT(protection_with_high_losses, Gt(protection_with_low_losses));
+  EXPECT_THAT(fec_generator_handler->getProtectionFactor(), Eq(FecGeneratorHandler::kMaxProtectionFactor));
+}
+
+TEST_F(FecGeneratorHandlerTest, shouldSendMediaInRedFollowedByFec_whenThereAreLosses) {
+  negotiateFec();
+  pipeline->notifyEvent(std::make_shared<VideoFractionLostEvent>(kTenPercentFractionLost));
+
+  writeFrame(erizo::kArbitrarySeqNumber, 5);
+
+  ASSERT_THAT(written_packets.size(), Gt(5u));
+  for (size_t i = 0; i < written_packets.size(); i++) {
+    RtpHeader *head = reinterpret_cast<RtpHeader*>(written_packets[i]->data);
+    EXPECT_THAT(head->getPayloadType(), Eq(RED_90000_PT));
+    EXPECT_THAT(head->getSeqNumber(), Eq(erizo::kArbitrarySeqNumber + i));
+    EXPECT_THAT(getRedBlockPayloadType(written_packets[i]), Eq(i < 5 ? kVP8PayloadType : ULP_90000_PT));
+  }
+}
+
+TEST_F(FecGeneratorHandlerTest, shouldLetReceiversRecoverLostPackets) {
+  negotiateFec();
+  pipeline->notifyEvent(std::make_shared<VideoFractionLostEvent>(kTenPercentFractionLost));
+  auto sent_packet = erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, kTimestamp, false, false);
+  sent_packet->data[sent_packet->length - 1] = 2;
+
+  writeFrame(erizo::kArbitrarySeqNumber, 5);
+
+  RecoveredPacketsCollector collector;
+  std::unique_ptr<webrtc::UlpfecReceiver> receiver{webrtc::UlpfecReceiver::Create(&collector)};
+  for (size_t i = 0; i < written_packets.size(); i++) {
+    if (i == 1) {
+      continue;  // lost
+    }
+    auto packet = written_packets[i];
+    webrtc::RTPHeader header;
+    header.headerLength = reinterpret_cast<RtpHeader*>(packet->data)->getHeaderLength();
+    header.sequenceNumber = reinterpret_cast<RtpHeader*>(packet->data)->getSeqNumber();
+    receiver->AddReceivedRedPacket(header, reinterpret_cast<const uint8_t*>(packet->data), packet->length,
+        ULP_90000_PT);
+    receiver->ProcessReceivedFec();
+  }
+
+  std::vector<std::shared_ptr<DataPacket>> recovered;
+  for (const auto &packet : collector.recovered_packets) {
+    if (reinterpret_cast<RtpHeader*>(packet->data)->getSeqNumber() == erizo::kArbitrarySeqNumber + 1) {
+      recovered.push_back(packet);
+    }
+  }
+  ASSERT_THAT(recovered.size(), Eq(1u));
+  ASSERT_THAT(recovered[0]->length, Eq(sent_packet->length));
+  EXPECT_THAT(memcmp(recovered[0]->data, sent_packet->data, sent_packet->length), Eq(0));
+}
+
+TEST_F(FecGeneratorHandlerTest, shouldDropFecFromPublisher_whenGeneratingFec) {
+  negotiateFec();
+  pipeline->notifyEvent(std::make_shared<VideoFractionLostEvent>(kTenPercentFractionLost));
+  auto publisher_fec = erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, kTimestamp, false, false);
+  auto publisher_red_fec = erizo::RtpUtils::makeRedPacket(publisher_fec, RED_90000_PT);
+  publisher_red_fec->data[reinterpret_cast<RtpHeader*>(publisher_red_fec->data)->getHeaderLength()] = ULP_90000_PT;
+
+  pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber, kTimestamp, false, false));
+  pipeline->write(publisher_red_fec);
+  pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 2, kTimestamp, false, false));
+
+  ASSERT_THAT(written_packets.size(), Eq(2u));
+  EXPECT_THAT(reinterpret_cast<RtpHeader*>(written_packets[1]->data)->getSeqNumber(),
+      Eq(erizo::kArbitrarySeqNumber + 1));
+}
+
+TEST_F(FecGeneratorHandlerTest, shouldTranslateNacks_whenTheirBlpCoversFecPackets) {
+  std::vector<std::shared_ptr<DataPacket>> read_packets;
+  EXPECT_CALL(*reader.get(), read(_, _)).WillRepeatedly(Invoke(
+    [&read_packets](erizo::Reader::Context *ctx, std::shared_ptr<DataPacket> packet) {
+      read_packets.push_back(packet);
+    }));
+  negotiateFec();
+  pipeline->notifyEvent(std::make_shared<VideoFractionLostEvent>(kTenPercentFractionLost));
+  writeFrame(erizo::kArbitrarySeqNumber, 5);
+  size_t fec_packets = written_packets.size() - 5;
+  ASSERT_THAT(fec_packets, Gt(0u));
+  writeFrame(erizo::kArbitrarySeqNumber + 5, 5);
+
+  // The last two media packets of the first frame, its first FEC packet and the first media packet of the next one
+  uint16_t blp = 0x0001 | 0x0002 | (1 << (fec_packets + 1));
+  auto nack = erizo::PacketTools::createNack(erizo::kVideoSsrc, erizo::kVideoSsrc, erizo::kArbitrarySeqNumber + 3,
+      VIDEO_PACKET, blp);
+  pipeline->read(nack);
+
+  ASSERT_THAT(read_packets.size(), Eq(1u));
+  erizo::RtcpHeader *translated_nack = reinterpret_cast<erizo::RtcpHeader*>(read_packets[0]->data);
+  EXPECT_THAT(read_packets[0]->length, Eq(16));
+  EXPECT_THAT(translated_nack->getNackPid(), Eq(erizo::kArbitrarySeqNumber + 3));
+  EXPECT_THAT(translated_nack->getNackBlp(), Eq(0x0001 | 0x0002));
+}
+
+TEST_F(FecGeneratorHandlerTest, shouldDropNacks_whenTheyOnlyCoverFecPackets) {
+  EXPECT_CALL(*reader.get(), read(_, _)).Times(0);
+  negotiateFec();
+  pipeline->notifyEvent(std::make_shared<VideoFractionLostEvent>(kTenPercentFractionLost));
+  writeFrame(erizo::kArbitrarySeqNumber, 5);
+  ASSERT_THAT(written_packets.size(), Gt(5u));
+
+  pipeline->read(erizo::PacketTools::createNack(erizo::kVideoSsrc, erizo::kVideoSsrc, erizo::kArbitrarySeqNumber + 5,
+      VIDEO_PACKET));
+}
+
+TEST_F(FecGeneratorHandlerTest, shouldSendRetransmissionsWithTheNumberMediaWasSentWith) {
+  constexpr uint32_t kRtxSsrc = 1111;
+  media_stream->setVideoSinkRtxSSRC(kRtxSsrc);
+  negotiateFec();
+  pipeline->notifyEvent(std::make_shared<VideoFractionLostEvent>(kTenPercentFractionLost));
+  writeFrame(erizo::kArbitrarySeqNumber, 5);
+  size_t fec_packets = written_packets.size() - 5;
+  ASSERT_THAT(fec_packets, Gt(0u));
+  auto packet = erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 5, kTimestamp, false, false);
+  pipeline->write(packet);
+  written_packets.clear();
+
+  auto retransmission = erizo::DataPacket::create(*packet);
+  retransmission->is_retransmission = true;
+  pipeline->write(retransmission);
+  pipeline->write(erizo::RtpUtils::makeRtxPacket(packet, kRtxSsrc, kVP8PayloadType + 1, erizo::kArbitrarySeqNumber));
+
+  uint16_t sent_seq_number = erizo::kArbitrarySeqNumber + 5 + fec_packets;
+  EXPECT_THAT(reinterpret_cast<RtpHeader*>(packet->data)->getSeqNumber(), Eq(erizo::kArbitrarySeqNumber + 5));
+  ASSERT_THAT(written_packets.size(), Eq(2u));
+  EXPECT_THAT(reinterpret_cast<RtpHeader*>(written_packets[0]->data)->getSeqNumber(), Eq(sent_seq_number));
+  ASSERT_TRUE(erizo::RtpUtils::unpackRtxPacket(written_packets[1], erizo::kVideoSsrc, kVP8PayloadType));
+  EXPECT_THAT(reinterpret_cast<RtpHeader*>(written_packets[1]->data)->getSeqNumber(), Eq(sent_seq_number));
+}
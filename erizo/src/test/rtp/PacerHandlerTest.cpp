@@ -0,0 +1,128 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/PacerHandler.h>
+#include <rtp/RtpHeaders.h>
+#include <MediaDefinitions.h>
+#include <WebRtcConnection.h>
+#include <stats/StatNode.h>
+#include <Stats.h>
+
+#include <string>
+#include <vector>
+
+#include "../utils/Mocks.h"
+#include "../utils/Tools.h"
+#include "../utils/Matchers.h"
+
+using ::testing::_;
+using ::testing::Args;
+using ::testing::Eq;
+using ::testing::Invoke;
+using ::testing::Lt;
+using erizo::DataPacket;
+using erizo::AUDIO_PACKET;
+using erizo::VIDEO_PACKET;
+using erizo::CumulativeStat;
+using erizo::PacerHandler;
+using erizo::RtpHeader;
+
+constexpr int kVideoPacketLength = 1200;
+constexpr int kBurstPackets = 20;
+
+class PacerHandlerTest : public erizo::HandlerTest {
+ public:
+  PacerHandlerTest() {}
+
+ protected:
+  void setHandler() override {
+    pacer_handler = std::make_shared<PacerHandler>(simulated_clock);
+    pipeline->addBack(pacer_handler);
+  }
+
+  void afterPipelineSetup() override {
+    ON_CALL(*writer.get(), write(_, _)).WillByDefault(Invoke([this](erizo::Writer::Context *ctx,
+                                                                    std::shared_ptr<DataPacket> packet) {
+      written_sequence_numbers.push_back(reinterpret_cast<RtpHeader*>(packet->data)->getSeqNumber());
+    }));
+  }
+
+  std::shared_ptr<DataPacket> createVideoPacket(uint16_t seq_number) {
+    auto packet = erizo::PacketTools::createDataPacket(seq_number, VIDEO_PACKET);
+    packet->length = kVideoPacketLength;
+    return packet;
+  }
+
+  void writeVideoBurst(uint16_t first_seq_number) {
+    for (uint16_t index = 0; index < kBurstPackets; index++) {
+      pipeline->write(createVideoPacket(first_seq_number + index));
+    }
+  }
+
+  std::shared_ptr<PacerHandler> pacer_handler;
+  std::vector<uint16_t> written_sequence_numbers;
+};
+
+TEST_F(PacerHandlerTest, basicBehaviourShouldWriteRtcpPacketsRightAway) {
+  auto packet = erizo::PacketTools::createReceiverReport(erizo::kVideoSsrc, erizo::kVideoSsrc,
+                                                         erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+
+  EXPECT_CALL(*writer.get(), write(_, _)).Times(1);
+  pipeline->write(packet);
+}
+
+TEST_F(PacerHandlerTest, shouldWriteAudioPacketsRightAway) {
+  writeVideoBurst(100);
+  written_sequence_numbers.clear();
+
+  pipeline->write(erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, AUDIO_PACKET));
+
+  ASSERT_THAT(written_sequence_numbers.size(), Eq(1u));
+  EXPECT_THAT(written_sequence_numbers[0], Eq(erizo::kArbitrarySeqNumber));
+}
+
+TEST_F(PacerHandlerTest, shouldSpreadBurstsOfVideoPacketsInTime) {
+  writeVideoBurst(100);
+
+  EXPECT_THAT(written_sequence_numbers.size(), Lt(static_cast<size_t>(kBurstPackets)));
+
+  executeTasksInNextMs(1000);
+
+  ASSERT_THAT(written_sequence_numbers.size(), Eq(static_cast<size_t>(kBurstPackets)));
+  EXPECT_THAT(written_sequence_numbers.back(), Eq(100 + kBurstPackets - 1));
+  EXPECT_THAT(stats->getNode()["total"]["pacerQueuedPackets"].value(), Eq(0u));
+}
+
+TEST_F(PacerHandlerTest, shouldWriteRetransmissionsBeforeQueuedVideoPackets) {
+  writeVideoBurst(100);
+  size_t written_before = written_sequence_numbers.size();
+  auto retransmission = createVideoPacket(50);
+  retransmission->is_retransmission = true;
+
+  pipeline->write(retransmission);
+  executeTasksInNextMs(1000);
+
+  ASSERT_THAT(written_sequence_numbers.size(), Eq(static_cast<size_t>(kBurstPackets + 1)));
+  EXPECT_THAT(written_sequence_numbers[written_before], Eq(50));
+}
+
+TEST_F(PacerHandlerTest, shouldWriteQueuedPacketsInOrder_WhenDisabled) {
+  writeVideoBurst(100);
+
+  pacer_handler->disable();
+
+  ASSERT_THAT(written_sequence_numbers.size(), Eq(static_cast<size_t>(kBurstPackets)));
+  for (uint16_t index = 0; index < kBurstPackets; index++) {
+    EXPECT_THAT(written_sequence_numbers[index], Eq(100 + index));
+  }
+}
+
+TEST_F(PacerHandlerTest, shouldPaceFaster_WhenTheEstimatedBandwidthGrows) {
+  stats->getNode()["total"].insertStat("senderBitrateEstimation", CumulativeStat{10000000});
+  executeTasksInNextMs(200);
+
+  writeVideoBurst(100);
+  executeTasksInNextMs(20);
+
+  EXPECT_THAT(written_sequence_numbers.size(), Eq(static_cast<size_t>(kBurstPackets)));
+}
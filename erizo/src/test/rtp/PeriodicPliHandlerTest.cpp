@@ -92,9 +92,9 @@ TEST_F(PeriodicPliHandlerTest, shouldUpdateIntervalIfRequested) {
 
 TEST_F(PeriodicPliHandlerTest, shouldNotSendPliIfMoreThanOneKeyframeFromTheLowestLayerIsReceivedInPeriod) {
     auto keyframe = erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber, true, true);
-    keyframe->compatible_spatial_layers.push_back(0);
+    keyframe->compatible_spatial_layers.add(0);
     auto keyframe2 = erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, true, true);
-    keyframe2->compatible_spatial_layers.push_back(0);
+    keyframe2->compatible_spatial_layers.add(0);
 
     EXPECT_CALL(*writer.get(), write(_, _)).With(Args<1>(erizo::IsPLI())).Times(0);
     EXPECT_CALL(*reader.get(), read(_, _)).
@@ -109,9 +109,9 @@ TEST_F(PeriodicPliHandlerTest, shouldNotSendPliIfMoreThanOneKeyframeFromTheLowes
 
 TEST_F(PeriodicPliHandlerTest, shouldSendPliIfNoKeyframesFromLowestLayerAreReceivedInPeriod) {
     auto keyframe = erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber, true, true);
-    keyframe->compatible_spatial_layers.push_back(1);
+    keyframe->compatible_spatial_layers.add(1);
     auto keyframe2 = erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, true, true);
-    keyframe2->compatible_spatial_layers.push_back(2);
+    keyframe2->compatible_spatial_layers.add(2);
 
     EXPECT_CALL(*writer.get(), write(_, _)).With(Args<1>(erizo::IsPLI())).Times(1);
     EXPECT_CALL(*reader.get(), read(_, _)).
@@ -1,7 +1,6 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
-#include <thread/Scheduler.h>
 #include <rtp/RtcpFeedbackGenerationHandler.h>
 #include <lib/Clock.h>
 #include <rtp/RtpHeaders.h>
@@ -8,7 +8,14 @@
 #include <MediaDefinitions.h>
 #include <WebRtcConnection.h>
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <queue>
+#include <random>
+#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "../utils/Mocks.h"
@@ -29,6 +36,25 @@ using erizo::RtcpHeader;
 using erizo::WebRtcConnection;
 using erizo::SimulatedClock;
 
+constexpr int kBenchmarkPackets = 200000;
+constexpr int kBenchmarkRttMs = 80;
+
+// Two state (Gilbert-Elliott) loss model, packets are lost with a different probability in each state
+struct LossTrace {
+  const char *name;
+  double good_to_bad;
+  double bad_to_good;
+  double loss_in_good;
+  double loss_in_bad;
+};
+
+constexpr LossTrace kLossTraces[] = {
+  {"2% random", 0., 1., 0.02, 0.},
+  {"bursty wifi", 0.01, 0.2, 0.001, 0.5},
+  {"congested uplink", 0.001, 0.01, 0.005, 0.9},
+  {"outages", 0.0005, 0.005, 0.001, 1.},
+};
+
 class RtcpNackGeneratorTest :public ::testing::Test {
  public:
   RtcpNackGeneratorTest(): clock{std::make_shared<SimulatedClock>()}, nack_generator{erizo::kVideoSsrc,
@@ -81,6 +107,12 @@ class RtcpNackGeneratorTest :public ::testing::Test {
     return found_nack;
   }
 
+  void receivePackets(uint16_t first_seq_num, uint16_t last_seq_num) {
+    for (uint16_t seq_num = first_seq_num; seq_num != last_seq_num + 1; seq_num++) {
+      nack_generator.handleRtpPacket(erizo::PacketTools::createDataPacket(seq_num, VIDEO_PACKET));
+    }
+  }
+
   std::shared_ptr<SimulatedClock> clock;
   std::shared_ptr<DataPacket> receiver_report;
   RtcpNackGenerator nack_generator;
@@ -205,3 +237,153 @@ TEST_F(RtcpNackGeneratorTest, shouldNotRetransmitNacksMoreThanTwice) {
   receiver_report = generateRrWithNack();
   EXPECT_FALSE(RtcpPacketContainsNackSeqNum(receiver_report, erizo::kArbitrarySeqNumber + 1));
 }
+
+TEST_F(RtcpNackGeneratorTest, shouldNotNackRecoveredPackets) {
+  nack_generator.handleRtpPacket(erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET));
+  nack_generator.handleRtpPacket(erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber + 4, VIDEO_PACKET));
+
+  nack_generator.handleRtpPacket(erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber + 2, VIDEO_PACKET));
+  receiver_report = generateRrWithNack();
+
+  EXPECT_TRUE(RtcpPacketContainsNackSeqNum(receiver_report, erizo::kArbitrarySeqNumber + 1));
+  EXPECT_FALSE(RtcpPacketContainsNackSeqNum(receiver_report, erizo::kArbitrarySeqNumber + 2));
+  EXPECT_TRUE(RtcpPacketContainsNackSeqNum(receiver_report, erizo::kArbitrarySeqNumber + 3));
+  EXPECT_EQ(nack_generator.getPendingNacks(), 2);
+}
+
+TEST_F(RtcpNackGeneratorTest, shouldTrackLossesAcrossRollOver) {
+  const uint16_t kMaxSeqnum = 65535;
+  receivePackets(kMaxSeqnum - 2, kMaxSeqnum - 2);
+  receivePackets(2, 2);
+
+  receiver_report = generateRrWithNack();
+
+  EXPECT_TRUE(RtcpPacketContainsNackSeqNum(receiver_report, kMaxSeqnum - 1));
+  EXPECT_TRUE(RtcpPacketContainsNackSeqNum(receiver_report, kMaxSeqnum));
+  EXPECT_TRUE(RtcpPacketContainsNackSeqNum(receiver_report, 0));
+  EXPECT_TRUE(RtcpPacketContainsNackSeqNum(receiver_report, 1));
+  EXPECT_EQ(nack_generator.getPendingNacks(), 4);
+}
+
+TEST_F(RtcpNackGeneratorTest, shouldKeepTheNewestNacks_whenThereAreTooManyLosses) {
+  uint16_t kManyLostPackets = 400;
+  receivePackets(erizo::kArbitrarySeqNumber, erizo::kArbitrarySeqNumber);
+  receivePackets(erizo::kArbitrarySeqNumber + kManyLostPackets + 1, erizo::kArbitrarySeqNumber + kManyLostPackets + 1);
+
+  receiver_report = generateRrWithNack();
+
+  EXPECT_EQ(nack_generator.getPendingNacks(), 150);
+  EXPECT_FALSE(RtcpPacketContainsNackSeqNum(receiver_report, erizo::kArbitrarySeqNumber + 1));
+  EXPECT_TRUE(RtcpPacketContainsNackSeqNum(receiver_report, erizo::kArbitrarySeqNumber + kManyLostPackets));
+}
+
+TEST_F(RtcpNackGeneratorTest, shouldForgetNacks_whenTheyAreOlderThanTheRing) {
+  receivePackets(erizo::kArbitrarySeqNumber, erizo::kArbitrarySeqNumber);
+  receivePackets(erizo::kArbitrarySeqNumber + 2, erizo::kArbitrarySeqNumber + 2);
+  receivePackets(erizo::kArbitrarySeqNumber + 3, erizo::kArbitrarySeqNumber + RtcpNackGenerator::kNackRingSize + 2);
+
+  receiver_report = generateRrWithNack();
+
+  EXPECT_EQ(nack_generator.getPendingNacks(), 0);
+  EXPECT_FALSE(RtcpPacketContainsNackSeqNum(receiver_report, erizo::kArbitrarySeqNumber + 1));
+}
+
+TEST_F(RtcpNackGeneratorTest, shouldWaitOneRttBeforeResendingNacks) {
+  uint16_t kRttMs = 100;
+  receivePackets(erizo::kArbitrarySeqNumber, erizo::kArbitrarySeqNumber);
+  receivePackets(erizo::kArbitrarySeqNumber + 2, erizo::kArbitrarySeqNumber + 2);
+  generateRrWithNack();
+  advanceClockMs(kRttMs);
+  receivePackets(erizo::kArbitrarySeqNumber + 1, erizo::kArbitrarySeqNumber + 1);
+  EXPECT_EQ(nack_generator.getRttMs(), kRttMs);
+
+  receivePackets(erizo::kArbitrarySeqNumber + 4, erizo::kArbitrarySeqNumber + 4);
+  receiver_report = generateRrWithNack();
+  EXPECT_TRUE(RtcpPacketContainsNackSeqNum(receiver_report, erizo::kArbitrarySeqNumber + 3));
+
+  advanceClockMs(kRttMs / 2);
+  receiver_report = generateRrWithNack();
+  EXPECT_FALSE(RtcpPacketContainsNackSeqNum(receiver_report, erizo::kArbitrarySeqNumber + 3));
+
+  advanceClockMs(kRttMs / 2 + 1);
+  receiver_report = generateRrWithNack();
+  EXPECT_TRUE(RtcpPacketContainsNackSeqNum(receiver_report, erizo::kArbitrarySeqNumber + 3));
+}
+
+// Receives kBenchmarkPackets at 1 packet/ms losing them as the traces say, and adds NACKs to a RR whenever the
+// generator asks for it, like RtcpFeedbackGenerationHandler. Nacked packets arrive one RTT later unless they are lost.
+// Run it with --gtest_also_run_disabled_tests --gtest_output=xml to get the results of every trace
+TEST(RtcpNackGeneratorBenchmark, DISABLED_LossTraces) {
+  for (const LossTrace &trace : kLossTraces) {
+    auto clock = std::make_shared<SimulatedClock>();
+    RtcpNackGenerator nack_generator{erizo::kVideoSsrc, clock};
+    std::mt19937 generator{1234};
+    std::uniform_real_distribution<double> random(0., 1.);
+    std::queue<std::pair<int, uint16_t>> retransmissions;
+    auto packet = erizo::PacketTools::createDataPacket(0, VIDEO_PACKET);
+    erizo::RtpHeader *head = reinterpret_cast<erizo::RtpHeader*>(packet->data);
+    bool is_bad_state = false;
+    int lost = 0, nacked = 0, recovered = 0;
+    std::chrono::steady_clock::duration elapsed{0};
+
+    for (int index = 0; index < kBenchmarkPackets; index++) {
+      clock->advanceTime(std::chrono::milliseconds(1));
+      is_bad_state = random(generator) < (is_bad_state ? 1. - trace.bad_to_good : trace.good_to_bad);
+      bool is_lost = random(generator) < (is_bad_state ? trace.loss_in_bad : trace.loss_in_good);
+      std::vector<uint16_t> arrived;
+      while (!retransmissions.empty() && retransmissions.front().first <= index) {
+        arrived.push_back(retransmissions.front().second);
+        retransmissions.pop();
+      }
+      auto receiver_report = erizo::PacketTools::createReceiverReport(erizo::kVideoSsrc, erizo::kVideoSsrc, 0,
+          VIDEO_PACKET);
+      bool has_nack = false;
+
+      auto start = std::chrono::steady_clock::now();
+      for (uint16_t seq_num : arrived) {
+        head->setSeqNumber(seq_num);
+        nack_generator.handleRtpPacket(packet);
+      }
+      if (!is_lost) {
+        head->setSeqNumber(index);
+        if (nack_generator.handleRtpPacket(packet)) {
+          has_nack = nack_generator.addNackPacketToRr(receiver_report);
+        }
+      }
+      elapsed += std::chrono::steady_clock::now() - start;
+
+      lost += is_lost;
+      recovered += arrived.size();
+      if (!has_nack) {
+        continue;
+      }
+      erizo::RtpUtils::forEachRtcpBlock(receiver_report, [&](RtcpHeader *chead) {
+        if (chead->packettype != RTCP_RTP_Feedback_PT) {
+          return;
+        }
+        erizo::RtpUtils::forEachNack(chead, [&](uint16_t pid, uint16_t blp, RtcpHeader *nack_head) {
+          for (int bit = -1; bit < 16; bit++) {
+            if (bit >= 0 && !((blp >> bit) & 1)) {
+              continue;
+            }
+            nacked++;
+            if (random(generator) >= (is_bad_state ? trace.loss_in_bad : trace.loss_in_good)) {
+              retransmissions.push({index + kBenchmarkRttMs, static_cast<uint16_t>(pid + bit + 1)});
+            }
+          }
+        });
+      });
+    }
+
+    std::ostringstream result;
+    result << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / kBenchmarkPackets
+        << " ns/packet, lost: " << lost << ", nacked: " << nacked << ", recovered: " << recovered
+        << ", rtt: " << nack_generator.getRttMs() << " ms";
+    std::string key = trace.name;
+    std::replace_if(key.begin(), key.end(), [](char c) { return !std::isalnum(c); }, '_');
+    ::testing::Test::RecordProperty(key, result.str());
+    EXPECT_THAT(recovered, ::testing::Gt(lost / 2)) << trace.name;
+    EXPECT_THAT(nacked, ::testing::Lt(2 * lost)) << trace.name;
+    EXPECT_NEAR(nack_generator.getRttMs(), kBenchmarkRttMs, kBenchmarkRttMs / 4) << trace.name;
+  }
+}
@@ -20,6 +20,7 @@ using ::testing::IsNull;
 using ::testing::Args;
 using ::testing::Return;
 using ::testing::AtLeast;
+using ::testing::Invoke;
 using erizo::DataPacket;
 using erizo::packetType;
 using erizo::AUDIO_PACKET;
@@ -102,3 +103,31 @@ TEST_F(RtpPaddingGeneratorHandlerTest, shouldNotSendPaddingAfterNotMarkers) {
   clock->advanceTime(std::chrono::milliseconds(200));
   pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, true, false));
 }
+
+TEST_F(RtpPaddingGeneratorHandlerTest, shouldResendMediaPacketsAsPadding_whenRtxIsNegotiated) {
+  RtpMap rtx_map{97, "rtx", 90000, erizo::VIDEO_TYPE, 1, {}, {{"apt", "96"}}};
+  media_stream->getRemoteSdpInfo()->getPayloadInfos().push_back(rtx_map);
+  media_stream->setVideoSinkRtxSSRC(3);
+  std::vector<std::shared_ptr<DataPacket>> written_packets;
+  EXPECT_CALL(*writer.get(), write(_, _)).WillRepeatedly(Invoke(
+    [this, &written_packets](erizo::Writer::Context *ctx, std::shared_ptr<DataPacket> packet) {
+      // The retransmission handler buffers what gets sent
+      if (!packet->is_retransmission) {
+        packet_buffer_service->insertPacket(packet);
+      }
+      written_packets.push_back(packet);
+    }));
+  EXPECT_CALL(*media_stream.get(), getTargetPaddingBitrate()).WillRepeatedly(Return(uint64_t(10000)));
+  pipeline->notifyUpdate();
+
+  pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber, true, false));
+  pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 1, true, false));
+  pipeline->write(erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber + 2, true, true));
+
+  ASSERT_THAT(written_packets.size(), ::testing::Gt(3u));
+  for (size_t i = 3; i < written_packets.size(); i++) {
+    EXPECT_TRUE(written_packets[i]->is_padding);
+    EXPECT_TRUE(written_packets[i]->is_retransmission);
+    EXPECT_EQ(written_packets[2 - (i - 3)]->length, written_packets[i]->length);
+  }
+}
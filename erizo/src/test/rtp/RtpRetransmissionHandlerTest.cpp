@@ -1,13 +1,13 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
-#include <thread/Scheduler.h>
 #include <rtp/RtpRetransmissionHandler.h>
 #include <rtp/RtpHeaders.h>
 #include <stats/StatNode.h>
 #include <MediaDefinitions.h>
 #include <WebRtcConnection.h>
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -19,6 +19,9 @@ using ::testing::_;
 using ::testing::IsNull;
 using ::testing::Args;
 using ::testing::Return;
+using ::testing::AllOf;
+using ::testing::Eq;
+using ::testing::Invoke;
 using erizo::DataPacket;
 using erizo::packetType;
 using erizo::AUDIO_PACKET;
@@ -43,6 +46,22 @@ class RtpRetransmissionHandlerTest : public erizo::HandlerTest {
     pipeline->addBack(rtx_handler);
   }
 
+  void negotiateRtx() {
+    RtpMap rtx_map{kRtxPayloadType, "rtx", 90000, erizo::VIDEO_TYPE, 1, {}, {{"apt", std::to_string(kPayloadType)}}};
+    media_stream->getRemoteSdpInfo()->getPayloadInfos().push_back(rtx_map);
+    media_stream->setVideoSinkRtxSSRC(kRtxSsrc);
+  }
+
+  std::shared_ptr<DataPacket> createVideoPacket(uint16_t seq_number) {
+    auto packet = erizo::PacketTools::createDataPacket(seq_number, VIDEO_PACKET);
+    reinterpret_cast<erizo::RtpHeader*>(packet->data)->setPayloadType(kPayloadType);
+    return packet;
+  }
+
+  static constexpr unsigned int kPayloadType = 100;
+  static constexpr unsigned int kRtxPayloadType = 96;
+  static constexpr uint32_t kRtxSsrc = 3;
+
   std::shared_ptr<RtpRetransmissionHandler> rtx_handler;
   std::shared_ptr<erizo::SimulatedClock> clock;
 };
@@ -154,3 +173,80 @@ TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitPackets_whenReceivingNackWi
     EXPECT_CALL(*reader.get(), read(_, _)).Times(0);
     pipeline->read(nack_packet);
 }
+
+TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitWithRtx_whenRtxIsNegotiated) {
+    negotiateRtx();
+    auto rtp_packet = createVideoPacket(erizo::kArbitrarySeqNumber);
+    int rtp_packet_length = rtp_packet->length;
+    uint ssrc = media_stream->getVideoSourceSSRC();
+    uint source_ssrc = media_stream->getVideoSinkSSRC();
+    auto nack_packet = erizo::PacketTools::createNack(ssrc, source_ssrc, erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+
+    EXPECT_CALL(*writer.get(), write(_, _)).
+      With(Args<1>(erizo::PacketHasSsrc(erizo::kVideoSsrc))).Times(1);
+    EXPECT_CALL(*writer.get(), write(_, _)).
+      With(Args<1>(AllOf(erizo::PacketHasSsrc(kRtxSsrc), erizo::PacketHasPayloadType(kRtxPayloadType),
+                         erizo::RtxHasOriginalSequenceNumber(erizo::kArbitrarySeqNumber),
+                         erizo::PacketLengthIs(rtp_packet_length + 2)))).Times(1);
+    pipeline->write(rtp_packet);
+
+    EXPECT_CALL(*reader.get(), read(_, _)).Times(0);
+    pipeline->read(nack_packet);
+}
+
+TEST_F(RtpRetransmissionHandlerTest, shouldUseConsecutiveRtxSequenceNumbers) {
+    negotiateRtx();
+    uint ssrc = media_stream->getVideoSourceSSRC();
+    uint source_ssrc = media_stream->getVideoSinkSSRC();
+    auto nack_packet = erizo::PacketTools::createNack(ssrc, source_ssrc, erizo::kArbitrarySeqNumber, VIDEO_PACKET, 1);
+    pipeline->write(createVideoPacket(erizo::kArbitrarySeqNumber));
+    pipeline->write(createVideoPacket(erizo::kArbitrarySeqNumber + 1));
+
+    std::vector<uint16_t> rtx_seq_numbers;
+    EXPECT_CALL(*writer.get(), write(_, _)).
+      With(Args<1>(erizo::PacketHasSsrc(kRtxSsrc))).Times(2).
+      WillRepeatedly(Invoke([&rtx_seq_numbers](erizo::Writer::Context *ctx, std::shared_ptr<DataPacket> packet) {
+        rtx_seq_numbers.push_back(reinterpret_cast<erizo::RtpHeader*>(packet->data)->getSeqNumber());
+      }));
+    pipeline->read(nack_packet);
+
+    ASSERT_THAT(rtx_seq_numbers.size(), Eq(2u));
+    EXPECT_THAT(rtx_seq_numbers[1], Eq(static_cast<uint16_t>(rtx_seq_numbers[0] + 1)));
+}
+
+TEST_F(RtpRetransmissionHandlerTest, shouldStartRtxSequenceNumbersAtRandom) {
+    std::vector<uint16_t> first_rtx_seq_numbers;
+    for (int handler = 0; handler < 10; handler++) {
+      first_rtx_seq_numbers.push_back(RtpRetransmissionHandler(clock).getRtxSequenceNumber());
+    }
+
+    std::sort(first_rtx_seq_numbers.begin(), first_rtx_seq_numbers.end());
+    EXPECT_THAT(std::unique(first_rtx_seq_numbers.begin(), first_rtx_seq_numbers.end()) -
+                first_rtx_seq_numbers.begin(), testing::Gt(1));
+}
+
+TEST_F(RtpRetransmissionHandlerTest, shouldRetransmitOriginalPackets_whenRtxIsNotNegotiatedForThePayloadType) {
+    negotiateRtx();
+    auto rtp_packet = erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+    uint ssrc = media_stream->getVideoSourceSSRC();
+    uint source_ssrc = media_stream->getVideoSinkSSRC();
+    auto nack_packet = erizo::PacketTools::createNack(ssrc, source_ssrc, erizo::kArbitrarySeqNumber, VIDEO_PACKET);
+
+    EXPECT_CALL(*writer.get(), write(_, _)).
+      With(Args<1>(erizo::PacketHasSsrc(erizo::kVideoSsrc))).Times(2);
+    pipeline->write(rtp_packet);
+
+    pipeline->read(nack_packet);
+}
+
+TEST_F(RtpRetransmissionHandlerTest, shouldSendResentPacketsFromUpstreamWithRtx) {
+    negotiateRtx();
+    auto rtp_packet = createVideoPacket(erizo::kArbitrarySeqNumber);
+    rtp_packet->is_padding = true;
+    rtp_packet->is_retransmission = true;
+
+    EXPECT_CALL(*writer.get(), write(_, _)).
+      With(Args<1>(AllOf(erizo::PacketHasSsrc(kRtxSsrc),
+                         erizo::RtxHasOriginalSequenceNumber(erizo::kArbitrarySeqNumber)))).Times(1);
+    pipeline->write(rtp_packet);
+}
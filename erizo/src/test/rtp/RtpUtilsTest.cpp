@@ -0,0 +1,46 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/RtpUtils.h>
+#include <rtp/RtpHeaders.h>
+#include <MediaDefinitions.h>
+
+#include <cstring>
+#include <memory>
+
+#include "../utils/Mocks.h"
+#include "../utils/Tools.h"
+
+using ::testing::Eq;
+using erizo::DataPacket;
+using erizo::RtpHeader;
+using erizo::RtpUtils;
+
+static constexpr uint32_t kRtxSsrc = 1111;
+static constexpr uint8_t kVideoPayloadType = 96;
+static constexpr uint8_t kRtxPayloadType = 97;
+static constexpr uint16_t kRtxSequenceNumber = 3000;
+
+TEST(RtpUtilsTest, unpackRtxPacket_ShouldRestoreTheRetransmittedPacket) {
+  auto packet = erizo::PacketTools::createVP8Packet(erizo::kArbitrarySeqNumber, true, true);
+  reinterpret_cast<RtpHeader*>(packet->data)->setPayloadType(kVideoPayloadType);
+  auto original_packet = DataPacket::create(*packet);
+  auto rtx_packet = RtpUtils::makeRtxPacket(packet, kRtxSsrc, kRtxPayloadType, kRtxSequenceNumber);
+
+  EXPECT_TRUE(RtpUtils::unpackRtxPacket(rtx_packet, erizo::kVideoSsrc, kVideoPayloadType));
+
+  RtpHeader *header = reinterpret_cast<RtpHeader*>(rtx_packet->data);
+  EXPECT_THAT(header->getSSRC(), Eq(erizo::kVideoSsrc));
+  EXPECT_THAT(header->getPayloadType(), Eq(kVideoPayloadType));
+  EXPECT_THAT(header->getSeqNumber(), Eq(erizo::kArbitrarySeqNumber));
+  EXPECT_TRUE(rtx_packet->is_retransmission);
+  ASSERT_THAT(rtx_packet->length, Eq(original_packet->length));
+  EXPECT_THAT(memcmp(rtx_packet->data, original_packet->data, original_packet->length), Eq(0));
+}
+
+TEST(RtpUtilsTest, unpackRtxPacket_ShouldFail_WhenTheRetransmissionIsOnlyPadding) {
+  auto packet = erizo::PacketTools::createDataPacket(kRtxSequenceNumber, erizo::VIDEO_PACKET);
+  auto padding_packet = RtpUtils::makePaddingPacket(packet, 100);
+
+  EXPECT_FALSE(RtpUtils::unpackRtxPacket(padding_packet, erizo::kVideoSsrc, kVideoPayloadType));
+}
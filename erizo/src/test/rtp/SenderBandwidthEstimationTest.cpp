@@ -3,6 +3,7 @@
 
 #include <rtp/SenderBandwidthEstimationHandler.h>
 #include <rtp/RtpHeaders.h>
+#include <rtp/RtpExtensionProcessor.h>
 #include <MediaDefinitions.h>
 #include <WebRtcConnection.h>
 
@@ -30,6 +31,8 @@ using erizo::MockSenderBandwidthEstimationListener;
 using erizo::Pipeline;
 using erizo::InboundHandler;
 using erizo::OutboundHandler;
+using erizo::RtpHeader;
+using erizo::TransportCcExtension;
 using std::queue;
 
 
@@ -52,10 +55,34 @@ class SenderBandwidthEstimationHandlerTest : public erizo::HandlerTest {
     simulated_clock->advanceTime(std::chrono::milliseconds(time_ms));
   }
 
+  void negotiateTransportCc() {
+    erizo::ExtMap transport_cc{kTransportCcExtensionId, kTransportCcUri};
+    transport_cc.mediaType = erizo::VIDEO_TYPE;
+    auto sdp = std::make_shared<erizo::SdpInfo>(rtp_maps);
+    sdp->extMapVector.push_back(transport_cc);
+    erizo::RtpExtensionProcessor extension_processor{{erizo::ExtMap{kTransportCcExtensionId, kTransportCcUri}}};
+    extension_processor.setSdpInfo(sdp);
+    connection->getRtpExtensionProcessor() = extension_processor;
+  }
+
+  std::shared_ptr<DataPacket> createPacketWithTransportCc(uint16_t seq_number, uint16_t transport_seq_number) {
+    auto packet = erizo::PacketTools::createDataPacket(seq_number, VIDEO_PACKET);
+    RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+    header->setExtension(1);
+    header->setExtId(0xBEDE);
+    header->setExtLength(1);
+    TransportCcExtension *extension = reinterpret_cast<TransportCcExtension*>(&header->extensions);
+    extension->ext_info = (kTransportCcExtensionId << 4) | 1;
+    extension->setSequenceNumber(transport_seq_number);
+    return packet;
+  }
+
   std::shared_ptr<SenderBandwidthEstimationHandler> sender_estimator_handler;
   std::shared_ptr<MockSenderBandwidthEstimationListener>  bandwidth_listener;
   const uint32_t kArbitrarySsrc = 32;
   const uint64_t kArbitraryNtpTimestamp = 493248028403924389;
+  const uint8_t kTransportCcExtensionId = 5;
+  const std::string kTransportCcUri = "http://www.ietf.org/id/draft-holmer-rmcat-transport-wide-cc-extensions-01";
 };
 
 TEST_F(SenderBandwidthEstimationHandlerTest, basicBehaviourShouldReadPackets) {
@@ -123,3 +150,74 @@ TEST_F(SenderBandwidthEstimationHandlerTest, shouldProvideEstimateAfterkMinUpdat
     advanceClock(SenderBandwidthEstimationHandler::kMinUpdateEstimateInterval+std::chrono::milliseconds(500));
     pipeline->write(packet_2);
 }
+
+TEST_F(SenderBandwidthEstimationHandlerTest, shouldUpdateTheSameEstimationStat_WhenTheEstimateChanges) {
+    int kArbitraryBitrate = 5000000;
+    int last_estimate = 0;
+    EXPECT_CALL(*bandwidth_listener.get(), onBandwidthEstimate(_, _, _)).Times(2).WillRepeatedly(testing::Invoke(
+      [&last_estimate](int estimated_bitrate, uint8_t estimated_loss, int64_t estimated_rtt) {
+        last_estimate = estimated_bitrate;
+    }));
+
+    pipeline->write(erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber, VIDEO_PACKET));
+    pipeline->read(erizo::PacketTools::createRembPacket(kArbitraryBitrate));
+    auto estimation_stat = stats->getNode()["total"].getStat<erizo::CumulativeStat>("senderBitrateEstimation");
+    advanceClock(SenderBandwidthEstimationHandler::kMinUpdateEstimateInterval+std::chrono::milliseconds(500));
+    pipeline->write(erizo::PacketTools::createDataPacket(erizo::kArbitrarySeqNumber + 1, VIDEO_PACKET));
+
+    ASSERT_TRUE(estimation_stat != nullptr);
+    EXPECT_THAT(stats->getNode()["total"].getStat<erizo::CumulativeStat>("senderBitrateEstimation"),
+                Eq(estimation_stat));
+    EXPECT_THAT(estimation_stat->value(), Eq(static_cast<uint64_t>(last_estimate)));
+}
+
+TEST_F(SenderBandwidthEstimationHandlerTest, shouldNumberSentPacketsWithTransportWideSequenceNumbers) {
+    const uint16_t kPublisherTransportSeqNumber = 4000;
+    negotiateTransportCc();
+    std::vector<uint16_t> transport_seq_numbers;
+    EXPECT_CALL(*writer.get(), write(_, _)).Times(3).WillRepeatedly(testing::Invoke(
+      [&transport_seq_numbers](erizo::Writer::Context *ctx, std::shared_ptr<DataPacket> packet) {
+        RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+        transport_seq_numbers.push_back(
+          reinterpret_cast<TransportCcExtension*>(&header->extensions)->getSequenceNumber());
+    }));
+
+    for (uint16_t index = 0; index < 3; index++) {
+      pipeline->write(createPacketWithTransportCc(erizo::kArbitrarySeqNumber + index, kPublisherTransportSeqNumber));
+    }
+
+    ASSERT_THAT(transport_seq_numbers.size(), Eq(3u));
+    EXPECT_THAT(transport_seq_numbers[1], Eq(transport_seq_numbers[0] + 1));
+    EXPECT_THAT(transport_seq_numbers[2], Eq(transport_seq_numbers[0] + 2));
+    EXPECT_THAT(transport_seq_numbers[0], testing::Ne(kPublisherTransportSeqNumber));
+}
+
+TEST_F(SenderBandwidthEstimationHandlerTest, shouldNotTouchPackets_WhenTransportCcIsNotNegotiated) {
+    const uint16_t kPublisherTransportSeqNumber = 4000;
+    EXPECT_CALL(*writer.get(), write(_, _)).With(Args<1>(erizo::RtpHasSequenceNumber(erizo::kArbitrarySeqNumber)))
+      .WillOnce(testing::Invoke([kPublisherTransportSeqNumber](erizo::Writer::Context *ctx,
+                                                               std::shared_ptr<DataPacket> packet) {
+        RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+        EXPECT_THAT(reinterpret_cast<TransportCcExtension*>(&header->extensions)->getSequenceNumber(),
+                    Eq(kPublisherTransportSeqNumber));
+    }));
+
+    pipeline->write(createPacketWithTransportCc(erizo::kArbitrarySeqNumber, kPublisherTransportSeqNumber));
+}
+
+TEST_F(SenderBandwidthEstimationHandlerTest, shouldNotNumberPackets_WhenTheExtensionIsNotTwoBytesLong) {
+    const uint16_t kPublisherTransportSeqNumber = 4000;
+    negotiateTransportCc();
+    EXPECT_CALL(*writer.get(), write(_, _)).With(Args<1>(erizo::RtpHasSequenceNumber(erizo::kArbitrarySeqNumber)))
+      .WillOnce(testing::Invoke([kPublisherTransportSeqNumber](erizo::Writer::Context *ctx,
+                                                               std::shared_ptr<DataPacket> packet) {
+        RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+        EXPECT_THAT(reinterpret_cast<TransportCcExtension*>(&header->extensions)->getSequenceNumber(),
+                    Eq(kPublisherTransportSeqNumber));
+    }));
+    auto packet = createPacketWithTransportCc(erizo::kArbitrarySeqNumber, kPublisherTransportSeqNumber);
+    RtpHeader *header = reinterpret_cast<RtpHeader*>(packet->data);
+    reinterpret_cast<TransportCcExtension*>(&header->extensions)->ext_info = (kTransportCcExtensionId << 4) | 2;
+
+    pipeline->write(packet);
+}
@@ -0,0 +1,108 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <rtp/TransportFeedbackAdapter.h>
+#include <rtp/RtpHeaders.h>
+#include <lib/Clock.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+
+using ::testing::Eq;
+using ::testing::Gt;
+using ::testing::Lt;
+using erizo::RtcpHeader;
+using erizo::TransportFeedbackAdapter;
+
+constexpr size_t kPacketLength = 1200;
+constexpr int kPacketIntervalMs = 5;
+constexpr int kFeedbackIntervalMs = 100;
+constexpr int64_t kOneWayDelayUs = 50000;
+
+class TransportFeedbackAdapterTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    simulated_clock = std::make_shared<erizo::SimulatedClock>();
+    adapter = std::make_shared<TransportFeedbackAdapter>(simulated_clock);
+  }
+
+  int64_t nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        simulated_clock->now().time_since_epoch()).count();
+  }
+
+  // Sends packets for the given time, each one arriving kOneWayDelayUs plus the extra delay it accumulates later
+  void sendPackets(int duration_ms, int64_t extra_delay_per_packet_us) {
+    for (int elapsed_ms = 0; elapsed_ms < duration_ms; elapsed_ms += kPacketIntervalMs) {
+      uint16_t sequence_number = adapter->onPacketSent(kPacketLength);
+      queuing_delay_us += extra_delay_per_packet_us;
+      pending_arrivals.push_back({sequence_number, nowUs() + kOneWayDelayUs + queuing_delay_us});
+      simulated_clock->advanceTime(std::chrono::milliseconds(kPacketIntervalMs));
+      if ((elapsed_ms + kPacketIntervalMs) % kFeedbackIntervalMs == 0) {
+        receiveFeedback();
+      }
+    }
+  }
+
+  void receiveFeedback() {
+    webrtc::rtcp::TransportFeedback feedback;
+    feedback.SetBase(pending_arrivals.front().first, pending_arrivals.front().second);
+    feedback.SetFeedbackSequenceNumber(feedback_count++);
+    for (const auto &arrival : pending_arrivals) {
+      feedback.AddReceivedPacket(arrival.first, arrival.second);
+    }
+    pending_arrivals.clear();
+    rtc::Buffer buffer = feedback.Build();
+    adapter->onTransportFeedback(reinterpret_cast<RtcpHeader*>(buffer.data()));
+  }
+
+  std::shared_ptr<erizo::SimulatedClock> simulated_clock;
+  std::shared_ptr<TransportFeedbackAdapter> adapter;
+  std::vector<std::pair<uint16_t, int64_t>> pending_arrivals;
+  int64_t queuing_delay_us = 0;
+  uint8_t feedback_count = 0;
+};
+
+TEST_F(TransportFeedbackAdapterTest, onPacketSent_ReturnsConsecutiveSequenceNumbers) {
+  uint16_t first = adapter->onPacketSent(kPacketLength);
+
+  EXPECT_THAT(adapter->onPacketSent(kPacketLength), Eq(first + 1));
+  EXPECT_THAT(adapter->onPacketSent(kPacketLength), Eq(first + 2));
+}
+
+TEST_F(TransportFeedbackAdapterTest, shouldNotProvideEstimate_WithoutFeedback) {
+  for (int packet = 0; packet < 100; packet++) {
+    adapter->onPacketSent(kPacketLength);
+    simulated_clock->advanceTime(std::chrono::milliseconds(kPacketIntervalMs));
+  }
+
+  EXPECT_THAT(adapter->hasEstimate(), Eq(false));
+}
+
+TEST_F(TransportFeedbackAdapterTest, shouldProvideEstimate_WhenFeedbackArrives) {
+  sendPackets(6000, 0);
+
+  EXPECT_THAT(adapter->hasEstimate(), Eq(true));
+  EXPECT_THAT(adapter->getEstimate(), Gt(0u));
+}
+
+TEST_F(TransportFeedbackAdapterTest, shouldLowerEstimate_WhenDelayGrows) {
+  sendPackets(6000, 0);
+  uint32_t estimate_before = adapter->getEstimate();
+
+  sendPackets(1000, 1000);
+
+  EXPECT_THAT(adapter->getEstimate(), Lt(estimate_before));
+}
+
+TEST_F(TransportFeedbackAdapterTest, shouldIgnoreFeedback_ForUnknownPackets) {
+  webrtc::rtcp::TransportFeedback feedback;
+  feedback.SetBase(1000, nowUs());
+  feedback.AddReceivedPacket(1000, nowUs());
+  rtc::Buffer buffer = feedback.Build();
+
+  EXPECT_THAT(adapter->onTransportFeedback(reinterpret_cast<RtcpHeader*>(buffer.data())), Eq(false));
+}
@@ -114,3 +114,23 @@ TEST_F(StatNodeTest, IntervalRateStatCanBeInserted) {
   EXPECT_THAT(root.toString(), Eq("{\"rate\":0}"));
 }
 
+
+TEST_F(StatNodeTest, getOrInsertStat_ReturnsAHandleThatUpdatesTheTree) {
+  std::shared_ptr<CumulativeStat> sum = root["a"].getOrInsertStat("sum", CumulativeStat{30});
+
+  (*sum)++;
+  *sum += 2;
+
+  EXPECT_THAT(root.toString(), Eq("{\"a\":{\"sum\":33}}"));
+  EXPECT_THAT(root["a"].getOrInsertStat("sum", CumulativeStat{0}), Eq(sum));
+}
+
+TEST_F(StatNodeTest, getOrInsertStat_ReplacesTheChild_WhenItHasAnotherType) {
+  root.insertStat("sum", StringStat{"text"});
+
+  std::shared_ptr<CumulativeStat> sum = root.getOrInsertStat("sum", CumulativeStat{1});
+
+  EXPECT_THAT(root.toString(), Eq("{\"sum\":1}"));
+  EXPECT_THAT(root.getStat<StringStat>("sum"), IsNull());
+  EXPECT_THAT(root.getStat<CumulativeStat>("sum"), Eq(sum));
+}
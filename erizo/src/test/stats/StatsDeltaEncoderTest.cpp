@@ -0,0 +1,100 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <stats/StatNode.h>
+#include <stats/StatsDeltaEncoder.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using ::testing::Eq;
+using erizo::StatNode;
+using erizo::StringStat;
+using erizo::CumulativeStat;
+using erizo::StatsDeltaEncoder;
+
+class StatsDeltaEncoderTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    root["1234"].insertStat("packetsLost", CumulativeStat{10});
+    root["1234"].insertStat("type", StringStat{"video"});
+    root["total"].insertStat("bitrate", CumulativeStat{300});
+  }
+
+  // Number of changes in a delta with no new keys
+  static uint8_t changeCount(const std::vector<uint8_t> &delta) {
+    return delta[3];
+  }
+
+  StatNode root;
+  StatsDeltaEncoder encoder;
+};
+
+TEST_F(StatsDeltaEncoderTest, encode_ReturnsAFullSnapshot_TheFirstTime) {
+  std::vector<uint8_t> delta = encoder.encode(root);
+
+  ASSERT_THAT(delta.size() > 4, Eq(true));
+  EXPECT_THAT(delta[0], Eq(StatsDeltaEncoder::kVersion));
+  EXPECT_THAT(delta[1], Eq(StatsDeltaEncoder::kFullSnapshot));
+  EXPECT_THAT(delta[2], Eq(3));
+  std::string encoded(delta.begin(), delta.end());
+  EXPECT_THAT(encoded.find("1234.packetsLost") != std::string::npos, Eq(true));
+  EXPECT_THAT(encoded.find("video") != std::string::npos, Eq(true));
+}
+
+TEST_F(StatsDeltaEncoderTest, encode_ReturnsNothing_WhenNoStatChanged) {
+  encoder.encode(root);
+
+  EXPECT_THAT(encoder.encode(root).empty(), Eq(true));
+}
+
+TEST_F(StatsDeltaEncoderTest, encode_ReturnsOnlyTheChangedStats) {
+  encoder.encode(root);
+  root["1234"]["packetsLost"] += 5;
+
+  std::vector<uint8_t> delta = encoder.encode(root);
+
+  ASSERT_THAT(delta.size(), Eq(7u));
+  EXPECT_THAT(delta[1], Eq(0));
+  EXPECT_THAT(delta[2], Eq(0));
+  EXPECT_THAT(changeCount(delta), Eq(1));
+  EXPECT_THAT(delta[5], Eq(StatsDeltaEncoder::kNumber));
+  EXPECT_THAT(delta[6], Eq(15));
+}
+
+TEST_F(StatsDeltaEncoderTest, encode_ReportsRemovedStats) {
+  encoder.encode(root);
+  root.insertStat("total", StatNode{});
+
+  std::vector<uint8_t> delta = encoder.encode(root);
+
+  ASSERT_THAT(delta.size(), Eq(6u));
+  EXPECT_THAT(changeCount(delta), Eq(1));
+  EXPECT_THAT(delta[5], Eq(StatsDeltaEncoder::kRemoved));
+}
+
+TEST_F(StatsDeltaEncoderTest, encode_ReturnsAFullSnapshot_AfterReset) {
+  encoder.encode(root);
+  encoder.reset();
+
+  std::vector<uint8_t> delta = encoder.encode(root);
+
+  ASSERT_THAT(delta.empty(), Eq(false));
+  EXPECT_THAT(delta[1], Eq(StatsDeltaEncoder::kFullSnapshot));
+  EXPECT_THAT(delta[2], Eq(3));
+}
+
+// erizo_controller/test/erizoJS/statsMirror.js decodes these same bytes, update both together
+TEST_F(StatsDeltaEncoderTest, encode_ProducesTheFullSnapshotThatStatsMirrorIsTestedWith) {
+  std::vector<uint8_t> delta = encoder.encode(root);
+
+  std::string hex;
+  char byte[3];
+  for (uint8_t value : delta) {
+    snprintf(byte, sizeof(byte), "%02x", value);
+    hex += byte;
+  }
+  EXPECT_THAT(hex, Eq("0101030010313233342e7061636b6574734c6f73740109313233342e74797065020d746f74616c2e62"
+                      "6974726174650300000a010105766964656f0200ac02"));
+}
@@ -0,0 +1,73 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <Stats.h>
+#include <stats/StatNode.h>
+#include <stats/StatsDeltaEncoder.h>
+
+#include <string>
+#include <vector>
+
+using ::testing::Eq;
+using erizo::Stats;
+using erizo::CumulativeStat;
+using erizo::StatsDeltaEncoder;
+
+class StatsTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    stats.getNode()["1234"].insertStat("packetsLost", CumulativeStat{10});
+    stats.getNode()["total"].insertStat("bitrate", CumulativeStat{300});
+  }
+
+  Stats stats;
+};
+
+TEST_F(StatsTest, getStatsDelta_ReturnsAFullSnapshot_TheFirstTimeOfEveryConsumer) {
+  stats.getStatsDelta("first");
+
+  std::vector<uint8_t> delta = stats.getStatsDelta("second");
+
+  ASSERT_THAT(delta.empty(), Eq(false));
+  EXPECT_THAT(delta[1], Eq(StatsDeltaEncoder::kFullSnapshot));
+  EXPECT_THAT(delta[2], Eq(2));
+}
+
+TEST_F(StatsTest, getStatsDelta_KeepsTheChangesOfEveryConsumer_WhenTheyAreInterleaved) {
+  stats.getStatsDelta("first");
+  stats.getStatsDelta("second");
+  stats.getNode()["1234"]["packetsLost"] += 5;
+
+  std::vector<uint8_t> first_delta = stats.getStatsDelta("first");
+  std::vector<uint8_t> second_delta = stats.getStatsDelta("second");
+
+  EXPECT_THAT(first_delta, Eq(second_delta));
+  ASSERT_THAT(second_delta.size(), Eq(7u));
+  EXPECT_THAT(second_delta[1], Eq(0));
+  EXPECT_THAT(second_delta[6], Eq(15));
+  EXPECT_THAT(stats.getStatsDelta("first").empty(), Eq(true));
+}
+
+TEST_F(StatsTest, getStatsDelta_ReturnsAFullSnapshot_AfterTheConsumerIsRemoved) {
+  stats.getStatsDelta("first");
+  stats.removeStatsDeltaConsumer("first");
+
+  std::vector<uint8_t> delta = stats.getStatsDelta("first");
+
+  ASSERT_THAT(delta.empty(), Eq(false));
+  EXPECT_THAT(delta[1], Eq(StatsDeltaEncoder::kFullSnapshot));
+}
+
+TEST_F(StatsTest, getStatsDelta_EvictsTheLeastRecentlyUsedConsumer_WhenThereAreTooMany) {
+  stats.getStatsDelta("evicted");
+  stats.getStatsDelta("kept");
+  for (int consumer = 0; consumer < 15; consumer++) {
+    stats.getStatsDelta("kept");
+    stats.getStatsDelta(std::to_string(consumer));
+  }
+
+  EXPECT_THAT(stats.getStatsDelta("kept").empty(), Eq(true));
+  std::vector<uint8_t> delta = stats.getStatsDelta("evicted");
+  ASSERT_THAT(delta.empty(), Eq(false));
+  EXPECT_THAT(delta[1], Eq(StatsDeltaEncoder::kFullSnapshot));
+}
@@ -0,0 +1,150 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/HandlerProfiler.h>
+#include <thread/Worker.h>
+#include <pipeline/Pipeline.h>
+#include <pipeline/Handler.h>
+#include <MediaDefinitions.h>
+
+#include <future>  // NOLINT
+#include <memory>
+#include <string>
+
+using testing::Eq;
+using testing::Gt;
+using erizo::DataPacket;
+using erizo::HandlerProfiler;
+using erizo::InboundHandler;
+using erizo::Pipeline;
+using erizo::ThreadWorker;
+
+// Spins for the given number of cycles on every packet before forwarding it
+class SpinningHandler : public InboundHandler {
+ public:
+  SpinningHandler(std::string name, uint64_t cycles) : name_{name}, cycles_{cycles} {}
+
+  void enable() override {}
+  void disable() override {}
+  std::string getName() override { return name_; }
+  void notifyUpdate() override {}
+
+  void read(Context *ctx, std::shared_ptr<DataPacket> packet) override {
+    uint64_t start = HandlerProfiler::readCycles();
+    while (HandlerProfiler::readCycles() - start < cycles_) {
+    }
+    ctx->fireRead(std::move(packet));
+  }
+
+ private:
+  std::string name_;
+  uint64_t cycles_;
+};
+
+class HandlerProfilerTest : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    HandlerProfiler::setSamplingInterval(1);
+    HandlerProfiler::setCurrent(&profiler);
+    pipeline = Pipeline::create();
+    pipeline->addBack(std::make_shared<SpinningHandler>("cheap", 0));
+    pipeline->addBack(std::make_shared<SpinningHandler>("expensive", 200000));
+    pipeline->finalize();
+  }
+
+  virtual void TearDown() {
+    HandlerProfiler::setCurrent(nullptr);
+    HandlerProfiler::setSamplingInterval(HandlerProfiler::kDefaultSamplingInterval);
+  }
+
+  void readPackets(int packets) {
+    char buffer[100] = {0};
+    for (int index = 0; index < packets; index++) {
+      pipeline->read(std::make_shared<DataPacket>(0, buffer, sizeof(buffer), erizo::VIDEO_PACKET));
+    }
+  }
+
+  HandlerProfiler profiler;
+  std::shared_ptr<Pipeline> pipeline;
+};
+
+TEST_F(HandlerProfilerTest, snapshot_CountsTheCallsOfEveryHandler) {
+  readPackets(5);
+  pipeline->notifyUpdate();
+
+  HandlerProfiler::Snapshot snapshot = profiler.getSnapshot();
+
+  EXPECT_THAT(snapshot["cheap"][HandlerProfiler::kRead].calls, Eq(5u));
+  EXPECT_THAT(snapshot["expensive"][HandlerProfiler::kRead].calls, Eq(5u));
+  // finalize() notifies the handlers too
+  EXPECT_THAT(snapshot["cheap"][HandlerProfiler::kNotifyUpdate].calls, Eq(2u));
+  EXPECT_THAT(snapshot["cheap"][HandlerProfiler::kWrite].calls, Eq(0u));
+}
+
+TEST_F(HandlerProfilerTest, snapshot_DoesNotChargeTheNextHandlersToTheCaller) {
+  readPackets(5);
+
+  HandlerProfiler::Snapshot snapshot = profiler.getSnapshot();
+
+  EXPECT_THAT(snapshot["expensive"][HandlerProfiler::kRead].cycles, Gt(5 * 200000u));
+  EXPECT_THAT(snapshot["cheap"][HandlerProfiler::kRead].cycles,
+              testing::Lt(snapshot["expensive"][HandlerProfiler::kRead].cycles / 10));
+}
+
+TEST_F(HandlerProfilerTest, snapshot_EstimatesCyclesOfAllCalls_WhenSampling) {
+  HandlerProfiler::setSamplingInterval(4);
+
+  readPackets(8);
+
+  HandlerProfiler::Snapshot snapshot = profiler.getSnapshot();
+  EXPECT_THAT(snapshot["expensive"][HandlerProfiler::kRead].calls, Eq(8u));
+  EXPECT_THAT(snapshot["expensive"][HandlerProfiler::kRead].cycles, Gt(8 * 200000u));
+}
+
+TEST_F(HandlerProfilerTest, nothingIsRecorded_WhenProfilingIsDisabled) {
+  HandlerProfiler::setSamplingInterval(0);
+
+  readPackets(5);
+
+  EXPECT_THAT(profiler.getSnapshot()["cheap"][HandlerProfiler::kRead].calls, Eq(0u));
+}
+
+TEST_F(HandlerProfilerTest, reset_ClearsTheCosts) {
+  readPackets(5);
+
+  profiler.reset();
+
+  EXPECT_THAT(profiler.getSnapshot()["cheap"][HandlerProfiler::kRead].calls, Eq(0u));
+}
+
+TEST_F(HandlerProfilerTest, reset_KeepsCountingTheCallsMadeAfterIt) {
+  readPackets(5);
+  profiler.reset();
+
+  readPackets(3);
+
+  EXPECT_THAT(profiler.getSnapshot()["cheap"][HandlerProfiler::kRead].calls, Eq(3u));
+  EXPECT_THAT(profiler.getSnapshot()["expensive"][HandlerProfiler::kRead].cycles, Gt(0u));
+}
+
+TEST(WorkerHandlerProfilerTest, getHandlerProfile_ReturnsTheHandlersRunInTheWorker) {
+  HandlerProfiler::setSamplingInterval(1);
+  auto worker = std::make_shared<ThreadWorker>();
+  worker->start();
+  auto pipeline = Pipeline::create();
+  pipeline->addBack(std::make_shared<SpinningHandler>("handler", 0));
+  std::promise<void> done;
+  worker->task([pipeline, &done] {
+    pipeline->finalize();
+    char buffer[100] = {0};
+    pipeline->read(std::make_shared<DataPacket>(0, buffer, sizeof(buffer), erizo::VIDEO_PACKET));
+    done.set_value();
+  });
+  done.get_future().wait();
+
+  HandlerProfiler::Snapshot snapshot = worker->getHandlerProfile();
+  worker->close();
+  HandlerProfiler::setSamplingInterval(HandlerProfiler::kDefaultSamplingInterval);
+
+  EXPECT_THAT(snapshot["handler"][HandlerProfiler::kRead].calls, Eq(1u));
+}
@@ -0,0 +1,80 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/IOWorker.h>
+
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <memory>
+#include <vector>
+
+using testing::Eq;
+using testing::Lt;
+using testing::ElementsAre;
+
+constexpr std::chrono::milliseconds kIOWorkerPollInterval(100);
+
+class IOWorkerTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    io_worker = std::make_shared<erizo::IOWorker>();
+    io_worker->start();
+  }
+  virtual void TearDown() {
+    io_worker->close();
+  }
+
+  std::shared_ptr<erizo::IOWorker> io_worker;
+};
+
+TEST_F(IOWorkerTest, task_RunsBeforeThePollInterval_WhenQueued) {
+  std::promise<void> task_run;
+  auto start = std::chrono::steady_clock::now();
+
+  io_worker->task([&task_run] {
+    task_run.set_value();
+  });
+
+  EXPECT_THAT(task_run.get_future().wait_for(kIOWorkerPollInterval), Eq(std::future_status::ready));
+  EXPECT_THAT(std::chrono::steady_clock::now() - start, Lt(kIOWorkerPollInterval));
+}
+
+TEST_F(IOWorkerTest, task_RunsTasksInOrder_WhenQueuedFromTheSameThread) {
+  std::vector<int> results;
+  std::promise<void> tasks_run;
+
+  io_worker->task([&results] { results.push_back(1); });
+  io_worker->task([&results] { results.push_back(2); });
+  io_worker->task([&results, &tasks_run] {
+    results.push_back(3);
+    tasks_run.set_value();
+  });
+
+  tasks_run.get_future().wait();
+  EXPECT_THAT(results, ElementsAre(1, 2, 3));
+}
+
+TEST_F(IOWorkerTest, getTaskLatency_CountsTheDelayOfEveryTask_WhenTasksRun) {
+  std::promise<void> task_run;
+
+  io_worker->task([] {});
+  io_worker->task([&task_run] { task_run.set_value(); });
+
+  task_run.get_future().wait();
+  EXPECT_THAT(io_worker->getTaskLatency().getDelays().getCount(), Eq(2u));
+}
+
+TEST_F(IOWorkerTest, getTaskLatency_AccountsTasksToTheirOrigin) {
+  std::promise<void> task_run;
+
+  io_worker->task([] {});
+  {
+    erizo::TaskOriginScope scope{erizo::kPacketTask};
+    io_worker->task([&task_run] { task_run.set_value(); });
+  }
+
+  task_run.get_future().wait();
+  erizo::TaskLatency task_latency = io_worker->getTaskLatency();
+  EXPECT_THAT(task_latency.getDelays(erizo::kApiTask).getCount(), Eq(1u));
+  EXPECT_THAT(task_latency.getDelays(erizo::kPacketTask).getCount(), Eq(1u));
+}
@@ -0,0 +1,171 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/MigratableWorker.h>
+#include <thread/Worker.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <memory>
+#include <vector>
+
+using testing::Eq;
+using erizo::MigratableWorker;
+using erizo::ThreadWorker;
+
+constexpr int kArbitraryNumberOfTasks = 1000;
+
+class MigratableWorkerTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    first_worker = std::make_shared<ThreadWorker>();
+    second_worker = std::make_shared<ThreadWorker>();
+    first_worker->start();
+    second_worker->start();
+    worker = std::make_shared<MigratableWorker>(first_worker);
+  }
+
+  virtual void TearDown() {
+    first_worker->close();
+    second_worker->close();
+  }
+
+  boost::thread::id getThreadIdOfNextTask() {
+    std::promise<boost::thread::id> thread_id;
+    worker->task([&thread_id] {
+      thread_id.set_value(boost::this_thread::get_id());
+    });
+    return thread_id.get_future().get();
+  }
+
+  std::shared_ptr<ThreadWorker> first_worker;
+  std::shared_ptr<ThreadWorker> second_worker;
+  std::shared_ptr<MigratableWorker> worker;
+};
+
+TEST_F(MigratableWorkerTest, task_RunsInTarget) {
+  EXPECT_THAT(getThreadIdOfNextTask(), Eq(first_worker->getId()));
+}
+
+TEST_F(MigratableWorkerTest, migrateTo_RunsNextTasksInNewTarget) {
+  EXPECT_TRUE(worker->migrateTo(second_worker).get());
+
+  EXPECT_THAT(worker->getTarget(), Eq(second_worker));
+  EXPECT_THAT(getThreadIdOfNextTask(), Eq(second_worker->getId()));
+}
+
+TEST_F(MigratableWorkerTest, migrateTo_Fails_WhenMigratingToTheSameTarget) {
+  EXPECT_FALSE(worker->migrateTo(first_worker).get());
+}
+
+TEST_F(MigratableWorkerTest, migrateTo_KeepsOrderAndDoesNotRunTasksConcurrently) {
+  std::vector<int> executed_tasks;
+  std::atomic<bool> running{false};
+  std::atomic<int> concurrent_executions{0};
+  std::promise<void> all_executed;
+  auto queue_task = [&](int index) {
+    worker->task([&, index] {
+      if (running.exchange(true)) {
+        concurrent_executions++;
+      }
+      executed_tasks.push_back(index);
+      running = false;
+      if (index == kArbitraryNumberOfTasks - 1) {
+        all_executed.set_value();
+      }
+    });
+  };
+
+  for (int index = 0; index < kArbitraryNumberOfTasks / 2; index++) {
+    queue_task(index);
+  }
+  boost::future<bool> migrated = worker->migrateTo(second_worker);
+  for (int index = kArbitraryNumberOfTasks / 2; index < kArbitraryNumberOfTasks; index++) {
+    queue_task(index);
+  }
+  all_executed.get_future().wait();
+
+  EXPECT_TRUE(migrated.get());
+  EXPECT_THAT(concurrent_executions.load(), Eq(0));
+  ASSERT_THAT(executed_tasks.size(), Eq(static_cast<size_t>(kArbitraryNumberOfTasks)));
+  for (int index = 0; index < kArbitraryNumberOfTasks; index++) {
+    EXPECT_THAT(executed_tasks[index], Eq(index));
+  }
+}
+
+TEST_F(MigratableWorkerTest, scheduleFromNow_RunsInNewTarget_WhenMigratedBeforeRunning) {
+  std::promise<boost::thread::id> thread_id;
+  worker->scheduleFromNow([&thread_id] {
+    thread_id.set_value(boost::this_thread::get_id());
+  }, std::chrono::milliseconds(50));
+
+  EXPECT_TRUE(worker->migrateTo(second_worker).get());
+
+  EXPECT_THAT(thread_id.get_future().get(), Eq(second_worker->getId()));
+}
+
+TEST_F(MigratableWorkerTest, migrateTo_DoesNotBlockTheNewTarget_WhileTheOldOneIsBusy) {
+  std::promise<void> unblock;
+  std::shared_future<void> unblocked = unblock.get_future().share();
+  std::promise<void> blocked;
+  worker->task([unblocked, &blocked] {
+    blocked.set_value();
+    unblocked.wait();
+  });
+  blocked.get_future().wait();
+
+  boost::future<bool> migrated = worker->migrateTo(second_worker);
+  std::promise<void> new_target_task_run;
+  second_worker->task([&new_target_task_run] {
+    new_target_task_run.set_value();
+  });
+
+  EXPECT_THAT(new_target_task_run.get_future().wait_for(std::chrono::seconds(5)), Eq(std::future_status::ready));
+  unblock.set_value();
+  EXPECT_TRUE(migrated.get());
+}
+
+TEST_F(MigratableWorkerTest, unschedule_ReleasesTheTaskCaptures) {
+  auto capture = std::make_shared<int>(0);
+  std::weak_ptr<int> weak_capture = capture;
+  auto id = worker->scheduleFromNow([capture] {}, std::chrono::seconds(10));
+  capture.reset();
+  getThreadIdOfNextTask();
+
+  worker->unschedule(id);
+  getThreadIdOfNextTask();
+
+  EXPECT_TRUE(weak_capture.expired());
+}
+
+TEST_F(MigratableWorkerTest, unschedule_ReleasesTheTaskCaptures_WhenMigratedAfterScheduling) {
+  auto capture = std::make_shared<int>(0);
+  std::weak_ptr<int> weak_capture = capture;
+  auto id = worker->scheduleFromNow([capture] {}, std::chrono::seconds(10));
+  capture.reset();
+  EXPECT_TRUE(worker->migrateTo(second_worker).get());
+
+  worker->unschedule(id);
+  std::promise<void> first_worker_synced;
+  first_worker->task([&first_worker_synced] {
+    first_worker_synced.set_value();
+  });
+  first_worker_synced.get_future().wait();
+
+  EXPECT_TRUE(weak_capture.expired());
+}
+
+TEST_F(MigratableWorkerTest, scheduleFromNow_AccountsTheTaskOnce) {
+  std::promise<void> task_run;
+  worker->scheduleFromNow([&task_run] {
+    task_run.set_value();
+  }, std::chrono::milliseconds(1));
+  task_run.get_future().wait();
+  // Joins the worker thread, so the task has been accounted
+  first_worker->close();
+
+  erizo::TaskLatency task_latency = first_worker->getTaskLatency();
+  EXPECT_THAT(task_latency.getDurations(erizo::kTimerTask).getCount(), Eq(1u));
+  EXPECT_THAT(task_latency.getDurations().getCount(), Eq(1u));
+}
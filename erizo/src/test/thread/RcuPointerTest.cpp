@@ -0,0 +1,93 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/RcuPointer.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>  // NOLINT
+
+using testing::Eq;
+using erizo::RcuPointer;
+
+constexpr int kUpdates = 10000;
+
+struct Value {
+  Value(int number_, std::atomic<int> *deleted_) : number{number_}, alive{true}, deleted{deleted_} {}
+  ~Value() {
+    alive = false;
+    (*deleted)++;
+  }
+  int number;
+  std::atomic<bool> alive;
+  std::atomic<int> *deleted;
+};
+
+class RcuPointerTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<const Value> value(int number) {
+    return std::unique_ptr<const Value>(new Value(number, &deleted));
+  }
+
+  std::atomic<int> deleted{0};
+};
+
+TEST_F(RcuPointerTest, update_DeletesThePreviousValue_WhenThereAreNoReaders) {
+  RcuPointer<Value> pointer(value(1));
+
+  pointer.update(value(2));
+
+  EXPECT_THAT(deleted.load(), Eq(1));
+  EXPECT_THAT(pointer.read()->number, Eq(2));
+}
+
+TEST_F(RcuPointerTest, update_KeepsThePreviousValue_UntilItsLastReaderIsDone) {
+  RcuPointer<Value> pointer(value(1));
+  std::unique_ptr<RcuPointer<Value>::ReadGuard> reader(new RcuPointer<Value>::ReadGuard(pointer.read()));
+
+  pointer.update(value(2));
+
+  EXPECT_THAT(pointer.read()->number, Eq(2));
+  EXPECT_THAT(deleted.load(), Eq(0));
+  EXPECT_TRUE((*reader)->alive);
+  EXPECT_THAT((*reader)->number, Eq(1));
+  reader.reset();
+  EXPECT_THAT(deleted.load(), Eq(1));
+}
+
+TEST_F(RcuPointerTest, update_DoesNotWait_WhenItIsCalledByAReader) {
+  RcuPointer<Value> pointer(value(1));
+
+  {
+    RcuPointer<Value>::ReadGuard reader = pointer.read();
+    pointer.update(value(2));
+    EXPECT_THAT(reader->number, Eq(1));
+  }
+
+  EXPECT_THAT(deleted.load(), Eq(1));
+}
+
+TEST_F(RcuPointerTest, read_NeverSeesADeletedValue_WhenItIsUpdatedFromAnotherThread) {
+  std::atomic<bool> done{false};
+  bool always_alive = true;
+  int last_number = 0;
+  {
+    RcuPointer<Value> pointer(value(0));
+    std::thread writer([this, &pointer, &done] {
+      for (int number = 1; number <= kUpdates; number++) {
+        pointer.update(value(number));
+      }
+      done = true;
+    });
+    while (!done) {
+      RcuPointer<Value>::ReadGuard reader = pointer.read();
+      always_alive = always_alive && reader->alive && reader->number >= last_number;
+      last_number = reader->number;
+    }
+    writer.join();
+    EXPECT_THAT(pointer.read()->number, Eq(kUpdates));
+  }
+
+  EXPECT_TRUE(always_alive);
+  EXPECT_THAT(deleted.load(), Eq(kUpdates + 1));
+}
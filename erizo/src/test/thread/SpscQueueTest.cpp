@@ -0,0 +1,64 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/SpscQueue.h>
+
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+using testing::Eq;
+using testing::ElementsAre;
+using erizo::SpscQueue;
+
+constexpr int kProducedElements = 100000;
+
+TEST(SpscQueueTest, push_KeepsTheElement_WhenTheRingIsFull) {
+  SpscQueue<std::shared_ptr<int>> queue(1);
+  std::vector<int> consumed;
+
+  EXPECT_TRUE(queue.push(std::make_shared<int>(1)));
+  EXPECT_FALSE(queue.push(std::make_shared<int>(2)));
+  queue.consumeAll([&consumed](std::shared_ptr<int> &value) { consumed.push_back(*value); });
+
+  EXPECT_THAT(consumed, ElementsAre(1, 2));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, consumeAll_KeepsTheOrder_WhenTheRingGetsRoomWhileOverflowing) {
+  SpscQueue<int> queue(2);
+  std::vector<int> consumed;
+
+  queue.push(1);
+  queue.push(2);
+  queue.push(3);
+  queue.push(4);
+  EXPECT_THAT(queue.consumeAll([&consumed](int value) { consumed.push_back(value); }), Eq(4u));
+  queue.push(5);
+  queue.consumeAll([&consumed](int value) { consumed.push_back(value); });
+
+  EXPECT_THAT(consumed, ElementsAre(1, 2, 3, 4, 5));
+}
+
+TEST(SpscQueueTest, consumeAll_ReceivesEveryElementInOrder_WhenTheRingOverflowsFromAnotherThread) {
+  SpscQueue<int> queue(4);
+  std::vector<int> consumed;
+
+  std::thread producer([&queue] {
+    for (int value = 0; value < kProducedElements; value++) {
+      queue.push(value);
+    }
+  });
+  while (consumed.size() < static_cast<size_t>(kProducedElements)) {
+    if (queue.consumeAll([&consumed](int value) { consumed.push_back(value); }) == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  bool in_order = true;
+  for (int value = 0; value < kProducedElements; value++) {
+    in_order = in_order && consumed[value] == value;
+  }
+  EXPECT_TRUE(in_order);
+}
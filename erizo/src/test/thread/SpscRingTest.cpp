@@ -0,0 +1,83 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/SpscRing.h>
+
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+using testing::Eq;
+using testing::ElementsAre;
+using erizo::SpscRing;
+
+constexpr int kProducedElements = 100000;
+
+TEST(SpscRingTest, capacity_IsRoundedUpToAPowerOfTwo) {
+  SpscRing<int> ring(100);
+
+  EXPECT_THAT(ring.capacity(), Eq(128u));
+}
+
+TEST(SpscRingTest, push_Fails_WhenTheRingIsFull) {
+  SpscRing<int> ring(2);
+
+  EXPECT_TRUE(ring.push(1));
+  EXPECT_TRUE(ring.push(2));
+  EXPECT_FALSE(ring.push(3));
+  EXPECT_THAT(ring.size(), Eq(2u));
+}
+
+TEST(SpscRingTest, consumeAll_ConsumesElementsInOrder_WhenTheIndexesWrapAround) {
+  SpscRing<int> ring(4);
+  std::vector<int> consumed;
+
+  for (int value = 0; value < 10; value++) {
+    ring.push(value);
+    if (value % 3 == 2) {
+      ring.consumeAll([&consumed](int value) { consumed.push_back(value); });
+    }
+  }
+  ring.consumeAll([&consumed](int value) { consumed.push_back(value); });
+
+  EXPECT_THAT(consumed, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTest, pop_ReleasesTheElement_WhenConsumed) {
+  SpscRing<std::shared_ptr<int>> ring(4);
+  auto element = std::make_shared<int>(1);
+  ring.push(element);
+
+  std::shared_ptr<int> popped;
+  EXPECT_TRUE(ring.pop(&popped));
+  popped.reset();
+
+  EXPECT_THAT(element.use_count(), Eq(1));
+  EXPECT_FALSE(ring.pop(&popped));
+}
+
+TEST(SpscRingTest, consumeAll_ReceivesEveryElement_WhenProducedFromAnotherThread) {
+  SpscRing<int> ring(64);
+  std::vector<int> consumed;
+
+  std::thread producer([&ring] {
+    for (int value = 0; value < kProducedElements; value++) {
+      while (!ring.push(value)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  while (consumed.size() < static_cast<size_t>(kProducedElements)) {
+    if (ring.consumeAll([&consumed](int value) { consumed.push_back(value); }) == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  bool in_order = true;
+  for (int value = 0; value < kProducedElements; value++) {
+    in_order = in_order && consumed[value] == value;
+  }
+  EXPECT_TRUE(in_order);
+}
@@ -0,0 +1,93 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/ThreadPool.h>
+
+#include <future>  // NOLINT
+#include <memory>
+
+using testing::Eq;
+using testing::Ne;
+using erizo::ThreadPool;
+using erizo::Worker;
+
+constexpr int kNumberOfQueuedTasks = 10;
+
+class ThreadPoolTest : public ::testing::Test {
+ public:
+  ThreadPoolTest() : thread_pool{2} {}
+
+  virtual void SetUp() {
+    thread_pool.start();
+  }
+  virtual void TearDown() {
+    thread_pool.close();
+  }
+
+  ThreadPool thread_pool;
+};
+
+TEST_F(ThreadPoolTest, getLessUsedWorker_ReturnsLessReferencedWorker_WhenLoadIsSimilar) {
+  std::shared_ptr<Worker> first_worker = thread_pool.getLessUsedWorker();
+  std::shared_ptr<Worker> second_worker = thread_pool.getLessUsedWorker();
+
+  EXPECT_THAT(second_worker, Ne(first_worker));
+}
+
+TEST_F(ThreadPoolTest, getLessUsedWorker_AvoidsWorkersWithQueuedTasks) {
+  std::shared_ptr<Worker> first_worker = thread_pool.getLessUsedWorker();
+  std::shared_ptr<Worker> second_worker = thread_pool.getLessUsedWorker();
+  std::promise<void> unblock;
+  std::shared_future<void> unblocked = unblock.get_future().share();
+  std::promise<void> blocked;
+
+  second_worker->task([unblocked, &blocked] {
+    blocked.set_value();
+    unblocked.wait();
+  });
+  blocked.get_future().wait();
+  for (int i = 0; i < kNumberOfQueuedTasks; i++) {
+    second_worker->task([] {});
+  }
+  std::shared_ptr<Worker> another_reference_to_first = first_worker;
+
+  EXPECT_THAT(thread_pool.getLessUsedWorker(), Eq(first_worker));
+  EXPECT_THAT(thread_pool.getWorkersLoad()[1].queued_tasks, Eq(static_cast<uint64_t>(kNumberOfQueuedTasks)));
+  unblock.set_value();
+}
+
+TEST_F(ThreadPoolTest, getLessUsedHandshakeWorker_ReturnsNull_WhenThereAreNoHandshakeWorkers) {
+  EXPECT_THAT(thread_pool.getLessUsedHandshakeWorker(), Eq(nullptr));
+}
+
+TEST(ThreadPoolHandshakeTest, getLessUsedHandshakeWorker_ReturnsWorkersApartFromMediaWorkers) {
+  ThreadPool thread_pool{1, 1};
+  thread_pool.start();
+
+  std::shared_ptr<Worker> handshake_worker = thread_pool.getLessUsedHandshakeWorker();
+
+  EXPECT_THAT(handshake_worker, Ne(nullptr));
+  EXPECT_THAT(handshake_worker, Ne(thread_pool.getLessUsedWorker()));
+  EXPECT_THAT(thread_pool.getWorkersLoad().size(), Eq(1u));
+  thread_pool.close();
+}
+
+TEST_F(ThreadPoolTest, getTaskLatencies_AccountsTasksToTheirOrigin) {
+  std::shared_ptr<Worker> worker = thread_pool.getLessUsedWorker();
+  std::promise<void> tasks_run;
+
+  worker->task([] {});
+  worker->task([] {}, erizo::kPacketTask);
+  worker->post([worker, &tasks_run] {
+    worker->post([&tasks_run] { tasks_run.set_value(); });
+  });
+  tasks_run.get_future().wait();
+  // Joins the worker threads, so every task has been accounted
+  thread_pool.close();
+
+  erizo::TaskLatency task_latency = thread_pool.getTaskLatencies()[0];
+  EXPECT_THAT(task_latency.getDurations(erizo::kApiTask).getCount(), Eq(2u));
+  EXPECT_THAT(task_latency.getDurations(erizo::kPacketTask).getCount(), Eq(1u));
+  EXPECT_THAT(task_latency.getDelays(erizo::kInternalTask).getCount(), Eq(1u));
+  EXPECT_THAT(task_latency.getDurations().getCount(), Eq(4u));
+}
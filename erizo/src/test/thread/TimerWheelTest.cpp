@@ -0,0 +1,204 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread/TimerWheel.h>
+#include <thread/Worker.h>
+
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+using testing::Eq;
+using testing::ElementsAre;
+using erizo::TimerWheel;
+using erizo::ScheduledTaskReference;
+using erizo::ThreadWorker;
+using erizo::time_point;
+using erizo::duration;
+
+constexpr int kBenchmarkTimers = 100000;
+constexpr int kBenchmarkThreads = 4;
+constexpr std::chrono::milliseconds kBenchmarkMaxDelay(10000);
+
+class TimerWheelTest : public ::testing::Test {
+ public:
+  TimerWheelTest() : start{std::chrono::steady_clock::now()}, wheel{start} {}
+
+  std::shared_ptr<ScheduledTaskReference> schedule(int value, std::chrono::milliseconds delay) {
+    auto reference = std::make_shared<ScheduledTaskReference>();
+    wheel.add(reference, start + delay, [this, value] {
+      executed.push_back(value);
+    });
+    return reference;
+  }
+
+  time_point start;
+  TimerWheel wheel;
+  std::vector<int> executed;
+};
+
+TEST_F(TimerWheelTest, advance_RunsTasksWhoseDeadlineHasPassed) {
+  schedule(1, std::chrono::milliseconds(10));
+  schedule(2, std::chrono::milliseconds(20));
+
+  wheel.advance(start + std::chrono::milliseconds(15));
+
+  EXPECT_THAT(executed, ElementsAre(1));
+  EXPECT_THAT(wheel.size(), Eq(1u));
+}
+
+TEST_F(TimerWheelTest, advance_RunsTasksInDeadlineOrder_WhenTheyAreInDifferentLevels) {
+  schedule(3, std::chrono::seconds(70));
+  schedule(1, std::chrono::milliseconds(100));
+  schedule(2, std::chrono::seconds(2));
+
+  for (int ms = 0; ms <= 70000; ms += 10) {
+    wheel.advance(start + std::chrono::milliseconds(ms));
+  }
+
+  EXPECT_THAT(executed, ElementsAre(1, 2, 3));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST_F(TimerWheelTest, advance_DoesNotRunTasksBeforeTheirDeadline_WhenFarAway) {
+  schedule(1, std::chrono::seconds(20));
+
+  wheel.advance(start + std::chrono::milliseconds(19999));
+  EXPECT_TRUE(executed.empty());
+
+  wheel.advance(start + std::chrono::seconds(20));
+  EXPECT_THAT(executed, ElementsAre(1));
+}
+
+TEST_F(TimerWheelTest, remove_CancelsTheTask) {
+  auto reference = schedule(1, std::chrono::milliseconds(10));
+  schedule(2, std::chrono::milliseconds(10));
+
+  wheel.remove(reference);
+  wheel.advance(start + std::chrono::milliseconds(10));
+
+  EXPECT_THAT(executed, ElementsAre(2));
+}
+
+TEST_F(TimerWheelTest, advance_SkipsCancelledTasks) {
+  auto reference = schedule(1, std::chrono::milliseconds(10));
+
+  reference->cancel();
+  wheel.advance(start + std::chrono::milliseconds(10));
+
+  EXPECT_TRUE(executed.empty());
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST_F(TimerWheelTest, advance_AllowsTasksToRemoveOtherExpiredTasks) {
+  std::shared_ptr<ScheduledTaskReference> second;
+  auto first = std::make_shared<ScheduledTaskReference>();
+  wheel.add(first, start + std::chrono::milliseconds(10), [this, &second] {
+    executed.push_back(1);
+    wheel.remove(second);
+  });
+  second = schedule(2, std::chrono::milliseconds(10));
+
+  wheel.advance(start + std::chrono::milliseconds(10));
+
+  EXPECT_THAT(executed, ElementsAre(1));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST_F(TimerWheelTest, getNextDeadline_ReturnsTheEarliestDeadline) {
+  time_point deadline;
+  EXPECT_FALSE(wheel.getNextDeadline(&deadline));
+
+  schedule(1, std::chrono::milliseconds(50));
+  schedule(2, std::chrono::milliseconds(30));
+
+  ASSERT_TRUE(wheel.getNextDeadline(&deadline));
+  EXPECT_THAT(deadline, Eq(start + std::chrono::milliseconds(30)));
+}
+
+TEST(WorkerTimerWheelTest, scheduleFromNow_RunsInTheWorkerThread) {
+  auto worker = std::make_shared<ThreadWorker>();
+  worker->start();
+  std::promise<boost::thread::id> thread_id;
+
+  worker->scheduleFromNow([&thread_id] {
+    thread_id.set_value(boost::this_thread::get_id());
+  }, std::chrono::milliseconds(10));
+
+  EXPECT_THAT(thread_id.get_future().get(), Eq(worker->getId()));
+  worker->close();
+}
+
+TEST(WorkerTimerWheelTest, unschedule_CancelsTheTask) {
+  auto worker = std::make_shared<ThreadWorker>();
+  worker->start();
+  std::atomic<bool> executed{false};
+  std::promise<void> done;
+
+  auto id = worker->scheduleFromNow([&executed] {
+    executed = true;
+  }, std::chrono::milliseconds(20));
+  worker->unschedule(id);
+  worker->scheduleFromNow([&done] {
+    done.set_value();
+  }, std::chrono::milliseconds(40));
+
+  done.get_future().wait();
+  EXPECT_FALSE(executed);
+  worker->close();
+}
+
+// Arms kBenchmarkTimers timers from several threads in one TimerWheel per thread, as Workers do, and runs them.
+// Run it with --gtest_also_run_disabled_tests --gtest_output=xml to get the ns/timer of both steps
+TEST(TimerWheelBenchmark, DISABLED_ArmAndRun100kTimers) {
+  std::vector<std::vector<std::chrono::milliseconds>> delays(kBenchmarkThreads);
+  std::mt19937 generator{1234};
+  std::uniform_int_distribution<int> delay_distribution(1, kBenchmarkMaxDelay.count());
+  for (auto &thread_delays : delays) {
+    for (int index = 0; index < kBenchmarkTimers / kBenchmarkThreads; index++) {
+      thread_delays.push_back(std::chrono::milliseconds(delay_distribution(generator)));
+    }
+  }
+  auto run_in_threads = [&delays](std::function<void(int)> f) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < kBenchmarkThreads; thread++) {
+      threads.emplace_back(f, thread);
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    return std::chrono::steady_clock::now() - start;
+  };
+
+  std::atomic<int> wheel_executed{0};
+  duration wheel_arm_time, wheel_run_time;
+  std::vector<std::unique_ptr<TimerWheel>> wheels;
+  time_point start = std::chrono::steady_clock::now();
+  for (int thread = 0; thread < kBenchmarkThreads; thread++) {
+    wheels.emplace_back(new TimerWheel(start));
+  }
+  wheel_arm_time = run_in_threads([&wheels, &delays, &wheel_executed, start](int thread) {
+    for (auto delay : delays[thread]) {
+      wheels[thread]->add(std::make_shared<ScheduledTaskReference>(), start + delay, [&wheel_executed] {
+        wheel_executed++;
+      });
+    }
+  });
+  wheel_run_time = run_in_threads([&wheels, start](int thread) {
+    for (int ms = 0; ms <= kBenchmarkMaxDelay.count(); ms++) {
+      wheels[thread]->advance(start + std::chrono::milliseconds(ms));
+    }
+  });
+
+  auto to_ns_per_timer = [](duration time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() / kBenchmarkTimers;
+  };
+  ::testing::Test::RecordProperty("arm_ns_per_timer", std::to_string(to_ns_per_timer(wheel_arm_time)));
+  ::testing::Test::RecordProperty("run_10s_of_ticks_ns_per_timer", std::to_string(to_ns_per_timer(wheel_run_time)));
+  EXPECT_THAT(wheel_executed.load(), Eq(kBenchmarkTimers));
+}
@@ -22,6 +22,17 @@ MATCHER_P(RtpHasSequenceNumberFromBuffer, seq_num, "") {
 MATCHER_P(RtpHasSequenceNumber, seq_num, "") {
   return (reinterpret_cast<erizo::RtpHeader*>(std::get<0>(arg)->data))->getSeqNumber() == seq_num;
 }
+MATCHER_P(PacketHasSsrc, ssrc, "") {
+  return (reinterpret_cast<erizo::RtpHeader*>(std::get<0>(arg)->data))->getSSRC() == ssrc;
+}
+MATCHER_P(PacketHasPayloadType, pt, "") {
+  return (reinterpret_cast<erizo::RtpHeader*>(std::get<0>(arg)->data))->getPayloadType() == pt;
+}
+MATCHER_P(RtxHasOriginalSequenceNumber, seq_num, "") {
+  char *data = std::get<0>(arg)->data;
+  uint16_t osn = *reinterpret_cast<uint16_t*>(data + reinterpret_cast<erizo::RtpHeader*>(data)->getHeaderLength());
+  return ntohs(osn) == seq_num;
+}
 MATCHER_P(NackHasSequenceNumber, seq_num, "") {
   return (reinterpret_cast<erizo::RtcpHeader*>(std::get<0>(arg)->data))->getNackPid() == seq_num;
 }
@@ -3,6 +3,7 @@
 #endif
 
 #include "IOThreadPool.h"
+#include "ThreadPool.h"
 
 using v8::Local;
 using v8::Value;
@@ -28,6 +29,9 @@ NAN_MODULE_INIT(IOThreadPool::Init) {
   // Prototype
   Nan::SetPrototypeMethod(tpl, "close", close);
   Nan::SetPrototypeMethod(tpl, "start", start);
+  Nan::SetPrototypeMethod(tpl, "resetStats", resetStats);
+  Nan::SetPrototypeMethod(tpl, "getTaskLatency", getTaskLatency);
+  Nan::SetPrototypeMethod(tpl, "getSocketBatchStats", getSocketBatchStats);
 
   constructor.Reset(Nan::GetFunction(tpl).ToLocalChecked());
   Nan::Set(target, Nan::New("IOThreadPool").ToLocalChecked(), Nan::GetFunction(tpl).ToLocalChecked());
@@ -58,3 +62,29 @@ NAN_METHOD(IOThreadPool::start) {
 
   obj->me->start();
 }
+
+NAN_METHOD(IOThreadPool::resetStats) {
+  IOThreadPool* obj = Nan::ObjectWrap::Unwrap<IOThreadPool>(info.Holder());
+
+  obj->me->resetStats();
+}
+
+NAN_METHOD(IOThreadPool::getTaskLatency) {
+  IOThreadPool* obj = Nan::ObjectWrap::Unwrap<IOThreadPool>(info.Holder());
+
+  info.GetReturnValue().Set(ThreadPool::toTaskLatencyArray(obj->me->getTaskLatencies()));
+}
+
+NAN_METHOD(IOThreadPool::getSocketBatchStats) {
+  IOThreadPool* obj = Nan::ObjectWrap::Unwrap<IOThreadPool>(info.Holder());
+
+  erizo::SocketBatchStats stats = obj->me->getSocketBatchStats();
+  v8::Local<v8::Object> result = Nan::New<v8::Object>();
+  Nan::Set(result, Nan::New("sendCalls").ToLocalChecked(), Nan::New(static_cast<double>(stats.send_calls)));
+  Nan::Set(result, Nan::New("gsoCalls").ToLocalChecked(), Nan::New(static_cast<double>(stats.gso_calls)));
+  Nan::Set(result, Nan::New("sentDatagrams").ToLocalChecked(), Nan::New(static_cast<double>(stats.sent_datagrams)));
+  Nan::Set(result, Nan::New("receiveCalls").ToLocalChecked(), Nan::New(static_cast<double>(stats.receive_calls)));
+  Nan::Set(result, Nan::New("receivedDatagrams").ToLocalChecked(),
+           Nan::New(static_cast<double>(stats.received_datagrams)));
+  info.GetReturnValue().Set(result);
+}
@@ -35,6 +35,16 @@ class IOThreadPool : public Nan::ObjectWrap {
      */
     static NAN_METHOD(start);
 
+    static NAN_METHOD(resetStats);
+    /*
+     * Returns the task latency of every worker since the last resetStats, like ThreadPool.getTaskLatency
+     */
+    static NAN_METHOD(getTaskLatency);
+    /*
+     * Returns the batched UDP send and read counters since the last resetStats
+     */
+    static NAN_METHOD(getSocketBatchStats);
+
     static Nan::Persistent<v8::Function> constructor;
 };
 
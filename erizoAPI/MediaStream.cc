@@ -46,6 +46,33 @@ void StatCallWorker::HandleOKCallback() {
   callback->Call(1, argv, &resource);
 }
 
+StatDeltaCallWorker::StatDeltaCallWorker(Nan::Callback *callback, std::weak_ptr<erizo::MediaStream> weak_stream,
+                                         const std::string &consumer_id)
+    : Nan::AsyncWorker{callback}, weak_stream_{weak_stream}, consumer_id_{consumer_id} {
+}
+
+void StatDeltaCallWorker::Execute() {
+  std::promise<std::vector<uint8_t>> delta_promise;
+  std::future<std::vector<uint8_t>> delta_future = delta_promise.get_future();
+  if (auto stream = weak_stream_.lock()) {
+    stream->getStatsDelta(consumer_id_, [&delta_promise] (std::vector<uint8_t> delta) {
+      delta_promise.set_value(std::move(delta));
+    });
+  } else {
+    delta_promise.set_value(std::vector<uint8_t>());
+  }
+  delta_future.wait();
+  delta_ = delta_future.get();
+}
+
+void StatDeltaCallWorker::HandleOKCallback() {
+  Local<Value> argv[] = {
+    Nan::CopyBuffer(reinterpret_cast<const char*>(delta_.data()), delta_.size()).ToLocalChecked()
+  };
+  Nan::AsyncResource resource("erizo::addon.statDeltaCall");
+  callback->Call(1, argv, &resource);
+}
+
 void destroyAsyncHandle(uv_handle_t *handle) {
   delete handle;
 }
@@ -139,6 +166,8 @@ NAN_MODULE_INIT(MediaStream::Init) {
   Nan::SetPrototypeMethod(tpl, "generatePLIPacket", generatePLIPacket);
   Nan::SetPrototypeMethod(tpl, "getStats", getStats);
   Nan::SetPrototypeMethod(tpl, "getPeriodicStats", getPeriodicStats);
+  Nan::SetPrototypeMethod(tpl, "getStatsDelta", getStatsDelta);
+  Nan::SetPrototypeMethod(tpl, "removeStatsDeltaConsumer", removeStatsDeltaConsumer);
   Nan::SetPrototypeMethod(tpl, "setFeedbackReports", setFeedbackReports);
   Nan::SetPrototypeMethod(tpl, "setSlideShowMode", setSlideShowMode);
   Nan::SetPrototypeMethod(tpl, "muteStream", muteStream);
@@ -183,7 +212,7 @@ NAN_METHOD(MediaStream::New) {
 
     bool is_publisher = Nan::To<bool>(info[5]).FromJust();
     int session_version = Nan::To<int>(info[6]).FromJust();
-    std::shared_ptr<erizo::Worker> worker = thread_pool->me->getLessUsedWorker();
+    std::shared_ptr<erizo::Worker> worker = thread_pool->me->getLessUsedMigratableWorker();
 
     MediaStream* obj = new MediaStream();
     obj->me = std::make_shared<erizo::MediaStream>(worker, wrtc, wrtc_id, stream_label, is_publisher, session_version);
@@ -474,12 +503,42 @@ NAN_METHOD(MediaStream::getStats) {
   AsyncQueueWorker(new StatCallWorker(callback, obj->me));
 }
 
-NAN_METHOD(MediaStream::getPeriodicStats) {
+NAN_METHOD(MediaStream::getStatsDelta) {
+  MediaStream* obj = Nan::ObjectWrap::Unwrap<MediaStream>(info.Holder());
+  if (info.Length() != 2 || !info[1]->IsFunction()) {
+    return;
+  }
+  Nan::Callback *callback = new Nan::Callback(info[1].As<Function>());
+  if (!obj->me || obj->closed_) {
+    Local<Value> argv[] = {
+      Nan::NewBuffer(0).ToLocalChecked()
+    };
+    Nan::Call(*callback, 1, argv);
+    return;
+  }
+  Nan::Utf8String param(Nan::To<v8::String>(info[0]).ToLocalChecked());
+  std::string consumer_id = std::string(*param);
+  AsyncQueueWorker(new StatDeltaCallWorker(callback, obj->me, consumer_id));
+}
+
+NAN_METHOD(MediaStream::removeStatsDeltaConsumer) {
   MediaStream* obj = Nan::ObjectWrap::Unwrap<MediaStream>(info.Holder());
   if (!obj->me || info.Length() != 1 || obj->closed_) {
     return;
   }
-  obj->me->setMediaStreamStatsListener(obj);
+  Nan::Utf8String param(Nan::To<v8::String>(info[0]).ToLocalChecked());
+  std::string consumer_id = std::string(*param);
+  obj->me->removeStatsDeltaConsumer(consumer_id);
+}
+
+NAN_METHOD(MediaStream::getPeriodicStats) {
+  MediaStream* obj = Nan::ObjectWrap::Unwrap<MediaStream>(info.Holder());
+  if (!obj->me || info.Length() < 1 || obj->closed_) {
+    return;
+  }
+  // With a second true argument the callback gets Buffers with deltas instead of JSON strings
+  bool binary = info.Length() > 1 && Nan::To<bool>(info[1]).FromJust();
+  obj->me->setMediaStreamStatsListener(obj, binary);
   obj->has_stats_callback_ = true;
   obj->stats_callback_ = new Nan::Callback(info[0].As<Function>());
 }
@@ -520,6 +579,19 @@ void MediaStream::notifyStats(const std::string& message) {
   uv_async_send(async_stats_);
 }
 
+void MediaStream::notifyStatsDelta(const std::vector<uint8_t>& delta) {
+  boost::mutex::scoped_lock lock(mutex);
+  if (!has_stats_callback_) {
+    return;
+  }
+  if (!async_stats_) {
+    return;
+  }
+  stats_deltas.push(delta);
+  async_stats_->data = this;
+  uv_async_send(async_stats_);
+}
+
 void MediaStream::notifyMediaStreamEvent(const std::string& type, const std::string& message) {
   boost::mutex::scoped_lock lock(mutex);
   if (!has_event_callback_) {
@@ -547,6 +619,15 @@ NAUV_WORK_CB(MediaStream::statsCallback) {
       resource.runInAsyncScope(Nan::GetCurrentContext()->Global(), obj->stats_callback_->GetFunction(), 1, args);
       obj->stats_messages.pop();
     }
+    while (!obj->stats_deltas.empty()) {
+      const std::vector<uint8_t> &delta = obj->stats_deltas.front();
+      Local<Value> args[] = {
+        Nan::CopyBuffer(reinterpret_cast<const char*>(delta.data()), delta.size()).ToLocalChecked()
+      };
+      Nan::AsyncResource resource("erizo::addon.stream.statsCallback");
+      resource.runInAsyncScope(Nan::GetCurrentContext()->Global(), obj->stats_callback_->GetFunction(), 1, args);
+      obj->stats_deltas.pop();
+    }
   }
 }
 
@@ -11,6 +11,7 @@
 
 #include <queue>
 #include <string>
+#include <vector>
 #include <future>  // NOLINT
 
 class StatCallWorker : public Nan::AsyncWorker {
@@ -26,6 +27,21 @@ class StatCallWorker : public Nan::AsyncWorker {
   std::string stat_;
 };
 
+class StatDeltaCallWorker : public Nan::AsyncWorker {
+ public:
+  StatDeltaCallWorker(Nan::Callback *callback, std::weak_ptr<erizo::MediaStream> weak_stream,
+                      const std::string &consumer_id);
+
+  void Execute();
+
+  void HandleOKCallback();
+
+ private:
+  std::weak_ptr<erizo::MediaStream> weak_stream_;
+  std::string consumer_id_;
+  std::vector<uint8_t> delta_;
+};
+
 typedef std::tuple<Nan::Persistent<v8::Promise::Resolver> *, erizo::time_point, erizo::time_point>
    StreamResultTuple;
 
@@ -42,6 +58,7 @@ class MediaStream : public MediaSink, public erizo::MediaStreamStatsListener, pu
 
     std::shared_ptr<erizo::MediaStream> me;
     std::queue<std::string> stats_messages;
+    std::queue<std::vector<uint8_t>> stats_deltas;
     std::queue<std::pair<std::string, std::string>> event_messages;
     std::queue<StreamResultTuple> futures;
     boost::mutex mutex;
@@ -145,6 +162,20 @@ class MediaStream : public MediaSink, public erizo::MediaStreamStatsListener, pu
      */
     static NAN_METHOD(getPeriodicStats);
 
+    /*
+     * Gets the stats that changed since the previous call with the same consumer id, as a Buffer encoded by
+     * erizo::StatsDeltaEncoder. The first call of a consumer gets a full snapshot
+     * Param: The consumer id
+     * Param: Callback that will get the Buffer, empty if nothing changed
+     */
+    static NAN_METHOD(getStatsDelta);
+
+    /*
+     * Drops the state kept for a getStatsDelta consumer
+     * Param: The consumer id
+     */
+    static NAN_METHOD(removeStatsDeltaConsumer);
+
     /*
      * Sets Metadata that will be logged in every message
      * Param: An object with metadata {key1:value1, key2: value2}
@@ -176,6 +207,7 @@ class MediaStream : public MediaSink, public erizo::MediaStreamStatsListener, pu
 
     static NAUV_WORK_CB(statsCallback);
     virtual void notifyStats(const std::string& message);
+    virtual void notifyStatsDelta(const std::vector<uint8_t>& delta);
 
     static NAUV_WORK_CB(eventCallback);
     virtual void notifyMediaStreamEvent(const std::string& type = "",
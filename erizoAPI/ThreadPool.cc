@@ -4,6 +4,8 @@
 
 #include "ThreadPool.h"
 
+#include <DtlsTransport.h>
+
 using v8::Local;
 using v8::Value;
 using v8::Function;
@@ -12,6 +14,9 @@ using v8::HandleScope;
 using v8::Exception;
 
 using erizo::DurationDistribution;
+using erizo::WorkerLoad;
+using erizo::DtlsTransport;
+using erizo::LatencyHistogram;
 
 Nan::Persistent<Function> ThreadPool::constructor;
 
@@ -33,6 +38,11 @@ NAN_MODULE_INIT(ThreadPool::Init) {
   Nan::SetPrototypeMethod(tpl, "getDurationDistribution", getDurationDistribution);
   Nan::SetPrototypeMethod(tpl, "getDelayDistribution", getDelayDistribution);
   Nan::SetPrototypeMethod(tpl, "resetStats", resetStats);
+  Nan::SetPrototypeMethod(tpl, "getWorkersLoad", getWorkersLoad);
+  Nan::SetPrototypeMethod(tpl, "rebalance", rebalance);
+  Nan::SetPrototypeMethod(tpl, "getDtlsHandshakeLatency", getDtlsHandshakeLatency);
+  Nan::SetPrototypeMethod(tpl, "getHandlerProfile", getHandlerProfile);
+  Nan::SetPrototypeMethod(tpl, "getTaskLatency", getTaskLatency);
 
   constructor.Reset(Nan::GetFunction(tpl).ToLocalChecked());
   Nan::Set(target, Nan::New("ThreadPool").ToLocalChecked(), Nan::GetFunction(tpl).ToLocalChecked());
@@ -44,9 +54,13 @@ NAN_METHOD(ThreadPool::New) {
   }
 
   unsigned int num_workers = Nan::To<unsigned int>(info[0]).FromJust();
+  unsigned int num_handshake_workers = 0;
+  if (info.Length() > 1 && info[1]->IsNumber()) {
+    num_handshake_workers = Nan::To<unsigned int>(info[1]).FromJust();
+  }
 
   ThreadPool* obj = new ThreadPool();
-  obj->me.reset(new erizo::ThreadPool(num_workers));
+  obj->me.reset(new erizo::ThreadPool(num_workers, num_handshake_workers));
 
   obj->Wrap(info.This());
   info.GetReturnValue().Set(info.This());
@@ -93,4 +107,112 @@ NAN_METHOD(ThreadPool::getDelayDistribution) {
 NAN_METHOD(ThreadPool::resetStats) {
   ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
   obj->me->resetStats();
+  DtlsTransport::getHandshakeLatencyHistogram().reset();
+}
+
+NAN_METHOD(ThreadPool::getWorkersLoad) {
+  ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
+  std::vector<WorkerLoad> loads = obj->me->getWorkersLoad();
+  v8::Local<v8::Array> array = Nan::New<v8::Array>(loads.size());
+  for (unsigned int index = 0; index < loads.size(); index++) {
+    v8::Local<v8::Object> load = Nan::New<v8::Object>();
+    Nan::Set(load, Nan::New("busyRatio").ToLocalChecked(), Nan::New(loads[index].busy_ratio));
+    Nan::Set(load, Nan::New("queuedTasks").ToLocalChecked(),
+             Nan::New(static_cast<double>(loads[index].queued_tasks)));
+    Nan::Set(load, Nan::New("packetsPerSecond").ToLocalChecked(), Nan::New(loads[index].packets_per_second));
+    Nan::Set(load, Nan::New("score").ToLocalChecked(), Nan::New(loads[index].getScore()));
+    Nan::Set(array, index, load);
+  }
+
+  info.GetReturnValue().Set(array);
+}
+
+NAN_METHOD(ThreadPool::rebalance) {
+  ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
+  info.GetReturnValue().Set(Nan::New(obj->me->rebalance()));
+}
+
+NAN_METHOD(ThreadPool::getDtlsHandshakeLatency) {
+  const LatencyHistogram &histogram = DtlsTransport::getHandshakeLatencyHistogram();
+  v8::Local<v8::Object> latency = Nan::New<v8::Object>();
+  Nan::Set(latency, Nan::New("count").ToLocalChecked(), Nan::New(static_cast<double>(histogram.getCount())));
+  Nan::Set(latency, Nan::New("p50Ms").ToLocalChecked(),
+           Nan::New(histogram.getPercentileMicroseconds(50) / 1000.));
+  Nan::Set(latency, Nan::New("p95Ms").ToLocalChecked(),
+           Nan::New(histogram.getPercentileMicroseconds(95) / 1000.));
+  Nan::Set(latency, Nan::New("p99Ms").ToLocalChecked(),
+           Nan::New(histogram.getPercentileMicroseconds(99) / 1000.));
+  Nan::Set(latency, Nan::New("maxMs").ToLocalChecked(), Nan::New(histogram.getMaxMicroseconds() / 1000.));
+
+  info.GetReturnValue().Set(latency);
+}
+
+NAN_METHOD(ThreadPool::getHandlerProfile) {
+  ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
+  std::vector<erizo::HandlerProfiler::Snapshot> profiles = obj->me->getHandlerProfiles();
+  const char *call_names[erizo::HandlerProfiler::kNumCalls] = {"read", "write", "notifyUpdate"};
+  v8::Local<v8::Array> array = Nan::New<v8::Array>(profiles.size());
+  for (unsigned int index = 0; index < profiles.size(); index++) {
+    v8::Local<v8::Object> profile = Nan::New<v8::Object>();
+    for (const auto &name_and_costs : profiles[index]) {
+      v8::Local<v8::Object> handler = Nan::New<v8::Object>();
+      for (size_t call = 0; call < erizo::HandlerProfiler::kNumCalls; call++) {
+        v8::Local<v8::Object> cost = Nan::New<v8::Object>();
+        Nan::Set(cost, Nan::New("calls").ToLocalChecked(),
+                 Nan::New(static_cast<double>(name_and_costs.second[call].calls)));
+        Nan::Set(cost, Nan::New("cycles").ToLocalChecked(),
+                 Nan::New(static_cast<double>(name_and_costs.second[call].cycles)));
+        Nan::Set(handler, Nan::New(call_names[call]).ToLocalChecked(), cost);
+      }
+      Nan::Set(profile, Nan::New(name_and_costs.first).ToLocalChecked(), handler);
+    }
+    Nan::Set(array, index, profile);
+  }
+
+  info.GetReturnValue().Set(array);
+}
+
+static v8::Local<v8::Object> toPercentilesObject(const LatencyHistogram &histogram) {
+  v8::Local<v8::Object> percentiles = Nan::New<v8::Object>();
+  Nan::Set(percentiles, Nan::New("count").ToLocalChecked(), Nan::New(static_cast<double>(histogram.getCount())));
+  Nan::Set(percentiles, Nan::New("p50Us").ToLocalChecked(),
+           Nan::New(static_cast<double>(histogram.getPercentileMicroseconds(50))));
+  Nan::Set(percentiles, Nan::New("p99Us").ToLocalChecked(),
+           Nan::New(static_cast<double>(histogram.getPercentileMicroseconds(99))));
+  Nan::Set(percentiles, Nan::New("p999Us").ToLocalChecked(),
+           Nan::New(static_cast<double>(histogram.getPercentileMicroseconds(99.9))));
+  Nan::Set(percentiles, Nan::New("maxUs").ToLocalChecked(),
+           Nan::New(static_cast<double>(histogram.getMaxMicroseconds())));
+  return percentiles;
+}
+
+v8::Local<v8::Array> ThreadPool::toTaskLatencyArray(const std::vector<erizo::TaskLatency> &latencies) {
+  const char *origin_names[erizo::kNumTaskOrigins] = {"internal", "packet", "timer", "api"};
+  v8::Local<v8::Array> array = Nan::New<v8::Array>(latencies.size());
+  for (unsigned int index = 0; index < latencies.size(); index++) {
+    const erizo::TaskLatency &latency = latencies[index];
+    v8::Local<v8::Object> durations = Nan::New<v8::Object>();
+    v8::Local<v8::Object> delays = Nan::New<v8::Object>();
+    Nan::Set(durations, Nan::New("all").ToLocalChecked(), toPercentilesObject(latency.getDurations()));
+    Nan::Set(delays, Nan::New("all").ToLocalChecked(), toPercentilesObject(latency.getDelays()));
+    for (int origin = 0; origin < erizo::kNumTaskOrigins; origin++) {
+      erizo::TaskOrigin task_origin = static_cast<erizo::TaskOrigin>(origin);
+      Nan::Set(durations, Nan::New(origin_names[origin]).ToLocalChecked(),
+               toPercentilesObject(latency.getDurations(task_origin)));
+      Nan::Set(delays, Nan::New(origin_names[origin]).ToLocalChecked(),
+               toPercentilesObject(latency.getDelays(task_origin)));
+    }
+    v8::Local<v8::Object> worker_latency = Nan::New<v8::Object>();
+    Nan::Set(worker_latency, Nan::New("queuedTasks").ToLocalChecked(),
+             Nan::New(static_cast<double>(latency.queued_tasks)));
+    Nan::Set(worker_latency, Nan::New("duration").ToLocalChecked(), durations);
+    Nan::Set(worker_latency, Nan::New("delay").ToLocalChecked(), delays);
+    Nan::Set(array, index, worker_latency);
+  }
+  return array;
+}
+
+NAN_METHOD(ThreadPool::getTaskLatency) {
+  ThreadPool* obj = Nan::ObjectWrap::Unwrap<ThreadPool>(info.Holder());
+  info.GetReturnValue().Set(toTaskLatencyArray(obj->me->getTaskLatencies()));
 }
@@ -16,6 +16,11 @@ class ThreadPool : public Nan::ObjectWrap {
     static NAN_MODULE_INIT(Init);
     std::unique_ptr<erizo::ThreadPool> me;
 
+    /*
+     * Percentiles of the task durations and delays of every worker, in microseconds and by task origin
+     */
+    static v8::Local<v8::Array> toTaskLatencyArray(const std::vector<erizo::TaskLatency> &latencies);
+
  private:
     ThreadPool();
     ~ThreadPool();
@@ -38,6 +43,27 @@ class ThreadPool : public Nan::ObjectWrap {
     static NAN_METHOD(getDurationDistribution);
     static NAN_METHOD(getDelayDistribution);
     static NAN_METHOD(resetStats);
+    /*
+     * Returns the measured load of every worker in the pool
+     */
+    static NAN_METHOD(getWorkersLoad);
+    /*
+     * Moves work away from workers with delayed tasks, returns true if something has been moved
+     */
+    static NAN_METHOD(rebalance);
+    /*
+     * Returns percentiles of the DTLS handshake durations since the last resetStats
+     */
+    static NAN_METHOD(getDtlsHandshakeLatency);
+    /*
+     * Returns, for every worker, the calls and estimated CPU cycles of each pipeline handler since the last
+     * resetStats
+     */
+    static NAN_METHOD(getHandlerProfile);
+    /*
+     * Returns the task latency of every worker since the last resetStats
+     */
+    static NAN_METHOD(getTaskLatency);
 
     static Nan::Persistent<v8::Function> constructor;
 };
@@ -260,14 +260,15 @@ NAN_METHOD(WebRtcConnection::New) {
     iceConfig.max_port = maxPort;
     iceConfig.should_trickle = trickle;
 
-    std::shared_ptr<erizo::Worker> worker = thread_pool->me->getLessUsedWorker();
+    std::shared_ptr<erizo::Worker> worker = thread_pool->me->getLessUsedMigratableWorker();
     std::shared_ptr<erizo::IOWorker> io_worker = io_thread_pool->me->getLessUsedIOWorker();
+    std::shared_ptr<erizo::Worker> handshake_worker = thread_pool->me->getLessUsedHandshakeWorker();
 
     WebRtcConnection* obj = new WebRtcConnection();
     obj->id_ = wrtcId;
     obj->me = std::make_shared<erizo::WebRtcConnection>(worker, io_worker, wrtcId, iceConfig,
                                                         rtp_mappings, ext_mappings, enable_connection_quality_check,
-                                                        obj);
+                                                        obj, handshake_worker);
     obj->Wrap(info.This());
     obj->Ref();
     info.GetReturnValue().Set(info.This());
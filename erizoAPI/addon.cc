@@ -14,6 +14,14 @@
 #include "ThreadPool.h"
 #include "IOThreadPool.h"
 
+NAN_METHOD(setDtlsSessionResumption) {
+  if (info.Length() < 1) {
+    Nan::ThrowError("Wrong number of arguments");
+    return;
+  }
+  dtls::DtlsSocketContext::setSessionResumption(Nan::To<bool>(info[0]).FromJust());
+}
+
 NAN_MODULE_INIT(InitAll) {
   dtls::DtlsSocketContext::Init();
   WebRtcConnection::Init(target);
@@ -25,6 +33,7 @@ NAN_MODULE_INIT(InitAll) {
   ThreadPool::Init(target);
   IOThreadPool::Init(target);
   ConnectionDescription::Init(target);
+  Nan::SetMethod(target, "setDtlsSessionResumption", setDtlsSessionResumption);
 }
 
 NODE_MODULE(addon, InitAll)
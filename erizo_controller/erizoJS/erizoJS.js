@@ -13,6 +13,9 @@ global.config = config || {};
 global.config.erizo = global.config.erizo || {};
 global.config.erizo.numWorkers = global.config.erizo.numWorkers || 24;
 global.config.erizo.numIOWorkers = global.config.erizo.numIOWorkers || 1;
+global.config.erizo.workerRebalanceInterval = global.config.erizo.workerRebalanceInterval || 0;
+global.config.erizo.numHandshakeWorkers = global.config.erizo.numHandshakeWorkers || 0;
+global.config.erizo.dtlsSessionResumption = global.config.erizo.dtlsSessionResumption || false;
 global.config.erizo.useConnectionQualityCheck =
   global.config.erizo.useConnectionQualityCheck || false;
 global.config.erizo.stunserver = global.config.erizo.stunserver || '';
@@ -103,8 +106,18 @@ process.on('unhandledRejection', (reason, promise) => {
 });
 
 
-const threadPool = new addon.ThreadPool(global.config.erizo.numWorkers);
+const threadPool = new addon.ThreadPool(global.config.erizo.numWorkers,
+  global.config.erizo.numHandshakeWorkers);
 threadPool.start();
+addon.setDtlsSessionResumption(global.config.erizo.dtlsSessionResumption);
+
+if (global.config.erizo.workerRebalanceInterval > 0) {
+  setInterval(() => {
+    if (threadPool.rebalance()) {
+      log.info('message: Moving work away from a delayed worker');
+    }
+  }, global.config.erizo.workerRebalanceInterval);
+}
 
 const ioThreadPool = new addon.IOThreadPool(global.config.erizo.numIOWorkers);
 
@@ -74,7 +74,7 @@ exports.ErizoJSController = (erizoJSId, threadPool, ioThreadPool) => {
     const timeStamp = new Date();
     amqper.broadcast('stats', { pub: streamId,
       subs: clientId,
-      stats: JSON.parse(newStats),
+      stats: newStats,
       timestamp: timeStamp.getTime() });
   };
 
@@ -709,7 +709,14 @@ exports.ErizoJSController = (erizoJSId, threadPool, ioThreadPool) => {
     metrics.connectionDurationDistribution = Array(10).fill(0);
     metrics.durationDistribution = threadPool.getDurationDistribution();
     metrics.delayDistribution = threadPool.getDelayDistribution();
+    metrics.workersLoad = threadPool.getWorkersLoad();
+    metrics.dtlsHandshakeLatency = threadPool.getDtlsHandshakeLatency();
+    metrics.handlerProfile = threadPool.getHandlerProfile();
+    metrics.taskLatency = threadPool.getTaskLatency();
+    metrics.ioTaskLatency = ioThreadPool.getTaskLatency();
+    metrics.socketBatchStats = ioThreadPool.getSocketBatchStats();
     threadPool.resetStats();
+    ioThreadPool.resetStats();
 
     clients.forEach((client) => {
       const connections = client.getConnections();
@@ -3,6 +3,7 @@
 
 const EventEmitter = require('events').EventEmitter;
 const Helpers = require('./Helpers');
+const StatsMirror = require('./StatsMirror').StatsMirror;
 const logger = require('./../../common/logger').logger;
 
 const log = logger.getLogger('Node');
@@ -93,9 +94,11 @@ class Node extends EventEmitter {
     if (global.config.erizoController.report.rtcp_stats) {
       log.debug('message: RTCP Stat collection is active,',
         logger.objectToLog(this.options), logger.objectToLog(this.options.metadata));
-      mediaStream.getPeriodicStats((newStats) => {
-        this.emit('periodic_stats', newStats);
-      });
+      // Only the stats that changed travel from erizo, the mirror keeps the whole tree
+      const periodicStats = new StatsMirror();
+      mediaStream.getPeriodicStats((delta) => {
+        this.emit('periodic_stats', periodicStats.apply(delta));
+      }, true);
     }
   }
 }
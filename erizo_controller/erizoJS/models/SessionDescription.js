@@ -9,6 +9,7 @@ const ICEInfo = require('./../../common/semanticSdp/ICEInfo');
 const DTLSInfo = require('./../../common/semanticSdp/DTLSInfo');
 const CodecInfo = require('./../../common/semanticSdp/CodecInfo');
 const SourceInfo = require('./../../common/semanticSdp/SourceInfo');
+const SourceGroupInfo = require('./../../common/semanticSdp/SourceGroupInfo');
 const StreamInfo = require('./../../common/semanticSdp/StreamInfo');
 const TrackInfo = require('./../../common/semanticSdp/TrackInfo');
 const RIDInfo = require('./../../common/semanticSdp/RIDInfo');
@@ -41,6 +42,11 @@ function addSsrc(sources, ssrc, sdp, media, msid = sdp.msidSemantic.token) {
     stream.addTrack(track);
   }
   track.addSSRC(source);
+  return track;
+}
+
+function hasRtx(media) {
+  return Array.from(media.getCodecs().values()).some(codec => codec.hasRTX());
 }
 
 function getMediaInfoFromDescription(info, sdp, mediaType) {
@@ -130,9 +136,16 @@ function getMediaInfoFromDescription(info, sdp, mediaType) {
 
     if (info.getDirection('video') !== 'recvonly') {
       const videoSsrcMap = info.getVideoSsrcMap();
+      const videoRtxSsrcMap = hasRtx(media) ? info.getVideoRtxSsrcMap() : {};
       Object.keys(videoSsrcMap).forEach((streamLabel) => {
+        const rtxSsrcs = videoRtxSsrcMap[streamLabel] || {};
         videoSsrcMap[streamLabel].forEach((ssrc) => {
-          addSsrc(sources, ssrc, sdp, media, streamLabel);
+          const track = addSsrc(sources, ssrc, sdp, media, streamLabel);
+          const rtxSsrc = rtxSsrcs[ssrc];
+          if (rtxSsrc) {
+            addSsrc(sources, rtxSsrc, sdp, media, streamLabel);
+            track.addSourceGroup(new SourceGroupInfo('FID', [ssrc, rtxSsrc]));
+          }
         });
       });
     }
@@ -234,6 +247,8 @@ class SessionDescription {
     const streamId = stream.getId();
     let videoSsrcList = [];
     let simulcastVideoSsrcList;
+    const rtxSsrcs = new Set();
+    const videoRtxSsrcMap = {};
 
     stream.getTracks().forEach((track) => {
       if (track.getMedia() === 'audio') {
@@ -248,12 +263,19 @@ class SessionDescription {
       track.getSourceGroups().forEach((group) => {
         if (group.getSemantics().toUpperCase() === 'SIM') {
           simulcastVideoSsrcList = group.getSSRCs();
+        } else if (group.getSemantics().toUpperCase() === 'FID') {
+          rtxSsrcs.add(group.getSSRCs()[1]);
+          videoRtxSsrcMap[group.getSSRCs()[0]] = group.getSSRCs()[1];
         }
       });
     });
 
-    videoSsrcList = simulcastVideoSsrcList || videoSsrcList;
+    // Retransmissions are not forwarded as media, so their SSRCs must not be taken as video sources
+    videoSsrcList = simulcastVideoSsrcList || videoSsrcList.filter(ssrc => !rtxSsrcs.has(ssrc));
     info.setVideoSsrcList(streamId, videoSsrcList);
+    if (Object.keys(videoRtxSsrcMap).length > 0) {
+      info.setVideoRtxSsrcMap(streamId, videoRtxSsrcMap);
+    }
   }
 
   processSdp() {
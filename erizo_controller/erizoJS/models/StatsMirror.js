@@ -0,0 +1,112 @@
+/* global exports */
+
+// Keeps a copy of a MediaStream stats tree up to date with the deltas built by erizo::StatsDeltaEncoder
+const VERSION = 1;
+const FULL_SNAPSHOT = 1;
+const NUMBER = 0;
+const TEXT = 1;
+const REMOVED = 2;
+
+class StatsMirror {
+  constructor() {
+    this.stats = {};
+    this.paths = new Map();
+  }
+
+  // Applies a delta Buffer and returns the updated stats object
+  apply(delta) {
+    if (!delta || delta.length === 0) {
+      return this.stats;
+    }
+    this.buffer = delta;
+    this.offset = 0;
+    const version = this._readByte();
+    if (version !== VERSION) {
+      throw new Error(`Unsupported stats delta version ${version}`);
+    }
+    const flags = this._readByte();
+    if (flags & FULL_SNAPSHOT) {
+      this.stats = {};
+      this.paths.clear();
+    }
+    const keyCount = this._readVarint();
+    for (let key = 0; key < keyCount; key += 1) {
+      const id = this._readVarint();
+      this.paths.set(id, this._readString().split('.'));
+    }
+    const changeCount = this._readVarint();
+    for (let change = 0; change < changeCount; change += 1) {
+      const path = this.paths.get(this._readVarint());
+      const type = this._readByte();
+      if (type === NUMBER) {
+        this._set(path, this._readVarint());
+      } else if (type === TEXT) {
+        this._set(path, this._readString());
+      } else if (type === REMOVED) {
+        this._remove(path);
+      }
+    }
+    this.buffer = undefined;
+    return this.stats;
+  }
+
+  _set(path, value) {
+    let node = this.stats;
+    for (let index = 0; index < path.length - 1; index += 1) {
+      if (typeof node[path[index]] !== 'object') {
+        node[path[index]] = {};
+      }
+      node = node[path[index]];
+    }
+    node[path[path.length - 1]] = value;
+  }
+
+  _remove(path) {
+    const parents = [];
+    let node = this.stats;
+    for (let index = 0; index < path.length - 1; index += 1) {
+      parents.push(node);
+      node = node[path[index]];
+      if (typeof node !== 'object') {
+        return;
+      }
+    }
+    delete node[path[path.length - 1]];
+    // Drops the parents that were left empty
+    for (let index = path.length - 2; index >= 0; index -= 1) {
+      if (Object.keys(node).length > 0) {
+        return;
+      }
+      node = parents[index];
+      delete node[path[index]];
+    }
+  }
+
+  _readByte() {
+    const byte = this.buffer[this.offset];
+    this.offset += 1;
+    return byte;
+  }
+
+  // Multiplies instead of shifting to keep values above 2^31 right
+  _readVarint() {
+    let value = 0;
+    let multiplier = 1;
+    let byte;
+    do {
+      byte = this._readByte();
+      value += (byte & 0x7f) * multiplier;
+      multiplier *= 128;
+    } while (byte & 0x80);
+    return value;
+  }
+
+  _readString() {
+    const length = this._readVarint();
+    const text = this.buffer.toString('utf8', this.offset, this.offset + length);
+    this.offset += length;
+    return text;
+  }
+}
+
+exports.StatsMirror = StatsMirror;
@@ -0,0 +1,85 @@
+/* global require, describe, it, beforeEach */
+
+// eslint-disable-next-line import/no-extraneous-dependencies
+const expect = require('chai').expect;
+const StatsMirror = require('../../erizoJS/models/StatsMirror').StatsMirror;
+
+// Deltas built by erizo::StatsDeltaEncoder, in order, for a tree that starts as
+// { 1234: { packetsLost: 10, type: 'video' }, total: { bitrate: 300 } }
+const kFullSnapshot = Buffer.from('0101030010313233342e7061636b6574734c6f73740109313233342e74797065020d746f74616c2e62' +
+  '6974726174650300000a010105766964656f0200ac02', 'hex');
+// 1234.packetsLost += 5 and a new total.fps = 30
+const kDelta = Buffer.from('0100010309746f74616c2e6670730200000f03001e', 'hex');
+// total replaced by an empty node
+const kRemoved = Buffer.from('0100000203020202', 'hex');
+// Encoder reset, the tree is { 1234: { packetsLost: 15, type: 'video' } }
+const kResetSnapshot = Buffer.from('0101020010313233342e7061636b6574734c6f73740109313233342e747970650200000f01010576' +
+  '6964656f', 'hex');
+// { v: { a: 0, b: 127, c: 128, d: 16383, e: 16384, f: 2^32 + 1, g: 2^53 - 1 }, text: 'x' repeated 200 times }
+const kVarints = Buffer.from(`0101080004746578740103762e610203762e620303762e630403762e640503762e650603762e66070376` +
+  `2e67080001c801${'78'.repeat(200)}01000002007f030080010400ff7f0500808001060081808080100700ffffffffffffff0f`, 'hex');
+
+describe('Stats Mirror', () => {
+  let mirror;
+
+  beforeEach(() => {
+    mirror = new StatsMirror();
+  });
+
+  it('should build the whole tree from a full snapshot', () => {
+    expect(mirror.apply(kFullSnapshot)).to.deep.equal({
+      1234: { packetsLost: 10, type: 'video' },
+      total: { bitrate: 300 },
+    });
+  });
+
+  it('should apply changes and new keys from a delta', () => {
+    mirror.apply(kFullSnapshot);
+
+    expect(mirror.apply(kDelta)).to.deep.equal({
+      1234: { packetsLost: 15, type: 'video' },
+      total: { bitrate: 300, fps: 30 },
+    });
+  });
+
+  it('should remove leaves and the parents they leave empty', () => {
+    mirror.apply(kFullSnapshot);
+    mirror.apply(kDelta);
+
+    expect(mirror.apply(kRemoved)).to.deep.equal({
+      1234: { packetsLost: 15, type: 'video' },
+    });
+  });
+
+  it('should drop its copy when it gets a new full snapshot', () => {
+    mirror.apply(kFullSnapshot);
+    mirror.apply(kDelta);
+
+    expect(mirror.apply(kResetSnapshot)).to.deep.equal({
+      1234: { packetsLost: 15, type: 'video' },
+    });
+  });
+
+  it('should keep the tree when the delta is empty', () => {
+    mirror.apply(kFullSnapshot);
+
+    expect(mirror.apply(Buffer.alloc(0))).to.deep.equal({
+      1234: { packetsLost: 10, type: 'video' },
+      total: { bitrate: 300 },
+    });
+  });
+
+  it('should decode varints of every length up to 2^53 - 1 and long texts', () => {
+    expect(mirror.apply(kVarints)).to.deep.equal({
+      v: { a: 0, b: 127, c: 128, d: 16383, e: 16384, f: 4294967297, g: Number.MAX_SAFE_INTEGER },
+      text: 'x'.repeat(200),
+    });
+  });
+
+  it('should fail with unknown versions', () => {
+    const delta = Buffer.from(kDelta);
+    delta[0] = 2;
+
+    expect(() => mirror.apply(delta)).to.throw('Unsupported stats delta version 2');
+  });
+});
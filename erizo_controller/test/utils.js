@@ -151,6 +151,7 @@ module.exports.reset = () => {
     setBundle: sinon.stub(),
     setAudioAndVideo: sinon.stub(),
     setVideoSsrcList: sinon.stub(),
+    setVideoRtxSsrcMap: sinon.stub(),
     postProcessInfo: sinon.stub(),
     hasAudio: sinon.stub(),
     hasVideo: sinon.stub(),
@@ -182,6 +183,8 @@ module.exports.reset = () => {
     setMaxVideoBW: sinon.stub(),
     getStats: sinon.stub(),
     getPeriodicStats: sinon.stub(),
+    getStatsDelta: sinon.stub(),
+    removeStatsDeltaConsumer: sinon.stub(),
     generatePLIPacket: sinon.stub(),
     setSlideShowMode: sinon.stub(),
     setPeriodicKeyframeRequests: sinon.stub(),
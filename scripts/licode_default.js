@@ -163,6 +163,16 @@ config.erizo.numWorkers = 24;
 // Number of workers what will be used for IO (including ICE logic)
 config.erizo.numIOWorkers = 1;
 
+// Interval in ms to move connections away from workers with delayed tasks. 0 disables it
+config.erizo.workerRebalanceInterval = 0;
+
+// Number of workers that will run DTLS handshakes, so they do not delay media workers.
+// 0 runs them in the connection worker
+config.erizo.numHandshakeWorkers = 0;
+
+// Lets reconnecting clients resume their DTLS session instead of running a full handshake
+config.erizo.dtlsSessionResumption = false;
+
 // the max amount of time in days a process is allowed to be up after the first publisher is added
 config.erizo.activeUptimeLimit = 7;
 // the max time in hours since last publish or subscribe operation where a erizoJS process can be killed